@@ -40,12 +40,21 @@ class GDataFrameQueue
 public:
 	GDataFrameQueue() :
 		m_bRejectWhenFull(true)
+		, m_bBlockWhenFull(false)
+		, m_bInterrupted(false)
 		, m_bReadingFlag(false)
 		, m_iTotalSize_Byte(0)
 		, m_iMaxFrameNum(4)
 	{}
 
 	void Init(int iSize_Byte, bool bRejectWhenFull = true, int iMaxFrameNum = 4);
+
+	//instead of rejecting a new frame when the queue is full, CreateFrame() waits until the reading thread releases a frame.
+	//only works together with bRejectWhenFull.
+	void SetBlockWhenFull(bool bBlockWhenFull);
+
+	//wake up CreateFrame() calls waiting for room and make them fail, as well as all later blocking calls.
+	void Interrupt();
 	bool CreateFrame(const TDataFrameHead& frameHead);
 	void* InMapFrame();
 	void CompleteFrame();
@@ -58,6 +67,8 @@ public:
 private:
 	int GetWriteableIdx(int iSize_Byte);
 
+	int GetWriteableIdx_Locked(int iSize_Byte);
+
 	bool CheckShouldResize(const TDataFrameHead& frameHead);
 
 	int CalcNewQueueSize(const TDataFrameHead& frameHead) const;
@@ -83,8 +94,11 @@ private:
 private:
 	int m_iMaxFrameNum;
 	bool m_bRejectWhenFull;
+	bool m_bBlockWhenFull;
+	bool m_bInterrupted;
 
 	std::mutex m_mtHeadBufferMutex;
+	std::condition_variable m_cvFrameReleasedCV;
 
 	bool m_bReadingFlag;
 	std::mutex m_mtReadingFlagMutex;
@@ -105,6 +119,23 @@ void GDataFrameQueue<TDataFrameHead>::Init(int iSize_Byte, bool bRejectWhenFull/
 	m_iMaxFrameNum = iMaxFrameNum;
 }
 
+template<typename TDataFrameHead>
+void GDataFrameQueue<TDataFrameHead>::SetBlockWhenFull(bool bBlockWhenFull)
+{
+	std::lock_guard<std::mutex> headBufferLock(m_mtHeadBufferMutex);
+	m_bBlockWhenFull = bBlockWhenFull;
+}
+
+template<typename TDataFrameHead>
+void GDataFrameQueue<TDataFrameHead>::Interrupt()
+{
+	{
+		std::lock_guard<std::mutex> headBufferLock(m_mtHeadBufferMutex);
+		m_bInterrupted = true;
+	}
+	m_cvFrameReleasedCV.notify_all();
+}
+
 template<typename TDataFrameHead>
 bool GDataFrameQueue<TDataFrameHead>::CreateFrame(const TDataFrameHead& frameHead)
 {
@@ -125,6 +156,21 @@ bool GDataFrameQueue<TDataFrameHead>::CreateFrame(const TDataFrameHead& frameHea
 	int iStartIdx = GetWriteableIdx(frameHead.Size_Byte());
 	if (m_bRejectWhenFull)
 	{
+		if ((iStartIdx < 0) && m_bBlockWhenFull)
+		{
+			std::unique_lock<std::mutex> headBufferLock(m_mtHeadBufferMutex);
+			m_cvFrameReleasedCV.wait(headBufferLock, [this, &frameHead, &iStartIdx]()
+			{
+				iStartIdx = this->GetWriteableIdx_Locked(frameHead.Size_Byte());
+				return (this->m_bInterrupted || (iStartIdx >= 0));
+			});
+
+			if (m_bInterrupted)
+			{
+				return false;
+			}
+		}
+
 		if (iStartIdx < 0)
 		{
 			//GLOGGER(info) << "GDataFrameQueue::CreateFrame(). no enough memory.";
@@ -257,15 +303,22 @@ void GDataFrameQueue<TDataFrameHead>::ReleaseFrame()
 		m_bReadingFlag = false;
 	}
 	m_cvReadingFlagCV.notify_one();
+	m_cvFrameReleasedCV.notify_all();
 }
 
 template<typename TDataFrameHead>
 int GDataFrameQueue<TDataFrameHead>::GetWriteableIdx(int iSize_Byte)
+{
+	std::lock_guard<std::mutex> headBufferLock(m_mtHeadBufferMutex);
+	return GetWriteableIdx_Locked(iSize_Byte);
+}
+
+template<typename TDataFrameHead>
+int GDataFrameQueue<TDataFrameHead>::GetWriteableIdx_Locked(int iSize_Byte)
 {
 	//ret: m_iHeadIdx / 0 / -1.
 	//to check.
 
-	std::lock_guard<std::mutex> headBufferLock(m_mtHeadBufferMutex);
 	if (m_qHeadBuffer.empty())
 	{
 		return 0;
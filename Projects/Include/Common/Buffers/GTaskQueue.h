@@ -42,6 +42,8 @@ public:
 	void CompleteTask();
 
 	TTask* GrabTask();
+	//grab the oldest task even if the queue is not full, for flushing the queue.
+	TTask* GrabOldestTask();
 	void ReleaseTask();
 
 	void Release(std::function<void(TTask&)> fnRelease);
@@ -106,6 +108,19 @@ TTask* GTaskQueue<TTask>::GrabTask()
 	}
 }
 
+template<typename TTask>
+TTask* GTaskQueue<TTask>::GrabOldestTask()
+{
+	if (!m_qIdxQueue.empty())
+	{
+		return &m_vTasks[m_qIdxQueue.front()];
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
 template<typename TTask>
 void GTaskQueue<TTask>::ReleaseTask()
 {
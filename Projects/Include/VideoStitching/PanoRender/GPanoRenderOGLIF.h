@@ -67,6 +67,12 @@
 typedef void(G_CALL_CONVENTION *G_tRenderCallBack)(void* pContext);
 typedef void(G_CALL_CONVENTION *G_tOutputCallBack)(unsigned int uiWidth, unsigned int uiHeight, const unsigned char* pRGBData, void* pContext);
 
+struct G_tQualityState;
+typedef void(G_CALL_CONVENTION *G_tQualityCallBack)(const struct G_tQualityState* pQualityState, void* pContext);
+
+struct G_tOutputFrameInfo;
+typedef void(G_CALL_CONVENTION *G_tOutputCallBackEx)(unsigned int uiWidth, unsigned int uiHeight, const unsigned char* pRGBData, const struct G_tOutputFrameInfo* pFrameInfo, void* pContext);
+
 enum G_enPanoType
 {
 	G_ePanoTypeOriginal = 0,
@@ -127,12 +133,37 @@ enum G_enRenderingMode
 {
 	//With display output, real time.
 	G_eRenderingModeOnScreen = 0,
-	//Without display output, not real time. NOT IMPLEMENTED YET, use G_eRenderingModeOffScreenRealTime instead.
+	//Without display output, not real time. Lossless: every group of input frames, one frame from each camera, is rendered
+	//into exactly one output frame, as fast as possible. G_InputFrame() blocks while the input queue of the camera is full.
 	G_eRenderingModeOffScreen = 1,
 	//Without display output, real time.
 	G_eRenderingModeOffScreenRealTime = 2,
 };
 
+enum G_enFramePacingMode
+{
+	//Render at a fixed frame rate. The default mode, at 30 FPS.
+	G_eFramePacingModeFixedFPS = 0,
+	//Render when every camera that has input frames has delivered a new one since the last render.
+	G_eFramePacingModeInputDriven = 1,
+	//Render as fast as possible.
+	G_eFramePacingModeUnthrottled = 2,
+	//Render once per display refresh. On screen mode only.
+	G_eFramePacingModeVSync = 3,
+};
+
+enum G_enHeadlessPlatform
+{
+	//Use the first available platform below.
+	G_eHeadlessPlatformAuto = 0,
+	//EGL_MESA_platform_surfaceless, e.g. Mesa llvmpipe in containers without a GPU.
+	G_eHeadlessPlatformSurfaceless = 1,
+	//EGL_EXT_platform_device, the first GPU found, without a display server.
+	G_eHeadlessPlatformDevice = 2,
+	//The default EGL display with a pbuffer surface.
+	G_eHeadlessPlatformPBuffer = 3,
+};
+
 struct G_tPanoRenderConfig
 {
 	G_enRenderingMode eRenderingMode;
@@ -167,10 +198,250 @@ struct G_tPhysicalDirection
 	float fPhi;
 };
 
+// Metadata of an output frame, passed to G_tOutputCallBackEx. All times are in microseconds on a monotonic clock.
+// The struct and the arrays it points to are only valid during the callback.
+struct G_tOutputFrameInfo
+{
+// Increases by one for every rendered panorama. A gap means panoramas were rendered but not delivered to this callback.
+	unsigned long long ullSequenceNumber;
+
+// Number of elements in pInputFrameIDs and pInputTimeStamps, equal to the number of cameras in the profile.
+	unsigned int uiCameraNum;
+
+// ID of the input frame stitched into this output, one for each camera. IDs start from 1 and increase by one for every
+// G_InputFrame()/G_InputFrameEx() call on the camera, and for every frame of the camera passed to G_RenderFrameGroup(),
+// so a gap means input frames were dropped. 0 means no frame has arrived yet.
+	const unsigned long long* pInputFrameIDs;
+
+// Timestamp of the input frame stitched into this output, one for each camera.
+// It is the llTimeStamp passed to G_InputFrameEx(), or the arrival time of the frame for G_InputFrame().
+	const long long* pInputTimeStamps;
+
+// The longest time an input frame consumed by this output waited in its input queue before rendering started.
+	long long llQueueWait_us;
+
+// Time the render pass started, and time the output pixels became available.
+	long long llRenderStartTime_us;
+	long long llRenderEndTime_us;
+};
+
+// An input frame of G_RenderFrameGroup(). The fields are the same as the arguments of G_InputFrameEx().
+struct G_tInputFrame
+{
+	unsigned int uiWidth;
+	unsigned int uiHeight;
+	void* pData[3];
+	unsigned int uiStep_Byte[3];
+	long long llTimeStamp;
+};
+
+// An output of G_RenderFrameGroup().
+struct G_tFrameGroupOutput
+{
+// Scale of the output frame relative to the original panorama size, the same as the fScale of G_SetOutputCallBack().
+	float fScale;
+
+// Input: resolution of the preallocated buffer. Output: actual resolution of the output frame.
+	unsigned int uiWidth;
+	unsigned int uiHeight;
+
+// Preallocated buffer for the RGB output frame, whose rows are stored without padding.
+	unsigned char* pRGBData;
+};
+
+// Frame pacing statistics, see G_GetRenderStatistics(). Averages are taken over the recent frames.
+struct G_tRenderStatistics
+{
+// Frame rate actually achieved.
+	float fAchievedFPS;
+
+// Time spent on one frame, including uploading, rendering, output and buffer swapping, in milliseconds.
+	float fAverageFrameTime_ms;
+
+// Scheduling slack of a frame, in milliseconds. In G_eFramePacingModeFixedFPS it is the time left before the deadline of
+// the next frame when the frame is done, and becomes negative when the renderer can not keep up with the target frame rate.
+// In the other modes it is the time the renderer was idle before the next frame.
+	float fAverageSlack_ms;
+	float fMinSlack_ms;
+
+// Number of frames rendered since the PanoRender object was created.
+	unsigned long long ullRenderedFrames;
+
+// Number of frames finished after the deadline of the next frame in G_eFramePacingModeFixedFPS.
+	unsigned long long ullLateFrames;
+
+// OpenGL calls issued to render the scenes of a frame, including the views. The patches of the same number of cameras are
+// drawn with one program from shared buffers, a state change is a program, uniform, vertex array or texture binding call.
+	float fAverageDrawCalls;
+	float fAverageStateChanges;
+
+// Time the rendering thread spends issuing the OpenGL calls of the scenes of a frame, including the views, in milliseconds.
+// It does not include the time the GPU takes to execute them.
+	float fAverageSceneCPUTime_ms;
+};
+
+// Quality axes the controller may degrade, see G_EnableQualityController(). Combine them with bitwise OR.
+enum G_enQualityAxis
+{
+	//Render the panorama and the views at a lower resolution.
+	G_eQualityAxisResolution = 1,
+	//Build the scene with a coarser surface mesh. Changing it rebuilds the scene, so it is the last axis to degrade.
+	G_eQualityAxisTessellation = 2,
+	//Do not upload the input frames of the cameras that can not be seen in the panorama or any view. The frames are still consumed.
+	G_eQualityAxisInvisibleCameras = 4,
+	//Reduce the scales of the output callbacks, and so the amount of pixels read back.
+	G_eQualityAxisOutputScale = 8,
+};
+
+// Ways to draw the scene of a panorama type, see G_SetRenderPath().
+enum G_enRenderPath
+{
+	//Draw the tessellated surface, the texture coordinates are interpolated over its triangles.
+	G_eRenderPathMesh = 0,
+	//Look the cameras and blending weights of every output pixel up in remap tables, one quad per frame.
+	G_eRenderPathRemapLUT = 1,
+};
+
+struct G_tQualityControllerConfig
+{
+// Frame time to hold, in milliseconds. It is the time the rendering thread spends on a frame, excluding the wait for the next frame and buffer swapping.
+	float fTargetFrameTime_ms;
+
+// Combination of G_enQualityAxis values.
+	unsigned int uiAxes;
+
+// Lower bounds of the degradation, fMinResolutionScale and fMinOutputScale in (0.0, 1.0].
+	float fMinResolutionScale;
+	int iMinTessellationLevel;
+	float fMinOutputScale;
+};
+
+// Current quality level, see G_GetQualityState().
+struct G_tQualityState
+{
+// 0 is the full quality, iLevelNum - 1 the lowest quality allowed by the configuration.
+	int iLevel;
+	int iLevelNum;
+
+// Factor applied to the rendering resolution, and to the scales of the output callbacks.
+	float fResolutionScale;
+	float fOutputScale;
+
+	int iTessellationLevel;
+	int bSkipInvisibleCameras;
+
+// Smoothed frame time measured by the controller, and the target, in milliseconds.
+	float fAverageFrameTime_ms;
+	float fTargetFrameTime_ms;
+};
+
+// Progress of the scenes requested by G_WarmUpPanoTypes().
+struct G_tWarmUpState
+{
+// Number of panorama types requested, and of them built on the worker thread, and ready to switch to without delay.
+// uiReady counts the current scene as well if its panorama type is requested.
+	unsigned int uiRequested;
+	unsigned int uiBuilt;
+	unsigned int uiReady;
+// Number of scenes that failed to build since the last request.
+	unsigned int uiFailed;
+};
+
+// Memory taken by the scenes, see G_GetSceneMemoryState(). The memory of a scene is that of its buffers and textures on the GPU,
+// and of the patches kept on the host for the visibility tests.
+struct G_tSceneMemoryState
+{
+// Bytes and number of the scenes in use, i.e. of the current panorama type and of the views.
+	unsigned long long ullInUse_Byte;
+	unsigned int uiInUseScenes;
+// Bytes and number of the scenes kept ready by G_WarmUpPanoTypes() and not in use.
+	unsigned long long ullCached_Byte;
+	unsigned int uiCachedScenes;
+// Budget set by G_SetSceneMemoryBudget(), 0 is unlimited.
+	unsigned long long ullBudget_Byte;
+// Number of cached scenes released to keep to the budget since the PanoRender object was created.
+	unsigned long long ullEvictedScenes;
+};
+
+// Shader programs of a PanoRender object, see G_GetProgramCacheStatistics(). A program only depends on the input frame format,
+// the number of cameras blended and the GLSL version, it is linked once and shared by all the scenes that need it.
+struct G_tProgramCacheStatistics
+{
+// Number of programs linked and kept.
+	unsigned int uiPrograms;
+// Number of requests for a program served from the cache, and number of programs linked, since the PanoRender object was created.
+	unsigned long long ullHits;
+	unsigned long long ullMisses;
+// Time spent compiling and linking the programs, in milliseconds.
+	float fCompileTime_ms;
+// Number of the programs linked that were loaded from the program binary cache instead, see G_SetProgramBinaryCacheDirectory().
+	unsigned long long ullBinaryLoads;
+// Number of programs of scenes warmed up by G_WarmUpPanoTypes() still being linked in the background, and number of programs
+// linked that way. The scene in use keeps being rendered while they are linked.
+	unsigned int uiPending;
+	unsigned long long ullBackgroundLinks;
+// Time from starting a background link until the program was ready, in milliseconds, averaged over the background links and
+// the longest one. It is measured in frames, the program is taken over by the first frame after it was linked.
+	float fAverageLinkLatency_ms;
+	float fMaxLinkLatency_ms;
+};
+
+// Statistics of a view added by G_AddView(). Averages are taken over the recent frames.
+struct G_tViewStatistics
+{
+// Number of frames rendered, and number of them delivered to the output callbacks of the view.
+	unsigned long long ullRenderedFrames;
+	unsigned long long ullDeliveredFrames;
+
+// CPU time spent on issuing the rendering of the view in a frame, in milliseconds.
+	float fAverageRenderTime_ms;
+
+// Time from the start of the frame to the output pixels of the view becoming available, in milliseconds.
+	float fAverageOutputLatency_ms;
+};
+
+// Statistics of the shared render threads, see G_GetRenderExecutorStatistics(). Counted since G_InitRenderExecutor().
+struct G_tRenderExecutorStatistics
+{
+	unsigned int uiThreadNum;
+
+// Number of PanoRender objects running on the render threads.
+	unsigned int uiPanoRenderNum;
+
+// Number of rendering loop iterations run, and how many of them had to switch the OpenGL context of the thread first.
+	unsigned long long ullSteps;
+	unsigned long long ullContextSwitches;
+
+// Time from a PanoRender object becoming ready to render, e.g. reaching its frame deadline, to running on its thread, in milliseconds.
+	float fAverageSchedulingDelay_ms;
+	float fMaxSchedulingDelay_ms;
+
+// Fraction of the time the render threads were busy, in [0.0, 1.0].
+	float fUtilization;
+};
+
 #ifdef __cplusplus
 extern "C"{
 #endif // __cplusplus
 
+//*************************** Shared render threads. ***************************//
+
+// Create a pool of render threads shared by the PanoRender objects created afterwards in the off screen rendering modes,
+// instead of a thread for each of them. Each PanoRender object stays on one of the threads, which switches between the
+// OpenGL contexts of its PanoRender objects and runs the one that has been ready to render for the longest time first.
+// PanoRender objects in G_eRenderingModeOnScreen always use a thread of their own.
+// Callbacks running on a shared thread should not wait for other PanoRender objects, which may share the thread.
+// uiThreadNum: number of render threads, must be positive.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_InitRenderExecutor(unsigned int uiThreadNum);
+
+// Get the statistics of the shared render threads.
+// pRenderExecutorStatistics: pointer to a G_tRenderExecutorStatistics structure that will store the statistics.
+// Per PanoRender frame times are reported by G_GetRenderStatistics().
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetRenderExecutorStatistics(G_tRenderExecutorStatistics* pRenderExecutorStatistics);
+
+// Stop the shared render threads. Fails if any PanoRender object created with them is not destroyed yet.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_ReleaseRenderExecutor();
+
 //*********************** Can ONLY be called once. *************************//
 
 // pModel: pointer to the buffer containing the calibration file.
@@ -182,6 +453,12 @@ extern "C"{
 // hWnd: handle to the window that the OpenGL rendering environment will be initialized in.
 	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_InitPanoRender(int iPanoRenderIdx, void* hWnd);
 
+// Initialize the OpenGL rendering environment without any window or display server, instead of G_InitPanoRender().
+// Only for the off screen rendering modes on Linux and Android. Android supports G_eHeadlessPlatformPBuffer only.
+// iPanoRenderIdx: handle of the PanoRender object.
+// eHeadlessPlatform: the EGL platform to create the OpenGL context on.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_InitPanoRenderHeadless(int iPanoRenderIdx, G_enHeadlessPlatform eHeadlessPlatform);
+
 //*********************** Can be called dynamically. ************************//
 
 // Get the supported panorama type list.
@@ -202,10 +479,19 @@ extern "C"{
 	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetOriginalPanoSize(int iPanoRenderIdx, unsigned int* puiWidth, unsigned int* puiHeight);
 
 // Set a new viewCamera to change the viewing angle, viewpoint, or zoom factor.
+// It never waits for the rendering thread, so it can be called at a high rate, e.g. while dragging. The latest view camera is
+// picked up at the start of the next frame.
 // iPanoRenderIdx: handle of the PanoRender object.
 // viewCamera: a G_tViewCamera structure containing the new view camera parameters.
 	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetViewCamera(int iPanoRenderIdx, G_tViewCamera viewCamera);
 
+// Re-sample the view camera right before the panorama is drawn, instead of at the start of the frame.
+// A view camera set while the input frames are being uploaded is then shown in the same frame. It also applies to the views.
+// A new view camera that comes with a new panorama type or drawing region still waits for the next frame.
+// iPanoRenderIdx: handle of the PanoRender object.
+// iEnable: 1 to enable, 0 to disable. Disabled by default.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetViewCameraLateLatch(int iPanoRenderIdx, int iEnable);
+
 // Set the OpenGL drawing area.
 // iPanoRenderIdx: handle of the PanoRender object.
 // uiX0 / uiY0: coordinates of the upper left corner of the drawing area, relative to the current window.
@@ -223,6 +509,25 @@ extern "C"{
 	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_InputFrame(int iPanoRenderIdx, int iCameraIdx
 		, unsigned int uiWidth, unsigned int uiHeight, void* pData[3], unsigned int uiStep_Byte[3]);
 
+// Input frame data with a user specified timestamp, e.g. the presentation timestamp from the decoder.
+// Same as G_InputFrame(), except that llTimeStamp is reported back in G_tOutputFrameInfo::pInputTimeStamps.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_InputFrameEx(int iPanoRenderIdx, int iCameraIdx
+		, unsigned int uiWidth, unsigned int uiHeight, void* pData[3], unsigned int uiStep_Byte[3], long long llTimeStamp);
+
+// Render one group of input frames synchronously, for offline frame by frame processing. The frames are uploaded directly,
+// bypassing the input queues, and the panorama is read back into the output buffers before the function returns.
+// Only available in the off screen rendering modes. The output callbacks and the views are not invoked for this panorama,
+// and the quality controller does not apply to it. Calls on the same PanoRender object are serialized.
+// Must not be called from a callback of the PanoRender object, the call fails because it would wait for itself.
+// iPanoRenderIdx: handle of the PanoRender object.
+// pInputFrames: one input frame for each camera, in the order of the camera indices.
+// uiInputFrameNum: number of input frames, equal to the number of cameras in the profile.
+// pOutputs: the outputs to read back, see G_tFrameGroupOutput. A failure is returned if a buffer is not sufficient,
+// the actual resolution is stored anyway.
+// uiOutputNum: number of outputs.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_RenderFrameGroup(int iPanoRenderIdx, const G_tInputFrame* pInputFrames, unsigned int uiInputFrameNum
+		, G_tFrameGroupOutput* pOutputs, unsigned int uiOutputNum);
+
 // Get the current panorama type.
 // iPanoRenderIdx: handle of the PanoRender object.
 // pCurrentPanoType: pointer to store the current panorama type.
@@ -249,6 +554,11 @@ extern "C"{
 // pContext: pointer to user-defined data to be passed to the callback function.
 	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetOutputCallBack(int iPanoRenderIdx, G_tOutputCallBack outputCallBackFunc, float fScale, void* pContext);
 
+// Set output callback with frame metadata.
+// Same as G_SetOutputCallBack(), except that the callback also receives a G_tOutputFrameInfo describing the output frame.
+// It is independent of the callback set by G_SetOutputCallBack(), both can be set at the same time.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetOutputCallBackEx(int iPanoRenderIdx, G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext);
+
 // Set the pre-render callback.
 // iPanoRenderIdx: handle of the PanoRender object.
 // renderCallBackFunc: the pre-render callback function to be set. This function will be called before rendering.
@@ -291,6 +601,137 @@ extern "C"{
 // The camera models used above are consistent with those in OpenCV.
 	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetCameraParameters(int iPanoRenderIdx, int iCameraIdx, char* sCameraMode, float* fK, float* fDistortion, float* fR, G_enCameraModelType* peCameraModelType);
 
+// Set how frames are paced. Takes effect from the next frame.
+// iPanoRenderIdx: handle of the PanoRender object.
+// eFramePacingMode: see G_enFramePacingMode.
+// fTargetFPS: for G_eFramePacingModeFixedFPS, the frame rate to render at, must be positive.
+// For G_eFramePacingModeInputDriven, the minimum frame rate: if a camera stops delivering frames, a frame is rendered anyway
+// after 1/fTargetFPS seconds. 0 means waiting for the frames of all cameras indefinitely. Ignored by the other modes.
+// G_eFramePacingModeVSync fails in off screen rendering modes. G_eRenderingModeOffScreen is paced by the input frames and
+// does not accept any pacing mode.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetFramePacing(int iPanoRenderIdx, G_enFramePacingMode eFramePacingMode, float fTargetFPS);
+
+// Get the frame pacing statistics.
+// iPanoRenderIdx: handle of the PanoRender object.
+// pRenderStatistics: pointer to a G_tRenderStatistics structure that will store the statistics.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetRenderStatistics(int iPanoRenderIdx, G_tRenderStatistics* pRenderStatistics);
+
+// Hold a frame time budget by trading quality for speed. When the frame time stays above the target, the controller
+// degrades one step at a time along the axes enabled in the configuration: it skips invisible cameras first, then lowers
+// the rendering resolution and the output scales in turn, then the tessellation level. It restores one step at a time
+// when the frame time has stayed well below the target for a while.
+// iPanoRenderIdx: handle of the PanoRender object.
+// pConfig: configuration of the controller, NULL disables the controller and restores the full quality.
+// qualityCallBackFunc: called on the rendering thread after every change of the quality level, can be NULL.
+// pContext: passed to the callback.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_EnableQualityController(int iPanoRenderIdx, const G_tQualityControllerConfig* pConfig, G_tQualityCallBack qualityCallBackFunc, void* pContext);
+
+// Get the current quality level.
+// pQualityState: pointer to a G_tQualityState structure that will store the state.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetQualityState(int iPanoRenderIdx, G_tQualityState* pQualityState);
+
+// Subdivide the surface of a panorama type adaptively. A cell of the surface is only subdivided while the texture coordinates
+// interpolated over it miss the camera projection by more than the tolerance, the tessellation level is then the maximum depth.
+// Flat regions of the projection get a few big triangles, the borders and the distorted regions of the cameras small ones.
+// The scenes of the panorama type, including the views, are rebuilt before the next frame.
+// iPanoRenderIdx: handle of the PanoRender object.
+// ePanoType: panorama type the tolerance applies to.
+// fTolerance_px: tolerance in pixels of the output, 0.0 subdivides uniformly, which is the default.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetTessellationTolerance(int iPanoRenderIdx, G_enPanoType ePanoType, float fTolerance_px);
+
+// Draw a panorama type from remap tables instead of its tessellated surface. The tables hold the cameras and blending weights
+// of every output pixel, they are generated once at the output size of the scene, so the frames are exact to the pixel and
+// cost a single draw call. Only the unwrapped panorama types, drawn through an orthogonal camera, support G_eRenderPathRemapLUT.
+// A scene falls back to the mesh if the GPU has not enough texture units for the tables and the frames of all the cameras, or
+// does not support GLSL 3.30. The scenes of the panorama type, including the views, are rebuilt before the next frame.
+// iPanoRenderIdx: handle of the PanoRender object.
+// ePanoType: panorama type the render path applies to.
+// eRenderPath: render path, G_eRenderPathMesh is the default.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetRenderPath(int iPanoRenderIdx, G_enPanoType ePanoType, G_enRenderPath eRenderPath);
+
+// Store the generated scenes in a local directory and load them from there instead of generating them again, on the first
+// switch to a panorama type and on every start-up. A cached scene is only used if the cameras, the panorama type, the crop
+// ratios and the tessellation settings it was generated with are all unchanged, so the cache never needs to be cleared for
+// correctness. Takes effect for the scenes created afterwards, call it before G_InitPanoRender() to cover the first scene.
+// iPanoRenderIdx: handle of the PanoRender object.
+// sDirectory: cache directory, created if missing. NULL or an empty string disables the cache, which is the default.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetSceneCacheDirectory(int iPanoRenderIdx, const char* sDirectory);
+
+// Remove the cached scenes from the cache directory set by G_SetSceneCacheDirectory(), e.g. to reclaim the disk space of
+// scenes of earlier camera calibrations.
+// iPanoRenderIdx: handle of the PanoRender object.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_ClearSceneCache(int iPanoRenderIdx);
+
+// Store the binaries of the linked shader programs in a local directory and load them from there instead of compiling the
+// shaders again, which shortens the start-up and the first switch to a panorama type. A binary is only used if the shader
+// sources and the vendor, renderer and version strings of the OpenGL driver are unchanged, and a binary the driver rejects is
+// removed and compiled again. Has no effect if the driver does not support program binaries. Takes effect for the programs
+// linked afterwards, call it before G_InitPanoRender() to cover the first scene.
+// iPanoRenderIdx: handle of the PanoRender object.
+// sDirectory: cache directory, created if missing. NULL or an empty string disables the cache, which is the default.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetProgramBinaryCacheDirectory(int iPanoRenderIdx, const char* sDirectory);
+
+// Build the scenes of panorama types in the background, so that switching to one of them with G_SetPanoType() takes effect
+// with the next frame. The surfaces are generated on a worker thread, and their GL objects are created by the rendering
+// thread at most one scene per frame, once the shader programs of the scene are linked without blocking the frames, see
+// G_tProgramCacheStatistics. The scenes are kept up to date with the draw region, the tessellation settings and the
+// scene cache directory, at the cost of the GPU memory of every scene requested.
+// iPanoRenderIdx: handle of the PanoRender object.
+// pPanoTypes, uiPanoTypeNum: panorama types to keep ready, replacing the former request. 0 releases the scenes built so far.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_WarmUpPanoTypes(int iPanoRenderIdx, const G_enPanoType* pPanoTypes, unsigned int uiPanoTypeNum);
+
+// Progress of G_WarmUpPanoTypes(). Can be polled from any thread, it does not wait for the rendering thread.
+// iPanoRenderIdx: handle of the PanoRender object.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetWarmUpState(int iPanoRenderIdx, G_tWarmUpState* pWarmUpState);
+
+// Limit the memory of the scenes. Once per frame, the cached scenes are released, least recently used first, until the scenes
+// in use and the cached ones fit into the budget. The scenes in use are never released. A released panorama type is not built
+// in the background again, switching to it builds its scene on the rendering thread, fast if it is in the scene cache directory.
+// iPanoRenderIdx: handle of the PanoRender object.
+// ullBudget_Byte: budget in bytes, 0 is unlimited, which is the default.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetSceneMemoryBudget(int iPanoRenderIdx, unsigned long long ullBudget_Byte);
+
+// Memory taken by the scenes as of the last frame. Can be polled from any thread, it does not wait for the rendering thread.
+// iPanoRenderIdx: handle of the PanoRender object.
+// pSceneMemoryState: pointer to a G_tSceneMemoryState structure that will store the state.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetSceneMemoryState(int iPanoRenderIdx, G_tSceneMemoryState* pSceneMemoryState);
+
+// Get the statistics of the shader programs shared by the scenes. Can be polled from any thread.
+// iPanoRenderIdx: handle of the PanoRender object.
+// pProgramCacheStatistics: pointer to a G_tProgramCacheStatistics structure that will store the statistics.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetProgramCacheStatistics(int iPanoRenderIdx, G_tProgramCacheStatistics* pProgramCacheStatistics);
+
+//*************************************** Views. *******************************************//
+// Besides the panorama drawn to the window or passed to the output callbacks, a PanoRender object can render additional named
+// views, each with its own view camera, panorama type, output size and output callbacks. All views are rendered in the same
+// frame from the input frames uploaded once. Views need OpenGL 3.0, and only views with an output callback are rendered.
+// Render callbacks are not invoked for views, and G_UnProject() refers to the main panorama.
+
+// Add a view.
+// iPanoRenderIdx: handle of the PanoRender object.
+// sViewName: name of the view, unique within the PanoRender object.
+// ePanoType: panorama type of the view, must be supported by the profile.
+// uiWidth, uiHeight: size of the output frames of the view.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_AddView(int iPanoRenderIdx, const char* sViewName, int ePanoType, unsigned int uiWidth, unsigned int uiHeight);
+
+// Remove a view and its output callback.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_RemoveView(int iPanoRenderIdx, const char* sViewName);
+
+// Same as G_GetViewCamera() and G_SetViewCamera(), for a view.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetViewCameraOfView(int iPanoRenderIdx, const char* sViewName, G_tViewCamera* pViewCamera);
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetViewCameraOfView(int iPanoRenderIdx, const char* sViewName, G_tViewCamera viewCamera);
+
+// Same as G_SwitchPanoType(), for a view.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SwitchPanoTypeOfView(int iPanoRenderIdx, const char* sViewName, int eNewPanoType);
+
+// Same as G_SetOutputCallBackEx(), for a view. The output frames of a view carry the same sequence number and input frame IDs
+// as the other outputs rendered in the same frame.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_SetOutputCallBackOfView(int iPanoRenderIdx, const char* sViewName, G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext);
+
+// Get the statistics of a view.
+// pViewStatistics: pointer to a G_tViewStatistics structure that will store the statistics.
+	G_PANO_RENDER_OGL_API int G_CALL_CONVENTION G_GetViewStatistics(int iPanoRenderIdx, const char* sViewName, G_tViewStatistics* pViewStatistics);
+
 //************************************* Destroy. ************************************************//
 
 // Release the PanoRender object.
@@ -41,12 +41,14 @@
 //todo.
 #elif __ANDROID__
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <GLES/gl.h>
 #include <GLES3/gl3.h>
 #include <GLES3/gl3ext.h>
 #elif __linux__
 #include <GL/glew.h>
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 //#include <GL/gl.h>
 
 //#include <GL/glx.h>
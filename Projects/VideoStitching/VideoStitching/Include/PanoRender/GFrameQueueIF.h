@@ -34,6 +34,11 @@ class GFrameQueueIF : public GFrameBufferIF, public GFrameSourceIF
 {
 public:
 	virtual ~GFrameQueueIF(){};
+
+	//CreateFrame() waits for room instead of rejecting the new frame when the queue is full.
+	virtual void SetBlockWhenFull(bool bBlockWhenFull) = 0;
+	//make the waiting and later blocking CreateFrame() calls fail.
+	virtual void Interrupt() = 0;
 };
 
 class GFrameQueueFactory
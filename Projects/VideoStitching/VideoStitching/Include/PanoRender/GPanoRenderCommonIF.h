@@ -26,6 +26,8 @@
 #define G_PANO_RENDER_COMMON_H_
 
 #include <vector>
+#include <string>
+#include <memory>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -46,6 +48,22 @@ struct GTextureGroup
 	std::vector<GLuint> vTextureGroup;
 };
 
+//GL calls issued by rendering a scene.
+struct GRenderCounters
+{
+	GRenderCounters() :
+		iDrawCalls(0)
+		, iStateChanges(0)
+		, dCPUTime_ms(0.0)
+	{}
+
+	int iDrawCalls;
+	//program, uniform, vertex array and texture binding calls.
+	int iStateChanges;
+	//time the render thread spent issuing the calls.
+	double dCPUTime_ms;
+};
+
 struct GFrameType
 {
 	int iWidth;
@@ -53,6 +71,13 @@ struct GFrameType
 	int step_Byte[3];
 	enFrameFormat eFrameFormat;
 
+	//ullFrameID: increases by one for every frame input on the same camera, starts from 1.
+	//llTimeStamp: user specified timestamp, or llArrivalTime_us if not specified.
+	//llArrivalTime_us: steady clock time when the frame is input, in microseconds.
+	unsigned long long ullFrameID;
+	long long llTimeStamp;
+	long long llArrivalTime_us;
+
 	int Size_Byte() const
 	{
 		if (eFrameFormatBGR == eFrameFormat ||
@@ -75,6 +100,23 @@ struct GFrameType
 	}
 };
 
+struct GOutputFrameInfo
+{
+	GOutputFrameInfo() :
+		ullSequenceNumber(0)
+		, llQueueWait_us(0)
+		, llRenderStartTime_us(0)
+		, llRenderEndTime_us(0)
+	{}
+
+	unsigned long long ullSequenceNumber;
+	std::vector<unsigned long long> vInputFrameIDs;
+	std::vector<long long> vInputTimeStamps;
+	long long llQueueWait_us;
+	long long llRenderStartTime_us;
+	long long llRenderEndTime_us;
+};
+
 class GFrameBufferIF
 {
 public:
@@ -104,6 +146,8 @@ public:
 	virtual glm::mat4 CalcV() const = 0;
 };
 
+class GGLSLProgramCache;
+
 class GStitcherConfig
 {
 public:
@@ -112,6 +156,12 @@ public:
 		, m_eOptionUploading(eOptionUploadingPBO)
 		, m_eOptionDownloading(eOptionDownloadingPBO)
 		, m_eInputFrameFormat(eFrameFormatYUV420P)
+		, m_iTessellationLevel(7)
+		, m_fTessellationTolerance_px(0.0f)
+		, m_iInputFrameWidth(0)
+		, m_iInputFrameHeight(0)
+		, m_iRemapTableWidth(0)
+		, m_iRemapTableHeight(0)
 	{}
 
 	enum enRenderingMode
@@ -137,6 +187,23 @@ public:
 	enStitcherGLOptionsUploading m_eOptionUploading;
 	enStitcherGLOptionsDownloading m_eOptionDownloading;
 	enFrameFormat m_eInputFrameFormat;
+	//subdivision depth of the scene surfaces.
+	int m_iTessellationLevel;
+	//adaptive subdivision: a surface cell is only subdivided while the texture coordinates interpolated over it
+	//miss the projection by more than this many input pixels, m_iTessellationLevel is then the maximum depth.
+	//0 subdivides uniformly.
+	float m_fTessellationTolerance_px;
+	int m_iInputFrameWidth;
+	int m_iInputFrameHeight;
+	//plane surfaces only: looked up per pixel from a remap table of this size, usually the output size, instead of
+	//interpolated over the tessellated surface. 0 renders the tessellated surface.
+	int m_iRemapTableWidth;
+	int m_iRemapTableHeight;
+	//directory of the scene cache, empty disables it. the key identifies the scene being created, see GSceneCache.
+	std::string m_sSceneCacheDirectory;
+	std::string m_sSceneCacheKey;
+	//programs of the GL context the scenes are prepared in, shared by them. null links the programs of every scene.
+	std::shared_ptr<GGLSLProgramCache> m_ptrProgramCache;
 };
 
 
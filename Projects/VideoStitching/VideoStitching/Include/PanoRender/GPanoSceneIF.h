@@ -42,8 +42,20 @@ public:
 	virtual ~GPanoSceneIF(){};
 
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios) = 0;
+	//recompute the texture coordinates of a prepared scene for another K0 or other crop ratios, the patches, buffers and programs are kept.
+	//false if the cameras of a patch would change or the scene has no patches, Create() and Prepare() it again then.
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios) = 0;
+	//render thread. starts linking the programs Prepare() needs without waiting for them, true once they are all linked,
+	//Prepare() does not wait for the shader compiler then. call it once per frame until it is true.
+	virtual bool RequestPrograms() = 0;
 	virtual bool Prepare() = 0;
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV) = 0;
+	//set vVisible[i] for the cameras whose frames can be seen through matP * matV, the others are left untouched.
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const = 0;
+	//GL calls of the last Render().
+	virtual bool GetRenderCounters(GRenderCounters& counters) const = 0;
+	//bytes the scene takes on the gpu and on the host, 0 before Create().
+	virtual size_t GetMemorySize() const = 0;
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPoint) const = 0;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPoint, Eigen::Vector3f& v3fPhysical3DPoint) const = 0;
 	virtual void Release() = 0;
@@ -26,6 +26,7 @@
 #define G_SURFACE_GENERATOR_IF_H_
 
 #include <vector>
+#include <functional>
 
 #include <Eigen/Dense>
 
@@ -33,6 +34,8 @@
 
 struct tVertex
 {
+	tVertex()
+	{}
 	tVertex(float fx, float fy, float fz) :
 		x(fx)
 		, y(fy)
@@ -49,11 +52,20 @@ struct tVertex
 	float z;
 };
 
+//asked before a surface cell is subdivided. pEndPoints holds the two end points of every sampled edge of the cell,
+//pMidPoints the surface point between them. returns true if the cell should be subdivided.
+typedef std::function<bool(const Eigen::Vector3f* pEndPoints, const Eigen::Vector3f* pMidPoints, int iEdgeNum)> tRefinePredicate;
+
 class GSurfaceGenerator4RenderIF
 {
 public:
 	virtual ~GSurfaceGenerator4RenderIF(){};
+	//indexed triangle list, a vertex shared by several triangles should be stored once in vVertices.
 	virtual void GenerateSurface(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices) = 0;
+	//adaptive subdivision up to the tessellation level, an empty predicate subdivides uniformly.
+	virtual void SetRefinePredicate(const tRefinePredicate& fnShouldRefine) = 0;
+	//false if the surface is not a plane. a plane is centered at the origin, in the z = 0 plane.
+	virtual bool GetPlaneSize(float& fWidth, float& fHeight) const = 0;
 };
 
 
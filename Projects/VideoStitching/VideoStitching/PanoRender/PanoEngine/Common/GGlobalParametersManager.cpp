@@ -47,6 +47,13 @@ void GGlobalParametersManager::Init()
 	std::string sGLVersion((char*)glGetString(GL_VERSION));
 	GLOGGER(info) << "OpenGL version: " << sGLVersion;
 
+	const char* szGLVendor = (const char*)glGetString(GL_VENDOR);
+	const char* szGLRenderer = (const char*)glGetString(GL_RENDERER);
+	m_sGLVendor = szGLVendor ? szGLVendor : "";
+	m_sGLRenderer = szGLRenderer ? szGLRenderer : "";
+	m_sGLVersion = sGLVersion;
+	GLOGGER(info) << "OpenGL vendor: " << m_sGLVendor << ", renderer: " << m_sGLRenderer;
+
 	if (!boost::ifind_first(sGLVersion, "nvidia").empty())
 	{
 		m_eGPUVendor = eGGPUVendorNvidia;
@@ -116,6 +123,10 @@ void GGlobalParametersManager::Init()
 
 	//m_aGLSLVersion[0] = 1;
 	//m_aGLSLVersion[1] = 20;
+
+	m_iMaxTextureImageUnits = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &m_iMaxTextureImageUnits);
+	GLOGGER(info) << "Max texture image units: " << m_iMaxTextureImageUnits;
 }
 
 int GGlobalParametersManager::GetParamInt(enGGlobalParam eParamName)
@@ -140,6 +151,30 @@ int GGlobalParametersManager::GetParamInt(enGGlobalParam eParamName)
 	{
 		return m_eGPUVendor;
 	}
+	else if (eGGlobalParamIntMaxTextureImageUnits == eParamName)
+	{
+		return m_iMaxTextureImageUnits;
+	}
+	else
+	{
+		throw GPanoRenderException();
+	}
+}
+
+std::string GGlobalParametersManager::GetParamString(enGGlobalParam eParamName)
+{
+	if (eGGlobalParamStringGLVendor == eParamName)
+	{
+		return m_sGLVendor;
+	}
+	else if (eGGlobalParamStringGLRenderer == eParamName)
+	{
+		return m_sGLRenderer;
+	}
+	else if (eGGlobalParamStringGLVersion == eParamName)
+	{
+		return m_sGLVersion;
+	}
 	else
 	{
 		throw GPanoRenderException();
@@ -25,6 +25,7 @@
 #ifndef G_GLOBAL_PARAMETERS_MANAGER_H_
 #define G_GLOBAL_PARAMETERS_MANAGER_H_
 
+#include <string>
 
 enum enGGlobalParam
 {
@@ -34,10 +35,14 @@ enum enGGlobalParam
 	eGGlobalParamIntGLSLMajorVersion,
 	eGGlobalParamIntGLSLMinorVersion,
 	eGGlobalParamIntGPUVendor,
+	eGGlobalParamIntMaxTextureImageUnits,
 
 	eGGlobalParamFloat = 100,
 
 	eGGlobalParamString=200,
+	eGGlobalParamStringGLVendor,
+	eGGlobalParamStringGLRenderer,
+	eGGlobalParamStringGLVersion,
 
 
 };
@@ -59,6 +64,7 @@ public:
 
 	int GetParamInt(enGGlobalParam eParamName);
 	double GetParamFloat(enGGlobalParam eParamName);
+	std::string GetParamString(enGGlobalParam eParamName);
 
 private:
 	GGlobalParametersManager(){};
@@ -68,6 +74,13 @@ private:
 	int m_aGLSLVersion[2];
 
 	enGGPUVendor m_eGPUVendor;
+	//samplers of a fragment shader.
+	int m_iMaxTextureImageUnits;
+
+	//as reported by the driver, a program binary only loads on the driver it was retrieved from.
+	std::string m_sGLVendor;
+	std::string m_sGLRenderer;
+	std::string m_sGLVersion;
 };
 
 
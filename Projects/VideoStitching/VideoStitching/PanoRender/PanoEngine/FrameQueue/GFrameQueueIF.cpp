@@ -41,6 +41,9 @@ public:
 	virtual void* OutMapFrame();
 	virtual void ReleaseFrame();
 
+	virtual void SetBlockWhenFull(bool bBlockWhenFull);
+	virtual void Interrupt();
+
 private:
 	GDataFrameQueue<GFrameType> m_DataFrameQueue;
 
@@ -81,6 +84,16 @@ void GFrameQueue::ReleaseFrame()
 	return m_DataFrameQueue.ReleaseFrame();
 }
 
+void GFrameQueue::SetBlockWhenFull(bool bBlockWhenFull)
+{
+	return m_DataFrameQueue.SetBlockWhenFull(bBlockWhenFull);
+}
+
+void GFrameQueue::Interrupt()
+{
+	return m_DataFrameQueue.Interrupt();
+}
+
 
 std::shared_ptr<GFrameQueueIF> GFrameQueueFactory::CreateFrameQueue()
 {
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#include "GCacheFile.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+#include "boost/filesystem.hpp"
+
+#include "Common/GiraffeLogger/GiraffeLogger.h"
+
+void GCacheFile::WriteString(std::ostream& os, const std::string& s)
+{
+	uint64_t ullSize = s.size();
+	WriteValue(os, ullSize);
+	os.write(s.data(), s.size());
+}
+
+uint64_t GCacheFile::CalcHash(const std::string& s)
+{
+	uint64_t ullHash = 14695981039346656037ULL;
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		ullHash ^= static_cast<unsigned char>(s[i]);
+		ullHash *= 1099511628211ULL;
+	}
+	return ullHash;
+}
+
+std::string GCacheFile::FormatHash(uint64_t ullHash)
+{
+	char szHash[17] = { 0 };
+	snprintf(szHash, sizeof(szHash), "%016llx", static_cast<unsigned long long>(ullHash));
+	return szHash;
+}
+
+std::string GCacheFile::GetFilePath(const std::string& sDirectory, const std::string& sPrefix, const std::string& sKey, const std::string& sExtension)
+{
+	return (boost::filesystem::path(sDirectory) / (sPrefix + FormatHash(CalcHash(sKey)) + sExtension)).string();
+}
+
+bool GCacheFile::Write(const std::string& sFilePath, const std::function<void(std::ostream&)>& fnWrite)
+{
+	try
+	{
+		boost::filesystem::path filePath(sFilePath);
+		boost::system::error_code ec;
+		boost::filesystem::create_directories(filePath.parent_path(), ec);
+
+		//unique among the threads and processes writing the same file.
+		std::ostringstream ossSuffix;
+		ossSuffix << "." << std::hash<std::thread::id>()(std::this_thread::get_id())
+			<< "_" << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+		std::string sTempFilePath = sFilePath + ossSuffix.str();
+		{
+			std::ofstream ofs(sTempFilePath, std::ios::binary);
+			if (!ofs.good())
+			{
+				GLOGGER(error) << "GCacheFile::Write(). Can NOT open " << sTempFilePath << ". ==>";
+				return false;
+			}
+
+			fnWrite(ofs);
+
+			if (!ofs.good())
+			{
+				GLOGGER(error) << "GCacheFile::Write(). Write " << sTempFilePath << " FAILED. ==>";
+				ofs.close();
+				std::remove(sTempFilePath.c_str());
+				return false;
+			}
+		}
+
+		//rename does not replace an existing file everywhere.
+		std::remove(sFilePath.c_str());
+		if (0 != std::rename(sTempFilePath.c_str(), sFilePath.c_str()))
+		{
+			GLOGGER(error) << "GCacheFile::Write(). Rename " << sTempFilePath << " FAILED. ==>";
+			std::remove(sTempFilePath.c_str());
+			return false;
+		}
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GCacheFile::Write(). EXCEPTION. ==>";
+		return false;
+	}
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#ifndef G_CACHE_FILE_H_
+#define G_CACHE_FILE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <functional>
+
+//the file handling shared by the on-disk caches: native endian values and vectors, the names of the files derived from
+//a hash of their keys, and the write through a temporary file.
+class GCacheFile
+{
+public:
+	template<class T>
+	static void WriteValue(std::ostream& os, const T& value)
+	{
+		os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<class T>
+	static bool ReadValue(std::istream& is, T& value)
+	{
+		return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	template<class T>
+	static void WriteVector(std::ostream& os, const std::vector<T>& vValues)
+	{
+		uint64_t ullSize = vValues.size();
+		WriteValue(os, ullSize);
+		if (!vValues.empty())
+		{
+			os.write(reinterpret_cast<const char*>(vValues.data()), vValues.size() * sizeof(T));
+		}
+	}
+
+	//ullMaxSize guards against a broken size allocating the memory away.
+	template<class T>
+	static bool ReadVector(std::istream& is, std::vector<T>& vValues, uint64_t ullMaxSize)
+	{
+		uint64_t ullSize = 0;
+		if (!ReadValue(is, ullSize) || (ullMaxSize < ullSize))
+		{
+			return false;
+		}
+		vValues.resize((size_t)ullSize);
+		return vValues.empty() || static_cast<bool>(is.read(reinterpret_cast<char*>(vValues.data()), vValues.size() * sizeof(T)));
+	}
+
+	//the layout of WriteVector(), read back with ReadVector<char>().
+	static void WriteString(std::ostream& os, const std::string& s);
+
+	//FNV-1a.
+	static uint64_t CalcHash(const std::string& s);
+
+	//16 hex digits.
+	static std::string FormatHash(uint64_t ullHash);
+
+	//sDirectory/sPrefix + 16 hex digits of the hash of sKey + sExtension.
+	static std::string GetFilePath(const std::string& sDirectory, const std::string& sPrefix, const std::string& sKey, const std::string& sExtension);
+
+	//fnWrite fills a temporary file, which then replaces sFilePath, so a concurrent reader never sees a partial file.
+	//the directory is created if missing.
+	static bool Write(const std::string& sFilePath, const std::function<void(std::ostream&)>& fnWrite);
+};
+
+#endif//!G_CACHE_FILE_H_
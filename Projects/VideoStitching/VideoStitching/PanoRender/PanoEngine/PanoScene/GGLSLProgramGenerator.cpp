@@ -27,10 +27,14 @@
 #include <vector>
 #include <iostream>
 #include <sstream>
+#include <chrono>
+#include <algorithm>
 
 #include "GGlobalParametersManager.h"
+#include "GProgramBinaryCache.h"
 #include "Common/GiraffeLogger/GiraffeLogger.h"
 
+const GLuint GGLSLBlenderGenerator::TRANSFORM_BLOCK_BINDING;
 
 std::string GGLSLBlenderGenerator::GenerateVertexShaderCode330(int iNumOfTextureUnits)
 {
@@ -49,7 +53,9 @@ std::string GGLSLBlenderGenerator::GenerateVertexShaderCode330(int iNumOfTexture
 		sStream << "out vec3 UV" << i << ";\n";
 	}
 
-	sStream << "uniform mat4 MVP;\n";
+	sStream << "layout(std140) uniform Transform {\n"
+		<< "mat4 MVP;\n"
+		<< "};\n";
 
 	sStream << "void main(){\n"
 		<< "gl_Position = MVP * vec4(vertexPosition, 1);\n";
@@ -499,18 +505,121 @@ std::string GGLSLBlenderGenerator::GenerateFragShaderNV12Code120(int iNumOfTextu
 	return sRet;
 }
 
-bool GGLSLBlenderGenerator::GetProgram(enGVertexShaderType eVertexShaderType, enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfTextureUnits
-	, GLuint& uiProgramID)
+std::string GGLSLBlenderGenerator::GenerateRemapVertexShaderCode330()
 {
-	// Create the shaders
-	GLuint uiVertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-	GLuint uiFragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+	std::stringstream sStream;
 
-	GLint iResult = GL_FALSE;
-	int iInfoLogLength;
+	sStream << "#version 330 core\n"
+		<< "layout(location = 0) in vec3 vertexPosition;\n"
+		<< "layout(location = 1) in vec2 vertexRemapUV;\n"
+		<< "out vec2 RemapUV;\n"
+		<< "layout(std140) uniform Transform {\n"
+		<< "mat4 MVP;\n"
+		<< "};\n";
+
+	sStream << "void main(){\n"
+		<< "gl_Position = MVP * vec4(vertexPosition, 1);\n"
+		<< "RemapUV = vertexRemapUV;\n"
+		<< "}";
+
+	return sStream.str();
+}
+
+std::string GGLSLBlenderGenerator::GenerateRemapFragShaderCode330(enGFragShaderType eFragShaderType, int iNumOfLayers, int iNumOfCameras)
+{
+	std::stringstream sStream;
+
+	sStream << "#version 330 core\n"
+		<< "in vec2 RemapUV;\n"
+		<< "out vec4 color;\n";
+
+	for (int i = 0; i < iNumOfLayers; ++i)
+	{
+		sStream << "uniform sampler2D remapSampler" << i << ";\n";
+	}
 
+	for (int i = 0; i < iNumOfCameras; ++i)
+	{
+		if (eGFragShaderTypeNormal == eFragShaderType)
+		{
+			sStream << "uniform sampler2D textureSampler" << i << ";\n";
+		}
+		else
+		{
+			int iNumOfPlanes = (eGFragShaderTypeYUV == eFragShaderType) ? 3 : 2;
+			for (int j = 0; j < iNumOfPlanes; ++j)
+			{
+				sStream << "uniform sampler2D textureSampler" << i << j << ";\n";
+			}
+		}
+	}
+
+	sStream << "const mat3 conv = mat3(1.0, 1.0, 1.0,"
+		<< "-0.00093, -0.3437, 1.77216,"
+		<< "1.401687, -0.71417, 0.00099);\n"
+		<< "const vec3 offset = vec3(0.0, -0.5, -0.5);\n";
+
+	//the camera of a pixel differs from its neighbours', the frames are read without derivatives.
+	sStream << "vec3 SampleCamera(float fCamera, vec2 uv){\n";
+	for (int i = 0; i < iNumOfCameras; ++i)
+	{
+		sStream << "if (fCamera < " << i << ".5)\n"
+			<< "{\n";
+		if (eGFragShaderTypeNormal == eFragShaderType)
+		{
+			sStream << "   return textureLod(textureSampler" << i << ", uv, 0.0).rgb;\n";
+		}
+		else if (eGFragShaderTypeYUV == eFragShaderType)
+		{
+			sStream << "   return conv * (vec3(textureLod(textureSampler" << i << "0, uv, 0.0).r, textureLod(textureSampler" << i
+				<< "1, uv, 0.0).r, textureLod(textureSampler" << i << "2, uv, 0.0).r) + offset);\n";
+		}
+		else
+		{
+			sStream << "   return conv * (vec3(textureLod(textureSampler" << i << "0, uv, 0.0).r, textureLod(textureSampler" << i
+				<< "1, uv, 0.0).rg) + offset);\n";
+		}
+		sStream << "}\n";
+	}
+	sStream << "return vec3(0.0);\n"
+		<< "}\n";
+
+	//a layer holds u, v, the weight and the camera index + 1 of a pixel, as 16 bit normalized values.
+	sStream << "void main(){\n"
+		<< "vec4 remap;\n"
+		<< "color.rgb = vec3(0.0);\n"
+		<< "float fTotalWeight = 0.0;\n";
+
+	for (int i = 0; i < iNumOfLayers; ++i)
+	{
+		sStream << "remap = texture(remapSampler" << i << ", RemapUV);\n"
+			<< "if (remap.b > 0.0)\n"
+			<< "{\n"
+			<< "   color.rgb += remap.b * SampleCamera(remap.a * 65535.0 - 1.0, remap.rg);\n"
+			<< "   fTotalWeight += remap.b;\n"
+			<< "}\n";
+	}
+
+	//cut dark edge.
+	sStream << "if (fTotalWeight < 0.95)\n"
+		<< "{\n"
+		<< "   color.a = 0.0;\n"
+		<< "}\n"
+		<< "else\n"
+		<< "{\n"
+		<< "   color.a = 1.0;\n"
+		<< "}\n";
+
+	sStream << "}";
+
+	return sStream.str();
+}
+
+bool GGLSLBlenderGenerator::GetProgramSources(enGVertexShaderType eVertexShaderType, enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfTextureUnits
+	, std::string& sVertexShaderCode, std::string& sFragShaderCode, std::vector<std::string>& vAttributeNames)
+{
 	// Get Vertex Shader
-	std::string sVertexShaderCode = "";
+	sVertexShaderCode = "";
 	if (GGLSLBlenderGenerator::eGVertexShaderTypeNormal == eVertexShaderType)
 	{
 		if (iGLSLVersion >= 330)
@@ -533,26 +642,8 @@ bool GGLSLBlenderGenerator::GetProgram(enGVertexShaderType eVertexShaderType, en
 		return false;
 	}
 
-	// Compile Vertex Shader
-	char const * pVertexSourcePointer = sVertexShaderCode.c_str();
-	glShaderSource(uiVertexShaderID, 1, &pVertexSourcePointer, NULL);
-	glCompileShader(uiVertexShaderID);
-
-	// Check Vertex Shader
-	glGetShaderiv(uiVertexShaderID, GL_COMPILE_STATUS, &iResult);
-	if (GL_FALSE == iResult)
-	{
-		glGetShaderiv(uiVertexShaderID, GL_INFO_LOG_LENGTH, &iInfoLogLength);
-		iInfoLogLength = (iInfoLogLength < 0) ? 0 : iInfoLogLength;
-
-		std::vector<char> vVertexShaderErrorMessage(iInfoLogLength + 1);
-		glGetShaderInfoLog(uiVertexShaderID, iInfoLogLength, NULL, &vVertexShaderErrorMessage[0]);
-		GLOGGER(error) << "GGLSLBlenderGenerator::GetProgram(). " << std::string(vVertexShaderErrorMessage.data());
-		return false;
-	}
-
 	// Get Fragment Shader
-	std::string sFragShaderCode = "";
+	sFragShaderCode = "";
 	if (GGLSLBlenderGenerator::eGFragShaderTypeNormal == eFragShaderType)
 	{
 		if (iGLSLVersion >= 330)
@@ -607,6 +698,145 @@ bool GGLSLBlenderGenerator::GetProgram(enGVertexShaderType eVertexShaderType, en
 		return false;
 	}
 
+	vAttributeNames.assign(1, "vertexPosition");
+	for (int iTextureIdx = 0; iTextureIdx < iNumOfTextureUnits; ++iTextureIdx)
+	{
+		vAttributeNames.push_back("vertexUV" + std::to_string(iTextureIdx));
+	}
+	return true;
+}
+
+bool GGLSLBlenderGenerator::GetProgram(enGVertexShaderType eVertexShaderType, enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfTextureUnits
+	, GLuint& uiProgramID, const std::string& sBinaryCacheDirectory, bool* pbBinaryLoaded)
+{
+	std::string sVertexShaderCode;
+	std::string sFragShaderCode;
+	std::vector<std::string> vAttributeNames;
+	if (!GetProgramSources(eVertexShaderType, eFragShaderType, iGLSLVersion, iNumOfTextureUnits, sVertexShaderCode, sFragShaderCode, vAttributeNames))
+	{
+		return false;
+	}
+
+	bool bBinaryLoaded = false;
+	if (!LinkProgram(sVertexShaderCode, sFragShaderCode, vAttributeNames, sBinaryCacheDirectory, uiProgramID, bBinaryLoaded))
+	{
+		return false;
+	}
+
+	if (nullptr != pbBinaryLoaded)
+	{
+		*pbBinaryLoaded = bBinaryLoaded;
+	}
+
+	if (iGLSLVersion >= 330)
+	{
+		BindTransformBlock(uiProgramID);
+	}
+	return true;
+}
+
+bool GGLSLBlenderGenerator::GetRemapProgramSources(enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras
+	, std::string& sVertexShaderCode, std::string& sFragShaderCode, std::vector<std::string>& vAttributeNames)
+{
+	if (iGLSLVersion < 330)
+	{
+		GLOGGER(error) << "GGLSLBlenderGenerator::GetRemapProgram(). GLSL version is too low: " << iGLSLVersion;
+		return false;
+	}
+
+	if ((eGFragShaderTypeNormal != eFragShaderType) && (eGFragShaderTypeYUV != eFragShaderType) && (eGFragShaderTypeNV12 != eFragShaderType))
+	{
+		GLOGGER(error) << "GGLSLBlenderGenerator::GetRemapProgram(). Invalid fragment shader type.";
+		return false;
+	}
+
+	sVertexShaderCode = GenerateRemapVertexShaderCode330();
+	sFragShaderCode = GenerateRemapFragShaderCode330(eFragShaderType, iNumOfLayers, iNumOfCameras);
+	vAttributeNames.clear();
+	vAttributeNames.push_back("vertexPosition");
+	vAttributeNames.push_back("vertexRemapUV");
+	return true;
+}
+
+bool GGLSLBlenderGenerator::GetRemapProgram(enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras, GLuint& uiProgramID
+	, const std::string& sBinaryCacheDirectory, bool* pbBinaryLoaded)
+{
+	std::string sVertexShaderCode;
+	std::string sFragShaderCode;
+	std::vector<std::string> vAttributeNames;
+	if (!GetRemapProgramSources(eFragShaderType, iGLSLVersion, iNumOfLayers, iNumOfCameras, sVertexShaderCode, sFragShaderCode, vAttributeNames))
+	{
+		return false;
+	}
+
+	bool bBinaryLoaded = false;
+	if (!LinkProgram(sVertexShaderCode, sFragShaderCode, vAttributeNames, sBinaryCacheDirectory, uiProgramID, bBinaryLoaded))
+	{
+		return false;
+	}
+
+	if (nullptr != pbBinaryLoaded)
+	{
+		*pbBinaryLoaded = bBinaryLoaded;
+	}
+
+	BindTransformBlock(uiProgramID);
+	return true;
+}
+
+void GGLSLBlenderGenerator::BindTransformBlock(GLuint uiProgramID)
+{
+	GLuint uiBlockIndex = glGetUniformBlockIndex(uiProgramID, "Transform");
+	if (GL_INVALID_INDEX != uiBlockIndex)
+	{
+		glUniformBlockBinding(uiProgramID, uiBlockIndex, TRANSFORM_BLOCK_BINDING);
+	}
+}
+
+bool GGLSLBlenderGenerator::LinkProgram(const std::string& sVertexShaderCode, const std::string& sFragShaderCode
+	, const std::vector<std::string>& vAttributeNames, const std::string& sBinaryCacheDirectory, GLuint& uiProgramID, bool& bBinaryLoaded)
+{
+	//the attribute locations are part of the binary, the uniform block binding is set again by the caller.
+	bBinaryLoaded = false;
+	bool bBinaryCache = !sBinaryCacheDirectory.empty() && GProgramBinaryCache::IsSupported();
+	std::string sBinaryFilePath;
+	std::string sBinaryKey;
+	if (bBinaryCache)
+	{
+		sBinaryKey = GProgramBinaryCache::CreateKey(sVertexShaderCode, sFragShaderCode, vAttributeNames);
+		sBinaryFilePath = GProgramBinaryCache::GetFilePath(sBinaryCacheDirectory, sBinaryKey);
+		if (GProgramBinaryCache::Load(sBinaryFilePath, sBinaryKey, uiProgramID))
+		{
+			bBinaryLoaded = true;
+			return true;
+		}
+	}
+
+	// Create the shaders
+	GLuint uiVertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+	GLuint uiFragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+
+	GLint iResult = GL_FALSE;
+	int iInfoLogLength;
+
+	// Compile Vertex Shader
+	char const * pVertexSourcePointer = sVertexShaderCode.c_str();
+	glShaderSource(uiVertexShaderID, 1, &pVertexSourcePointer, NULL);
+	glCompileShader(uiVertexShaderID);
+
+	// Check Vertex Shader
+	glGetShaderiv(uiVertexShaderID, GL_COMPILE_STATUS, &iResult);
+	if (GL_FALSE == iResult)
+	{
+		glGetShaderiv(uiVertexShaderID, GL_INFO_LOG_LENGTH, &iInfoLogLength);
+		iInfoLogLength = (iInfoLogLength < 0) ? 0 : iInfoLogLength;
+
+		std::vector<char> vVertexShaderErrorMessage(iInfoLogLength + 1);
+		glGetShaderInfoLog(uiVertexShaderID, iInfoLogLength, NULL, &vVertexShaderErrorMessage[0]);
+		GLOGGER(error) << "GGLSLBlenderGenerator::LinkProgram(). " << std::string(vVertexShaderErrorMessage.data());
+		return false;
+	}
+
 	// Compile Fragment Shader
 	char const * pFragmentSourcePointer = sFragShaderCode.c_str();
 	glShaderSource(uiFragmentShaderID, 1, &pFragmentSourcePointer, NULL);
@@ -634,14 +864,17 @@ bool GGLSLBlenderGenerator::GetProgram(enGVertexShaderType eVertexShaderType, en
 	//for OpenGL < 3.3, the corresponding attribute name in shader should be explicitly specified.
 	if (opengl_compatible(3, 3))
 	{
-		glBindAttribLocation(uiProgramID, 0, "vertexPosition");
-		std::string sUVStr = "vertexUV";
-		for (int iTextureIdx = 0; iTextureIdx < iNumOfTextureUnits; ++iTextureIdx)
+		for (int iAttributeIdx = 0; iAttributeIdx < vAttributeNames.size(); ++iAttributeIdx)
 		{
-			glBindAttribLocation(uiProgramID, 1 + iTextureIdx, (sUVStr + std::to_string(iTextureIdx)).c_str());
+			glBindAttribLocation(uiProgramID, iAttributeIdx, vAttributeNames[iAttributeIdx].c_str());
 		}
 	}
 
+	if (bBinaryCache)
+	{
+		glProgramParameteri(uiProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
 	glLinkProgram(uiProgramID);
 
 	// Check the program
@@ -659,6 +892,364 @@ bool GGLSLBlenderGenerator::GetProgram(enGVertexShaderType eVertexShaderType, en
 
 	glDeleteShader(uiVertexShaderID);
 	glDeleteShader(uiFragmentShaderID);
+
+	//the program is fine without its binary, the next run compiles it again.
+	if (bBinaryCache)
+	{
+		GProgramBinaryCache::Save(sBinaryFilePath, sBinaryKey, uiProgramID);
+	}
 	return true;
 }
 
+bool GGLSLBlenderGenerator::IsParallelCompileSupported()
+{
+#if (defined __APPLE__) || (defined __ANDROID__)
+	return false;
+#else
+	return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+#endif //(defined __APPLE__) || (defined __ANDROID__)
+}
+
+bool GGLSLBlenderGenerator::EnableParallelCompile()
+{
+#if (defined __APPLE__) || (defined __ANDROID__)
+	return false;
+#else
+	//0xFFFFFFFF leaves the number of threads to the driver.
+	if (GLEW_KHR_parallel_shader_compile)
+	{
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		return true;
+	}
+	else if (GLEW_ARB_parallel_shader_compile)
+	{
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		return true;
+	}
+	return false;
+#endif //(defined __APPLE__) || (defined __ANDROID__)
+}
+
+bool GGLSLBlenderGenerator::StartLinkProgram(const std::string& sVertexShaderCode, const std::string& sFragShaderCode, const std::vector<std::string>& vAttributeNames
+	, bool bTransformBlock, const std::string& sBinaryCacheDirectory, tPendingLink& pendingLink)
+{
+	pendingLink = tPendingLink();
+	pendingLink.bTransformBlock = bTransformBlock;
+
+	bool bBinaryCache = !sBinaryCacheDirectory.empty() && GProgramBinaryCache::IsSupported();
+	if (bBinaryCache)
+	{
+		std::string sBinaryKey = GProgramBinaryCache::CreateKey(sVertexShaderCode, sFragShaderCode, vAttributeNames);
+		std::string sBinaryFilePath = GProgramBinaryCache::GetFilePath(sBinaryCacheDirectory, sBinaryKey);
+		if (GProgramBinaryCache::Load(sBinaryFilePath, sBinaryKey, pendingLink.uiProgram))
+		{
+			pendingLink.bBinaryLoaded = true;
+			return true;
+		}
+		pendingLink.sBinaryKey = sBinaryKey;
+		pendingLink.sBinaryFilePath = sBinaryFilePath;
+	}
+
+	//no status is queried here, the errors of the shaders show up in the log of the link.
+	GLuint uiVertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+	char const * pVertexSourcePointer = sVertexShaderCode.c_str();
+	glShaderSource(uiVertexShaderID, 1, &pVertexSourcePointer, NULL);
+	glCompileShader(uiVertexShaderID);
+
+	GLuint uiFragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+	char const * pFragmentSourcePointer = sFragShaderCode.c_str();
+	glShaderSource(uiFragmentShaderID, 1, &pFragmentSourcePointer, NULL);
+	glCompileShader(uiFragmentShaderID);
+
+	pendingLink.uiProgram = glCreateProgram();
+	glAttachShader(pendingLink.uiProgram, uiVertexShaderID);
+	glAttachShader(pendingLink.uiProgram, uiFragmentShaderID);
+
+	//for OpenGL < 3.3, the corresponding attribute name in shader should be explicitly specified.
+	if (opengl_compatible(3, 3))
+	{
+		for (int iAttributeIdx = 0; iAttributeIdx < vAttributeNames.size(); ++iAttributeIdx)
+		{
+			glBindAttribLocation(pendingLink.uiProgram, iAttributeIdx, vAttributeNames[iAttributeIdx].c_str());
+		}
+	}
+
+	if (bBinaryCache)
+	{
+		glProgramParameteri(pendingLink.uiProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	glLinkProgram(pendingLink.uiProgram);
+
+	//the attached shaders are deleted with the program.
+	glDeleteShader(uiVertexShaderID);
+	glDeleteShader(uiFragmentShaderID);
+	return true;
+}
+
+bool GGLSLBlenderGenerator::IsLinkCompleted(const tPendingLink& pendingLink)
+{
+#if (defined __APPLE__) || (defined __ANDROID__)
+	return true;
+#else
+	if (pendingLink.bBinaryLoaded || !IsParallelCompileSupported())
+	{
+		return true;
+	}
+
+	GLint iCompleted = GL_FALSE;
+	glGetProgramiv(pendingLink.uiProgram, GL_COMPLETION_STATUS_KHR, &iCompleted);
+	return (GL_FALSE != iCompleted);
+#endif //(defined __APPLE__) || (defined __ANDROID__)
+}
+
+bool GGLSLBlenderGenerator::FinishLinkProgram(tPendingLink& pendingLink)
+{
+	if (!pendingLink.bBinaryLoaded)
+	{
+		GLint iResult = GL_FALSE;
+		glGetProgramiv(pendingLink.uiProgram, GL_LINK_STATUS, &iResult);
+		if (GL_FALSE == iResult)
+		{
+			int iInfoLogLength = 0;
+			glGetProgramiv(pendingLink.uiProgram, GL_INFO_LOG_LENGTH, &iInfoLogLength);
+			iInfoLogLength = (iInfoLogLength < 0) ? 0 : iInfoLogLength;
+
+			std::vector<char> vProgramErrorMessage(iInfoLogLength + 1);
+			glGetProgramInfoLog(pendingLink.uiProgram, iInfoLogLength, NULL, &vProgramErrorMessage[0]);
+			GLOGGER(error) << "GGLSLBlenderGenerator::FinishLinkProgram(). " << std::string(vProgramErrorMessage.data());
+			glDeleteProgram(pendingLink.uiProgram);
+			pendingLink.uiProgram = 0;
+			return false;
+		}
+
+		//the program is fine without its binary, the next run compiles it again.
+		if (!pendingLink.sBinaryFilePath.empty())
+		{
+			GProgramBinaryCache::Save(pendingLink.sBinaryFilePath, pendingLink.sBinaryKey, pendingLink.uiProgram);
+		}
+	}
+
+	if (pendingLink.bTransformBlock)
+	{
+		BindTransformBlock(pendingLink.uiProgram);
+	}
+	return true;
+}
+
+template<class tLink>
+bool GGLSLProgramCache::FindOrLink(const tKey& key, GLuint& uiProgram, tLink fnLink)
+{
+	//a scene needed before the background link of its program is done.
+	if (m_mpPending.end() != m_mpPending.find(key))
+	{
+		FinishPending(key);
+	}
+
+	auto itProgram = m_mpPrograms.find(key);
+	if (m_mpPrograms.end() != itProgram)
+	{
+		uiProgram = itProgram->second;
+		std::lock_guard<std::mutex> lock(m_mtStatisticsMutex);
+		++m_statistics.ullHits;
+		return true;
+	}
+
+	auto tpStart = std::chrono::steady_clock::now();
+	bool bBinaryLoaded = false;
+	bool bLinked = fnLink(uiProgram, bBinaryLoaded);
+	double dCompileTime_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count();
+	if (bLinked)
+	{
+		m_mpPrograms[key] = uiProgram;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mtStatisticsMutex);
+	++m_statistics.ullMisses;
+	m_statistics.ullBinaryLoads += (bLinked && bBinaryLoaded) ? 1 : 0;
+	m_statistics.dCompileTime_ms += dCompileTime_ms;
+	m_statistics.iPrograms = static_cast<int>(m_mpPrograms.size());
+	return bLinked;
+}
+
+bool GGLSLProgramCache::GetProgram(GGLSLBlenderGenerator::enGVertexShaderType eVertexShaderType, GGLSLBlenderGenerator::enGFragShaderType eFragShaderType
+	, int iGLSLVersion, int iNumOfTextureUnits, GLuint& uiProgram)
+{
+	return FindOrLink(std::make_tuple(false, static_cast<int>(eVertexShaderType), static_cast<int>(eFragShaderType), iGLSLVersion, iNumOfTextureUnits, 0)
+		, uiProgram, [&](GLuint& uiLinkedProgram, bool& bBinaryLoaded)
+	{
+		return GGLSLBlenderGenerator::GetProgram(eVertexShaderType, eFragShaderType, iGLSLVersion, iNumOfTextureUnits, uiLinkedProgram
+			, m_sBinaryCacheDirectory, &bBinaryLoaded);
+	});
+}
+
+bool GGLSLProgramCache::GetRemapProgram(GGLSLBlenderGenerator::enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras, GLuint& uiProgram)
+{
+	return FindOrLink(std::make_tuple(true, 0, static_cast<int>(eFragShaderType), iGLSLVersion, iNumOfLayers, iNumOfCameras)
+		, uiProgram, [&](GLuint& uiLinkedProgram, bool& bBinaryLoaded)
+	{
+		return GGLSLBlenderGenerator::GetRemapProgram(eFragShaderType, iGLSLVersion, iNumOfLayers, iNumOfCameras, uiLinkedProgram
+			, m_sBinaryCacheDirectory, &bBinaryLoaded);
+	});
+}
+
+template<class tSources>
+bool GGLSLProgramCache::Request(const tKey& key, bool bTransformBlock, tSources fnSources)
+{
+	if ((m_mpPrograms.end() != m_mpPrograms.find(key)) || (m_stFailedKeys.end() != m_stFailedKeys.find(key)))
+	{
+		return true;
+	}
+
+	if (m_mpPending.end() != m_mpPending.find(key))
+	{
+		return false;
+	}
+
+	std::string sVertexShaderCode;
+	std::string sFragShaderCode;
+	std::vector<std::string> vAttributeNames;
+	if (!fnSources(sVertexShaderCode, sFragShaderCode, vAttributeNames))
+	{
+		m_stFailedKeys.insert(key);
+		return true;
+	}
+
+	auto tpStart = std::chrono::steady_clock::now();
+	tPendingProgram& pending = m_mpPending[key];
+	pending.tpRequested = tpStart;
+	GGLSLBlenderGenerator::StartLinkProgram(sVertexShaderCode, sFragShaderCode, vAttributeNames, bTransformBlock, m_sBinaryCacheDirectory, pending.link);
+	double dCompileTime_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count();
+
+	std::lock_guard<std::mutex> lock(m_mtStatisticsMutex);
+	m_statistics.dCompileTime_ms += dCompileTime_ms;
+	m_statistics.iPending = static_cast<int>(m_mpPending.size());
+	return false;
+}
+
+bool GGLSLProgramCache::FinishPending(const tKey& key)
+{
+	auto itPending = m_mpPending.find(key);
+	if (m_mpPending.end() == itPending)
+	{
+		return false;
+	}
+
+	auto tpStart = std::chrono::steady_clock::now();
+	tPendingProgram pending = itPending->second;
+	m_mpPending.erase(itPending);
+	bool bLinked = GGLSLBlenderGenerator::FinishLinkProgram(pending.link);
+	auto tpEnd = std::chrono::steady_clock::now();
+	double dCompileTime_ms = std::chrono::duration<double, std::milli>(tpEnd - tpStart).count();
+	double dLatency_ms = std::chrono::duration<double, std::milli>(tpEnd - pending.tpRequested).count();
+	if (bLinked)
+	{
+		m_mpPrograms[key] = pending.link.uiProgram;
+	}
+	else
+	{
+		m_stFailedKeys.insert(key);
+	}
+
+	GLOGGER(info) << "GGLSLProgramCache::FinishPending(). Program (remap: " << std::get<0>(key) << ", fragment shader: " << std::get<2>(key)
+		<< ", GLSL: " << std::get<3>(key) << ", layers: " << std::get<4>(key) << ", cameras: " << std::get<5>(key) << ") "
+		<< (bLinked ? (pending.link.bBinaryLoaded ? "loaded" : "linked") : "FAILED") << " in " << dLatency_ms << " ms"
+		<< ", waited " << dCompileTime_ms << " ms.";
+
+	std::lock_guard<std::mutex> lock(m_mtStatisticsMutex);
+	++m_statistics.ullMisses;
+	++m_statistics.ullBackgroundLinks;
+	m_statistics.ullBinaryLoads += (bLinked && pending.link.bBinaryLoaded) ? 1 : 0;
+	m_statistics.dCompileTime_ms += dCompileTime_ms;
+	m_statistics.dLinkLatency_ms += dLatency_ms;
+	m_statistics.dMaxLinkLatency_ms = (std::max)(m_statistics.dMaxLinkLatency_ms, dLatency_ms);
+	m_statistics.iPrograms = static_cast<int>(m_mpPrograms.size());
+	m_statistics.iPending = static_cast<int>(m_mpPending.size());
+	return bLinked;
+}
+
+bool GGLSLProgramCache::RequestProgram(GGLSLBlenderGenerator::enGVertexShaderType eVertexShaderType, GGLSLBlenderGenerator::enGFragShaderType eFragShaderType
+	, int iGLSLVersion, int iNumOfTextureUnits)
+{
+	return Request(std::make_tuple(false, static_cast<int>(eVertexShaderType), static_cast<int>(eFragShaderType), iGLSLVersion, iNumOfTextureUnits, 0)
+		, iGLSLVersion >= 330, [&](std::string& sVertexShaderCode, std::string& sFragShaderCode, std::vector<std::string>& vAttributeNames)
+	{
+		return GGLSLBlenderGenerator::GetProgramSources(eVertexShaderType, eFragShaderType, iGLSLVersion, iNumOfTextureUnits
+			, sVertexShaderCode, sFragShaderCode, vAttributeNames);
+	});
+}
+
+bool GGLSLProgramCache::RequestRemapProgram(GGLSLBlenderGenerator::enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras)
+{
+	return Request(std::make_tuple(true, 0, static_cast<int>(eFragShaderType), iGLSLVersion, iNumOfLayers, iNumOfCameras)
+		, true, [&](std::string& sVertexShaderCode, std::string& sFragShaderCode, std::vector<std::string>& vAttributeNames)
+	{
+		return GGLSLBlenderGenerator::GetRemapProgramSources(eFragShaderType, iGLSLVersion, iNumOfLayers, iNumOfCameras
+			, sVertexShaderCode, sFragShaderCode, vAttributeNames);
+	});
+}
+
+void GGLSLProgramCache::Poll()
+{
+	if (m_mpPending.empty())
+	{
+		return;
+	}
+
+	bool bParallelCompile = GGLSLBlenderGenerator::IsParallelCompileSupported();
+	std::vector<tKey> vCompletedKeys;
+	for (auto it = m_mpPending.begin(); it != m_mpPending.end(); ++it)
+	{
+		if (GGLSLBlenderGenerator::IsLinkCompleted(it->second.link))
+		{
+			vCompletedKeys.push_back(it->first);
+			if (!bParallelCompile)
+			{
+				break;
+			}
+		}
+	}
+
+	for (int i = 0; i < vCompletedKeys.size(); ++i)
+	{
+		FinishPending(vCompletedKeys[i]);
+	}
+}
+
+void GGLSLProgramCache::SetBinaryCacheDirectory(const std::string& sDirectory)
+{
+	if (m_sBinaryCacheDirectory != sDirectory)
+	{
+		GLOGGER(info) << "GGLSLProgramCache::SetBinaryCacheDirectory(). Directory: " << sDirectory
+			<< (GProgramBinaryCache::IsSupported() ? "." : ", program binaries are NOT supported.");
+	}
+	m_sBinaryCacheDirectory = sDirectory;
+}
+
+GGLSLProgramCache::tStatistics GGLSLProgramCache::GetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_mtStatisticsMutex);
+	return m_statistics;
+}
+
+void GGLSLProgramCache::Release()
+{
+	for (auto it = m_mpPrograms.begin(); it != m_mpPrograms.end(); ++it)
+	{
+		glDeleteProgram(it->second);
+	}
+
+	for (auto it = m_mpPending.begin(); it != m_mpPending.end(); ++it)
+	{
+		glDeleteProgram(it->second.link.uiProgram);
+	}
+
+	GLOGGER(info) << "GGLSLProgramCache::Release(). " << m_mpPrograms.size() << " programs released, " << m_mpPending.size() << " pending.";
+	m_mpPrograms.clear();
+	m_mpPending.clear();
+	m_stFailedKeys.clear();
+
+	std::lock_guard<std::mutex> lock(m_mtStatisticsMutex);
+	m_statistics.iPrograms = 0;
+	m_statistics.iPending = 0;
+}
@@ -26,6 +26,12 @@
 #define G_GLSL_PROGRAM_GENERATOR_H_
 
 #include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <set>
+#include <mutex>
+#include <chrono>
 
 #include "GGLHeaders.h"
 
@@ -44,9 +50,66 @@ public:
 		eGFragShaderTypeNV12,
 	};
 
-	static bool GetProgram(enGVertexShaderType eVertexShaderType, enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfTextureUnits, GLuint& uiProgram);
+	//binding point of the uniform block "Transform" holding the MVP matrix, used by the GLSL 330 programs.
+	//the programs of GLSL 120 have a plain MVP uniform instead.
+	static const GLuint TRANSFORM_BLOCK_BINDING = 0;
+
+	//a program linked without waiting for the driver, see StartLinkProgram().
+	struct tPendingLink
+	{
+		tPendingLink() :
+			uiProgram(0)
+			, bBinaryLoaded(false)
+			, bTransformBlock(false)
+		{}
+
+		GLuint uiProgram;
+		bool bBinaryLoaded;
+		bool bTransformBlock;
+		//empty if the binary is not stored.
+		std::string sBinaryFilePath;
+		std::string sBinaryKey;
+	};
+
+	//render thread. KHR_parallel_shader_compile or ARB_parallel_shader_compile, the driver compiles and links on threads of its own.
+	static bool IsParallelCompileSupported();
+
+	//render thread, once per context. lets the driver use all the threads it likes, false if parallel compile is not supported.
+	static bool EnableParallelCompile();
+
+	//the program is loaded from and stored to the binaries in sBinaryCacheDirectory, see GProgramBinaryCache. empty compiles it.
+	//*pbBinaryLoaded tells whether it was loaded.
+	static bool GetProgram(enGVertexShaderType eVertexShaderType, enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfTextureUnits, GLuint& uiProgram
+		, const std::string& sBinaryCacheDirectory = std::string(), bool* pbBinaryLoaded = nullptr);
+
+	//full screen pass of a remap table: iNumOfLayers tables select the cameras of a pixel, from the frames of iNumOfCameras cameras.
+	static bool GetRemapProgram(enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras, GLuint& uiProgram
+		, const std::string& sBinaryCacheDirectory = std::string(), bool* pbBinaryLoaded = nullptr);
+
+	//the shaders GetProgram() and GetRemapProgram() link. vAttributeNames[i] is bound to the attribute location i.
+	static bool GetProgramSources(enGVertexShaderType eVertexShaderType, enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfTextureUnits
+		, std::string& sVertexShaderCode, std::string& sFragShaderCode, std::vector<std::string>& vAttributeNames);
+	static bool GetRemapProgramSources(enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras
+		, std::string& sVertexShaderCode, std::string& sFragShaderCode, std::vector<std::string>& vAttributeNames);
+
+	//render thread. issues the compile and link without asking for their results, which would wait for them.
+	//a program found in sBinaryCacheDirectory is loaded at once. bTransformBlock: the program reads MVP from the block "Transform".
+	static bool StartLinkProgram(const std::string& sVertexShaderCode, const std::string& sFragShaderCode, const std::vector<std::string>& vAttributeNames
+		, bool bTransformBlock, const std::string& sBinaryCacheDirectory, tPendingLink& pendingLink);
+
+	//render thread. true once FinishLinkProgram() does not wait for the driver. always true without parallel compile.
+	static bool IsLinkCompleted(const tPendingLink& pendingLink);
+
+	//render thread. waits for the link if it is not completed yet, the program is deleted if it failed.
+	static bool FinishLinkProgram(tPendingLink& pendingLink);
 
 private:
+	//vAttributeNames[i] is bound to the attribute location i.
+	static bool LinkProgram(const std::string& sVertexShaderCode, const std::string& sFragShaderCode
+		, const std::vector<std::string>& vAttributeNames, const std::string& sBinaryCacheDirectory, GLuint& uiProgram, bool& bBinaryLoaded);
+
+	static void BindTransformBlock(GLuint uiProgram);
+
 	static std::string GenerateVertexShaderCode120(int iNumOfTextureUnits);
 	static std::string GenerateFragShaderCode120(int iNumOfTextureUnits);
 	static std::string GenerateFragShaderYUVCode120(int iNumOfTextureUnits);
@@ -57,6 +120,109 @@ private:
 	static std::string GenerateFragShaderYUVCode330(int iNumOfTextureUnits);
 	static std::string GenerateFragShaderNV12Code330(int iNumOfTextureUnits);
 
+	static std::string GenerateRemapVertexShaderCode330();
+	static std::string GenerateRemapFragShaderCode330(enGFragShaderType eFragShaderType, int iNumOfLayers, int iNumOfCameras);
+
+};
+
+//programs of one GL context shared by its scenes. a program only depends on the shader types, the GLSL version and the number
+//of layers (and cameras of a remap pass), so it is linked once and handed out to every batch asking for the same inputs.
+//the programs are kept until Release(), which has to be called on the render thread before the context is destroyed.
+class GGLSLProgramCache
+{
+public:
+	struct tStatistics
+	{
+		tStatistics() :
+			iPrograms(0)
+			, ullHits(0)
+			, ullMisses(0)
+			, dCompileTime_ms(0.0)
+			, ullBinaryLoads(0)
+			, iPending(0)
+			, ullBackgroundLinks(0)
+			, dLinkLatency_ms(0.0)
+			, dMaxLinkLatency_ms(0.0)
+		{}
+
+		int iPrograms;
+		unsigned long long ullHits;
+		//programs linked, including the ones that failed.
+		unsigned long long ullMisses;
+		//spent linking the programs.
+		double dCompileTime_ms;
+		//misses loaded from the binary cache instead of being compiled.
+		unsigned long long ullBinaryLoads;
+		//requested programs still being linked.
+		int iPending;
+		//programs linked in the background, see RequestProgram(). they are included in ullMisses.
+		unsigned long long ullBackgroundLinks;
+		//from the request of a background link until Poll() found it linked, summed over the links and the longest of them.
+		double dLinkLatency_ms;
+		double dMaxLinkLatency_ms;
+	};
+
+	GGLSLProgramCache() {}
+
+	//render thread. the program is owned by the cache, the caller must not delete it.
+	bool GetProgram(GGLSLBlenderGenerator::enGVertexShaderType eVertexShaderType, GGLSLBlenderGenerator::enGFragShaderType eFragShaderType
+		, int iGLSLVersion, int iNumOfTextureUnits, GLuint& uiProgram);
+
+	//render thread. the program is owned by the cache, the caller must not delete it.
+	bool GetRemapProgram(GGLSLBlenderGenerator::enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras, GLuint& uiProgram);
+
+	//render thread. starts linking the program in the background if it is not linked yet, and never waits for it.
+	//true once GetProgram() returns it without linking, or if it can not be linked at all, which GetProgram() reports then.
+	bool RequestProgram(GGLSLBlenderGenerator::enGVertexShaderType eVertexShaderType, GGLSLBlenderGenerator::enGFragShaderType eFragShaderType
+		, int iGLSLVersion, int iNumOfTextureUnits);
+
+	//render thread, see RequestProgram().
+	bool RequestRemapProgram(GGLSLBlenderGenerator::enGFragShaderType eFragShaderType, int iGLSLVersion, int iNumOfLayers, int iNumOfCameras);
+
+	//render thread, once per frame. takes over the requested programs the driver has linked. without parallel compile the driver
+	//links a program when it is asked for the result, at most one is taken over then, so a frame waits for one link at most.
+	void Poll();
+
+	//render thread. the programs linked afterwards are loaded from and stored to the binaries in sDirectory, empty disables it.
+	void SetBinaryCacheDirectory(const std::string& sDirectory);
+
+	//any thread.
+	tStatistics GetStatistics();
+
+	//render thread, deletes the programs.
+	void Release();
+
+private:
+	//remap pass or not, vertex shader type, fragment shader type, GLSL version, layers, cameras.
+	typedef std::tuple<bool, int, int, int, int, int> tKey;
+
+	//the program of key, linked by fnLink(uiProgram, bBinaryLoaded) if it is not cached yet.
+	template<class tLink>
+	bool FindOrLink(const tKey& key, GLuint& uiProgram, tLink fnLink);
+
+	struct tPendingProgram
+	{
+		GGLSLBlenderGenerator::tPendingLink link;
+		std::chrono::steady_clock::time_point tpRequested;
+	};
+
+	//the request of key, the link is started with the sources of fnSources(vs, fs, attribute names) if it is not linked or pending yet.
+	template<class tSources>
+	bool Request(const tKey& key, bool bTransformBlock, tSources fnSources);
+
+	//waits for the link if it is not completed, the program is cached on success. the entry is erased.
+	bool FinishPending(const tKey& key);
+
+	//render thread only.
+	std::map<tKey, GLuint> m_mpPrograms;
+	std::map<tKey, tPendingProgram> m_mpPending;
+	//background links that failed, they are left to GetProgram() instead of being started again every frame.
+	std::set<tKey> m_stFailedKeys;
+	std::string m_sBinaryCacheDirectory;
+
+	std::mutex m_mtStatisticsMutex;
+	//guarded by m_mtStatisticsMutex.
+	tStatistics m_statistics;
 };
 
 
@@ -47,6 +47,32 @@ bool GetK0(int iCameraIdx, const std::string& sK0Name, const std::vector<CameraM
 	return true;
 }
 
+bool GPanoSceneImmersionSemiSphere::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs)
+{
+	vProjectorObjs.resize(vCameras.size());
+	std::vector<float> vDistortionValidRange(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+	}
+
+	return true;
+}
+
 bool GPanoSceneImmersionSemiSphere::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
@@ -55,29 +81,16 @@ bool GPanoSceneImmersionSemiSphere::Create(const GStitcherConfig& config, const
 
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorSphere> ptrSphereSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorSphere>(new GSurfaceGeneratorSphere);
+		ptrSphereSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrSphereSurfaceGenerator;
 
-		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		std::vector<float> vDistortionValidRange(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -94,11 +107,30 @@ bool GPanoSceneImmersionSemiSphere::Create(const GStitcherConfig& config, const
 	}
 }
 
+bool GPanoSceneImmersionSemiSphere::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionSemiSphere::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneImmersionSemiSphere::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -129,6 +161,43 @@ bool GPanoSceneImmersionSemiSphere::Render(const GTextureGroup& textureGroup, co
 	}
 }
 
+bool GPanoSceneImmersionSemiSphere::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionSemiSphere::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneImmersionSemiSphere::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionSemiSphere::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneImmersionSemiSphere::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneImmersionSemiSphere::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneImmersionSemiSphere::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -174,50 +243,63 @@ void GPanoSceneImmersionSemiSphere::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder180::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder180, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+		vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedCylinder180::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder180, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinder180), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinder180));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetFlip(false);
-			vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
-
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -234,11 +316,30 @@ bool GPanoSceneUnwrappedCylinder180::Create(const GStitcherConfig& config, const
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder180::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder180::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedCylinder180::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -269,6 +370,43 @@ bool GPanoSceneUnwrappedCylinder180::Render(const GTextureGroup& textureGroup, c
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder180::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder180::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedCylinder180::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder180::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedCylinder180::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedCylinder180::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedCylinder180::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -326,50 +464,63 @@ void GPanoSceneUnwrappedCylinder180::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder360::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder360, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+		vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedCylinder360::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder360, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinder360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinder360));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetFlip(false);
-			vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
-
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -386,11 +537,30 @@ bool GPanoSceneUnwrappedCylinder360::Create(const GStitcherConfig& config, const
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder360::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder360::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedCylinder360::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -421,6 +591,43 @@ bool GPanoSceneUnwrappedCylinder360::Render(const GTextureGroup& textureGroup, c
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder360::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder360::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedCylinder360::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder360::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedCylinder360::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedCylinder360::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedCylinder360::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -478,44 +685,57 @@ void GPanoSceneUnwrappedCylinder360::Release()
 	}
 }
 
+bool GPanoSceneImmersionCylinder360::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs)
+{
+	Eigen::Vector2f panoHeight = GPanoTypeStaticParameters::GetPanoHeightOnCanvas(ePanoTypeImmersionCylinder360, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoHeight](float fX, float fY, float fZ)
+	{
+		return ((fY >= (panoHeight[0] - FLT_EPSILON)) && (fY <= (panoHeight[1] + FLT_EPSILON)));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneImmersionCylinder360::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		Eigen::Vector2f panoHeight = GPanoTypeStaticParameters::GetPanoHeightOnCanvas(ePanoTypeImmersionCylinder360, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoHeight](float fX, float fY, float fZ)
-		{
-			return ((fY >= (panoHeight[0] - FLT_EPSILON)) && (fY <= (panoHeight[1] + FLT_EPSILON)));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorCylinder> ptrCylinderSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorCylinder>(new GSurfaceGeneratorCylinder);
 		ptrCylinderSurfaceGenerator->SetSurfaceSize(GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeImmersionCylinder360));
+		ptrCylinderSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrCylinderSurfaceGenerator;
 
-		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -532,11 +752,30 @@ bool GPanoSceneImmersionCylinder360::Create(const GStitcherConfig& config, const
 	}
 }
 
+bool GPanoSceneImmersionCylinder360::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionCylinder360::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneImmersionCylinder360::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -567,6 +806,43 @@ bool GPanoSceneImmersionCylinder360::Render(const GTextureGroup& textureGroup, c
 	}
 }
 
+bool GPanoSceneImmersionCylinder360::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionCylinder360::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneImmersionCylinder360::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionCylinder360::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneImmersionCylinder360::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneImmersionCylinder360::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneImmersionCylinder360::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -612,47 +888,60 @@ void GPanoSceneImmersionCylinder360::Release()
 	}
 }
 
-bool GPanoSceneUnwrappedCylinderSplited::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+bool GPanoSceneUnwrappedCylinderSplited::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix>& vProjectorObjs)
 {
-	try
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinderSplited, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
 	{
-		m_config = config;
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinderSplited, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
 		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
+bool GPanoSceneUnwrappedCylinderSplited::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		m_config = config;
 
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinderSplited), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinderSplited));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -669,11 +958,30 @@ bool GPanoSceneUnwrappedCylinderSplited::Create(const GStitcherConfig& config, c
 	}
 }
 
+bool GPanoSceneUnwrappedCylinderSplited::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinderSplited::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedCylinderSplited::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -704,6 +1012,43 @@ bool GPanoSceneUnwrappedCylinderSplited::Render(const GTextureGroup& textureGrou
 	}
 }
 
+bool GPanoSceneUnwrappedCylinderSplited::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinderSplited::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedCylinderSplited::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinderSplited::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedCylinderSplited::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedCylinderSplited::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedCylinderSplited::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -747,47 +1092,60 @@ void GPanoSceneUnwrappedCylinderSplited::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedCylinderSplitedFrontBack::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinderSplitedFrontBack, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedCylinderSplitedFrontBack::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinderSplitedFrontBack, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinderSplitedFrontBack), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinderSplitedFrontBack));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -804,11 +1162,30 @@ bool GPanoSceneUnwrappedCylinderSplitedFrontBack::Create(const GStitcherConfig&
 	}
 }
 
+bool GPanoSceneUnwrappedCylinderSplitedFrontBack::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinderSplitedFrontBack::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedCylinderSplitedFrontBack::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -839,6 +1216,43 @@ bool GPanoSceneUnwrappedCylinderSplitedFrontBack::Render(const GTextureGroup& te
 	}
 }
 
+bool GPanoSceneUnwrappedCylinderSplitedFrontBack::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinderSplitedFrontBack::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedCylinderSplitedFrontBack::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinderSplitedFrontBack::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedCylinderSplitedFrontBack::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedCylinderSplitedFrontBack::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedCylinderSplitedFrontBack::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -894,47 +1308,60 @@ void GPanoSceneUnwrappedCylinderSplitedFrontBack::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedSphere180::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedSphere180, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedSphere180::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedSphere180, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedSphere180), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedSphere180));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -951,11 +1378,30 @@ bool GPanoSceneUnwrappedSphere180::Create(const GStitcherConfig& config, const s
 	}
 }
 
+bool GPanoSceneUnwrappedSphere180::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere180::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedSphere180::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -986,6 +1432,43 @@ bool GPanoSceneUnwrappedSphere180::Render(const GTextureGroup& textureGroup, con
 	}
 }
 
+bool GPanoSceneUnwrappedSphere180::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere180::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedSphere180::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere180::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedSphere180::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedSphere180::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedSphere180::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -1039,53 +1522,66 @@ void GPanoSceneUnwrappedSphere180::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedSphere360::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedSphere360, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+
+		vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+
+		vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(false);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedSphere360::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedSphere360, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedSphere360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedSphere360));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-
-			vProjectorObjs[iProjectorObjIdx].SetFlip(false);
-
-			vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(false);
-
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1102,11 +1598,30 @@ bool GPanoSceneUnwrappedSphere360::Create(const GStitcherConfig& config, const s
 	}
 }
 
+bool GPanoSceneUnwrappedSphere360::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere360::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedSphere360::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1137,6 +1652,43 @@ bool GPanoSceneUnwrappedSphere360::Render(const GTextureGroup& textureGroup, con
 	}
 }
 
+bool GPanoSceneUnwrappedSphere360::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere360::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedSphere360::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere360::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedSphere360::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedSphere360::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedSphere360::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -1194,53 +1746,66 @@ void GPanoSceneUnwrappedSphere360::Release()
 	}
 }
 
-bool GPanoSceneUnwrappedSphere360Flip::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+bool GPanoSceneUnwrappedSphere360Flip::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs)
 {
-	try
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedSphere360Flip, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
 	{
-		m_config = config;
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedSphere360Flip, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
 		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
 
-		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
-		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
-		ptrPlaneSurfaceGenerator->SetSurfaceSize(
-			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedSphere360Flip), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedSphere360Flip));
-		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
 
-		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
-		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
 
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+		vProjectorObjs[iProjectorObjIdx].SetFlip(true);
 
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(false);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
 
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+	return true;
+}
 
-			vProjectorObjs[iProjectorObjIdx].SetFlip(true);
+bool GPanoSceneUnwrappedSphere360Flip::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		m_config = config;
 
-			vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(false);
+		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
+		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
+		ptrPlaneSurfaceGenerator->SetSurfaceSize(
+			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedSphere360Flip), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedSphere360Flip));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
+		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1257,11 +1822,30 @@ bool GPanoSceneUnwrappedSphere360Flip::Create(const GStitcherConfig& config, con
 	}
 }
 
+bool GPanoSceneUnwrappedSphere360Flip::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere360Flip::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedSphere360Flip::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1292,6 +1876,43 @@ bool GPanoSceneUnwrappedSphere360Flip::Render(const GTextureGroup& textureGroup,
 	}
 }
 
+bool GPanoSceneUnwrappedSphere360Flip::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere360Flip::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedSphere360Flip::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedSphere360Flip::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedSphere360Flip::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedSphere360Flip::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedSphere360Flip::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -1349,50 +1970,63 @@ void GPanoSceneUnwrappedSphere360Flip::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder180Flip::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder180Flip, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetFlip(true);
+		vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedCylinder180Flip::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder180Flip, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinder180Flip), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinder180Flip));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetFlip(true);
-			vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
-
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1409,11 +2043,30 @@ bool GPanoSceneUnwrappedCylinder180Flip::Create(const GStitcherConfig& config, c
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder180Flip::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder180Flip::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedCylinder180Flip::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1444,6 +2097,43 @@ bool GPanoSceneUnwrappedCylinder180Flip::Render(const GTextureGroup& textureGrou
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder180Flip::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder180Flip::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedCylinder180Flip::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder180Flip::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedCylinder180Flip::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedCylinder180Flip::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedCylinder180Flip::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -1501,50 +2191,63 @@ void GPanoSceneUnwrappedCylinder180Flip::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder360Flip::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder360Flip, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetFlip(true);
+		vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedCylinder360Flip::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedCylinder360Flip, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinder360Flip), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinder360Flip));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-			vProjectorObjs[iProjectorObjIdx].SetFlip(true);
-			vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
-
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1561,11 +2264,30 @@ bool GPanoSceneUnwrappedCylinder360Flip::Create(const GStitcherConfig& config, c
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder360Flip::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder360Flip::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedCylinder360Flip::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1596,6 +2318,43 @@ bool GPanoSceneUnwrappedCylinder360Flip::Render(const GTextureGroup& textureGrou
 	}
 }
 
+bool GPanoSceneUnwrappedCylinder360Flip::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder360Flip::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedCylinder360Flip::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedCylinder360Flip::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedCylinder360Flip::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedCylinder360Flip::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedCylinder360Flip::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -1653,6 +2412,31 @@ void GPanoSceneUnwrappedCylinder360Flip::Release()
 	}
 }
 
+bool GPanoSceneImmersionFullSphere::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs)
+{
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+	}
+
+	return true;
+}
+
 bool GPanoSceneImmersionFullSphere::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
@@ -1662,28 +2446,16 @@ bool GPanoSceneImmersionFullSphere::Create(const GStitcherConfig& config, const
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorSphere> ptrSphereSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorSphere>(new GSurfaceGeneratorSphere);
 		ptrSphereSurfaceGenerator->SetIsFullSphere(true);
+		ptrSphereSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrSphereSurfaceGenerator;
 
-		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1700,11 +2472,30 @@ bool GPanoSceneImmersionFullSphere::Create(const GStitcherConfig& config, const
 	}
 }
 
+bool GPanoSceneImmersionFullSphere::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionFullSphere::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneImmersionFullSphere::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1736,99 +2527,149 @@ bool GPanoSceneImmersionFullSphere::Render(const GTextureGroup& textureGroup, co
 
 }
 
-bool GPanoSceneImmersionFullSphere::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
+bool GPanoSceneImmersionFullSphere::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
 {
 	try
 	{
-		v3fScene3DPointf = v3fPhysical3DPoint;
-		return true;
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
 	}
 	catch (...)
 	{
-		GLOGGER(error) << "GPanoSceneImmersionFullSphere::Project(): exception.";
+		GLOGGER(error) << "GPanoSceneImmersionFullSphere::GetVisibleCameras(): exception.";
 		return false;
 	}
-
 }
 
-bool GPanoSceneImmersionFullSphere::UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const
+bool GPanoSceneImmersionFullSphere::GetRenderCounters(GRenderCounters& counters) const
 {
 	try
 	{
-		v3fPhysical3DPoint = v3fScene3DPointf;
+		counters = m_ptrRenderScene->GetRenderCounters();
 		return true;
 	}
 	catch (...)
 	{
-		GLOGGER(error) << "GPanoSceneImmersionFullSphere::UnProject(): exception.";
+		GLOGGER(error) << "GPanoSceneImmersionFullSphere::GetRenderCounters(): exception.";
 		return false;
 	}
 }
 
-void GPanoSceneImmersionFullSphere::Release()
+size_t GPanoSceneImmersionFullSphere::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneImmersionFullSphere::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
+bool GPanoSceneImmersionFullSphere::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
 	{
-		if (nullptr != m_ptrRenderScene.get())
-		{
-			m_ptrRenderScene->Release();
-			m_ptrRenderScene.reset();
-		}
+		v3fScene3DPointf = v3fPhysical3DPoint;
+		return true;
 	}
 	catch (...)
 	{
-		GLOGGER(error) << "GPanoSceneImmersionFullSphere::Release(): exception.";
-		return;
+		GLOGGER(error) << "GPanoSceneImmersionFullSphere::Project(): exception.";
+		return false;
 	}
+
 }
 
-bool GPanoSceneUnwrappedFullSphere360::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+bool GPanoSceneImmersionFullSphere::UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const
 {
 	try
 	{
-		m_config = config;
+		v3fPhysical3DPoint = v3fScene3DPointf;
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionFullSphere::UnProject(): exception.";
+		return false;
+	}
+}
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedFullSphere360, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+void GPanoSceneImmersionFullSphere::Release()
+{
+	try
+	{
+		if (nullptr != m_ptrRenderScene.get())
 		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
+			m_ptrRenderScene->Release();
+			m_ptrRenderScene.reset();
+		}
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneImmersionFullSphere::Release(): exception.";
+		return;
+	}
+}
 
-		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
-		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
-		ptrPlaneSurfaceGenerator->SetSurfaceSize(
-			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedFullSphere360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedFullSphere360));
-		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
+bool GPanoSceneUnwrappedFullSphere360::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedFullSphere360, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
 
-		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
 
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
 
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
 
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+		vProjectorObjs[iProjectorObjIdx].SetFlip(false);
 
-			vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+		vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(true);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
 
-			vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(true);
+bool GPanoSceneUnwrappedFullSphere360::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		m_config = config;
 
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
+		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
+		ptrPlaneSurfaceGenerator->SetSurfaceSize(
+			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedFullSphere360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedFullSphere360));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
+		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
+
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1845,11 +2686,30 @@ bool GPanoSceneUnwrappedFullSphere360::Create(const GStitcherConfig& config, con
 	}
 }
 
+bool GPanoSceneUnwrappedFullSphere360::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedFullSphere360::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -1880,6 +2740,43 @@ bool GPanoSceneUnwrappedFullSphere360::Render(const GTextureGroup& textureGroup,
 	}
 }
 
+bool GPanoSceneUnwrappedFullSphere360::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedFullSphere360::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedFullSphere360::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedFullSphere360::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedFullSphere360::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -1937,53 +2834,66 @@ void GPanoSceneUnwrappedFullSphere360::Release()
 	}
 }
 
+bool GPanoSceneUnwrappedFullSphere360Flip::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedFullSphere360Flip, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
+
+		cv::Mat mK0ForSize;
+		if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
+		{
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
+
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
+
+		vProjectorObjs[iProjectorObjIdx].SetFlip(true);
+
+		vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(true);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneUnwrappedFullSphere360Flip::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedFullSphere360Flip, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedFullSphere360Flip), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedFullSphere360Flip));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].distorsionCoefficients);
-
-			cv::Mat mK0ForSize;
-			if (!GetK0(iProjectorObjIdx, sK0Name, vCameras, mK0ForSize))
-			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
-			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
-
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iProjectorObjIdx].eCameraType);
-
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iProjectorObjIdx].dDistortionValidRange);
-
-			vProjectorObjs[iProjectorObjIdx].SetFlip(true);
-
-			vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(true);
-
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -2000,11 +2910,30 @@ bool GPanoSceneUnwrappedFullSphere360Flip::Create(const GStitcherConfig& config,
 	}
 }
 
+bool GPanoSceneUnwrappedFullSphere360Flip::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360Flip::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedFullSphere360Flip::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -2035,6 +2964,43 @@ bool GPanoSceneUnwrappedFullSphere360Flip::Render(const GTextureGroup& textureGr
 	}
 }
 
+bool GPanoSceneUnwrappedFullSphere360Flip::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360Flip::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedFullSphere360Flip::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360Flip::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedFullSphere360Flip::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedFullSphere360Flip::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedFullSphere360Flip::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -2092,77 +3058,90 @@ void GPanoSceneUnwrappedFullSphere360Flip::Release()
 	}
 }
 
-bool GPanoSceneUnwrappedFullSphere360Binocular::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+bool GPanoSceneUnwrappedFullSphere360Binocular::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular>& vProjectorObjs)
 {
-	try
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedFullSphere360Binocular, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
 	{
-		m_config = config;
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeUnwrappedFullSphere360Binocular, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
+	vProjectorObjs.resize(vCameras.size() - 1);
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		int iCameraIdx = iProjectorObjIdx;
+		bool bIsLeft = iProjectorObjIdx % 2 == 0;
 
-		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
-		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
-		ptrPlaneSurfaceGenerator->SetSurfaceSize(
-			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedFullSphere360Binocular), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedFullSphere360Binocular));
-		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iCameraIdx);
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iCameraIdx].R.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iCameraIdx].distorsionCoefficients);
 
-		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular> vProjectorObjs(vCameras.size() - 1);
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		cv::Mat mK0ForSize;
+		if (!GetK0(iCameraIdx, sK0Name, vCameras, mK0ForSize))
 		{
-			int iCameraIdx = iProjectorObjIdx;
-			bool bIsLeft = iProjectorObjIdx % 2 == 0;
+			GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
+			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+			return false;
+		}
+		vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iCameraIdx].eCameraType);
+
+		vProjectorObjs[iProjectorObjIdx].SetIsLeft(bIsLeft);
 
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iCameraIdx);
-			vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iCameraIdx].R.inv());
-			vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iCameraIdx].distorsionCoefficients);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iCameraIdx].dDistortionValidRange);
 
-			cv::Mat mK0ForSize;
-			if (!GetK0(iCameraIdx, sK0Name, vCameras, mK0ForSize))
+		if (iProjectorObjIdx < vCameras.size())
+		{
+			if (bIsLeft)
 			{
-				GLOGGER(error) << "GStitcherOGL::CreateScene(). get K0 failed.";
-				GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
-				return false;
+				//theoretically: 0.125 - 0.25
+				vProjectorObjs[iProjectorObjIdx].SetTheta(M_PI * -0.49, M_PI * 0.49);
+
+				vProjectorObjs[iProjectorObjIdx].SetPhi(M_PI * -0.4, M_PI * 0.4);
 			}
-			vProjectorObjs[iProjectorObjIdx].SetK1(mK0ForSize);
+			else
+			{
+				vProjectorObjs[iProjectorObjIdx].SetTheta(M_PI * -0.49, M_PI * 0.49);
+
+				vProjectorObjs[iProjectorObjIdx].SetPhi(M_PI * -0.4, M_PI * 0.4);
+			}
+		}
+		//else
+		//{
+		//	vProjectorObjs[iProjectorObjIdx].SetTheta(-M_PI / 2.001, M_PI / 2.001);
 
-			vProjectorObjs[iProjectorObjIdx].SetCameraType(vCameras[iCameraIdx].eCameraType);
+		//	vProjectorObjs[iProjectorObjIdx].SetPhi(-M_PI / 2.001, M_PI / 2.001);
+		//}
 
-			vProjectorObjs[iProjectorObjIdx].SetIsLeft(bIsLeft);
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
 
-			vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(vCameras[iCameraIdx].dDistortionValidRange);
+	return true;
+}
 
-			if (iProjectorObjIdx < vCameras.size())
-			{
-				if (bIsLeft)
-				{
-					//theoretically: 0.125 - 0.25
-					vProjectorObjs[iProjectorObjIdx].SetTheta(M_PI * -0.49, M_PI * 0.49);
-
-					vProjectorObjs[iProjectorObjIdx].SetPhi(M_PI * -0.4, M_PI * 0.4);
-				}
-				else
-				{
-					vProjectorObjs[iProjectorObjIdx].SetTheta(M_PI * -0.49, M_PI * 0.49);
-
-					vProjectorObjs[iProjectorObjIdx].SetPhi(M_PI * -0.4, M_PI * 0.4);
-				}
-			}
-			//else
-			//{
-			//	vProjectorObjs[iProjectorObjIdx].SetTheta(-M_PI / 2.001, M_PI / 2.001);
+bool GPanoSceneUnwrappedFullSphere360Binocular::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		m_config = config;
 
-			//	vProjectorObjs[iProjectorObjIdx].SetPhi(-M_PI / 2.001, M_PI / 2.001);
-			//}
+		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
+		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
+		ptrPlaneSurfaceGenerator->SetSurfaceSize(
+			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedFullSphere360Binocular), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedFullSphere360Binocular));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
+		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -2179,11 +3158,30 @@ bool GPanoSceneUnwrappedFullSphere360Binocular::Create(const GStitcherConfig& co
 	}
 }
 
+bool GPanoSceneUnwrappedFullSphere360Binocular::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360Binocular::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneUnwrappedFullSphere360Binocular::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -2214,6 +3212,43 @@ bool GPanoSceneUnwrappedFullSphere360Binocular::Render(const GTextureGroup& text
 	}
 }
 
+bool GPanoSceneUnwrappedFullSphere360Binocular::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360Binocular::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneUnwrappedFullSphere360Binocular::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneUnwrappedFullSphere360Binocular::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneUnwrappedFullSphere360Binocular::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneUnwrappedFullSphere360Binocular::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneUnwrappedFullSphere360Binocular::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
@@ -2257,38 +3292,51 @@ void GPanoSceneUnwrappedFullSphere360Binocular::Release()
 	}
 }
 
+bool GPanoSceneOriginal::CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+	, std::vector<GProjectorObjectOriginal3d2NormalizedPix>& vProjectorObjs)
+{
+	cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeOriginal, v4fCropRatios);
+	std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
+	{
+		return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
+			&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
+	};
+
+	vProjectorObjs.resize(vCameras.size());
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
+
+		vProjectorObjs[iProjectorObjIdx].SetNumOfCameras(vCameras.size());
+
+		vProjectorObjs[iProjectorObjIdx].SetIndexOfCamera(iProjectorObjIdx);
+
+		vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+	}
+
+	return true;
+}
+
 bool GPanoSceneOriginal::Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	try
 	{
 		m_config = config;
 
-		cv::Rect_<float> panoRect = GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoTypeOriginal, v4fCropRatios);
-		std::function<bool(float, float, float)> panoPixSelector = [panoRect](float fX, float fY, float fZ)
-		{
-			return (fX >= (panoRect.tl().x - FLT_EPSILON)) && (fX <= (panoRect.br().x + FLT_EPSILON))
-				&& (fY >= (panoRect.tl().y - FLT_EPSILON)) && (fY <= (panoRect.br().y + FLT_EPSILON));
-		};
-
 		m_ptrRenderScene = std::shared_ptr<GRenderScene>(new GRenderScene());
 		std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
 		ptrPlaneSurfaceGenerator->SetSurfaceSize(
 			GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeOriginal), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeOriginal));
+		ptrPlaneSurfaceGenerator->SetTessellationLevel(config.m_iTessellationLevel);
 		std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator = ptrPlaneSurfaceGenerator;
 
-		std::vector<GProjectorObjectOriginal3d2NormalizedPix> vProjectorObjs(vCameras.size());
-		for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+		std::vector<GProjectorObjectOriginal3d2NormalizedPix> vProjectorObjs;
+		if (!CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
 		{
-			vProjectorObjs[iProjectorObjIdx].SetCameraIdx(iProjectorObjIdx);
-
-			vProjectorObjs[iProjectorObjIdx].SetNumOfCameras(vCameras.size());
-
-			vProjectorObjs[iProjectorObjIdx].SetIndexOfCamera(iProjectorObjIdx);
-
-			vProjectorObjs[iProjectorObjIdx].SetSelectiveFunctor(panoPixSelector);
+			return false;
 		}
 
-		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs))
+		if (!m_ptrRenderScene->Create(ptrSurfaceGenerator, vProjectorObjs, config))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). create render scene failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -2305,11 +3353,30 @@ bool GPanoSceneOriginal::Create(const GStitcherConfig& config, const std::vector
 	}
 }
 
+bool GPanoSceneOriginal::Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	try
+	{
+		std::vector<GProjectorObjectOriginal3d2NormalizedPix> vProjectorObjs;
+		if ((nullptr == m_ptrRenderScene.get()) || !CreateProjectorObjs(vCameras, sK0Name, v4fCropRatios, vProjectorObjs))
+		{
+			return false;
+		}
+
+		return m_ptrRenderScene->Update(vProjectorObjs);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneOriginal::Update(): exception.";
+		return false;
+	}
+}
+
 bool GPanoSceneOriginal::Prepare()
 {
 	try
 	{
-		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat))
+		if (!m_ptrRenderScene->Prepare(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache))
 		{
 			GLOGGER(error) << "GStitcherOGL::CreateScene(). render scene prepare failed.";
 			GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
@@ -2340,6 +3407,43 @@ bool GPanoSceneOriginal::Render(const GTextureGroup& textureGroup, const glm::ma
 	}
 }
 
+bool GPanoSceneOriginal::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	try
+	{
+		return m_ptrRenderScene->GetVisibleCameras(matP, matV, vVisible);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneOriginal::GetVisibleCameras(): exception.";
+		return false;
+	}
+}
+
+bool GPanoSceneOriginal::GetRenderCounters(GRenderCounters& counters) const
+{
+	try
+	{
+		counters = m_ptrRenderScene->GetRenderCounters();
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GPanoSceneOriginal::GetRenderCounters(): exception.";
+		return false;
+	}
+}
+
+size_t GPanoSceneOriginal::GetMemorySize() const
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->GetMemorySize() : 0;
+}
+
+bool GPanoSceneOriginal::RequestPrograms()
+{
+	return m_ptrRenderScene ? m_ptrRenderScene->RequestPrograms(m_config.m_eInputFrameFormat, m_config.m_ptrProgramCache) : true;
+}
+
 bool GPanoSceneOriginal::Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const
 {
 	try
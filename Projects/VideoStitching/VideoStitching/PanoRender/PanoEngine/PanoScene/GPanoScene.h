@@ -26,6 +26,7 @@
 #define G_PANO_SCENE_H_
 
 #include "PanoRender/GPanoSceneIF.h"
+#include "GProjectorObjects.h"
 
 class GRenderScene;
 
@@ -38,11 +39,19 @@ public:
 
 	virtual ~GPanoSceneImmersionSemiSphere(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -57,11 +66,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedCylinder180(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -76,11 +93,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedCylinder360(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -95,11 +120,19 @@ public:
 
 	virtual ~GPanoSceneImmersionCylinder360(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -114,11 +147,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedCylinderSplited(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -133,11 +174,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedCylinderSplitedFrontBack(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -152,11 +201,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedSphere180(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -171,11 +228,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedSphere360(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -190,11 +255,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedSphere360Flip(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -209,11 +282,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedCylinder180Flip(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -228,11 +309,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedCylinder360Flip(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -247,11 +336,19 @@ public:
 
 	virtual ~GPanoSceneImmersionFullSphere(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -266,11 +363,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedFullSphere360(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -285,11 +390,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedFullSphere360Flip(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -304,11 +417,19 @@ public:
 
 	virtual ~GPanoSceneUnwrappedFullSphere360Binocular(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -323,11 +444,19 @@ public:
 
 	virtual ~GPanoSceneOriginal(){};
 	virtual bool Create(const GStitcherConfig& config, const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+	virtual bool Update(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 	virtual bool Prepare();
 	virtual bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
+	virtual bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+	virtual bool GetRenderCounters(GRenderCounters& counters) const;
+	virtual size_t GetMemorySize() const;
+	virtual bool RequestPrograms();
 	virtual bool Project(const Eigen::Vector3f& v3fPhysical3DPoint, Eigen::Vector3f& v3fScene3DPointf) const;
 	virtual bool UnProject(const Eigen::Vector3f& v3fScene3DPointf, Eigen::Vector3f& v3fPhysical3DPoint) const;
 	virtual void Release();
+private:
+	bool CreateProjectorObjs(const std::vector<CameraModel>& vCameras, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios
+		, std::vector<GProjectorObjectOriginal3d2NormalizedPix>& vProjectorObjs);
 private:
 	GStitcherConfig m_config;
 	std::shared_ptr<GRenderScene> m_ptrRenderScene;
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#include "GProgramBinaryCache.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "GCacheFile.h"
+#include "GGlobalParametersManager.h"
+#include "Common/GiraffeLogger/GiraffeLogger.h"
+
+static const char s_szFileMagic[4] = { 'G', 'P', 'R', 'G' };
+static const char s_szFileEndMagic[4] = { 'G', 'E', 'N', 'D' };
+static const char* s_szFilePrefix = "program_";
+static const char* s_szFileExtension = ".bin";
+//upper bound of a program binary read from a file.
+static const uint64_t s_ullMaxBinaryLength = 64ULL << 20;
+
+bool GProgramBinaryCache::IsSupported()
+{
+#if (defined __APPLE__) || (defined __ANDROID__)
+	return false;
+#else
+	if (!GLEW_ARB_get_program_binary && !opengl_compatible(4, 1))
+	{
+		return false;
+	}
+
+	GLint iFormatNum = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &iFormatNum);
+	return (0 < iFormatNum);
+#endif //(defined __APPLE__) || (defined __ANDROID__)
+}
+
+std::string GProgramBinaryCache::CreateKey(const std::string& sVertexShaderCode, const std::string& sFragShaderCode
+	, const std::vector<std::string>& vAttributeNames)
+{
+	std::ostringstream ossSources;
+	ossSources << sVertexShaderCode << '\0' << sFragShaderCode << '\0';
+	for (int i = 0; i < vAttributeNames.size(); ++i)
+	{
+		ossSources << vAttributeNames[i] << '\0';
+	}
+
+	GGlobalParametersManager* pParametersManager = GGlobalParametersManager::GetInstance();
+	std::ostringstream oss;
+	oss << "sources:" << GCacheFile::FormatHash(GCacheFile::CalcHash(ossSources.str()))
+		<< ";vendor:" << pParametersManager->GetParamString(eGGlobalParamStringGLVendor)
+		<< ";renderer:" << pParametersManager->GetParamString(eGGlobalParamStringGLRenderer)
+		<< ";version:" << pParametersManager->GetParamString(eGGlobalParamStringGLVersion);
+	return oss.str();
+}
+
+std::string GProgramBinaryCache::GetFilePath(const std::string& sDirectory, const std::string& sKey)
+{
+	return GCacheFile::GetFilePath(sDirectory, s_szFilePrefix, sKey, s_szFileExtension);
+}
+
+bool GProgramBinaryCache::Load(const std::string& sFilePath, const std::string& sKey, GLuint& uiProgram)
+{
+	try
+	{
+		std::ifstream ifs(sFilePath, std::ios::binary);
+		if (!ifs.good())
+		{
+			return false;
+		}
+
+		char szMagic[4] = { 0 };
+		unsigned int uiVersion = 0;
+		if (!ifs.read(szMagic, sizeof(szMagic)) || (0 != memcmp(szMagic, s_szFileMagic, sizeof(szMagic))) ||
+			!GCacheFile::ReadValue(ifs, uiVersion) || (s_uiVersion != uiVersion))
+		{
+			GLOGGER(info) << "GProgramBinaryCache::Load(). " << sFilePath << " is of another version. ==>";
+			return false;
+		}
+
+		//another driver, or a different key with the same hash.
+		std::vector<char> vKey;
+		if (!GCacheFile::ReadVector(ifs, vKey, sKey.size()) || (vKey.size() != sKey.size()) || !std::equal(vKey.begin(), vKey.end(), sKey.begin()))
+		{
+			GLOGGER(info) << "GProgramBinaryCache::Load(). " << sFilePath << " belongs to another program or driver. ==>";
+			return false;
+		}
+
+		GLenum eFormat = 0;
+		std::vector<char> vBinary;
+		char szEndMagic[4] = { 0 };
+		bool bRet = GCacheFile::ReadValue(ifs, eFormat) && GCacheFile::ReadVector(ifs, vBinary, s_ullMaxBinaryLength) && !vBinary.empty()
+			&& ifs.read(szEndMagic, sizeof(szEndMagic)) && (0 == memcmp(szEndMagic, s_szFileEndMagic, sizeof(szEndMagic)));
+		ifs.close();
+		if (!bRet)
+		{
+			GLOGGER(error) << "GProgramBinaryCache::Load(). " << sFilePath << " is broken, removed. ==>";
+			std::remove(sFilePath.c_str());
+			return false;
+		}
+
+		GLuint uiLoadedProgram = glCreateProgram();
+		glProgramBinary(uiLoadedProgram, eFormat, vBinary.data(), static_cast<GLsizei>(vBinary.size()));
+
+		//a driver update keeping the version string may still reject the binary.
+		GLint iResult = GL_FALSE;
+		glGetProgramiv(uiLoadedProgram, GL_LINK_STATUS, &iResult);
+		if (GL_FALSE == iResult)
+		{
+			GLOGGER(info) << "GProgramBinaryCache::Load(). " << sFilePath << " is rejected by the driver, removed. ==>";
+			glDeleteProgram(uiLoadedProgram);
+			std::remove(sFilePath.c_str());
+			return false;
+		}
+
+		uiProgram = uiLoadedProgram;
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GProgramBinaryCache::Load(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GProgramBinaryCache::Save(const std::string& sFilePath, const std::string& sKey, GLuint uiProgram)
+{
+	try
+	{
+		GLint iLength = 0;
+		glGetProgramiv(uiProgram, GL_PROGRAM_BINARY_LENGTH, &iLength);
+		if (iLength <= 0)
+		{
+			GLOGGER(error) << "GProgramBinaryCache::Save(). No binary of program " << uiProgram << ". ==>";
+			return false;
+		}
+
+		GLenum eFormat = 0;
+		GLsizei iWritten = 0;
+		std::vector<char> vBinary(iLength);
+		glGetProgramBinary(uiProgram, iLength, &iWritten, &eFormat, vBinary.data());
+		if (iWritten <= 0)
+		{
+			GLOGGER(error) << "GProgramBinaryCache::Save(). Get the binary of program " << uiProgram << " FAILED. ==>";
+			return false;
+		}
+
+		vBinary.resize(iWritten);
+		return GCacheFile::Write(sFilePath, [&](std::ostream& os)
+		{
+			os.write(s_szFileMagic, sizeof(s_szFileMagic));
+			GCacheFile::WriteValue(os, static_cast<unsigned int>(s_uiVersion));
+			GCacheFile::WriteString(os, sKey);
+			GCacheFile::WriteValue(os, eFormat);
+			GCacheFile::WriteVector(os, vBinary);
+			os.write(s_szFileEndMagic, sizeof(s_szFileEndMagic));
+		});
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GProgramBinaryCache::Save(). EXCEPTION. ==>";
+		return false;
+	}
+}
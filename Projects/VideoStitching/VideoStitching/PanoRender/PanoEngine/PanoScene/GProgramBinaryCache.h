@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#ifndef G_PROGRAM_BINARY_CACHE_H_
+#define G_PROGRAM_BINARY_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "GGLHeaders.h"
+
+//linked programs stored in a local directory through glGetProgramBinary(), one file per program.
+//the key of a file is a hash of the shader sources and the driver strings of GGlobalParametersManager, a binary of another
+//driver is never handed to glProgramBinary(). a binary the driver rejects anyway is removed, the program is compiled then.
+class GProgramBinaryCache
+{
+public:
+	//bump whenever the file layout changes, files of other versions are compiled again.
+	static const unsigned int s_uiVersion = 1;
+
+	//render thread. ARB_get_program_binary with at least one binary format.
+	static bool IsSupported();
+
+	//render thread, after GGlobalParametersManager::Init().
+	static std::string CreateKey(const std::string& sVertexShaderCode, const std::string& sFragShaderCode
+		, const std::vector<std::string>& vAttributeNames);
+
+	static std::string GetFilePath(const std::string& sDirectory, const std::string& sKey);
+
+	//render thread. uiProgram is a new linked program on success, nothing is created otherwise.
+	//false if the file is missing, of another version or key, broken or rejected by the driver. such a file is removed.
+	static bool Load(const std::string& sFilePath, const std::string& sKey, GLuint& uiProgram);
+
+	//render thread. uiProgram must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT.
+	//written to a temporary file first, a concurrent reader never sees a partial file.
+	static bool Save(const std::string& sFilePath, const std::string& sKey, GLuint uiProgram);
+};
+
+#endif//!G_PROGRAM_BINARY_CACHE_H_
@@ -24,73 +24,190 @@
  
 #include "GRenderScene.h"
 
+#include <thread>
+#include <algorithm>
+#include <exception>
+#include <chrono>
+#include <climits>
+#include <set>
+
 #include "GProjectorObjects.h"
 #include "GGLSLProgramGenerator.h"
 #include "GGlobalParametersManager.h"
+#include "GSceneCache.h"
 #include "Common/GiraffeLogger/GiraffeLogger.h"
 
 
+//fewer items are not worth a thread.
+static const int s_iMinItemsPerThread = 4096;
+//small enough to cull most of a patch in a narrow view, large enough to keep the runs of a patch few.
+static const int s_iClusterTriangleNum = 256;
+//cameras blended at a pixel of a remap table, the ones of the smallest weights are dropped beyond.
+static const int s_iMaxRemapLayerNum = 4;
+
 template<class tProjectorObject>
 void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<tProjectorObject>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches)
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches
+	, int iThreadNum)
 {
 	assert(0 == vVerticeIndices.size() % 3);
 
 	mpPatches.clear();
 
-	for (int i = 0; i < vVerticeIndices.size() / 3; ++i)
+	if (iThreadNum <= 0)
 	{
-		std::bitset<MAX_PATCHES_NUM> bsTexture;
-		bsTexture.reset();
+		iThreadNum = std::thread::hardware_concurrency();
+	}
 
-		tVertex u1 = vVertices[vVerticeIndices[3 * i]];
-		tVertex u2 = vVertices[vVerticeIndices[3 * i + 1]];
-		tVertex u3 = vVertices[vVerticeIndices[3 * i + 2]];
+	try
+	{
+		//project every vertex only once per camera, the triangles sharing it read the same projection.
+		int iVertexNum = vVertices.size();
+		int iCameraNum = vProjectorObjs.size();
+		std::vector<tVertexProjection> vProjections((size_t)iVertexNum * iCameraNum);
+		RunInRanges(iVertexNum, CalcRangeNum(iVertexNum, iThreadNum)
+			, [&vVertices, &vProjectorObjs, &vProjections, iCameraNum](int iRangeIdx, int iBegin, int iEnd)
+		{
+			for (int iVertexIdx = iBegin; iVertexIdx < iEnd; ++iVertexIdx)
+			{
+				cv::Point3f ptVertex(vVertices[iVertexIdx].x, vVertices[iVertexIdx].y, vVertices[iVertexIdx].z);
+				for (int iCameraIdx = 0; iCameraIdx < iCameraNum; ++iCameraIdx)
+				{
+					vProjections[(size_t)iVertexIdx * iCameraNum + iCameraIdx] = ProjectVertex(vProjectorObjs[iCameraIdx](ptVertex));
+				}
+			}
+		});
 
-		float fTotalWeight1 = 0.0f;
-		float fTotalWeight2 = 0.0f;
-		float fTotalWeight3 = 0.0f;
+		std::vector<int> vCameraIndices(iCameraNum);
+		for (int iCameraIdx = 0; iCameraIdx < iCameraNum; ++iCameraIdx)
+		{
+			vCameraIndices[iCameraIdx] = vProjectorObjs[iCameraIdx].GetCameraIdx();
+		}
 
-		std::vector<tTextureCoordinate> vTextureSrcPoints(vProjectorObjs.size() * 3);
+		//the first range is generated into mpPatches.
+		int iTriangleNum = vVerticeIndices.size() / 3;
+		int iRangeNum = CalcRangeNum(iTriangleNum, iThreadNum);
+		std::vector<std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>> vPartialPatches(iRangeNum - 1);
+		std::vector<tPatchVertexMaps> vPatchVertexMaps(iRangeNum);
+		RunInRanges(iTriangleNum, iRangeNum
+			, [&vVertices, &vVerticeIndices, &vProjections, &vCameraIndices, &mpPatches, &vPartialPatches, &vPatchVertexMaps](int iRangeIdx, int iBegin, int iEnd)
+		{
+			GeneratePatchesOfTriangles(vVertices, vVerticeIndices, vProjections, vCameraIndices, iBegin, iEnd
+				, (0 == iRangeIdx) ? mpPatches : vPartialPatches[iRangeIdx - 1], vPatchVertexMaps[iRangeIdx]);
+		});
 
-		for (int j = 0; j < vProjectorObjs.size(); ++j)
+		//merge in range order, every patch then holds its vertices and triangles in the same order as a single threaded run.
+		for (int iPartIdx = 0; iPartIdx < vPartialPatches.size(); ++iPartIdx)
 		{
-			cv::Point3f ptRet1;
-			cv::Point3f ptRet2;
-			cv::Point3f ptRet3;
+			MergePatches(vPartialPatches[iPartIdx], vPatchVertexMaps[iPartIdx + 1], mpPatches, vPatchVertexMaps[0]);
+		}
+	}
+	catch (...)
+	{
+		mpPatches.clear();
+		throw;
+	}
+}
+
+GPatchesGenerator::tVertexProjection GPatchesGenerator::ProjectVertex(const cv::Point3f& ptProjected)
+{
+	tVertexProjection ret;
+	ret.bInside = 0.0f < ptProjected.x && 0.0f < ptProjected.y && ptProjected.x < 1.0f && ptProjected.y < 1.0f;
+	ret.u = (ptProjected.x != ptProjected.x) ? FLT_MAX : ptProjected.x;
+	ret.v = (ptProjected.y != ptProjected.y) ? FLT_MAX : ptProjected.y;
+
+	float fBlenderStrength = 20.0f;
+	ret.weight = (ret.bInside) ? powf(ptProjected.z, fBlenderStrength) : (0.0f);
+	return ret;
+}
+
+int GPatchesGenerator::CalcRangeNum(int iItemNum, int iThreadNum)
+{
+	int iRangeNum = std::min(iThreadNum, iItemNum / s_iMinItemsPerThread);
+	return (iRangeNum < 1) ? 1 : iRangeNum;
+}
 
-			ptRet1 = vProjectorObjs[j](cv::Point3f(u1.x, u1.y, u1.z));
-			ptRet2 = vProjectorObjs[j](cv::Point3f(u2.x, u2.y, u2.z));
-			ptRet3 = vProjectorObjs[j](cv::Point3f(u3.x, u3.y, u3.z));
+void GPatchesGenerator::RunInRanges(int iItemNum, int iRangeNum, const std::function<void(int iRangeIdx, int iBegin, int iEnd)>& fnRunRange)
+{
+	if (iRangeNum <= 1)
+	{
+		fnRunRange(0, 0, iItemNum);
+		return;
+	}
 
-			int vFlags[3] = { 0.0f < ptRet1.x && 0.0f < ptRet1.y && ptRet1.x < 1.0f && ptRet1.y < 1.0f
-				, 0.0f < ptRet2.x && 0.0f < ptRet2.y && ptRet2.x < 1.0f && ptRet2.y < 1.0f
-				, 0.0f < ptRet3.x && 0.0f < ptRet3.y && ptRet3.x < 1.0f && ptRet3.y < 1.0f };
-			if (vFlags[0] || vFlags[1] || vFlags[2])
+	//the first range runs on the calling thread.
+	//exceptions are rethrown on the calling thread once every worker has been joined.
+	std::vector<std::exception_ptr> vExceptions(iRangeNum);
+	std::vector<std::thread> vThreads;
+	vThreads.reserve(iRangeNum - 1);
+	for (int iRangeIdx = 1; iRangeIdx < iRangeNum; ++iRangeIdx)
+	{
+		int iBegin = (long long)iItemNum * iRangeIdx / iRangeNum;
+		int iEnd = (long long)iItemNum * (iRangeIdx + 1) / iRangeNum;
+		std::exception_ptr& ptrException = vExceptions[iRangeIdx];
+		vThreads.push_back(std::thread([&fnRunRange, iRangeIdx, iBegin, iEnd, &ptrException]()
+		{
+			try
 			{
-				assert(j < MAX_PATCHES_NUM);//todo.
-				bsTexture.set(j);
+				fnRunRange(iRangeIdx, iBegin, iEnd);
+			}
+			catch (...)
+			{
+				ptrException = std::current_exception();
+			}
+		}));
+	}
+
+	try
+	{
+		fnRunRange(0, 0, iItemNum / iRangeNum);
+	}
+	catch (...)
+	{
+		vExceptions[0] = std::current_exception();
+	}
+
+	for (int iThreadIdx = 0; iThreadIdx < vThreads.size(); ++iThreadIdx)
+	{
+		vThreads[iThreadIdx].join();
+	}
+
+	for (int iRangeIdx = 0; iRangeIdx < vExceptions.size(); ++iRangeIdx)
+	{
+		if (vExceptions[iRangeIdx])
+		{
+			std::rethrow_exception(vExceptions[iRangeIdx]);
+		}
+	}
+}
+
+void GPatchesGenerator::GeneratePatchesOfTriangles(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
+	, const std::vector<tVertexProjection>& vProjections, const std::vector<int>& vCameraIndices, int iTriangleBegin, int iTriangleEnd
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, tPatchVertexMaps& mpPatchVertexMaps)
+{
+	int iCameraNum = vCameraIndices.size();
+	for (int i = iTriangleBegin; i < iTriangleEnd; ++i)
+	{
+		std::bitset<MAX_PATCHES_NUM> bsTexture;
+		bsTexture.reset();
 
-				ptRet1.x = (ptRet1.x != ptRet1.x) ? FLT_MAX : ptRet1.x;
-				ptRet1.y = (ptRet1.y != ptRet1.y) ? FLT_MAX : ptRet1.y;
-				ptRet2.x = (ptRet2.x != ptRet2.x) ? FLT_MAX : ptRet2.x;
-				ptRet2.y = (ptRet2.y != ptRet2.y) ? FLT_MAX : ptRet2.y;
-				ptRet3.x = (ptRet3.x != ptRet3.x) ? FLT_MAX : ptRet3.x;
-				ptRet3.y = (ptRet3.y != ptRet3.y) ? FLT_MAX : ptRet3.y;
+		const tVertexProjection* vpProjections[3] = { &vProjections[(size_t)vVerticeIndices[3 * i] * iCameraNum]
+			, &vProjections[(size_t)vVerticeIndices[3 * i + 1] * iCameraNum]
+			, &vProjections[(size_t)vVerticeIndices[3 * i + 2] * iCameraNum] };
 
-				float fBlenderStrength = 20.0f;
-				float fWeight1 = (vFlags[0]) ? powf(ptRet1.z, fBlenderStrength) : (0.0f);
-				float fWeight2 = (vFlags[1]) ? powf(ptRet2.z, fBlenderStrength) : (0.0f);
-				float fWeight3 = (vFlags[2]) ? powf(ptRet3.z, fBlenderStrength) : (0.0f);
+		float vTotalWeights[3] = { 0.0f, 0.0f, 0.0f };
 
-				vTextureSrcPoints[3 * j] = tTextureCoordinate(ptRet1.x, ptRet1.y, fWeight1);
-				vTextureSrcPoints[3 * j + 1] = tTextureCoordinate(ptRet2.x, ptRet2.y, fWeight2);
-				vTextureSrcPoints[3 * j + 2] = tTextureCoordinate(ptRet3.x, ptRet3.y, fWeight3);
+		for (int j = 0; j < iCameraNum; ++j)
+		{
+			if (vpProjections[0][j].bInside || vpProjections[1][j].bInside || vpProjections[2][j].bInside)
+			{
+				assert(j < MAX_PATCHES_NUM);//todo.
+				bsTexture.set(j);
 
-				fTotalWeight1 += fWeight1;
-				fTotalWeight2 += fWeight2;
-				fTotalWeight3 += fWeight3;
+				vTotalWeights[0] += vpProjections[0][j].weight;
+				vTotalWeights[1] += vpProjections[1][j].weight;
+				vTotalWeights[2] += vpProjections[2][j].weight;
 
 				//check max texture units.
 				if (bsTexture.count() >= MAX_PATCHES_NUM)
@@ -100,66 +217,121 @@ void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, c
 			}
 		}
 		GScenePatch& patch = mpPatches[bsTexture];
-		patch.vVertices.push_back(u1);
-		patch.vVertices.push_back(u2);
-		patch.vVertices.push_back(u3);
-		patch.vVerticeIndices.push_back(patch.vVertices.size() - 3);
-		patch.vVerticeIndices.push_back(patch.vVertices.size() - 2);
-		patch.vVerticeIndices.push_back(patch.vVertices.size() - 1);
+		tPatchVertexMap& patchVertexMap = mpPatchVertexMaps[bsTexture];
 
 		if (patch.vMultiTextureCoordinates.empty())
 		{
 			patch.vMultiTextureCoordinates.resize(bsTexture.count());
+			int iTextureIdx = 0;
+			for (int k = 0; k < bsTexture.size(); ++k)
+			{
+				if (bsTexture[k])
+				{
+					patch.vMultiTextureCoordinates[iTextureIdx].first = vCameraIndices[k];
+					++iTextureIdx;
+				}
+			}
 		}
 
-		int iTextureIdx = 0;
-		for (int k = 0; k < bsTexture.size(); ++k)
+		//the blending weights of a vertex only depend on the cameras of the patch, so a vertex is shared by all the triangles of a patch.
+		for (int iCornerIdx = 0; iCornerIdx < 3; ++iCornerIdx)
 		{
-			if (bsTexture[k])
+			GLuint uiVertexIdx = vVerticeIndices[3 * i + iCornerIdx];
+			auto ret = patchVertexMap.mpPatchVertexIndices.insert(std::make_pair(uiVertexIdx, (GLuint)patch.vVertices.size()));
+			if (ret.second)
 			{
-				tTextureCoordinate textureCoordinate1 = vTextureSrcPoints[k * 3];
-				tTextureCoordinate textureCoordinate2 = vTextureSrcPoints[k * 3 + 1];
-				tTextureCoordinate textureCoordinate3 = vTextureSrcPoints[k * 3 + 2];
+				patchVertexMap.vSurfaceVertexIndices.push_back(uiVertexIdx);
+				patch.vVertices.push_back(vVertices[uiVertexIdx]);
 
-				textureCoordinate1.weight = (fTotalWeight1 == 0) ? 0.0f : textureCoordinate1.weight / fTotalWeight1;
-				textureCoordinate2.weight = (fTotalWeight2 == 0) ? 0.0f : textureCoordinate2.weight / fTotalWeight2;
-				textureCoordinate3.weight = (fTotalWeight3 == 0) ? 0.0f : textureCoordinate3.weight / fTotalWeight3;
-
-				patch.vMultiTextureCoordinates[iTextureIdx].first = vProjectorObjs[k].GetCameraIdx();
-				patch.vMultiTextureCoordinates[iTextureIdx].second.push_back(textureCoordinate1);
-				patch.vMultiTextureCoordinates[iTextureIdx].second.push_back(textureCoordinate2);
-				patch.vMultiTextureCoordinates[iTextureIdx].second.push_back(textureCoordinate3);
-
-				++iTextureIdx;
+				const tVertexProjection* pProjections = vpProjections[iCornerIdx];
+				float fTotalWeight = vTotalWeights[iCornerIdx];
+				int iTextureIdx = 0;
+				for (int k = 0; k < bsTexture.size(); ++k)
+				{
+					if (bsTexture[k])
+					{
+						patch.vMultiTextureCoordinates[iTextureIdx].second.push_back(tTextureCoordinate(pProjections[k].u, pProjections[k].v
+							, (fTotalWeight == 0) ? 0.0f : pProjections[k].weight / fTotalWeight));
+						++iTextureIdx;
+					}
+				}
 			}
+			patch.vVerticeIndices.push_back(ret.first->second);
 		}
 	}
 }
 
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
 template void GPatchesGenerator::GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 	, const std::vector<GProjectorObjectOriginal3d2NormalizedPix>& vProjectorObjs
-	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, int iThreadNum);
+
+void GPatchesGenerator::MergePatches(std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpSrcPatches, tPatchVertexMaps& mpSrcPatchVertexMaps
+	, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpDstPatches, tPatchVertexMaps& mpDstPatchVertexMaps)
+{
+	for (auto itSrc = mpSrcPatches.begin(); itSrc != mpSrcPatches.end(); ++itSrc)
+	{
+		GScenePatch& srcPatch = itSrc->second;
+		tPatchVertexMap& srcPatchVertexMap = mpSrcPatchVertexMaps[itSrc->first];
+		GScenePatch& dstPatch = mpDstPatches[itSrc->first];
+		tPatchVertexMap& dstPatchVertexMap = mpDstPatchVertexMaps[itSrc->first];
+		if (dstPatch.vVertices.empty())
+		{
+			std::swap(dstPatch, srcPatch);
+			std::swap(dstPatchVertexMap, srcPatchVertexMap);
+			continue;
+		}
+
+		//same key, so the same cameras in the same order.
+		assert(dstPatch.vMultiTextureCoordinates.size() == srcPatch.vMultiTextureCoordinates.size());
+
+		//vertices already in the destination patch are shared, the others are appended in their source order.
+		std::vector<GLuint> vSrc2DstIndices(srcPatch.vVertices.size());
+		for (int iSrcVertexIdx = 0; iSrcVertexIdx < srcPatch.vVertices.size(); ++iSrcVertexIdx)
+		{
+			GLuint uiSurfaceVertexIdx = srcPatchVertexMap.vSurfaceVertexIndices[iSrcVertexIdx];
+			auto ret = dstPatchVertexMap.mpPatchVertexIndices.insert(std::make_pair(uiSurfaceVertexIdx, (GLuint)dstPatch.vVertices.size()));
+			if (ret.second)
+			{
+				dstPatchVertexMap.vSurfaceVertexIndices.push_back(uiSurfaceVertexIdx);
+				dstPatch.vVertices.push_back(srcPatch.vVertices[iSrcVertexIdx]);
+				for (int iTextureIdx = 0; iTextureIdx < srcPatch.vMultiTextureCoordinates.size(); ++iTextureIdx)
+				{
+					dstPatch.vMultiTextureCoordinates[iTextureIdx].second.push_back(srcPatch.vMultiTextureCoordinates[iTextureIdx].second[iSrcVertexIdx]);
+				}
+			}
+			vSrc2DstIndices[iSrcVertexIdx] = ret.first->second;
+		}
+
+		dstPatch.vVerticeIndices.reserve(dstPatch.vVerticeIndices.size() + srcPatch.vVerticeIndices.size());
+		for (int iIdx = 0; iIdx < srcPatch.vVerticeIndices.size(); ++iIdx)
+		{
+			dstPatch.vVerticeIndices.push_back(vSrc2DstIndices[srcPatch.vVerticeIndices[iIdx]]);
+		}
+	}
+	mpSrcPatches.clear();
+	mpSrcPatchVertexMaps.clear();
+}
 
 float GPatchesGenerator::CalcWeight(const cv::Point2f& ptPosition, const cv::Mat& mK, float fDistortionValidRange)
 {
@@ -185,29 +357,64 @@ float GPatchesGenerator::CalcWeight(const cv::Point2f& ptPosition, const cv::Mat
 	return (fRet <= 0.0) ? 0.0 : pow(fRet, 5.0);
 }
 
-void GScenePatch::SetUpVertexAttributes()
+void GScenePatchBatch::SetUpVertexAttributes(const std::vector<const GScenePatch*>& vPatches)
 {
-	m_vVBOs.resize(2 + vMultiTextureCoordinates.size());
+	//the patches are appended to the shared buffers, the indices of a patch are offset by the vertices before it.
+	std::vector<tVertex> vVertices;
+	std::vector<GLuint> vVerticeIndices;
+	std::vector<std::vector<tTextureCoordinate>> vLayerTextureCoordinates(m_iLayerNum);
+	for (int iPatchIdx = 0; iPatchIdx < vPatches.size(); ++iPatchIdx)
+	{
+		const GScenePatch& patch = *(vPatches[iPatchIdx]);
+
+		tPatchRange range;
+		range.pPatch = vPatches[iPatchIdx];
+		range.iIndexNum = static_cast<GLsizei>(patch.vVerticeIndices.size());
+		range.ullIndexOffset_Byte = sizeof(GLuint) * vVerticeIndices.size();
+		for (int i = 0; i < m_iLayerNum; ++i)
+		{
+			range.vCameraIndices.push_back(patch.vMultiTextureCoordinates[i].first);
+		}
+		m_vPatchRanges.push_back(range);
+
+		GLuint uiBaseVertex = static_cast<GLuint>(vVertices.size());
+		for (int i = 0; i < patch.vVerticeIndices.size(); ++i)
+		{
+			vVerticeIndices.push_back(uiBaseVertex + patch.vVerticeIndices[i]);
+		}
+		vVertices.insert(vVertices.end(), patch.vVertices.begin(), patch.vVertices.end());
+		for (int i = 0; i < m_iLayerNum; ++i)
+		{
+			vLayerTextureCoordinates[i].insert(vLayerTextureCoordinates[i].end()
+				, patch.vMultiTextureCoordinates[i].second.begin(), patch.vMultiTextureCoordinates[i].second.end());
+		}
+	}
+
+	m_vVBOs.resize(2 + m_iLayerNum);
 	glGenBuffers(m_vVBOs.size(), &m_vVBOs[0]);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_vVBOs[eVBOTypeVertices]);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(tVertex)*vVertices.size(), &(vVertices[0]), GL_STATIC_DRAW);
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)(nullptr));
 
-	for (int i = 0; i < vMultiTextureCoordinates.size(); ++i)
+	for (int i = 0; i < m_iLayerNum; ++i)
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, m_vVBOs[eVBOTypeTexture + i]);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(tTextureCoordinate)*vMultiTextureCoordinates[i].second.size(), &(vMultiTextureCoordinates[i].second[0]), GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(tTextureCoordinate)*vLayerTextureCoordinates[i].size(), &(vLayerTextureCoordinates[i][0]), GL_STATIC_DRAW);
 		glVertexAttribPointer(1 + i, 3, GL_FLOAT, GL_FALSE, 0, (void*)(nullptr));
 	}
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vVBOs[eVBOTypeIndices]);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint)*vVerticeIndices.size(), &(vVerticeIndices[0]), GL_STATIC_DRAW);
+
+	m_ullBufferSize_Byte = sizeof(tVertex)*vVertices.size() + sizeof(GLuint)*vVerticeIndices.size()
+		+ m_iLayerNum * sizeof(tTextureCoordinate)*vVertices.size();
 }
 
-bool GScenePatch::Prepare(enFrameFormat eFrameFormat)
+bool GScenePatchBatch::Prepare(int iLayerNum, const std::vector<const GScenePatch*>& vPatches, enFrameFormat eFrameFormat
+	, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache)
 {
-	if (vMultiTextureCoordinates.empty())
+	if ((iLayerNum <= 0) || vPatches.empty())
 	{
 		return true;
 	}
@@ -216,42 +423,68 @@ bool GScenePatch::Prepare(enFrameFormat eFrameFormat)
 	if (eFrameFormatRGB == eFrameFormat)
 	{
 		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeNormal;
+		m_iPlaneNum = 1;
 	}
 	else if (eFrameFormatYUV420P == eFrameFormat)
 	{
 		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeYUV;
+		m_iPlaneNum = 3;
 	}
 	else if (eFrameFormatNV12 == eFrameFormat)
 	{
 		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeNV12;
+		m_iPlaneNum = 2;
 	}
 	else
 	{
-		GLOGGER(error) << "GScenePatch::Prepare(). frame format not supported: " << eFrameFormat;
+		GLOGGER(error) << "GScenePatchBatch::Prepare(). frame format not supported: " << eFrameFormat;
 		return false;
 	}
 
-	if (!GGLSLBlenderGenerator::GetProgram(GGLSLBlenderGenerator::eGVertexShaderTypeNormal, eFragShaderType
-		, GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMajorVersion) * 100 + GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMinorVersion)
-		, vMultiTextureCoordinates.size(), m_uiBlender))
+	m_iLayerNum = iLayerNum;
+	int iGLSLVersion = GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMajorVersion) * 100
+		+ GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMinorVersion);
+	m_ptrProgramCache = ptrProgramCache;
+	bool bProgram = (nullptr != m_ptrProgramCache) ?
+		m_ptrProgramCache->GetProgram(GGLSLBlenderGenerator::eGVertexShaderTypeNormal, eFragShaderType, iGLSLVersion, m_iLayerNum, m_uiBlender)
+		: GGLSLBlenderGenerator::GetProgram(GGLSLBlenderGenerator::eGVertexShaderTypeNormal, eFragShaderType, iGLSLVersion, m_iLayerNum, m_uiBlender);
+	if (!bProgram)
 	{
-		GLOGGER(error) << "GScenePatch::Prepare(). prepare failed.";
+		GLOGGER(error) << "GScenePatchBatch::Prepare(). prepare failed.";
 		return false;
 	}
+	m_iMVPLocation = glGetUniformLocation(m_uiBlender, "MVP");
+
+	//the samplers of a layer always read the same texture units, only the textures bound to them change.
+	//a shared program gets the same units from every batch of iLayerNum cameras.
+	glUseProgram(m_uiBlender);
+	for (int iLayerIdx = 0; iLayerIdx < m_iLayerNum; ++iLayerIdx)
+	{
+		for (int iPlaneIdx = 0; iPlaneIdx < m_iPlaneNum; ++iPlaneIdx)
+		{
+			std::string sTextureSampler = "textureSampler" + std::to_string(iLayerIdx);
+			if (1 < m_iPlaneNum)
+			{
+				sTextureSampler += std::to_string(iPlaneIdx);
+			}
+			glUniform1i(glGetUniformLocation(m_uiBlender, sTextureSampler.c_str()), iLayerIdx * m_iPlaneNum + iPlaneIdx);
+		}
+	}
+	glUseProgram(0);
 
 	if (opengl_compatible(3, 0))
 	{
 		glGenVertexArrays(1, &m_uiVAO);
 		glBindVertexArray(m_uiVAO);
-	}
 
-	glEnableVertexAttribArray(0);
-	for (int i = 0; i < vMultiTextureCoordinates.size(); ++i)
-	{
-		glEnableVertexAttribArray(1 + i);
+		glEnableVertexAttribArray(0);
+		for (int i = 0; i < m_iLayerNum; ++i)
+		{
+			glEnableVertexAttribArray(1 + i);
+		}
 	}
 
-	SetUpVertexAttributes();
+	SetUpVertexAttributes(vPatches);
 
 	if (opengl_compatible(3, 0))
 	{
@@ -261,116 +494,167 @@ bool GScenePatch::Prepare(enFrameFormat eFrameFormat)
 	return true;
 }
 
-bool GScenePatch::Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV)
+void GScenePatchBatch::UpdateTextureCoordinates()
 {
-	if (vMultiTextureCoordinates.empty())
+	if (m_vPatchRanges.empty())
 	{
-		return true;
+		return;
 	}
 
-	glUseProgram(m_uiBlender);
-
-	glm::mat4 glmMVP = matP * matV * glm::mat4();
-	GLuint uiMatrixID = glGetUniformLocation(m_uiBlender, "MVP");
-	glUniformMatrix4fv(uiMatrixID, 1, GL_FALSE, &glmMVP[0][0]);
-
-	if (eFrameFormatRGB == textureGroup.eTextureFormat)
+	//same layout as SetUpVertexAttributes(), the buffers are overwritten in place.
+	std::vector<tTextureCoordinate> vTextureCoordinates;
+	for (int i = 0; i < m_iLayerNum; ++i)
 	{
-		for (int iOverlapLayerIdx = 0; iOverlapLayerIdx < vMultiTextureCoordinates.size(); ++iOverlapLayerIdx)
+		vTextureCoordinates.clear();
+		for (int iRangeIdx = 0; iRangeIdx < m_vPatchRanges.size(); ++iRangeIdx)
 		{
-			std::string sTextureSampler = "textureSampler" + std::to_string(iOverlapLayerIdx);
-			GLuint TextureID = glGetUniformLocation(m_uiBlender, sTextureSampler.c_str());
+			const std::vector<tTextureCoordinate>& vPatchTextureCoordinates = m_vPatchRanges[iRangeIdx].pPatch->vMultiTextureCoordinates[i].second;
+			vTextureCoordinates.insert(vTextureCoordinates.end(), vPatchTextureCoordinates.begin(), vPatchTextureCoordinates.end());
+		}
 
-			int iCameraIndex = vMultiTextureCoordinates[iOverlapLayerIdx].first;
-			glActiveTexture(GL_TEXTURE0 + iOverlapLayerIdx);
-			glBindTexture(GL_TEXTURE_2D, textureGroup.vTextureGroup[iCameraIndex]);
-			//glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_BLEND);
+		glBindBuffer(GL_ARRAY_BUFFER, m_vVBOs[eVBOTypeTexture + i]);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(tTextureCoordinate)*vTextureCoordinates.size(), &(vTextureCoordinates[0]));
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-			glUniform1i(TextureID, iOverlapLayerIdx);
-		}
+void GScenePatchBatch::BindVertexAttributes(GRenderCounters& counters)
+{
+	if (opengl_compatible(3, 0))
+	{
+		glBindVertexArray(m_uiVAO);
+		++counters.iStateChanges;
+		return;
 	}
-	else if (eFrameFormatYUV420P == textureGroup.eTextureFormat)
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vVBOs[eVBOTypeVertices]);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)(nullptr));
+	counters.iStateChanges += 3;
+
+	for (int i = 0; i < m_iLayerNum; ++i)
 	{
-		for (int iOverlapLayerIdx = 0; iOverlapLayerIdx < vMultiTextureCoordinates.size(); ++iOverlapLayerIdx)
-		{
-			int iCameraIdx = vMultiTextureCoordinates[iOverlapLayerIdx].first;
+		glBindBuffer(GL_ARRAY_BUFFER, m_vVBOs[eVBOTypeTexture + i]);
+		glEnableVertexAttribArray(1 + i);
+		glVertexAttribPointer(1 + i, 3, GL_FLOAT, GL_FALSE, 0, (void*)(nullptr));
+		counters.iStateChanges += 3;
+	}
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vVBOs[eVBOTypeIndices]);
+	++counters.iStateChanges;
+}
 
-			std::string sTextureSampler = "textureSampler" + std::to_string(iOverlapLayerIdx) + std::to_string(0);
-			GLuint uiSamplerIdx = glGetUniformLocation(m_uiBlender, sTextureSampler.c_str());
+void GScenePatchBatch::Render(const GTextureGroup& textureGroup, const glm::mat4& matMVP, std::vector<GLuint>& vBoundTextures, GRenderCounters& counters)
+{
+	if (m_vPatchRanges.empty())
+	{
+		return;
+	}
 
-			glActiveTexture(GL_TEXTURE0 + iOverlapLayerIdx * 3);
-			glBindTexture(GL_TEXTURE_2D, textureGroup.vTextureGroup[iCameraIdx * 3]);
-			glUniform1i(uiSamplerIdx, iOverlapLayerIdx * 3);
+	glUseProgram(m_uiBlender);
+	++counters.iStateChanges;
+	if (0 <= m_iMVPLocation)
+	{
+		glUniformMatrix4fv(m_iMVPLocation, 1, GL_FALSE, &matMVP[0][0]);
+		++counters.iStateChanges;
+	}
 
-			sTextureSampler = "textureSampler" + std::to_string(iOverlapLayerIdx) + std::to_string(1);
-			uiSamplerIdx = glGetUniformLocation(m_uiBlender, sTextureSampler.c_str());
-			glActiveTexture(GL_TEXTURE0 + iOverlapLayerIdx * 3 + 1);
-			glBindTexture(GL_TEXTURE_2D, textureGroup.vTextureGroup[iCameraIdx * 3 + 1]);
-			glUniform1i(uiSamplerIdx, iOverlapLayerIdx * 3 + 1);
+	BindVertexAttributes(counters);
 
-			sTextureSampler = "textureSampler" + std::to_string(iOverlapLayerIdx) + std::to_string(2);
-			uiSamplerIdx = glGetUniformLocation(m_uiBlender, sTextureSampler.c_str());
-			glActiveTexture(GL_TEXTURE0 + iOverlapLayerIdx * 3 + 2);
-			glBindTexture(GL_TEXTURE_2D, textureGroup.vTextureGroup[iCameraIdx * 3 + 2]);
-			glUniform1i(uiSamplerIdx, iOverlapLayerIdx * 3 + 2);
-		}
+	int iUnitNum = m_iLayerNum * m_iPlaneNum;
+	if (vBoundTextures.size() < iUnitNum)
+	{
+		vBoundTextures.resize(iUnitNum, 0);
 	}
-	else if (eFrameFormatNV12 == textureGroup.eTextureFormat)
+
+	for (int iRangeIdx = 0; iRangeIdx < m_vPatchRanges.size(); ++iRangeIdx)
 	{
-		for (int iOverlapLayerIdx = 0; iOverlapLayerIdx < vMultiTextureCoordinates.size(); ++iOverlapLayerIdx)
+		const tPatchRange& range = m_vPatchRanges[iRangeIdx];
+		CollectVisibleRuns(range, matMVP);
+		if (m_vRunIndexNums.empty())
 		{
-			int iCameraIdx = vMultiTextureCoordinates[iOverlapLayerIdx].first;
+			continue;
+		}
 
-			std::string sTextureSampler = "textureSampler" + std::to_string(iOverlapLayerIdx) + std::to_string(0);
-			GLuint uiSamplerIdx = glGetUniformLocation(m_uiBlender, sTextureSampler.c_str());
+		for (int iLayerIdx = 0; iLayerIdx < m_iLayerNum; ++iLayerIdx)
+		{
+			for (int iPlaneIdx = 0; iPlaneIdx < m_iPlaneNum; ++iPlaneIdx)
+			{
+				int iUnit = iLayerIdx * m_iPlaneNum + iPlaneIdx;
+				GLuint uiTexture = textureGroup.vTextureGroup[range.vCameraIndices[iLayerIdx] * m_iPlaneNum + iPlaneIdx];
+				if (vBoundTextures[iUnit] == uiTexture)
+				{
+					continue;
+				}
 
-			glActiveTexture(GL_TEXTURE0 + iOverlapLayerIdx * 2);
-			glBindTexture(GL_TEXTURE_2D, textureGroup.vTextureGroup[iCameraIdx * 2]);
-			glUniform1i(uiSamplerIdx, iOverlapLayerIdx * 2);
+				glActiveTexture(GL_TEXTURE0 + iUnit);
+				glBindTexture(GL_TEXTURE_2D, uiTexture);
+				vBoundTextures[iUnit] = uiTexture;
+				counters.iStateChanges += 2;
+			}
+		}
 
-			sTextureSampler = "textureSampler" + std::to_string(iOverlapLayerIdx) + std::to_string(1);
-			uiSamplerIdx = glGetUniformLocation(m_uiBlender, sTextureSampler.c_str());
-			glActiveTexture(GL_TEXTURE0 + iOverlapLayerIdx * 2 + 1);
-			glBindTexture(GL_TEXTURE_2D, textureGroup.vTextureGroup[iCameraIdx * 2 + 1]);
-			glUniform1i(uiSamplerIdx, iOverlapLayerIdx * 2 + 1);
+#ifdef __ANDROID__
+		for (int iRunIdx = 0; iRunIdx < m_vRunIndexNums.size(); ++iRunIdx)
+		{
+			glDrawElements(GL_TRIANGLES, m_vRunIndexNums[iRunIdx], GL_UNSIGNED_INT, m_vRunOffsets[iRunIdx]);
 		}
+		counters.iDrawCalls += static_cast<int>(m_vRunIndexNums.size());
+#else
+		glMultiDrawElements(GL_TRIANGLES, &(m_vRunIndexNums[0]), GL_UNSIGNED_INT, &(m_vRunOffsets[0]), static_cast<GLsizei>(m_vRunIndexNums.size()));
+		++counters.iDrawCalls;
+#endif //__ANDROID__
 	}
 
-	//Draw.
-
-	if (opengl_compatible(3, 0))
-	{
-		glBindVertexArray(m_uiVAO);
-	}
-	else
+	//without a vertex array the texture coordinates would stay enabled for the next batch of fewer layers.
+	if (!opengl_compatible(3, 0))
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_vVBOs[eVBOTypeVertices]);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)(nullptr));
-
-		for (int i = 0; i < vMultiTextureCoordinates.size(); ++i)
+		for (int i = 0; i < m_iLayerNum; ++i)
 		{
-			glBindBuffer(GL_ARRAY_BUFFER, m_vVBOs[eVBOTypeTexture + i]);
-			glVertexAttribPointer(1 + i, 3, GL_FLOAT, GL_FALSE, 0, (void*)(nullptr));
+			glDisableVertexAttribArray(1 + i);
 		}
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vVBOs[eVBOTypeIndices]);
+		counters.iStateChanges += m_iLayerNum;
 	}
+}
 
-	glDrawElements(GL_TRIANGLES, vVerticeIndices.size(), GL_UNSIGNED_INT, (void*)(nullptr));
+void GScenePatchBatch::CollectVisibleRuns(const tPatchRange& range, const glm::mat4& matMVP)
+{
+	m_vRunIndexNums.clear();
+	m_vRunOffsets.clear();
 
-	if (opengl_compatible(3, 0))
+	const std::vector<GScenePatch::tCluster>& vClusters = range.pPatch->vClusters;
+	if (vClusters.empty())
 	{
-		glBindVertexArray(0);
+		m_vRunIndexNums.push_back(range.iIndexNum);
+		m_vRunOffsets.push_back((const void*)(range.ullIndexOffset_Byte));
+		return;
 	}
 
-	glUseProgram(0);
+	int iRunEnd = -1;
+	for (int i = 0; i < vClusters.size(); ++i)
+	{
+		const GScenePatch::tCluster& cluster = vClusters[i];
+		if (!GScenePatch::IsBoxInFrustum(cluster.v3BoundingBoxMin, cluster.v3BoundingBoxMax, matMVP))
+		{
+			continue;
+		}
 
-	return true;
+		if (cluster.iIndexBegin == iRunEnd)
+		{
+			m_vRunIndexNums.back() += cluster.iIndexNum;
+		}
+		else
+		{
+			m_vRunIndexNums.push_back(cluster.iIndexNum);
+			m_vRunOffsets.push_back((const void*)(range.ullIndexOffset_Byte + sizeof(GLuint) * cluster.iIndexBegin));
+		}
+		iRunEnd = cluster.iIndexBegin + cluster.iIndexNum;
+	}
 }
 
-void GScenePatch::Release()
+void GScenePatchBatch::Release()
 {
-	if (vMultiTextureCoordinates.empty())
+	if (0 == m_iLayerNum)
 	{
 		return;
 	}
@@ -383,10 +667,11 @@ void GScenePatch::Release()
 	if (!m_vVBOs.empty())
 	{
 		glDeleteBuffers(m_vVBOs.size(), &(m_vVBOs[0]));
+		m_vVBOs.clear();
 	}
 
 	GLint iNumOfShaders = 0;
-	if (glIsProgram(m_uiBlender))
+	if ((nullptr == m_ptrProgramCache) && glIsProgram(m_uiBlender))
 	{
 		glGetProgramiv(m_uiBlender, GL_ATTACHED_SHADERS, &iNumOfShaders);
 		if (iNumOfShaders > 0)
@@ -401,76 +686,1024 @@ void GScenePatch::Release()
 
 		glDeleteProgram(m_uiBlender);
 	}
+
+	m_ptrProgramCache.reset();
+	m_iMVPLocation = -1;
+	m_vPatchRanges.clear();
+	m_ullBufferSize_Byte = 0;
+	m_iLayerNum = 0;
 }
 
-template<class tProjectorObject>
-bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator, const std::vector<tProjectorObject>& vProjectorObjs)
+void GScenePatch::CreateClusters(int iMaxTriangleNum)
 {
-	//GLOGGER(info) << "==> GRenderScene::Create().";
+	vClusters.clear();
 
-	int iMaxTextureUnits = 0;
-	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &iMaxTextureUnits);
-	GLOGGER(info) << "Max Texture Units: " << iMaxTextureUnits;//todo.
+	int iTriangleNum = static_cast<int>(vVerticeIndices.size() / 3);
+	std::vector<int> vTriangles(iTriangleNum);
+	std::vector<glm::vec3> vCentroids(iTriangleNum);
+	for (int i = 0; i < iTriangleNum; ++i)
+	{
+		vTriangles[i] = i;
+		glm::vec3 v3Centroid(0.0f, 0.0f, 0.0f);
+		for (int j = 0; j < 3; ++j)
+		{
+			const tVertex& vertex = vVertices[vVerticeIndices[3 * i + j]];
+			v3Centroid += glm::vec3(vertex.x, vertex.y, vertex.z);
+		}
+		vCentroids[i] = v3Centroid / 3.0f;
+	}
 
-	ptrSurfaceGenerator->GenerateSurface(m_vVertices, m_vVerticeIndices);
-	GPatchesGenerator::GeneratePatches(m_vVertices, m_vVerticeIndices, vProjectorObjs, m_mpScenePatches);
+	SplitClusters(vTriangles, 0, iTriangleNum, vCentroids, std::max(iMaxTriangleNum, 1));
 
-	std::vector<tVertex> vTempVertices;
-	std::vector<GLuint> vTempVerticeIndices;
-	m_vVertices.swap(vTempVertices);
-	m_vVerticeIndices.swap(vTempVerticeIndices);
+	std::vector<GLuint> vClusteredIndices(vVerticeIndices.size());
+	for (int i = 0; i < iTriangleNum; ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+		{
+			vClusteredIndices[3 * i + j] = vVerticeIndices[3 * vTriangles[i] + j];
+		}
+	}
+	vVerticeIndices.swap(vClusteredIndices);
 
-	//GLOGGER(info) << "GRenderScene::Create() ==>";
-	return true;
+	for (int iClusterIdx = 0; iClusterIdx < vClusters.size(); ++iClusterIdx)
+	{
+		tCluster& cluster = vClusters[iClusterIdx];
+		cluster.v3BoundingBoxMin = glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+		cluster.v3BoundingBoxMax = glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (int i = cluster.iIndexBegin; i < cluster.iIndexBegin + cluster.iIndexNum; ++i)
+		{
+			const tVertex& vertex = vVertices[vVerticeIndices[i]];
+			glm::vec3 v3Vertex(vertex.x, vertex.y, vertex.z);
+			cluster.v3BoundingBoxMin = glm::min(cluster.v3BoundingBoxMin, v3Vertex);
+			cluster.v3BoundingBoxMax = glm::max(cluster.v3BoundingBoxMax, v3Vertex);
+		}
+	}
 }
 
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs);
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs);
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix>& vProjectorObjs);
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix>& vProjectorObjs);
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180>& vProjectorObjs);
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs);
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular>& vProjectorObjs);
-template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
-	, const std::vector<GProjectorObjectOriginal3d2NormalizedPix>& vProjectorObjs);
-
-
-bool GRenderScene::Prepare(enFrameFormat eFrameFormat)
+void GScenePatch::SplitClusters(std::vector<int>& vTriangles, int iBegin, int iEnd, const std::vector<glm::vec3>& vCentroids, int iMaxTriangleNum)
 {
-	//GLOGGER(info) << "==> GRenderScene::Prepare().";
-	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	if (iEnd - iBegin <= iMaxTriangleNum)
 	{
-		if (!it->second.Prepare(eFrameFormat))
+		if (iEnd > iBegin)
 		{
-			GLOGGER(error) << "GRenderScene::Prepare(). patch prepare failed.";
-			GLOGGER(info) << "GRenderScene::Prepare()==> ";
-			return false;
+			tCluster cluster;
+			cluster.iIndexBegin = 3 * iBegin;
+			cluster.iIndexNum = 3 * (iEnd - iBegin);
+			vClusters.push_back(cluster);
 		}
+		return;
 	}
-	//GLOGGER(info) << "GRenderScene::Prepare() ==> ";
-	return true;
+
+	glm::vec3 v3Min(FLT_MAX, FLT_MAX, FLT_MAX);
+	glm::vec3 v3Max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	for (int i = iBegin; i < iEnd; ++i)
+	{
+		v3Min = glm::min(v3Min, vCentroids[vTriangles[i]]);
+		v3Max = glm::max(v3Max, vCentroids[vTriangles[i]]);
+	}
+
+	glm::vec3 v3Extent = v3Max - v3Min;
+	int iAxis = (v3Extent.x >= v3Extent.y) ? ((v3Extent.x >= v3Extent.z) ? 0 : 2) : ((v3Extent.y >= v3Extent.z) ? 1 : 2);
+
+	int iMiddle = iBegin + (iEnd - iBegin) / 2;
+	std::nth_element(vTriangles.begin() + iBegin, vTriangles.begin() + iMiddle, vTriangles.begin() + iEnd
+		, [&vCentroids, iAxis](int iTriangle1, int iTriangle2)
+	{
+		return vCentroids[iTriangle1][iAxis] < vCentroids[iTriangle2][iAxis];
+	});
+
+	SplitClusters(vTriangles, iBegin, iMiddle, vCentroids, iMaxTriangleNum);
+	SplitClusters(vTriangles, iMiddle, iEnd, vCentroids, iMaxTriangleNum);
 }
 
-bool GRenderScene::Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV)
+void GScenePatch::CalcBoundingBox()
 {
-	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	m_v3BoundingBoxMin = glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+	m_v3BoundingBoxMax = glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	for (int i = 0; i < vVertices.size(); ++i)
 	{
-		it->second.Render(textureGroup, matP, matV);
+		glm::vec3 v3Vertex(vVertices[i].x, vVertices[i].y, vVertices[i].z);
+		m_v3BoundingBoxMin = glm::min(m_v3BoundingBoxMin, v3Vertex);
+		m_v3BoundingBoxMax = glm::max(m_v3BoundingBoxMax, v3Vertex);
 	}
-	return true;
 }
 
-void GRenderScene::Release()
+bool GScenePatch::IsInFrustum(const glm::mat4& matMVP) const
 {
-	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	if (vVertices.empty() || !IsBoxInFrustum(m_v3BoundingBoxMin, m_v3BoundingBoxMax, matMVP))
+	{
+		return false;
+	}
+
+	if (vClusters.empty())
+	{
+		return true;
+	}
+
+	for (int i = 0; i < vClusters.size(); ++i)
+	{
+		if (IsBoxInFrustum(vClusters[i].v3BoundingBoxMin, vClusters[i].v3BoundingBoxMax, matMVP))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GScenePatch::IsBoxInFrustum(const glm::vec3& v3BoundingBoxMin, const glm::vec3& v3BoundingBoxMax, const glm::mat4& matMVP)
+{
+	//the planes of the frustum are sums and differences of the rows of the mvp matrix (w +- x, w +- y, w +- z).
+	glm::vec4 v4Row[4];
+	for (int i = 0; i < 4; ++i)
 	{
-		it->second.Release();
+		v4Row[i] = glm::vec4(matMVP[0][i], matMVP[1][i], matMVP[2][i], matMVP[3][i]);
 	}
-}
\ No newline at end of file
+
+	for (int iPlane = 0; iPlane < 6; ++iPlane)
+	{
+		glm::vec4 v4Plane = (0 == iPlane % 2) ? (v4Row[3] + v4Row[iPlane / 2]) : (v4Row[3] - v4Row[iPlane / 2]);
+
+		//the corner of the box farthest along the plane normal.
+		glm::vec3 v3Corner((v4Plane.x > 0.0f) ? v3BoundingBoxMax.x : v3BoundingBoxMin.x
+			, (v4Plane.y > 0.0f) ? v3BoundingBoxMax.y : v3BoundingBoxMin.y
+			, (v4Plane.z > 0.0f) ? v3BoundingBoxMax.z : v3BoundingBoxMin.z);
+
+		if (glm::dot(glm::vec3(v4Plane), v3Corner) + v4Plane.w < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<class tProjectorObject>
+void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<tProjectorObject>& vProjectorObjs, int iMaxLayerNum, int iThreadNum)
+{
+	Release();
+
+	if (iThreadNum <= 0)
+	{
+		iThreadNum = std::thread::hardware_concurrency();
+	}
+	iMaxLayerNum = std::max(iMaxLayerNum, 1);
+
+	iWidth = std::max(iTableWidth, 1);
+	iHeight = std::max(iTableHeight, 1);
+	fPlaneWidth = fSurfaceWidth;
+	fPlaneHeight = fSurfaceHeight;
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		iCameraNum = std::max(iCameraNum, vProjectorObjs[iProjectorObjIdx].GetCameraIdx() + 1);
+	}
+
+	size_t uiPixelNum = (size_t)iWidth * iHeight;
+	tTexel emptyTexel = { 0, 0, 0, 0 };
+	vLayers.assign(iMaxLayerNum, std::vector<tTexel>(uiPixelNum, emptyTexel));
+
+	//rows of the same range share the layer count and the camera boxes, they are merged once every range is done.
+	int iRangeNum = std::min(GPatchesGenerator::CalcRangeNum(static_cast<int>(std::min(uiPixelNum, (size_t)INT_MAX)), iThreadNum), iHeight);
+	std::vector<int> vRangeLayerNums(iRangeNum, 0);
+	std::vector<std::vector<glm::vec3>> vRangeBoxMins(iRangeNum, std::vector<glm::vec3>(iCameraNum, glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX)));
+	std::vector<std::vector<glm::vec3>> vRangeBoxMaxs(iRangeNum, std::vector<glm::vec3>(iCameraNum, glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX)));
+	GPatchesGenerator::RunInRanges(iHeight, iRangeNum
+		, [this, &vProjectorObjs, iMaxLayerNum, &vRangeLayerNums, &vRangeBoxMins, &vRangeBoxMaxs](int iRangeIdx, int iBegin, int iEnd)
+	{
+		float fPixelWidth = fPlaneWidth / iWidth;
+		float fPixelHeight = fPlaneHeight / iHeight;
+		std::vector<std::pair<int, GPatchesGenerator::tVertexProjection>> vCandidates;
+		for (int j = iBegin; j < iEnd; ++j)
+		{
+			float fY = -fPlaneHeight / 2.0f + (j + 0.5f) * fPixelHeight;
+			for (int i = 0; i < iWidth; ++i)
+			{
+				float fX = -fPlaneWidth / 2.0f + (i + 0.5f) * fPixelWidth;
+				cv::Point3f ptPixel(fX, fY, 0.0f);
+
+				vCandidates.clear();
+				for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+				{
+					GPatchesGenerator::tVertexProjection projection = GPatchesGenerator::ProjectVertex(vProjectorObjs[iProjectorObjIdx](ptPixel));
+					if (projection.bInside && (0.0f < projection.weight))
+					{
+						vCandidates.push_back(std::make_pair(vProjectorObjs[iProjectorObjIdx].GetCameraIdx(), projection));
+					}
+				}
+
+				//the cameras of the largest weights, normalized as the vertices of a patch are.
+				int iLayerNum = std::min(static_cast<int>(vCandidates.size()), iMaxLayerNum);
+				std::partial_sort(vCandidates.begin(), vCandidates.begin() + iLayerNum, vCandidates.end()
+					, [](const std::pair<int, GPatchesGenerator::tVertexProjection>& candidate1, const std::pair<int, GPatchesGenerator::tVertexProjection>& candidate2)
+				{
+					return candidate1.second.weight > candidate2.second.weight;
+				});
+
+				float fTotalWeight = 0.0f;
+				for (int iLayerIdx = 0; iLayerIdx < iLayerNum; ++iLayerIdx)
+				{
+					fTotalWeight += vCandidates[iLayerIdx].second.weight;
+				}
+
+				size_t uiPixelIdx = (size_t)j * iWidth + i;
+				for (int iLayerIdx = 0; iLayerIdx < iLayerNum; ++iLayerIdx)
+				{
+					int iCameraIdx = vCandidates[iLayerIdx].first;
+					const GPatchesGenerator::tVertexProjection& projection = vCandidates[iLayerIdx].second;
+					tTexel& texel = vLayers[iLayerIdx][uiPixelIdx];
+					texel.u = static_cast<unsigned short>(std::min(std::max(projection.u, 0.0f), 1.0f) * 65535.0f + 0.5f);
+					texel.v = static_cast<unsigned short>(std::min(std::max(projection.v, 0.0f), 1.0f) * 65535.0f + 0.5f);
+					texel.weight = static_cast<unsigned short>(std::min(projection.weight / fTotalWeight, 1.0f) * 65535.0f + 0.5f);
+					texel.camera = static_cast<unsigned short>(iCameraIdx + 1);
+
+					glm::vec3& v3BoxMin = vRangeBoxMins[iRangeIdx][iCameraIdx];
+					glm::vec3& v3BoxMax = vRangeBoxMaxs[iRangeIdx][iCameraIdx];
+					v3BoxMin = glm::min(v3BoxMin, glm::vec3(fX - fPixelWidth / 2.0f, fY - fPixelHeight / 2.0f, 0.0f));
+					v3BoxMax = glm::max(v3BoxMax, glm::vec3(fX + fPixelWidth / 2.0f, fY + fPixelHeight / 2.0f, 0.0f));
+				}
+				vRangeLayerNums[iRangeIdx] = std::max(vRangeLayerNums[iRangeIdx], iLayerNum);
+			}
+		}
+	});
+
+	vCameraBoxMins.assign(iCameraNum, glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX));
+	vCameraBoxMaxs.assign(iCameraNum, glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+	for (int iRangeIdx = 0; iRangeIdx < iRangeNum; ++iRangeIdx)
+	{
+		iLayerNum = std::max(iLayerNum, vRangeLayerNums[iRangeIdx]);
+		for (int iCameraIdx = 0; iCameraIdx < iCameraNum; ++iCameraIdx)
+		{
+			vCameraBoxMins[iCameraIdx] = glm::min(vCameraBoxMins[iCameraIdx], vRangeBoxMins[iRangeIdx][iCameraIdx]);
+			vCameraBoxMaxs[iCameraIdx] = glm::max(vCameraBoxMaxs[iCameraIdx], vRangeBoxMaxs[iRangeIdx][iCameraIdx]);
+		}
+	}
+
+	//a plane seen by no camera keeps one empty layer, it is drawn transparent.
+	iLayerNum = std::max(iLayerNum, 1);
+	vLayers.resize(iLayerNum);
+}
+
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+template void GRemapTable::Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+	, const std::vector<GProjectorObjectOriginal3d2NormalizedPix>& vProjectorObjs, int iMaxLayerNum, int iThreadNum);
+
+bool GRemapTable::IsCameraInFrustum(int iCameraIdx, const glm::mat4& matMVP) const
+{
+	if ((iCameraIdx < 0) || (iCameraIdx >= vCameraBoxMins.size()) || (vCameraBoxMins[iCameraIdx].x > vCameraBoxMaxs[iCameraIdx].x))
+	{
+		return false;
+	}
+
+	return GScenePatch::IsBoxInFrustum(vCameraBoxMins[iCameraIdx], vCameraBoxMaxs[iCameraIdx], matMVP);
+}
+
+void GRemapTable::Release()
+{
+	vLayers.clear();
+	vCameraBoxMins.clear();
+	vCameraBoxMaxs.clear();
+	iWidth = 0;
+	iHeight = 0;
+	iLayerNum = 0;
+	iCameraNum = 0;
+}
+
+int GRemapPass::CalcTextureUnitNum(int iLayerNum, int iCameraNum, enFrameFormat eFrameFormat)
+{
+	int iPlaneNum = 0;
+	if (eFrameFormatRGB == eFrameFormat)
+	{
+		iPlaneNum = 1;
+	}
+	else if (eFrameFormatYUV420P == eFrameFormat)
+	{
+		iPlaneNum = 3;
+	}
+	else if (eFrameFormatNV12 == eFrameFormat)
+	{
+		iPlaneNum = 2;
+	}
+	else
+	{
+		return 0;
+	}
+
+	return iLayerNum + iCameraNum * iPlaneNum;
+}
+
+bool GRemapPass::Prepare(const GRemapTable& table, enFrameFormat eFrameFormat, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache)
+{
+	GGLSLBlenderGenerator::enGFragShaderType eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeNormal;
+	if (eFrameFormatRGB == eFrameFormat)
+	{
+		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeNormal;
+		m_iPlaneNum = 1;
+	}
+	else if (eFrameFormatYUV420P == eFrameFormat)
+	{
+		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeYUV;
+		m_iPlaneNum = 3;
+	}
+	else if (eFrameFormatNV12 == eFrameFormat)
+	{
+		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeNV12;
+		m_iPlaneNum = 2;
+	}
+	else
+	{
+		GLOGGER(error) << "GRemapPass::Prepare(). frame format not supported: " << eFrameFormat;
+		return false;
+	}
+
+#ifdef __ANDROID__
+	GLOGGER(error) << "GRemapPass::Prepare(). 16 bit normalized textures are not supported.";
+	return false;
+#else
+	m_iLayerNum = table.iLayerNum;
+	m_iCameraNum = table.iCameraNum;
+	int iGLSLVersion = GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMajorVersion) * 100
+		+ GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMinorVersion);
+	m_ptrProgramCache = ptrProgramCache;
+	bool bProgram = (nullptr != m_ptrProgramCache) ?
+		m_ptrProgramCache->GetRemapProgram(eFragShaderType, iGLSLVersion, m_iLayerNum, m_iCameraNum, m_uiBlender)
+		: GGLSLBlenderGenerator::GetRemapProgram(eFragShaderType, iGLSLVersion, m_iLayerNum, m_iCameraNum, m_uiBlender);
+	if (!bProgram)
+	{
+		GLOGGER(error) << "GRemapPass::Prepare(). prepare failed.";
+		return false;
+	}
+	m_iMVPLocation = glGetUniformLocation(m_uiBlender, "MVP");
+
+	//the tables take the first texture units, the frames of the cameras the ones after them.
+	glUseProgram(m_uiBlender);
+	for (int iLayerIdx = 0; iLayerIdx < m_iLayerNum; ++iLayerIdx)
+	{
+		glUniform1i(glGetUniformLocation(m_uiBlender, ("remapSampler" + std::to_string(iLayerIdx)).c_str()), iLayerIdx);
+	}
+	for (int iCameraIdx = 0; iCameraIdx < m_iCameraNum; ++iCameraIdx)
+	{
+		for (int iPlaneIdx = 0; iPlaneIdx < m_iPlaneNum; ++iPlaneIdx)
+		{
+			std::string sTextureSampler = "textureSampler" + std::to_string(iCameraIdx);
+			if (1 < m_iPlaneNum)
+			{
+				sTextureSampler += std::to_string(iPlaneIdx);
+			}
+			glUniform1i(glGetUniformLocation(m_uiBlender, sTextureSampler.c_str()), m_iLayerNum + iCameraIdx * m_iPlaneNum + iPlaneIdx);
+		}
+	}
+	glUseProgram(0);
+
+	//the camera index of a texel is not interpolated.
+	m_vTables.resize(m_iLayerNum);
+	glGenTextures(m_vTables.size(), &(m_vTables[0]));
+	for (int iLayerIdx = 0; iLayerIdx < m_iLayerNum; ++iLayerIdx)
+	{
+		glBindTexture(GL_TEXTURE_2D, m_vTables[iLayerIdx]);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16, table.iWidth, table.iHeight, 0, GL_RGBA, GL_UNSIGNED_SHORT, &(table.vLayers[iLayerIdx][0]));
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	//two triangles over the plane, wound as the tessellated plane is. position and table coordinate of each vertex.
+	float fHalfWidth = table.fPlaneWidth / 2.0f;
+	float fHalfHeight = table.fPlaneHeight / 2.0f;
+	const GLfloat vQuad[6][5] = {
+		{ -fHalfWidth, -fHalfHeight, 0.0f, 0.0f, 0.0f }, { fHalfWidth, -fHalfHeight, 0.0f, 1.0f, 0.0f }, { fHalfWidth, fHalfHeight, 0.0f, 1.0f, 1.0f },
+		{ fHalfWidth, fHalfHeight, 0.0f, 1.0f, 1.0f }, { -fHalfWidth, fHalfHeight, 0.0f, 0.0f, 1.0f }, { -fHalfWidth, -fHalfHeight, 0.0f, 0.0f, 0.0f } };
+
+	glGenVertexArrays(1, &m_uiVAO);
+	glBindVertexArray(m_uiVAO);
+
+	glGenBuffers(1, &m_uiVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uiVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vQuad), vQuad, GL_STATIC_DRAW);
+	m_ullTextureSize_Byte = sizeof(vQuad) + (size_t)table.iWidth * table.iHeight * m_iLayerNum * sizeof(GRemapTable::tTexel);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (void*)(nullptr));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return true;
+#endif //__ANDROID__
+}
+
+void GRemapPass::Render(const GTextureGroup& textureGroup, const glm::mat4& matMVP, GRenderCounters& counters)
+{
+	if (0 == m_iLayerNum)
+	{
+		return;
+	}
+
+	glUseProgram(m_uiBlender);
+	glBindVertexArray(m_uiVAO);
+	counters.iStateChanges += 2;
+	if (0 <= m_iMVPLocation)
+	{
+		glUniformMatrix4fv(m_iMVPLocation, 1, GL_FALSE, &matMVP[0][0]);
+		++counters.iStateChanges;
+	}
+
+	for (int iLayerIdx = 0; iLayerIdx < m_iLayerNum; ++iLayerIdx)
+	{
+		glActiveTexture(GL_TEXTURE0 + iLayerIdx);
+		glBindTexture(GL_TEXTURE_2D, m_vTables[iLayerIdx]);
+		counters.iStateChanges += 2;
+	}
+
+	//any camera may be selected by a pixel, the frames of all of them are bound.
+	int iTextureNum = std::min(m_iCameraNum * m_iPlaneNum, static_cast<int>(textureGroup.vTextureGroup.size()));
+	for (int iTextureIdx = 0; iTextureIdx < iTextureNum; ++iTextureIdx)
+	{
+		glActiveTexture(GL_TEXTURE0 + m_iLayerNum + iTextureIdx);
+		glBindTexture(GL_TEXTURE_2D, textureGroup.vTextureGroup[iTextureIdx]);
+		counters.iStateChanges += 2;
+	}
+
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	++counters.iDrawCalls;
+}
+
+void GRemapPass::Release()
+{
+	if (0 == m_iLayerNum)
+	{
+		return;
+	}
+
+	glDeleteVertexArrays(1, &m_uiVAO);
+	glDeleteBuffers(1, &m_uiVBO);
+
+	if (!m_vTables.empty())
+	{
+		glDeleteTextures(m_vTables.size(), &(m_vTables[0]));
+		m_vTables.clear();
+	}
+
+	GLint iNumOfShaders = 0;
+	if ((nullptr == m_ptrProgramCache) && glIsProgram(m_uiBlender))
+	{
+		glGetProgramiv(m_uiBlender, GL_ATTACHED_SHADERS, &iNumOfShaders);
+		if (iNumOfShaders > 0)
+		{
+			std::vector<GLuint> vShaders(iNumOfShaders);
+			glGetAttachedShaders(m_uiBlender, vShaders.size(), nullptr, &(vShaders[0]));
+			for (int iShaderIdx = 0; iShaderIdx < vShaders.size(); ++iShaderIdx)
+			{
+				glDeleteShader(vShaders[iShaderIdx]);
+			}
+		}
+
+		glDeleteProgram(m_uiBlender);
+	}
+
+	m_ptrProgramCache.reset();
+	m_iMVPLocation = -1;
+	m_ullTextureSize_Byte = 0;
+	m_iLayerNum = 0;
+}
+
+static bool IsValidProjection(const cv::Point3f& ptProjected)
+{
+	return (ptProjected.x == ptProjected.x) && (ptProjected.y == ptProjected.y);
+}
+
+static bool IsInsideFrame(const cv::Point3f& ptProjected)
+{
+	return 0.0f < ptProjected.x && 0.0f < ptProjected.y && ptProjected.x < 1.0f && ptProjected.y < 1.0f;
+}
+
+//the texture coordinates are interpolated linearly along an edge, its midpoint is drawn at the mean of the end point projections.
+//true if that misses the projection of the midpoint by more than fTolerance_px in a camera which sees the edge.
+template<class tProjectorObject>
+static bool IsInterpolationErrorAbove(const std::vector<tProjectorObject>& vProjectorObjs, float fTolerance_px, float fFrameWidth, float fFrameHeight
+	, const Eigen::Vector3f* pEndPoints, const Eigen::Vector3f* pMidPoints, int iEdgeNum)
+{
+	for (int iEdgeIdx = 0; iEdgeIdx < iEdgeNum; ++iEdgeIdx)
+	{
+		const Eigen::Vector3f& vu1 = pEndPoints[2 * iEdgeIdx];
+		const Eigen::Vector3f& vu2 = pEndPoints[2 * iEdgeIdx + 1];
+		const Eigen::Vector3f& vuMid = pMidPoints[iEdgeIdx];
+		cv::Point3f pt1(vu1[0], vu1[1], vu1[2]);
+		cv::Point3f pt2(vu2[0], vu2[1], vu2[2]);
+		cv::Point3f ptMid(vuMid[0], vuMid[1], vuMid[2]);
+
+		for (int iCameraIdx = 0; iCameraIdx < vProjectorObjs.size(); ++iCameraIdx)
+		{
+			cv::Point3f ptProjected1 = vProjectorObjs[iCameraIdx](pt1);
+			cv::Point3f ptProjected2 = vProjectorObjs[iCameraIdx](pt2);
+			cv::Point3f ptProjectedMid = vProjectorObjs[iCameraIdx](ptMid);
+
+			if (!IsInsideFrame(ptProjected1) && !IsInsideFrame(ptProjected2) && !IsInsideFrame(ptProjectedMid))
+			{
+				continue;
+			}
+
+			//the edge crosses the border of the valid range of the camera.
+			if (!IsValidProjection(ptProjected1) || !IsValidProjection(ptProjected2) || !IsValidProjection(ptProjectedMid))
+			{
+				return true;
+			}
+
+			float fErrorX_px = (ptProjectedMid.x - (ptProjected1.x + ptProjected2.x) / 2.0f) * fFrameWidth;
+			float fErrorY_px = (ptProjectedMid.y - (ptProjected1.y + ptProjected2.y) / 2.0f) * fFrameHeight;
+			if (fErrorX_px * fErrorX_px + fErrorY_px * fErrorY_px > fTolerance_px * fTolerance_px)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+template<class tProjectorObject>
+bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator, const std::vector<tProjectorObject>& vProjectorObjs
+	, const GStitcherConfig& config)
+{
+	//GLOGGER(info) << "==> GRenderScene::Create().";
+	//no GL calls here, scenes are created on worker threads as well.
+	std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+
+	float fPlaneWidth = 0.0f;
+	float fPlaneHeight = 0.0f;
+	if ((0 < config.m_iRemapTableWidth) && (0 < config.m_iRemapTableHeight) && ptrSurfaceGenerator->GetPlaneSize(fPlaneWidth, fPlaneHeight)
+		&& CreateRemapTable(fPlaneWidth, fPlaneHeight, vProjectorObjs, config))
+	{
+		return true;
+	}
+
+	//a scene of the same inputs generated before is loaded from the scene cache.
+	std::string sCacheFilePath;
+	if (!config.m_sSceneCacheDirectory.empty() && !config.m_sSceneCacheKey.empty())
+	{
+		sCacheFilePath = GSceneCache::GetFilePath(config.m_sSceneCacheDirectory, config.m_sSceneCacheKey);
+	}
+	bool bCached = (!sCacheFilePath.empty()) && GSceneCache::Load(sCacheFilePath, config.m_sSceneCacheKey, m_mpScenePatches);
+
+	bool bAdaptive = (0.0f < config.m_fTessellationTolerance_px) && (0 < config.m_iInputFrameWidth) && (0 < config.m_iInputFrameHeight);
+	if (!bCached)
+	{
+		if (bAdaptive)
+		{
+			float fTolerance_px = config.m_fTessellationTolerance_px;
+			float fFrameWidth = (float)config.m_iInputFrameWidth;
+			float fFrameHeight = (float)config.m_iInputFrameHeight;
+			ptrSurfaceGenerator->SetRefinePredicate([&vProjectorObjs, fTolerance_px, fFrameWidth, fFrameHeight]
+				(const Eigen::Vector3f* pEndPoints, const Eigen::Vector3f* pMidPoints, int iEdgeNum)
+			{
+				return IsInterpolationErrorAbove(vProjectorObjs, fTolerance_px, fFrameWidth, fFrameHeight, pEndPoints, pMidPoints, iEdgeNum);
+			});
+		}
+		ptrSurfaceGenerator->GenerateSurface(m_vVertices, m_vVerticeIndices);
+		ptrSurfaceGenerator->SetRefinePredicate(tRefinePredicate());
+
+		GPatchesGenerator::GeneratePatches(m_vVertices, m_vVerticeIndices, vProjectorObjs, m_mpScenePatches);
+
+		//a failed write only costs the next start-up the generation again.
+		if (!sCacheFilePath.empty())
+		{
+			GSceneCache::Save(sCacheFilePath, config.m_sSceneCacheKey, m_mpScenePatches);
+		}
+	}
+
+	size_t uiVertexNum = 0;
+	size_t uiIndexNum = 0;
+	size_t uiBufferSize_Byte = 0;
+	size_t uiClusterNum = 0;
+	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	{
+		it->second.CreateClusters(s_iClusterTriangleNum);
+		it->second.CalcBoundingBox();
+		uiClusterNum += it->second.vClusters.size();
+
+		uiVertexNum += it->second.vVertices.size();
+		uiIndexNum += it->second.vVerticeIndices.size();
+		uiBufferSize_Byte += it->second.vVertices.size() * (sizeof(tVertex) + it->second.vMultiTextureCoordinates.size() * sizeof(tTextureCoordinate))
+			+ it->second.vVerticeIndices.size() * sizeof(GLuint);
+	}
+	GLOGGER(info) << "GRenderScene::Create(). " << (bCached ? "loaded from " + sCacheFilePath : std::string("generated"))
+		<< ", tessellation tolerance: " << (bAdaptive ? config.m_fTessellationTolerance_px : 0.0f)
+		<< " px, surface vertices: " << m_vVertices.size() << ", triangles: " << m_vVerticeIndices.size() / 3
+		<< ", patches: " << m_mpScenePatches.size() << ", clusters: " << uiClusterNum << ", patch vertices: " << uiVertexNum << ", patch indices: " << uiIndexNum
+		<< ", buffer size: " << uiBufferSize_Byte / 1024 << " KB, in "
+		<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count() << " ms.";
+
+	std::vector<tVertex> vTempVertices;
+	std::vector<GLuint> vTempVerticeIndices;
+	m_vVertices.swap(vTempVertices);
+	m_vVerticeIndices.swap(vTempVerticeIndices);
+
+	//GLOGGER(info) << "GRenderScene::Create() ==>";
+	return true;
+}
+
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs, const GStitcherConfig& config);
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs, const GStitcherConfig& config);
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix>& vProjectorObjs, const GStitcherConfig& config);
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix>& vProjectorObjs, const GStitcherConfig& config);
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180>& vProjectorObjs, const GStitcherConfig& config);
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs, const GStitcherConfig& config);
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular>& vProjectorObjs, const GStitcherConfig& config);
+template bool GRenderScene::Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator
+	, const std::vector<GProjectorObjectOriginal3d2NormalizedPix>& vProjectorObjs, const GStitcherConfig& config);
+
+template<class tProjectorObject>
+bool GRenderScene::CreateRemapTable(float fPlaneWidth, float fPlaneHeight, const std::vector<tProjectorObject>& vProjectorObjs, const GStitcherConfig& config)
+{
+	std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+
+	//the tables and the frames of all the cameras are sampled by one program.
+	int iCameraNum = 0;
+	for (int iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		iCameraNum = std::max(iCameraNum, vProjectorObjs[iProjectorObjIdx].GetCameraIdx() + 1);
+	}
+	int iGLSLVersion = GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMajorVersion) * 100
+		+ GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMinorVersion);
+	int iMaxTextureUnits = GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntMaxTextureImageUnits);
+	int iCameraTextureUnits = GRemapPass::CalcTextureUnitNum(0, iCameraNum, config.m_eInputFrameFormat);
+	int iMaxLayerNum = std::min(s_iMaxRemapLayerNum, iMaxTextureUnits - iCameraTextureUnits);
+	if ((iGLSLVersion < 330) || (0 == iCameraTextureUnits) || (iMaxLayerNum < 1))
+	{
+		GLOGGER(info) << "GRenderScene::CreateRemapTable(). GLSL version: " << iGLSLVersion << ", texture units: " << iMaxTextureUnits
+			<< ", of the cameras: " << iCameraTextureUnits << ", not enough for a remap table, the tessellated surface is drawn.";
+		return false;
+	}
+
+	m_remapTable.Generate(fPlaneWidth, fPlaneHeight, config.m_iRemapTableWidth, config.m_iRemapTableHeight, vProjectorObjs, iMaxLayerNum);
+
+	GLOGGER(info) << "GRenderScene::CreateRemapTable(). " << m_remapTable.iWidth << " x " << m_remapTable.iHeight
+		<< ", layers: " << m_remapTable.iLayerNum << ", cameras: " << m_remapTable.iCameraNum
+		<< ", table size: " << (size_t)m_remapTable.iWidth * m_remapTable.iHeight * m_remapTable.iLayerNum * sizeof(GRemapTable::tTexel) / 1024
+		<< " KB, in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count() << " ms.";
+	return true;
+}
+
+bool GRenderScene::Prepare(enFrameFormat eFrameFormat, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache)
+{
+	//GLOGGER(info) << "==> GRenderScene::Prepare().";
+	//the GLSL 330 programs, the remap ones included, read the MVP matrix from a uniform block.
+	int iGLSLVersion = GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMajorVersion) * 100
+		+ GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMinorVersion);
+	if ((iGLSLVersion >= 330) && (0 == m_uiTransformUBO))
+	{
+		glGenBuffers(1, &m_uiTransformUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_uiTransformUBO);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	if (0 < m_remapTable.iLayerNum)
+	{
+		bool bRet = m_remapPass.Prepare(m_remapTable, eFrameFormat, ptrProgramCache);
+		//the tables are on the gpu, the camera boxes are kept for the visibility.
+		std::vector<std::vector<GRemapTable::tTexel>>().swap(m_remapTable.vLayers);
+		if (!bRet)
+		{
+			GLOGGER(error) << "GRenderScene::Prepare(). remap pass prepare failed.";
+			GLOGGER(info) << "GRenderScene::Prepare()==> ";
+		}
+		return bRet;
+	}
+
+	int iMaxTextureUnits = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &iMaxTextureUnits);
+	GLOGGER(info) << "Max Texture Units: " << iMaxTextureUnits;//todo.
+
+	//one batch for the patches of each number of cameras, i.e. for each program.
+	std::map<int, std::vector<const GScenePatch*>> mpPatchesByLayerNum;
+	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	{
+		if (!it->second.vMultiTextureCoordinates.empty())
+		{
+			mpPatchesByLayerNum[static_cast<int>(it->second.vMultiTextureCoordinates.size())].push_back(&(it->second));
+		}
+	}
+
+	m_vPatchBatches.resize(mpPatchesByLayerNum.size());
+	int iBatchIdx = 0;
+	for (auto it = mpPatchesByLayerNum.begin(); it != mpPatchesByLayerNum.end(); ++it, ++iBatchIdx)
+	{
+		if (!m_vPatchBatches[iBatchIdx].Prepare(it->first, it->second, eFrameFormat, ptrProgramCache))
+		{
+			GLOGGER(error) << "GRenderScene::Prepare(). patch prepare failed.";
+			GLOGGER(info) << "GRenderScene::Prepare()==> ";
+			return false;
+		}
+	}
+	//GLOGGER(info) << "GRenderScene::Prepare() ==> ";
+	return true;
+}
+
+bool GRenderScene::RequestPrograms(enFrameFormat eFrameFormat, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache)
+{
+	if (nullptr == ptrProgramCache)
+	{
+		return true;
+	}
+
+	//as chosen by GScenePatchBatch::Prepare() and GRemapPass::Prepare(), which report an unsupported format.
+	GGLSLBlenderGenerator::enGFragShaderType eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeNormal;
+	if (eFrameFormatYUV420P == eFrameFormat)
+	{
+		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeYUV;
+	}
+	else if (eFrameFormatNV12 == eFrameFormat)
+	{
+		eFragShaderType = GGLSLBlenderGenerator::eGFragShaderTypeNV12;
+	}
+	else if (eFrameFormatRGB != eFrameFormat)
+	{
+		return true;
+	}
+
+	int iGLSLVersion = GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMajorVersion) * 100
+		+ GGlobalParametersManager::GetInstance()->GetParamInt(eGGlobalParamIntGLSLMinorVersion);
+	if (0 < m_remapTable.iLayerNum)
+	{
+		return ptrProgramCache->RequestRemapProgram(eFragShaderType, iGLSLVersion, m_remapTable.iLayerNum, m_remapTable.iCameraNum);
+	}
+
+	//all of them are requested, not only up to the first one still being linked.
+	std::set<int> stLayerNums;
+	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	{
+		if (!it->second.vMultiTextureCoordinates.empty())
+		{
+			stLayerNums.insert(static_cast<int>(it->second.vMultiTextureCoordinates.size()));
+		}
+	}
+
+	bool bLinked = true;
+	for (auto it = stLayerNums.begin(); it != stLayerNums.end(); ++it)
+	{
+		bLinked = ptrProgramCache->RequestProgram(GGLSLBlenderGenerator::eGVertexShaderTypeNormal, eFragShaderType, iGLSLVersion, *it) && bLinked;
+	}
+	return bLinked;
+}
+
+template<class tProjectorObject>
+bool GRenderScene::Update(const std::vector<tProjectorObject>& vProjectorObjs)
+{
+	std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+	if ((0 < m_remapTable.iLayerNum) || m_vPatchBatches.empty())
+	{
+		return false;
+	}
+
+	//the new texture coordinates are only applied once every patch is known to keep its cameras.
+	int iCameraNum = vProjectorObjs.size();
+	int iThreadNum = std::thread::hardware_concurrency();
+	std::vector<std::vector<std::vector<tTextureCoordinate>>> vPatchTextureCoordinates(m_mpScenePatches.size());
+	size_t uiVertexNum = 0;
+	int iPatchIdx = 0;
+	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it, ++iPatchIdx)
+	{
+		const std::bitset<MAX_PATCHES_NUM>& bsTexture = it->first;
+		const GScenePatch& patch = it->second;
+		if (bsTexture.count() != patch.vMultiTextureCoordinates.size())
+		{
+			return false;
+		}
+
+		int iVertexNum = patch.vVertices.size();
+		std::vector<GPatchesGenerator::tVertexProjection> vProjections((size_t)iVertexNum * iCameraNum);
+		GPatchesGenerator::RunInRanges(iVertexNum, GPatchesGenerator::CalcRangeNum(iVertexNum, iThreadNum)
+			, [&patch, &vProjectorObjs, &vProjections, iCameraNum](int iRangeIdx, int iBegin, int iEnd)
+		{
+			for (int iVertexIdx = iBegin; iVertexIdx < iEnd; ++iVertexIdx)
+			{
+				cv::Point3f ptVertex(patch.vVertices[iVertexIdx].x, patch.vVertices[iVertexIdx].y, patch.vVertices[iVertexIdx].z);
+				for (int iCameraIdx = 0; iCameraIdx < iCameraNum; ++iCameraIdx)
+				{
+					vProjections[(size_t)iVertexIdx * iCameraNum + iCameraIdx] = GPatchesGenerator::ProjectVertex(vProjectorObjs[iCameraIdx](ptVertex));
+				}
+			}
+		});
+
+		//the cameras of a triangle are chosen the way GPatchesGenerator::GeneratePatchesOfTriangles() does.
+		for (int i = 0; i < patch.vVerticeIndices.size(); i += 3)
+		{
+			std::bitset<MAX_PATCHES_NUM> bsTriangleTexture;
+			for (int j = 0; j < iCameraNum; ++j)
+			{
+				if (vProjections[(size_t)patch.vVerticeIndices[i] * iCameraNum + j].bInside
+					|| vProjections[(size_t)patch.vVerticeIndices[i + 1] * iCameraNum + j].bInside
+					|| vProjections[(size_t)patch.vVerticeIndices[i + 2] * iCameraNum + j].bInside)
+				{
+					bsTriangleTexture.set(j);
+					if (bsTriangleTexture.count() >= MAX_PATCHES_NUM)
+					{
+						break;
+					}
+				}
+			}
+
+			if (bsTriangleTexture != bsTexture)
+			{
+				GLOGGER(info) << "GRenderScene::Update(). the cameras of a patch change, the scene has to be created again.";
+				return false;
+			}
+		}
+
+		std::vector<std::vector<tTextureCoordinate>>& vTextureCoordinates = vPatchTextureCoordinates[iPatchIdx];
+		vTextureCoordinates.resize(bsTexture.count());
+		for (int iTextureIdx = 0; iTextureIdx < vTextureCoordinates.size(); ++iTextureIdx)
+		{
+			vTextureCoordinates[iTextureIdx].reserve(iVertexNum);
+		}
+		for (int iVertexIdx = 0; iVertexIdx < iVertexNum; ++iVertexIdx)
+		{
+			const GPatchesGenerator::tVertexProjection* pProjections = &vProjections[(size_t)iVertexIdx * iCameraNum];
+			float fTotalWeight = 0.0f;
+			for (int k = 0; k < iCameraNum; ++k)
+			{
+				if (bsTexture[k])
+				{
+					fTotalWeight += pProjections[k].weight;
+				}
+			}
+
+			int iTextureIdx = 0;
+			for (int k = 0; k < iCameraNum; ++k)
+			{
+				if (bsTexture[k])
+				{
+					vTextureCoordinates[iTextureIdx].push_back(tTextureCoordinate(pProjections[k].u, pProjections[k].v
+						, (fTotalWeight == 0) ? 0.0f : pProjections[k].weight / fTotalWeight));
+					++iTextureIdx;
+				}
+			}
+		}
+		uiVertexNum += iVertexNum;
+	}
+
+	iPatchIdx = 0;
+	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it, ++iPatchIdx)
+	{
+		for (int iTextureIdx = 0; iTextureIdx < it->second.vMultiTextureCoordinates.size(); ++iTextureIdx)
+		{
+			it->second.vMultiTextureCoordinates[iTextureIdx].second.swap(vPatchTextureCoordinates[iPatchIdx][iTextureIdx]);
+		}
+	}
+
+	for (int i = 0; i < m_vPatchBatches.size(); ++i)
+	{
+		m_vPatchBatches[i].UpdateTextureCoordinates();
+	}
+
+	GLOGGER(info) << "GRenderScene::Update(). texture coordinates of " << uiVertexNum << " patch vertices updated in "
+		<< std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count() << " ms.";
+	return true;
+}
+
+template bool GRenderScene::Update(const std::vector<GProjectorObjectGlobal3d2NormalizedPix>& vProjectorObjs);
+template bool GRenderScene::Update(const std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix>& vProjectorObjs);
+template bool GRenderScene::Update(const std::vector<GProjectorObjectCylinderExpandedPlaneSplited3d2NormalizedPix>& vProjectorObjs);
+template bool GRenderScene::Update(const std::vector<GProjectorObjectCylinderExpandedPlaneSplitedFrontBack3d2NormalizedPix>& vProjectorObjs);
+template bool GRenderScene::Update(const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix180>& vProjectorObjs);
+template bool GRenderScene::Update(const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360>& vProjectorObjs);
+template bool GRenderScene::Update(const std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360CircularBinocular>& vProjectorObjs);
+template bool GRenderScene::Update(const std::vector<GProjectorObjectOriginal3d2NormalizedPix>& vProjectorObjs);
+
+bool GRenderScene::Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV)
+{
+	auto tpStart = std::chrono::steady_clock::now();
+	m_renderCounters = GRenderCounters();
+
+	//the texture bindings are left over from the last draw call outside of the scene, they are all bound again.
+	std::vector<GLuint> vBoundTextures;
+	glm::mat4 glmMVP = matP * matV * glm::mat4();
+	if (0 != m_uiTransformUBO)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, m_uiTransformUBO);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), &glmMVP[0][0]);
+		glBindBufferBase(GL_UNIFORM_BUFFER, GGLSLBlenderGenerator::TRANSFORM_BLOCK_BINDING, m_uiTransformUBO);
+		m_renderCounters.iStateChanges += 3;
+	}
+	if (0 < m_remapTable.iLayerNum)
+	{
+		m_remapPass.Render(textureGroup, glmMVP, m_renderCounters);
+	}
+	for (int i = 0; i < m_vPatchBatches.size(); ++i)
+	{
+		m_vPatchBatches[i].Render(textureGroup, glmMVP, vBoundTextures, m_renderCounters);
+	}
+
+	if (opengl_compatible(3, 0))
+	{
+		glBindVertexArray(0);
+	}
+	glUseProgram(0);
+	m_renderCounters.iStateChanges += opengl_compatible(3, 0) ? 2 : 1;
+
+	m_renderCounters.dCPUTime_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count();
+	return true;
+}
+
+GRenderCounters GRenderScene::GetRenderCounters() const
+{
+	return m_renderCounters;
+}
+
+size_t GRenderScene::GetMemorySize() const
+{
+	size_t ullSize_Byte = m_remapPass.GetTextureSize();
+	for (int i = 0; i < m_vPatchBatches.size(); ++i)
+	{
+		ullSize_Byte += m_vPatchBatches[i].GetBufferSize();
+	}
+
+	ullSize_Byte += sizeof(tVertex) * m_vVertices.capacity() + sizeof(GLuint) * m_vVerticeIndices.capacity();
+	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	{
+		const GScenePatch& patch = it->second;
+		ullSize_Byte += sizeof(tVertex) * patch.vVertices.capacity() + sizeof(GLuint) * patch.vVerticeIndices.capacity()
+			+ sizeof(GScenePatch::tCluster) * patch.vClusters.capacity();
+		for (int i = 0; i < patch.vMultiTextureCoordinates.size(); ++i)
+		{
+			ullSize_Byte += sizeof(tTextureCoordinate) * patch.vMultiTextureCoordinates[i].second.capacity();
+		}
+	}
+
+	for (int i = 0; i < m_remapTable.vLayers.size(); ++i)
+	{
+		ullSize_Byte += sizeof(GRemapTable::tTexel) * m_remapTable.vLayers[i].capacity();
+	}
+	return ullSize_Byte;
+}
+
+bool GRenderScene::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const
+{
+	glm::mat4 glmMVP = matP * matV * glm::mat4();
+	for (int iCameraIdx = 0; iCameraIdx < m_remapTable.iCameraNum; ++iCameraIdx)
+	{
+		if ((iCameraIdx < vVisible.size()) && m_remapTable.IsCameraInFrustum(iCameraIdx, glmMVP))
+		{
+			vVisible[iCameraIdx] = true;
+		}
+	}
+
+	for (auto it = m_mpScenePatches.begin(); it != m_mpScenePatches.end(); ++it)
+	{
+		const GScenePatch& patch = it->second;
+		if (!patch.IsInFrustum(glmMVP))
+		{
+			continue;
+		}
+
+		for (int i = 0; i < patch.vMultiTextureCoordinates.size(); ++i)
+		{
+			int iCameraIdx = patch.vMultiTextureCoordinates[i].first;
+			if ((0 <= iCameraIdx) && (iCameraIdx < vVisible.size()))
+			{
+				vVisible[iCameraIdx] = true;
+			}
+		}
+	}
+	return true;
+}
+
+void GRenderScene::Release()
+{
+	for (int i = 0; i < m_vPatchBatches.size(); ++i)
+	{
+		m_vPatchBatches[i].Release();
+	}
+	m_vPatchBatches.clear();
+
+	if (0 != m_uiTransformUBO)
+	{
+		glDeleteBuffers(1, &m_uiTransformUBO);
+		m_uiTransformUBO = 0;
+	}
+
+	m_remapPass.Release();
+	m_remapTable.Release();
+}
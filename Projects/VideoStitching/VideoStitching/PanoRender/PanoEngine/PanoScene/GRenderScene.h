@@ -27,8 +27,10 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <bitset>
 #include <memory>
+#include <functional>
 
 #include "GCameraModel.h"
 #include "PanoRender/GPanoRenderCommonIF.h"
@@ -66,9 +68,50 @@ public:
 class GScenePatch
 {
 public:
-	GScenePatch():
-		m_uiVAO(0)
+	//indexed mesh, every vertex of the patch is stored once with one texture coordinate per camera.
+	std::vector<tVertex> vVertices;
+	std::vector<GLuint> vVerticeIndices;
+	std::vector<std::pair<int, std::vector<tTextureCoordinate>>> vMultiTextureCoordinates;
+
+	//a spatially compact range of the triangles of vVerticeIndices, culled on its own.
+	struct tCluster
+	{
+		int iIndexBegin;
+		int iIndexNum;
+		glm::vec3 v3BoundingBoxMin;
+		glm::vec3 v3BoundingBoxMax;
+	};
+	std::vector<tCluster> vClusters;
+
+public:
+	//reorder the triangles into clusters of at most iMaxTriangleNum triangles, split at the median of their longest axis.
+	void CreateClusters(int iMaxTriangleNum);
+	//axis aligned bounding box of vVertices, in scene coordinates.
+	void CalcBoundingBox();
+	//false if the bounding box, or the box of every cluster, is completely outside the view frustum of matMVP.
+	bool IsInFrustum(const glm::mat4& matMVP) const;
+
+	static bool IsBoxInFrustum(const glm::vec3& v3BoundingBoxMin, const glm::vec3& v3BoundingBoxMax, const glm::mat4& matMVP);
+private:
+	void SplitClusters(std::vector<int>& vTriangles, int iBegin, int iEnd, const std::vector<glm::vec3>& vCentroids, int iMaxTriangleNum);
+private:
+	glm::vec3 m_v3BoundingBoxMin;
+	glm::vec3 m_v3BoundingBoxMax;
+};
+
+//the patches of the same number of cameras share one program, one vertex array and one set of buffers.
+//the program, the transform and the vertex array are set once for all of them, a patch only binds the textures
+//of its cameras which are not bound yet, and draws its clusters in the view frustum from its range of the shared index buffer.
+class GScenePatchBatch
+{
+public:
+	GScenePatchBatch() :
+		m_iLayerNum(0)
+		, m_iPlaneNum(0)
+		, m_uiVAO(0)
 		, m_uiBlender(0)
+		, m_iMVPLocation(-1)
+		, m_ullBufferSize_Byte(0)
 	{}
 
 	enum enVBOType
@@ -78,50 +121,249 @@ public:
 		eVBOTypeTexture,
 	};
 
-	std::vector<tVertex> vVertices;
-	std::vector<GLuint> vVerticeIndices;
-	std::vector<std::pair<int, std::vector<tTextureCoordinate>>> vMultiTextureCoordinates;
+	//vPatches: the patches of iLayerNum cameras. the program is taken from ptrProgramCache if it is not null.
+	bool Prepare(int iLayerNum, const std::vector<const GScenePatch*>& vPatches, enFrameFormat eFrameFormat
+		, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache);
+
+	//upload the texture coordinates of the patches again, the number of their vertices must not have changed.
+	void UpdateTextureCoordinates();
+
+	//vBoundTextures: texture bound to each texture unit, shared by the batches of a scene and updated.
+	void Render(const GTextureGroup& textureGroup, const glm::mat4& matMVP, std::vector<GLuint>& vBoundTextures, GRenderCounters& counters);
+
+	//bytes of the vertex, index and texture coordinate buffers.
+	size_t GetBufferSize() const { return m_ullBufferSize_Byte; }
 
-public:
-	bool Prepare(enFrameFormat eFrameFormat);
-	bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
 	void Release();
 private:
-	void SetUpVertexAttributes();
+	struct tPatchRange
+	{
+		const GScenePatch* pPatch;
+		std::vector<int> vCameraIndices;
+		GLsizei iIndexNum;
+		size_t ullIndexOffset_Byte;
+	};
+
+	void SetUpVertexAttributes(const std::vector<const GScenePatch*>& vPatches);
+
+	void BindVertexAttributes(GRenderCounters& counters);
+
+	//the visible clusters of a patch, adjacent ones are merged into one run of indices.
+	void CollectVisibleRuns(const tPatchRange& range, const glm::mat4& matMVP);
 private:
+	int m_iLayerNum;
+	//textures of a camera, 1 for RGB, 3 for YUV420P and 2 for NV12.
+	int m_iPlaneNum;
+	std::vector<tPatchRange> m_vPatchRanges;
+	//runs of the patch being drawn, kept to save the allocations.
+	std::vector<GLsizei> m_vRunIndexNums;
+	std::vector<const void*> m_vRunOffsets;
+
 	std::vector<GLuint> m_vVBOs;
 	GLuint m_uiVAO;
 	GLuint m_uiBlender;
+	//-1 if the MVP matrix is read from the uniform block of the scene.
+	GLint m_iMVPLocation;
+	//owner of m_uiBlender, null if the batch owns it.
+	std::shared_ptr<GGLSLProgramCache> m_ptrProgramCache;
+	size_t m_ullBufferSize_Byte;
 };
 
 class GPatchesGenerator
 {
 public:
+	//the triangles are split into contiguous ranges generated in parallel, iThreadNum <= 0 uses all the cores.
+	//the partial patches are merged in range order, so the result does not depend on iThreadNum.
 	template<class tProjectorObject>
 	static void GeneratePatches(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
 		, const std::vector<tProjectorObject>& vProjectorObjs
-		, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+		, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches
+		, int iThreadNum = 0);
 
 private:
+	//the remap tables project every pixel the way a vertex is projected.
+	friend class GRemapTable;
+	friend class GRenderScene;
+
+	//projection of one vertex into one camera, u and v are FLT_MAX where the projection is undefined.
+	struct tVertexProjection
+	{
+		float u;
+		float v;
+		float weight;
+		bool bInside;
+	};
+
+	//surface vertex of every patch vertex and the reverse lookup, only needed while the patches are generated.
+	struct tPatchVertexMap
+	{
+		std::vector<GLuint> vSurfaceVertexIndices;
+		std::unordered_map<GLuint, GLuint> mpPatchVertexIndices;
+	};
+	typedef std::map < std::bitset<MAX_PATCHES_NUM>, tPatchVertexMap, BitsetLessThan> tPatchVertexMaps;
+
+	static tVertexProjection ProjectVertex(const cv::Point3f& ptProjected);
+
+	static void GeneratePatchesOfTriangles(const std::vector<tVertex>& vVertices, const std::vector<GLuint>& vVerticeIndices
+		, const std::vector<tVertexProjection>& vProjections, const std::vector<int>& vCameraIndices, int iTriangleBegin, int iTriangleEnd
+		, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches, tPatchVertexMaps& mpPatchVertexMaps);
+
+	static int CalcRangeNum(int iItemNum, int iThreadNum);
+
+	//split [0, iItemNum) into iRangeNum contiguous ranges and run them in parallel, the first one on the calling thread.
+	static void RunInRanges(int iItemNum, int iRangeNum, const std::function<void(int iRangeIdx, int iBegin, int iEnd)>& fnRunRange);
+
+	//append the triangles of mpSrcPatches to mpDstPatches, vertices of the same surface vertex are shared.
+	static void MergePatches(std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpSrcPatches, tPatchVertexMaps& mpSrcPatchVertexMaps
+		, std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpDstPatches, tPatchVertexMaps& mpDstPatchVertexMaps);
+
 	static float CalcWeight(const cv::Point2f& ptPosition, const cv::Mat& mK, float fDistortionValidRange);
 };
 
+//cameras of every pixel of a plane surface, looked up per pixel instead of interpolated over a tessellated surface.
+//a pixel keeps at most iLayerNum cameras, layer 0 holds the one of the largest weight, the unused layers have no weight.
+class GRemapTable
+{
+public:
+	GRemapTable() :
+		iWidth(0)
+		, iHeight(0)
+		, iLayerNum(0)
+		, iCameraNum(0)
+		, fPlaneWidth(0.0f)
+		, fPlaneHeight(0.0f)
+	{}
+
+	//u, v, the weight and the camera index + 1 of a pixel in one layer, normalized to 16 bits. camera 0 is no camera.
+	struct tTexel
+	{
+		unsigned short u;
+		unsigned short v;
+		unsigned short weight;
+		unsigned short camera;
+	};
+
+	//pixel (i, j) is the point (-fPlaneWidth / 2 + (i + 0.5) * fPlaneWidth / iWidth, -fPlaneHeight / 2 + (j + 0.5) * fPlaneHeight / iHeight, 0).
+	//the rows are split into ranges generated in parallel, iThreadNum <= 0 uses all the cores.
+	template<class tProjectorObject>
+	void Generate(float fSurfaceWidth, float fSurfaceHeight, int iTableWidth, int iTableHeight
+		, const std::vector<tProjectorObject>& vProjectorObjs, int iMaxLayerNum, int iThreadNum = 0);
+
+	//false if none of the pixels of the camera is in the view frustum of matMVP.
+	bool IsCameraInFrustum(int iCameraIdx, const glm::mat4& matMVP) const;
+
+	void Release();
+public:
+	int iWidth;
+	int iHeight;
+	int iLayerNum;
+	//1 + the largest camera index of the projectors.
+	int iCameraNum;
+	float fPlaneWidth;
+	float fPlaneHeight;
+	//iWidth * iHeight texels per layer, row by row from the bottom of the plane.
+	std::vector<std::vector<tTexel>> vLayers;
+	//bounding box of the pixels of each camera, empty if min > max.
+	std::vector<glm::vec3> vCameraBoxMins;
+	std::vector<glm::vec3> vCameraBoxMaxs;
+};
+
+//draws a remap table in one pass over the plane, every camera frame is bound at once and selected per pixel.
+class GRemapPass
+{
+public:
+	GRemapPass() :
+		m_iLayerNum(0)
+		, m_iCameraNum(0)
+		, m_iPlaneNum(0)
+		, m_uiVBO(0)
+		, m_uiVAO(0)
+		, m_uiBlender(0)
+		, m_iMVPLocation(-1)
+		, m_ullTextureSize_Byte(0)
+	{}
+
+	//texture units taken by a pass of iLayerNum layers, iCameraNum cameras of eFrameFormat, 0 if the format is not supported.
+	static int CalcTextureUnitNum(int iLayerNum, int iCameraNum, enFrameFormat eFrameFormat);
+
+	//the program is taken from ptrProgramCache if it is not null.
+	bool Prepare(const GRemapTable& table, enFrameFormat eFrameFormat, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache);
+
+	void Render(const GTextureGroup& textureGroup, const glm::mat4& matMVP, GRenderCounters& counters);
+
+	//bytes of the tables and of the quad.
+	size_t GetTextureSize() const { return m_ullTextureSize_Byte; }
+
+	void Release();
+private:
+	int m_iLayerNum;
+	int m_iCameraNum;
+	int m_iPlaneNum;
+	std::vector<GLuint> m_vTables;
+	GLuint m_uiVBO;
+	GLuint m_uiVAO;
+	GLuint m_uiBlender;
+	//-1 if the MVP matrix is read from the uniform block of the scene.
+	GLint m_iMVPLocation;
+	//owner of m_uiBlender, null if the pass owns it.
+	std::shared_ptr<GGLSLProgramCache> m_ptrProgramCache;
+	size_t m_ullTextureSize_Byte;
+};
+
 class GRenderScene
 {
 public:
+	GRenderScene() :
+		m_uiTransformUBO(0)
+	{}
+
+	//the tessellation tolerance of config makes the surface subdivision adaptive.
+	//a plane surface is drawn from a remap table instead if config has a remap table size and the gpu can sample all the cameras in one pass.
 	template<class tProjectorObject>
-	bool Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator, const std::vector<tProjectorObject>& vProjectorObjs);
+	bool Create(std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator, const std::vector<tProjectorObject>& vProjectorObjs
+		, const GStitcherConfig& config);
+
+	//the programs are shared through ptrProgramCache if it is not null, see GStitcherConfig::m_ptrProgramCache.
+	bool Prepare(enFrameFormat eFrameFormat, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache);
 
-	bool Prepare(enFrameFormat eFrameFormat);
+	//starts linking the programs Prepare() takes from ptrProgramCache, true once they are all linked. always true without a cache.
+	bool RequestPrograms(enFrameFormat eFrameFormat, const std::shared_ptr<GGLSLProgramCache>& ptrProgramCache);
+
+	//project the vertices of the prepared patches again and replace their texture coordinates in the buffers.
+	//false, with the scene untouched, if a triangle would move to a patch of other cameras or the scene is drawn from a remap table.
+	template<class tProjectorObject>
+	bool Update(const std::vector<tProjectorObject>& vProjectorObjs);
 
 	bool Render(const GTextureGroup& textureGroup, const glm::mat4& matP, const glm::mat4& matV);
 
+	//set vVisible[i] for the cameras used by the patches in the view frustum.
+	bool GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible) const;
+
+	//GL calls of the last Render().
+	GRenderCounters GetRenderCounters() const;
+
+	//bytes of the buffers and textures on the gpu and of the patches and tables kept on the host.
+	size_t GetMemorySize() const;
+
 	void Release();
+private:
+	//false if the remap table can not be drawn, the tessellated surface is drawn then.
+	template<class tProjectorObject>
+	bool CreateRemapTable(float fPlaneWidth, float fPlaneHeight, const std::vector<tProjectorObject>& vProjectorObjs, const GStitcherConfig& config);
 private:
 	std::vector<tVertex> m_vVertices;
 	std::vector<GLuint> m_vVerticeIndices;
 
 	std::map< std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan> m_mpScenePatches;
+
+	//by number of cameras.
+	std::vector<GScenePatchBatch> m_vPatchBatches;
+	//used instead of the patches if it has layers.
+	GRemapTable m_remapTable;
+	GRemapPass m_remapPass;
+	//MVP matrix of the GLSL 330 programs, written once per Render() for all the batches. 0 with the GLSL 120 programs.
+	GLuint m_uiTransformUBO;
+	GRenderCounters m_renderCounters;
 };
 
 
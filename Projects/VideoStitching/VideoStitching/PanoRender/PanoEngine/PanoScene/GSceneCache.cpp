@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#include "GSceneCache.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "boost/filesystem.hpp"
+
+#include "GCacheFile.h"
+#include "Common/GiraffeLogger/GiraffeLogger.h"
+#include "GPanoTypeStaticParameters.h"
+
+static const char s_szFileMagic[4] = { 'G', 'S', 'C', 'N' };
+static const char s_szFileEndMagic[4] = { 'G', 'E', 'N', 'D' };
+static const char* s_szFilePrefix = "scene_";
+static const char* s_szFileExtension = ".bin";
+//upper bound of the element counts read from a file.
+static const uint64_t s_ullMaxElementNum = 1ULL << 32;
+
+static void WriteMat(std::ostream& os, const cv::Mat& m)
+{
+	cv::Mat mContinuous = m.isContinuous() ? m : m.clone();
+	GCacheFile::WriteValue(os, mContinuous.rows);
+	GCacheFile::WriteValue(os, mContinuous.cols);
+	GCacheFile::WriteValue(os, mContinuous.type());
+	os.write(reinterpret_cast<const char*>(mContinuous.data), mContinuous.total() * mContinuous.elemSize());
+}
+
+std::string GSceneCache::CreateKey(enPanoType ePanoType, const std::vector<CameraModel>& vCameras, const std::string& sK0Name
+	, const Eigen::Vector4f& v4fCropRatios, const GStitcherConfig& config)
+{
+	std::ostringstream oss(std::ios::binary);
+	GCacheFile::WriteValue(oss, static_cast<unsigned int>(s_uiVersion));
+	GCacheFile::WriteValue(oss, static_cast<int>(ePanoType));
+	GCacheFile::WriteValue(oss, GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoType));
+	GCacheFile::WriteValue(oss, GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoType));
+	GCacheFile::WriteString(oss, sK0Name);
+	for (int i = 0; i < 4; ++i)
+	{
+		GCacheFile::WriteValue(oss, v4fCropRatios[i]);
+	}
+
+	GCacheFile::WriteValue(oss, config.m_iTessellationLevel);
+	GCacheFile::WriteValue(oss, config.m_fTessellationTolerance_px);
+	//the frame size only matters to the adaptive subdivision.
+	if (0.0f < config.m_fTessellationTolerance_px)
+	{
+		GCacheFile::WriteValue(oss, config.m_iInputFrameWidth);
+		GCacheFile::WriteValue(oss, config.m_iInputFrameHeight);
+	}
+	//a plane drawn from a remap table is not cached, its key only has to differ from the one of the tessellated plane.
+	if ((0 < config.m_iRemapTableWidth) && (0 < config.m_iRemapTableHeight))
+	{
+		GCacheFile::WriteValue(oss, config.m_iRemapTableWidth);
+		GCacheFile::WriteValue(oss, config.m_iRemapTableHeight);
+	}
+
+	GCacheFile::WriteValue(oss, static_cast<uint64_t>(vCameras.size()));
+	for (int i = 0; i < vCameras.size(); ++i)
+	{
+		const CameraModel& camera = vCameras[i];
+		GCacheFile::WriteValue(oss, static_cast<int>(camera.eCameraType));
+		GCacheFile::WriteString(oss, camera.sCameraName);
+		WriteMat(oss, camera.K0);
+		WriteMat(oss, camera.distorsionCoefficients);
+		WriteMat(oss, camera.K);
+		WriteMat(oss, camera.R);
+		WriteMat(oss, camera.t);
+		GCacheFile::WriteValue(oss, camera.dDistortionValidRange);
+		GCacheFile::WriteValue(oss, static_cast<uint64_t>(camera.m_mpMultiK0Map.size()));
+		for (auto it = camera.m_mpMultiK0Map.begin(); it != camera.m_mpMultiK0Map.end(); ++it)
+		{
+			GCacheFile::WriteString(oss, it->first);
+			WriteMat(oss, it->second);
+		}
+	}
+	return oss.str();
+}
+
+std::string GSceneCache::GetFilePath(const std::string& sDirectory, const std::string& sKey)
+{
+	return GCacheFile::GetFilePath(sDirectory, s_szFilePrefix, sKey, s_szFileExtension);
+}
+
+bool GSceneCache::Load(const std::string& sFilePath, const std::string& sKey
+	, std::map<std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches)
+{
+	try
+	{
+		std::ifstream ifs(sFilePath, std::ios::binary);
+		if (!ifs.good())
+		{
+			return false;
+		}
+
+		char szMagic[4] = { 0 };
+		unsigned int uiVersion = 0;
+		if (!ifs.read(szMagic, sizeof(szMagic)) || (0 != memcmp(szMagic, s_szFileMagic, sizeof(szMagic))) ||
+			!GCacheFile::ReadValue(ifs, uiVersion) || (s_uiVersion != uiVersion))
+		{
+			GLOGGER(info) << "GSceneCache::Load(). " << sFilePath << " is of another version. ==>";
+			return false;
+		}
+
+		//a different key with the same hash.
+		std::vector<char> vKey;
+		if (!GCacheFile::ReadVector(ifs, vKey, sKey.size()) || (vKey.size() != sKey.size()) || !std::equal(vKey.begin(), vKey.end(), sKey.begin()))
+		{
+			GLOGGER(info) << "GSceneCache::Load(). " << sFilePath << " belongs to another scene. ==>";
+			return false;
+		}
+
+		std::map<std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan> mpLoadedPatches;
+		bool bRet = true;
+		uint64_t ullPatchNum = 0;
+		bRet = GCacheFile::ReadValue(ifs, ullPatchNum) && (ullPatchNum <= s_ullMaxElementNum);
+		for (uint64_t ullPatchIdx = 0; bRet && (ullPatchIdx < ullPatchNum); ++ullPatchIdx)
+		{
+			uint64_t ullCameras = 0;
+			uint64_t ullCameraNum = 0;
+			bRet = GCacheFile::ReadValue(ifs, ullCameras) && GCacheFile::ReadValue(ifs, ullCameraNum) && (ullCameraNum <= MAX_PATCHES_NUM);
+			if (!bRet)
+			{
+				break;
+			}
+
+			GScenePatch& patch = mpLoadedPatches[std::bitset<MAX_PATCHES_NUM>((unsigned long long)ullCameras)];
+			bRet = GCacheFile::ReadVector(ifs, patch.vVertices, s_ullMaxElementNum) && GCacheFile::ReadVector(ifs, patch.vVerticeIndices, s_ullMaxElementNum);
+			for (uint64_t ullCameraIdx = 0; bRet && (ullCameraIdx < ullCameraNum); ++ullCameraIdx)
+			{
+				int iCameraIdx = 0;
+				std::vector<tTextureCoordinate> vTextureCoordinates;
+				bRet = GCacheFile::ReadValue(ifs, iCameraIdx) && GCacheFile::ReadVector(ifs, vTextureCoordinates, patch.vVertices.size())
+					&& (vTextureCoordinates.size() == patch.vVertices.size());
+				patch.vMultiTextureCoordinates.push_back(std::make_pair(iCameraIdx, std::move(vTextureCoordinates)));
+			}
+		}
+
+		char szEndMagic[4] = { 0 };
+		bRet = bRet && ifs.read(szEndMagic, sizeof(szEndMagic)) && (0 == memcmp(szEndMagic, s_szFileEndMagic, sizeof(szEndMagic)));
+		if (!bRet)
+		{
+			GLOGGER(error) << "GSceneCache::Load(). " << sFilePath << " is broken, removed. ==>";
+			ifs.close();
+			std::remove(sFilePath.c_str());
+			return false;
+		}
+
+		mpPatches.swap(mpLoadedPatches);
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GSceneCache::Load(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GSceneCache::Save(const std::string& sFilePath, const std::string& sKey
+	, const std::map<std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches)
+{
+	return GCacheFile::Write(sFilePath, [&](std::ostream& os)
+	{
+		os.write(s_szFileMagic, sizeof(s_szFileMagic));
+		GCacheFile::WriteValue(os, static_cast<unsigned int>(s_uiVersion));
+		GCacheFile::WriteString(os, sKey);
+
+		GCacheFile::WriteValue(os, static_cast<uint64_t>(mpPatches.size()));
+		for (auto it = mpPatches.begin(); it != mpPatches.end(); ++it)
+		{
+			const GScenePatch& patch = it->second;
+			GCacheFile::WriteValue(os, static_cast<uint64_t>(it->first.to_ullong()));
+			GCacheFile::WriteValue(os, static_cast<uint64_t>(patch.vMultiTextureCoordinates.size()));
+			GCacheFile::WriteVector(os, patch.vVertices);
+			GCacheFile::WriteVector(os, patch.vVerticeIndices);
+			for (int i = 0; i < patch.vMultiTextureCoordinates.size(); ++i)
+			{
+				GCacheFile::WriteValue(os, patch.vMultiTextureCoordinates[i].first);
+				GCacheFile::WriteVector(os, patch.vMultiTextureCoordinates[i].second);
+			}
+		}
+		os.write(s_szFileEndMagic, sizeof(s_szFileEndMagic));
+	});
+}
+
+bool GSceneCache::Clear(const std::string& sDirectory)
+{
+	try
+	{
+		boost::system::error_code ec;
+		if (!boost::filesystem::is_directory(sDirectory, ec))
+		{
+			return true;
+		}
+
+		//collected first, the directory is not modified while it is iterated.
+		std::vector<boost::filesystem::path> vFiles;
+		std::string sPrefix(s_szFilePrefix);
+		for (boost::filesystem::directory_iterator it(sDirectory), itEnd; it != itEnd; ++it)
+		{
+			std::string sFileName = it->path().filename().string();
+			if ((0 == sFileName.compare(0, sPrefix.size(), sPrefix)) && (std::string::npos != sFileName.find(s_szFileExtension)))
+			{
+				vFiles.push_back(it->path());
+			}
+		}
+
+		bool bRet = true;
+		for (int i = 0; i < vFiles.size(); ++i)
+		{
+			if (!boost::filesystem::remove(vFiles[i], ec))
+			{
+				GLOGGER(error) << "GSceneCache::Clear(). Remove " << vFiles[i].string() << " FAILED. ==>";
+				bRet = false;
+			}
+		}
+		GLOGGER(info) << "GSceneCache::Clear(). " << vFiles.size() << " files in " << sDirectory << ". ==>";
+		return bRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GSceneCache::Clear(). EXCEPTION. ==>";
+		return false;
+	}
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#ifndef G_SCENE_CACHE_H_
+#define G_SCENE_CACHE_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <bitset>
+
+#include "GRenderScene.h"
+#include "GPanoCameraInfo.h"
+
+//generated scene patches stored in a local directory, one file per scene.
+//a file is found by a hash of everything the patches depend on and holds that description in full,
+//so a scene is regenerated whenever one of its inputs changes. the files are native endian, not meant to be shared between machines.
+class GSceneCache
+{
+public:
+	//bump whenever the scene generation or the file layout changes, files of other versions are regenerated.
+	static const unsigned int s_uiVersion = 1;
+
+	//description of the inputs of a scene, the key of its cache file.
+	static std::string CreateKey(enPanoType ePanoType, const std::vector<CameraModel>& vCameras, const std::string& sK0Name
+		, const Eigen::Vector4f& v4fCropRatios, const GStitcherConfig& config);
+
+	static std::string GetFilePath(const std::string& sDirectory, const std::string& sKey);
+
+	//false if the file is missing, of another version or key, or broken. a broken file is removed.
+	static bool Load(const std::string& sFilePath, const std::string& sKey
+		, std::map<std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+
+	//written to a temporary file first, a concurrent reader never sees a partial file.
+	static bool Save(const std::string& sFilePath, const std::string& sKey
+		, const std::map<std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches);
+
+	//remove all the cache files in the directory.
+	static bool Clear(const std::string& sDirectory);
+};
+
+#endif//!G_SCENE_CACHE_H_
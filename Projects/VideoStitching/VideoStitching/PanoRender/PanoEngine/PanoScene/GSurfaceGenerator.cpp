@@ -24,69 +24,235 @@
  
 #include "GSurfaceGenerator.h"
 
+#include <cstring>
+
 #include "Common/GiraffeLogger/GiraffeLogger.h"
 
+//adaptive subdivision: the first levels are always subdivided, a camera could otherwise fall between the samples of a big cell.
+static const int s_iMinAdaptiveLevel = 3;
+//deepest chain of finer vertices searched on one edge.
+static const int s_iMaxEdgeSplitDepth = 32;
+
+static bool ShouldRefine(const tRefinePredicate& fnShouldRefine, int iLevel
+	, const Eigen::Vector3f* pEndPoints, const Eigen::Vector3f* pMidPoints, int iEdgeNum)
+{
+	return (!fnShouldRefine) || (iLevel < s_iMinAdaptiveLevel) || fnShouldRefine(pEndPoints, pMidPoints, iEdgeNum);
+}
+
+//the midpoints of the subdivisions, projected back onto the surfaces.
+static Eigen::Vector3f ToSphere(const Eigen::Vector3f& vu)
+{
+	Eigen::Vector3f u = vu;
+	u /= u.norm();
+	return u;
+}
+
+static Eigen::Vector3f ToPlane(const Eigen::Vector3f& vu)
+{
+	return vu;
+}
+
+static Eigen::Vector3f ToCylinder(const Eigen::Vector3f& vu)
+{
+	Eigen::Vector3f u = vu;
+	float fDistance = sqrtf(powf(u[0], 2) + powf(u[2], 2));
+	u[0] /= fDistance;
+	u[2] /= fDistance;
+	return u;
+}
+
+
+tVertexPosition::tVertexPosition(float fX, float fY, float fZ)
+{
+	memcpy(&uiX, &fX, sizeof(float));
+	memcpy(&uiY, &fY, sizeof(float));
+	memcpy(&uiZ, &fZ, sizeof(float));
+}
+
+GIndexedMeshBuilder::GIndexedMeshBuilder(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices) :
+	m_vVertices(vVertices)
+	, m_vVerticeIndices(vVerticeIndices)
+{}
+
+void GIndexedMeshBuilder::AddTriangle(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3)
+{
+	m_vVerticeIndices.push_back(AddVertex(vu1));
+	m_vVerticeIndices.push_back(AddVertex(vu2));
+	m_vVerticeIndices.push_back(AddVertex(vu3));
+}
+
+void GIndexedMeshBuilder::FixTJunctions(const std::function<Eigen::Vector3f(const Eigen::Vector3f&)>& fnToSurface)
+{
+	std::vector<GLuint> vTriangles;
+	vTriangles.swap(m_vVerticeIndices);
+	m_vVerticeIndices.reserve(vTriangles.size());
+
+	std::vector<GLuint> vEdgeVertices[3];
+	std::vector<GLuint> vBoundary;
+	for (size_t i = 0; i + 2 < vTriangles.size(); i += 3)
+	{
+		const GLuint* pCorners = &vTriangles[i];
+
+		int iSplitEdgeNum = 0;
+		int iSplitEdgeIdx = 0;
+		for (int j = 0; j < 3; j++)
+		{
+			vEdgeVertices[j].clear();
+			CollectEdgeVertices(pCorners[j], pCorners[(j + 1) % 3], fnToSurface, s_iMaxEdgeSplitDepth, vEdgeVertices[j]);
+			if (!vEdgeVertices[j].empty())
+			{
+				iSplitEdgeNum++;
+				iSplitEdgeIdx = j;
+			}
+		}
+
+		if (0 == iSplitEdgeNum)
+		{
+			m_vVerticeIndices.insert(m_vVerticeIndices.end(), pCorners, pCorners + 3);
+			continue;
+		}
+
+		//the split triangles keep the winding of the original one.
+		if (1 == iSplitEdgeNum)
+		{
+			//fan from the corner opposite to the split edge.
+			GLuint uiApex = pCorners[(iSplitEdgeIdx + 2) % 3];
+			vBoundary.clear();
+			vBoundary.push_back(pCorners[iSplitEdgeIdx]);
+			vBoundary.insert(vBoundary.end(), vEdgeVertices[iSplitEdgeIdx].begin(), vEdgeVertices[iSplitEdgeIdx].end());
+			vBoundary.push_back(pCorners[(iSplitEdgeIdx + 1) % 3]);
+
+			for (size_t k = 0; k + 1 < vBoundary.size(); k++)
+			{
+				m_vVerticeIndices.push_back(uiApex);
+				m_vVerticeIndices.push_back(vBoundary[k]);
+				m_vVerticeIndices.push_back(vBoundary[k + 1]);
+			}
+			continue;
+		}
+
+		//fan from a new vertex in the middle of the triangle.
+		vBoundary.clear();
+		for (int j = 0; j < 3; j++)
+		{
+			vBoundary.push_back(pCorners[j]);
+			vBoundary.insert(vBoundary.end(), vEdgeVertices[j].begin(), vEdgeVertices[j].end());
+		}
+
+		Eigen::Vector3f vuCenter = (GetVertex(pCorners[0]) + GetVertex(pCorners[1]) + GetVertex(pCorners[2])) / 3.0f;
+		GLuint uiCenter = AddVertex(fnToSurface(vuCenter));
+		for (size_t k = 0; k < vBoundary.size(); k++)
+		{
+			m_vVerticeIndices.push_back(uiCenter);
+			m_vVerticeIndices.push_back(vBoundary[k]);
+			m_vVerticeIndices.push_back(vBoundary[(k + 1) % vBoundary.size()]);
+		}
+	}
+}
+
+GLuint GIndexedMeshBuilder::AddVertex(const Eigen::Vector3f& vu)
+{
+	auto ret = m_mpVertexIndices.insert(std::make_pair(tVertexPosition(vu[0], vu[1], vu[2]), (GLuint)m_vVertices.size()));
+	if (ret.second)
+	{
+		m_vVertices.push_back(tVertex(vu[0], vu[1], vu[2]));
+	}
+	return ret.first->second;
+}
+
+bool GIndexedMeshBuilder::FindVertex(const Eigen::Vector3f& vu, GLuint& uiVertexIdx) const
+{
+	auto it = m_mpVertexIndices.find(tVertexPosition(vu[0], vu[1], vu[2]));
+	if (it == m_mpVertexIndices.end())
+	{
+		return false;
+	}
+	uiVertexIdx = it->second;
+	return true;
+}
+
+Eigen::Vector3f GIndexedMeshBuilder::GetVertex(GLuint uiVertexIdx) const
+{
+	const tVertex& vertex = m_vVertices[uiVertexIdx];
+	return Eigen::Vector3f(vertex.x, vertex.y, vertex.z);
+}
+
+void GIndexedMeshBuilder::CollectEdgeVertices(GLuint uiVertexIdx1, GLuint uiVertexIdx2
+	, const std::function<Eigen::Vector3f(const Eigen::Vector3f&)>& fnToSurface, int iDepth, std::vector<GLuint>& vEdgeVertices) const
+{
+	if (iDepth <= 0)
+	{
+		return;
+	}
+
+	//a finer neighbour computed the same midpoint when it subdivided this edge.
+	GLuint uiMidIdx = 0;
+	if (!FindVertex(fnToSurface((GetVertex(uiVertexIdx1) + GetVertex(uiVertexIdx2)) / 2.0f), uiMidIdx))
+	{
+		return;
+	}
+
+	CollectEdgeVertices(uiVertexIdx1, uiMidIdx, fnToSurface, iDepth - 1, vEdgeVertices);
+	vEdgeVertices.push_back(uiMidIdx);
+	CollectEdgeVertices(uiMidIdx, uiVertexIdx2, fnToSurface, iDepth - 1, vEdgeVertices);
+}
 
 void GSurfaceGeneratorSphere::GenerateSurface(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
 {
 	vVertices.clear();
 	vVerticeIndices.clear();
+	GIndexedMeshBuilder meshBuilder(vVertices, vVerticeIndices);
 
 	float vertices0[6][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }
 	, { -1.0f, 0.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } };
 
-	int iDep = 7;
+	int iDep = m_iTessellationLevel;
 	//clock wise watch from outside.
-	SubDivide(Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[2]), iDep, vVertices, vVerticeIndices);
-	SubDivide(Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[2]), iDep, vVertices, vVerticeIndices);
-	SubDivide(Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[2]), iDep, vVertices, vVerticeIndices);
-	SubDivide(Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[2]), iDep, vVertices, vVerticeIndices);
+	SubDivide(Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[2]), iDep, meshBuilder);
+	SubDivide(Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[2]), iDep, meshBuilder);
+	SubDivide(Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[2]), iDep, meshBuilder);
+	SubDivide(Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[2]), iDep, meshBuilder);
 	if (m_bIsFullSphere)
 	{
-		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[0]), iDep, vVertices, vVerticeIndices);
-		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[1]), iDep, vVertices, vVerticeIndices);
-		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[3]), iDep, vVertices, vVerticeIndices);
-		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[4]), iDep, vVertices, vVerticeIndices);
+		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[0]), iDep, meshBuilder);
+		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[1]), iDep, meshBuilder);
+		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[3]), iDep, meshBuilder);
+		SubDivide(Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[4]), iDep, meshBuilder);
+	}
+
+	if (m_fnShouldRefine)
+	{
+		meshBuilder.FixTJunctions(ToSphere);
 	}
 }
 
+//the corners are on the sphere already, the midpoints are normalized once so that neighbours share them bitwise.
 void GSurfaceGeneratorSphere::SubDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3, int iDepth
-	, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
+	, GIndexedMeshBuilder& meshBuilder)
 {
-	Eigen::Vector3f u1 = vu1;
-	u1 /= u1.norm();
-	Eigen::Vector3f u2 = vu2;
-	u2 /= u2.norm();
-	Eigen::Vector3f u3 = vu3;
-	u3 /= u3.norm();
-
 	if (iDepth == 0)
 	{
-		vVertices.push_back(tVertex(u1[0], u1[1], u1[2]));
-		vVertices.push_back(tVertex(u2[0], u2[1], u2[2]));
-		vVertices.push_back(tVertex(u3[0], u3[1], u3[2]));
-
-		vVerticeIndices.push_back(vVertices.size() - 3);
-		vVerticeIndices.push_back(vVertices.size() - 2);
-		vVerticeIndices.push_back(vVertices.size() - 1);
-
+		meshBuilder.AddTriangle(vu1, vu2, vu3);
 		return;
 	}
 
-	Eigen::Vector3f u12, u23, u31;
-	u12 = (u1 + u2) / 2.0f;
-	u23 = (u2 + u3) / 2.0f;
-	u31 = (u3 + u1) / 2.0f;
+	Eigen::Vector3f u12 = ToSphere((vu1 + vu2) / 2.0f);
+	Eigen::Vector3f u23 = ToSphere((vu2 + vu3) / 2.0f);
+	Eigen::Vector3f u31 = ToSphere((vu3 + vu1) / 2.0f);
 
-	u12 /= u12.norm();
-	u23 /= u23.norm();
-	u31 /= u31.norm();
+	const Eigen::Vector3f vEndPoints[6] = { vu1, vu2, vu2, vu3, vu3, vu1 };
+	const Eigen::Vector3f vMidPoints[3] = { u12, u23, u31 };
+	if (!ShouldRefine(m_fnShouldRefine, m_iTessellationLevel - iDepth, vEndPoints, vMidPoints, 3))
+	{
+		meshBuilder.AddTriangle(vu1, vu2, vu3);
+		return;
+	}
 
 	//clock wise subdivide.
-	SubDivide(u1, u12, u31, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(u2, u23, u12, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(u3, u31, u23, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(u12, u23, u31, iDepth - 1, vVertices, vVerticeIndices);
+	SubDivide(vu1, u12, u31, iDepth - 1, meshBuilder);
+	SubDivide(vu2, u23, u12, iDepth - 1, meshBuilder);
+	SubDivide(vu3, u31, u23, iDepth - 1, meshBuilder);
+	SubDivide(u12, u23, u31, iDepth - 1, meshBuilder);
 }
 
 void GSurfaceGeneratorSphere::SetIsFullSphere(bool bIsFullSphere)
@@ -94,24 +260,45 @@ void GSurfaceGeneratorSphere::SetIsFullSphere(bool bIsFullSphere)
 	m_bIsFullSphere = bIsFullSphere;
 }
 
+void GSurfaceGeneratorSphere::SetTessellationLevel(int iTessellationLevel)
+{
+	m_iTessellationLevel = (iTessellationLevel < 0) ? 0 : iTessellationLevel;
+}
+
+void GSurfaceGeneratorSphere::SetRefinePredicate(const tRefinePredicate& fnShouldRefine)
+{
+	m_fnShouldRefine = fnShouldRefine;
+}
+
+bool GSurfaceGeneratorSphere::GetPlaneSize(float& fWidth, float& fHeight) const
+{
+	return false;
+}
+
 void GSurfaceGeneratorPlane::GenerateSurface(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
 {
 	vVertices.clear();
 	vVerticeIndices.clear();
+	GIndexedMeshBuilder meshBuilder(vVertices, vVerticeIndices);
 
 	float vertices0[4][3] = { { -m_fWidth / 2.0f, -m_fHeight / 2.0f, 0.0f }, { m_fWidth / 2.0f, -m_fHeight / 2.0f, 0.0f }, { m_fWidth / 2.0f, m_fHeight / 2.0f, 0.0f }, { -m_fWidth / 2.0f, m_fHeight / 2.0f, 0.0f } };
 
-	int iDep = 7;
-	SubDivide(Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[2]), Eigen::Vector3f(vertices0[3]), iDep, vVertices, vVerticeIndices);
+	int iDep = m_iTessellationLevel;
+	SubDivide(Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[2]), Eigen::Vector3f(vertices0[3]), iDep, meshBuilder);
+
+	if (m_fnShouldRefine)
+	{
+		meshBuilder.FixTJunctions(ToPlane);
+	}
 }
 
 void GSurfaceGeneratorPlane::SubDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3, const Eigen::Vector3f& vu4
-	, int iDepth, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
+	, int iDepth, GIndexedMeshBuilder& meshBuilder)
 {
 	if (iDepth == 0)
 	{
-		TriangleDivide(vu1, vu2, vu3, vVertices, vVerticeIndices);
-		TriangleDivide(vu3, vu4, vu1, vVertices, vVerticeIndices);
+		meshBuilder.AddTriangle(vu1, vu2, vu3);
+		meshBuilder.AddTriangle(vu3, vu4, vu1);
 		return;
 	}
 
@@ -122,22 +309,19 @@ void GSurfaceGeneratorPlane::SubDivide(const Eigen::Vector3f& vu1, const Eigen::
 	u41 = (vu4 + vu1) / 2.0f;
 	u31 = (vu3 + vu1) / 2.0f;
 
-	SubDivide(vu1, u12, u31, u41, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(vu2, u23, u31, u12, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(vu3, u34, u31, u23, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(vu4, u41, u31, u34, iDepth - 1, vVertices, vVerticeIndices);
-}
-
-void GSurfaceGeneratorPlane::TriangleDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3
-	, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
-{
-	vVertices.push_back(tVertex(vu1[0], vu1[1], vu1[2]));
-	vVertices.push_back(tVertex(vu2[0], vu2[1], vu2[2]));
-	vVertices.push_back(tVertex(vu3[0], vu3[1], vu3[2]));
+	const Eigen::Vector3f vEndPoints[10] = { vu1, vu2, vu2, vu3, vu3, vu4, vu4, vu1, vu3, vu1 };
+	const Eigen::Vector3f vMidPoints[5] = { u12, u23, u34, u41, u31 };
+	if (!ShouldRefine(m_fnShouldRefine, m_iTessellationLevel - iDepth, vEndPoints, vMidPoints, 5))
+	{
+		meshBuilder.AddTriangle(vu1, vu2, vu3);
+		meshBuilder.AddTriangle(vu3, vu4, vu1);
+		return;
+	}
 
-	vVerticeIndices.push_back(vVertices.size() - 3);
-	vVerticeIndices.push_back(vVertices.size() - 2);
-	vVerticeIndices.push_back(vVertices.size() - 1);
+	SubDivide(vu1, u12, u31, u41, iDepth - 1, meshBuilder);
+	SubDivide(vu2, u23, u31, u12, iDepth - 1, meshBuilder);
+	SubDivide(vu3, u34, u31, u23, iDepth - 1, meshBuilder);
+	SubDivide(vu4, u41, u31, u34, iDepth - 1, meshBuilder);
 }
 
 void GSurfaceGeneratorPlane::SetSurfaceSize(float fWidth, float fHeight)
@@ -146,93 +330,92 @@ void GSurfaceGeneratorPlane::SetSurfaceSize(float fWidth, float fHeight)
 	m_fHeight = fHeight;
 }
 
+void GSurfaceGeneratorPlane::SetTessellationLevel(int iTessellationLevel)
+{
+	m_iTessellationLevel = (iTessellationLevel < 0) ? 0 : iTessellationLevel;
+}
+
+void GSurfaceGeneratorPlane::SetRefinePredicate(const tRefinePredicate& fnShouldRefine)
+{
+	m_fnShouldRefine = fnShouldRefine;
+}
+
+bool GSurfaceGeneratorPlane::GetPlaneSize(float& fWidth, float& fHeight) const
+{
+	fWidth = m_fWidth;
+	fHeight = m_fHeight;
+	return true;
+}
+
 void GSurfaceGeneratorCylinder::GenerateSurface(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
 {
 	vVertices.clear();
 	vVerticeIndices.clear();
+	GIndexedMeshBuilder meshBuilder(vVertices, vVerticeIndices);
 
 	float vertices0[8][3] = { { 1.0f, -m_fHeight / 2.0f, 0.0f }, { 1.0f, m_fHeight / 2.0f, 0.0f }, { 0.0f, m_fHeight / 2.0f, 1.0f }, { 0.0f, -m_fHeight / 2.0f, 1.0f }
 	, { -1.0f, -m_fHeight / 2.0f, 0.0f }, { -1.0f, m_fHeight / 2.0f, 0.0f }, { 0.0f, m_fHeight / 2.0f, -1.0f }, { 0.0f, -m_fHeight / 2.0f, -1.0f } };
 
-	int iDep = 7;
-	SubDivide(Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[2]), Eigen::Vector3f(vertices0[3]), iDep, vVertices, vVerticeIndices);
-	SubDivide(Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[2]), Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[4]), iDep, vVertices, vVerticeIndices);
-	SubDivide(Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[6]), Eigen::Vector3f(vertices0[7]), iDep, vVertices, vVerticeIndices);
-	SubDivide(Eigen::Vector3f(vertices0[7]), Eigen::Vector3f(vertices0[6]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[0]), iDep, vVertices, vVerticeIndices);
+	int iDep = m_iTessellationLevel;
+	SubDivide(Eigen::Vector3f(vertices0[0]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[2]), Eigen::Vector3f(vertices0[3]), iDep, meshBuilder);
+	SubDivide(Eigen::Vector3f(vertices0[3]), Eigen::Vector3f(vertices0[2]), Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[4]), iDep, meshBuilder);
+	SubDivide(Eigen::Vector3f(vertices0[4]), Eigen::Vector3f(vertices0[5]), Eigen::Vector3f(vertices0[6]), Eigen::Vector3f(vertices0[7]), iDep, meshBuilder);
+	SubDivide(Eigen::Vector3f(vertices0[7]), Eigen::Vector3f(vertices0[6]), Eigen::Vector3f(vertices0[1]), Eigen::Vector3f(vertices0[0]), iDep, meshBuilder);
+
+	if (m_fnShouldRefine)
+	{
+		meshBuilder.FixTJunctions(ToCylinder);
+	}
 }
 
+//the corners are on the cylinder already, the midpoints are projected once so that neighbours share them bitwise.
 void GSurfaceGeneratorCylinder::SubDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3, const Eigen::Vector3f& vu4
-	, int iDepth, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
-{
-	Eigen::Vector3f u1 = vu1;
-	float fDistance1 = sqrtf(powf(u1[0], 2) + powf(u1[2], 2));
-	u1[0] /= fDistance1;
-	u1[2] /= fDistance1;
-	Eigen::Vector3f u2 = vu2;
-	float fDistance2 = sqrtf(powf(u2[0], 2) + powf(u2[2], 2));
-	u2[0] /= fDistance2;
-	u2[2] /= fDistance2;
-	Eigen::Vector3f u3 = vu3;
-	float fDistance3 = sqrtf(powf(u3[0], 2) + powf(u3[2], 2));
-	u3[0] /= fDistance3;
-	u3[2] /= fDistance3;
-	Eigen::Vector3f u4 = vu4;
-	float fDistance4 = sqrtf(powf(u4[0], 2) + powf(u4[2], 2));
-	u4[0] /= fDistance4;
-	u4[2] /= fDistance4;
-
+	, int iDepth, GIndexedMeshBuilder& meshBuilder)
+{
 	if (iDepth == 0)
 	{
-		TriangleDivide(u1, u2, u3, vVertices, vVerticeIndices);
-		TriangleDivide(u3, u4, u1, vVertices, vVerticeIndices);
+		meshBuilder.AddTriangle(vu1, vu2, vu3);
+		meshBuilder.AddTriangle(vu3, vu4, vu1);
 		return;
 	}
 
-	Eigen::Vector3f u12, u23, u34, u41, u31;
-	u12 = (u1 + u2) / 2.0f;
-	float fDistance12 = sqrtf(powf(u12[0], 2) + powf(u12[2], 2));
-	u12[0] /= fDistance12;
-	u12[2] /= fDistance12;
-
-	u23 = (u2 + u3) / 2.0f;
-	float fDistance23 = sqrtf(powf(u23[0], 2) + powf(u23[2], 2));
-	u23[0] /= fDistance23;
-	u23[2] /= fDistance23;
-
-	u34 = (u3 + u4) / 2.0f;
-	float fDistance34 = sqrtf(powf(u34[0], 2) + powf(u34[2], 2));
-	u34[0] /= fDistance34;
-	u34[2] /= fDistance34;
+	Eigen::Vector3f u12 = ToCylinder((vu1 + vu2) / 2.0f);
+	Eigen::Vector3f u23 = ToCylinder((vu2 + vu3) / 2.0f);
+	Eigen::Vector3f u34 = ToCylinder((vu3 + vu4) / 2.0f);
+	Eigen::Vector3f u41 = ToCylinder((vu4 + vu1) / 2.0f);
+	Eigen::Vector3f u31 = ToCylinder((vu3 + vu1) / 2.0f);
 
-	u41 = (u4 + u1) / 2.0f;
-	float fDistance41 = sqrtf(powf(u41[0], 2) + powf(u41[2], 2));
-	u41[0] /= fDistance41;
-	u41[2] /= fDistance41;
+	const Eigen::Vector3f vEndPoints[10] = { vu1, vu2, vu2, vu3, vu3, vu4, vu4, vu1, vu3, vu1 };
+	const Eigen::Vector3f vMidPoints[5] = { u12, u23, u34, u41, u31 };
+	if (!ShouldRefine(m_fnShouldRefine, m_iTessellationLevel - iDepth, vEndPoints, vMidPoints, 5))
+	{
+		meshBuilder.AddTriangle(vu1, vu2, vu3);
+		meshBuilder.AddTriangle(vu3, vu4, vu1);
+		return;
+	}
 
-	u31 = (u3 + u1) / 2.0f;
-	float fDistance31 = sqrtf(powf(u31[0], 2) + powf(u31[2], 2));
-	u31[0] /= fDistance31;
-	u31[2] /= fDistance31;
+	SubDivide(vu1, u12, u31, u41, iDepth - 1, meshBuilder);
+	SubDivide(vu2, u23, u31, u12, iDepth - 1, meshBuilder);
+	SubDivide(vu3, u34, u31, u23, iDepth - 1, meshBuilder);
+	SubDivide(vu4, u41, u31, u34, iDepth - 1, meshBuilder);
+}
 
-	SubDivide(u1, u12, u31, u41, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(u2, u23, u31, u12, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(u3, u34, u31, u23, iDepth - 1, vVertices, vVerticeIndices);
-	SubDivide(u4, u41, u31, u34, iDepth - 1, vVertices, vVerticeIndices);
+void GSurfaceGeneratorCylinder::SetSurfaceSize(float fHeight)
+{
+	m_fHeight = fHeight;
 }
 
-void GSurfaceGeneratorCylinder::TriangleDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3
-	, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices)
+void GSurfaceGeneratorCylinder::SetTessellationLevel(int iTessellationLevel)
 {
-	vVertices.push_back(tVertex(vu1[0], vu1[1], vu1[2]));
-	vVertices.push_back(tVertex(vu2[0], vu2[1], vu2[2]));
-	vVertices.push_back(tVertex(vu3[0], vu3[1], vu3[2]));
+	m_iTessellationLevel = (iTessellationLevel < 0) ? 0 : iTessellationLevel;
+}
 
-	vVerticeIndices.push_back(vVertices.size() - 3);
-	vVerticeIndices.push_back(vVertices.size() - 2);
-	vVerticeIndices.push_back(vVertices.size() - 1);
+void GSurfaceGeneratorCylinder::SetRefinePredicate(const tRefinePredicate& fnShouldRefine)
+{
+	m_fnShouldRefine = fnShouldRefine;
 }
 
-void GSurfaceGeneratorCylinder::SetSurfaceSize(float fHeight)
+bool GSurfaceGeneratorCylinder::GetPlaneSize(float& fWidth, float& fHeight) const
 {
-	m_fHeight = fHeight;
+	return false;
 }
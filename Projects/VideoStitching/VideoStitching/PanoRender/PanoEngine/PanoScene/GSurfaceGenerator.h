@@ -26,30 +26,93 @@
 #define G_SURFACE_GENERATOR_H_
 
 #include <vector>
+#include <unordered_map>
+#include <functional>
 
 #include <Eigen/Geometry>
 
 #include "PanoRender/GSurfaceGeneratorIF.h"
 
+//bitwise equal positions, the subdivisions compute shared vertices with the same arithmetic.
+struct tVertexPosition
+{
+	tVertexPosition(float fX, float fY, float fZ);
+
+	bool operator==(const tVertexPosition& other) const
+	{
+		return uiX == other.uiX && uiY == other.uiY && uiZ == other.uiZ;
+	}
+
+	unsigned int uiX;
+	unsigned int uiY;
+	unsigned int uiZ;
+};
+
+struct tVertexPositionHash
+{
+	size_t operator()(const tVertexPosition& position) const
+	{
+		size_t uiRet = position.uiX;
+		uiRet = uiRet * 0x9E3779B1u + position.uiY;
+		uiRet = uiRet * 0x9E3779B1u + position.uiZ;
+		return uiRet;
+	}
+};
+
+//appends triangles to an indexed mesh, every position is stored once.
+class GIndexedMeshBuilder
+{
+public:
+	GIndexedMeshBuilder(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
+
+	void AddTriangle(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3);
+
+	//an adaptive subdivision leaves vertices of the finer cells on the edges of the coarser ones.
+	//splits the coarser triangles at those vertices so that the mesh has no cracks.
+	//fnToSurface has to be the function the generator computes its edge midpoints with.
+	void FixTJunctions(const std::function<Eigen::Vector3f(const Eigen::Vector3f&)>& fnToSurface);
+
+private:
+	GLuint AddVertex(const Eigen::Vector3f& vu);
+
+	bool FindVertex(const Eigen::Vector3f& vu, GLuint& uiVertexIdx) const;
+
+	Eigen::Vector3f GetVertex(GLuint uiVertexIdx) const;
+
+	//appends the vertices strictly between the two end points, ordered from the first one.
+	void CollectEdgeVertices(GLuint uiVertexIdx1, GLuint uiVertexIdx2
+		, const std::function<Eigen::Vector3f(const Eigen::Vector3f&)>& fnToSurface, int iDepth, std::vector<GLuint>& vEdgeVertices) const;
+
+	std::vector<tVertex>& m_vVertices;
+	std::vector<GLuint>& m_vVerticeIndices;
+	std::unordered_map<tVertexPosition, GLuint, tVertexPositionHash> m_mpVertexIndices;
+};
+
 
 class GSurfaceGeneratorSphere : public GSurfaceGenerator4RenderIF
 {
 public:
 	GSurfaceGeneratorSphere() :
 		m_bIsFullSphere(false)
+		, m_iTessellationLevel(7)
 	{}
 
 	virtual ~GSurfaceGeneratorSphere(){};
 	virtual void GenerateSurface(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
+	virtual void SetRefinePredicate(const tRefinePredicate& fnShouldRefine);
+	virtual bool GetPlaneSize(float& fWidth, float& fHeight) const;
 
 public:
 	void SetIsFullSphere(bool bIsFullSphere);
+	void SetTessellationLevel(int iTessellationLevel);
 
 private:
 	void SubDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3, int iDepth
-		, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
+		, GIndexedMeshBuilder& meshBuilder);
 
 	bool m_bIsFullSphere;
+	int m_iTessellationLevel;
+	tRefinePredicate m_fnShouldRefine;
 };
 
 class GSurfaceGeneratorPlane : public GSurfaceGenerator4RenderIF
@@ -58,22 +121,26 @@ public:
 	GSurfaceGeneratorPlane() :
 		m_fWidth(0.0)
 		, m_fHeight(0.0)
+		, m_iTessellationLevel(7)
 	{}
 
 	virtual ~GSurfaceGeneratorPlane(){};
 	virtual void GenerateSurface(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
+	virtual void SetRefinePredicate(const tRefinePredicate& fnShouldRefine);
+	virtual bool GetPlaneSize(float& fWidth, float& fHeight) const;
 	
 public:
 	void SetSurfaceSize(float fWidth,float fHeight);
+	void SetTessellationLevel(int iTessellationLevel);
 
 private:
 	void SubDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3, const Eigen::Vector3f& vu4
-		, int iDepth, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
-	void TriangleDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3
-		, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
+		, int iDepth, GIndexedMeshBuilder& meshBuilder);
 
 	float m_fWidth;
 	float m_fHeight;
+	int m_iTessellationLevel;
+	tRefinePredicate m_fnShouldRefine;
 };
 
 class GSurfaceGeneratorCylinder : public GSurfaceGenerator4RenderIF
@@ -81,20 +148,24 @@ class GSurfaceGeneratorCylinder : public GSurfaceGenerator4RenderIF
 public:
 	GSurfaceGeneratorCylinder() :
 		m_fHeight(0.0)
+		, m_iTessellationLevel(7)
 	{}
 
 	virtual ~GSurfaceGeneratorCylinder(){};
 	virtual void GenerateSurface(std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
+	virtual void SetRefinePredicate(const tRefinePredicate& fnShouldRefine);
+	virtual bool GetPlaneSize(float& fWidth, float& fHeight) const;
 
 public:
 	void SetSurfaceSize(float fHeight);
+	void SetTessellationLevel(int iTessellationLevel);
 
 private:
 	void SubDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3, const Eigen::Vector3f& vu4
-		, int iDepth, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
-	void TriangleDivide(const Eigen::Vector3f& vu1, const Eigen::Vector3f& vu2, const Eigen::Vector3f& vu3
-		, std::vector<tVertex>& vVertices, std::vector<GLuint>& vVerticeIndices);
+		, int iDepth, GIndexedMeshBuilder& meshBuilder);
 
 	float m_fHeight;
+	int m_iTessellationLevel;
+	tRefinePredicate m_fnShouldRefine;
 };
 #endif//!G_SURFACE_GENERATOR_H_
\ No newline at end of file
@@ -53,7 +53,11 @@ bool GTextureGroupUploader::Init(GStitcherConfig::enStitcherGLOptionsUploading e
 		m_vCurrentFrameType[iFrameIdx].eFrameFormat = eInputFrameFormat;
 		m_vCurrentFrameType[iFrameIdx].iWidth = 0;
 		m_vCurrentFrameType[iFrameIdx].iHeight = 0;
+		m_vCurrentFrameType[iFrameIdx].ullFrameID = 0;
+		m_vCurrentFrameType[iFrameIdx].llTimeStamp = 0;
+		m_vCurrentFrameType[iFrameIdx].llArrivalTime_us = 0;
 	}
+	m_vUpdatedFrameIdx.clear();
 
 	if (GStitcherConfig::eOptionUploadingPBO == eUploadingOption)
 	{
@@ -284,10 +288,12 @@ bool GTextureGroupUploader::ResizeTextures(const std::vector<std::pair<int, GFra
 	return true;
 }
 
-bool GTextureGroupUploader::Upload(std::vector<std::shared_ptr<GFrameSourceIF>> vPtrSource, GTextureGroup& textureGroup)
+bool GTextureGroupUploader::Upload(std::vector<std::shared_ptr<GFrameSourceIF>> vPtrSource, GTextureGroup& textureGroup
+	, const std::vector<bool>& vUploadMask)
 {
 	std::vector<std::pair<int, GFrameType>> vFrameType;
-	
+	m_vUpdatedFrameIdx.clear();
+
 	for (int iQueueIdx = 0; iQueueIdx < vPtrSource.size(); ++iQueueIdx)
 	{
 		GFrameType frameType;
@@ -296,6 +302,13 @@ bool GTextureGroupUploader::Upload(std::vector<std::shared_ptr<GFrameSourceIF>>
 			continue;
 		}
 
+		if ((iQueueIdx < vUploadMask.size()) && (!vUploadMask[iQueueIdx]))
+		{
+			vPtrSource[iQueueIdx]->ReleaseFrame();
+			m_vUpdatedFrameIdx.push_back(iQueueIdx);
+			continue;
+		}
+
 		vFrameType.push_back(std::pair<int, GFrameType>(iQueueIdx, frameType));
 	}
 
@@ -339,6 +352,7 @@ bool GTextureGroupUploader::Upload(std::vector<std::shared_ptr<GFrameSourceIF>>
 	for (int iAFrameIdx = 0; iAFrameIdx < vFrameType.size(); ++iAFrameIdx)
 	{
 		vPtrSource[vFrameType[iAFrameIdx].first]->ReleaseFrame();
+		m_vUpdatedFrameIdx.push_back(vFrameType[iAFrameIdx].first);
 	}
 
 	textureGroup.eTextureFormat = m_eInputFrameFormat;
@@ -48,9 +48,17 @@ public:
 		, m_cbPackagesSizeBuffer(boost::circular_buffer<int>(10))
 	{}
 	bool Init(GStitcherConfig::enStitcherGLOptionsUploading eUploadingOption, enFrameFormat eInputFrameFormat, int iNumOfFrame);
-	bool Upload(std::vector<std::shared_ptr<GFrameSourceIF>> vPtrSource, GTextureGroup& textureGroup);
+	//vUploadMask: if not empty, frames of the sources set to false are consumed without being uploaded.
+	bool Upload(std::vector<std::shared_ptr<GFrameSourceIF>> vPtrSource, GTextureGroup& textureGroup
+		, const std::vector<bool>& vUploadMask = std::vector<bool>());
 	void Release();
 
+	//frame types of the frames currently held by the texture group, one for each frame source.
+	const std::vector<GFrameType>& GetCurrentFrameTypes() const { return m_vCurrentFrameType; };
+
+	//indices of the frame sources updated by the last Upload().
+	const std::vector<int>& GetUpdatedFrameIdx() const { return m_vUpdatedFrameIdx; };
+
 private:
 	bool CheckInputFrameFormat(const std::vector<std::pair<int, GFrameType>>& vInputFrameType) const;
 
@@ -79,6 +87,7 @@ private:
 	int m_iPBOSize_Byte;
 
 	std::vector<GFrameType> m_vCurrentFrameType;
+	std::vector<int> m_vUpdatedFrameIdx;
 	std::vector<GLuint> m_vTextures;
 
 	boost::circular_buffer<int> m_cbPackagesSizeBuffer;
@@ -88,7 +97,8 @@ private:
 class GFrameDownloader
 {
 public:
-	GFrameDownloader()
+	GFrameDownloader() :
+		m_fOutputScale(1.0f)
 	{}
 
 	bool Init(int iWidth, int iHeight);
@@ -108,9 +118,19 @@ public:
 	void UnmapFrame(float fScale);
 	void Release();
 
+	//metadata of the frame rendered into this downloader, travels with it through the task queue.
+	void SetFrameInfo(const GOutputFrameInfo& frameInfo) { m_FrameInfo = frameInfo; };
+	GOutputFrameInfo& GetFrameInfo() { return m_FrameInfo; };
+
+	//factor applied to the scales of the output callbacks when this frame was rendered, travels with it as well.
+	void SetOutputScale(float fOutputScale) { m_fOutputScale = fOutputScale; };
+	float GetOutputScale() const { return m_fOutputScale; };
+
 private:
 	std::map<float, std::pair<bool, std::shared_ptr<GDownChannelIF>>> m_mpDownChannels;
 	GOpenGLFrameBuffer m_FBO;
+	GOutputFrameInfo m_FrameInfo;
+	float m_fOutputScale;
 };
 
 
@@ -31,6 +31,7 @@
 #include "Common/GiraffeLogger/GiraffeLogger.h"
 #include "GRenderParaManager.h"
 #include "GGlobalParametersManager.h"
+#include "GSceneCache.h"
 
 extern "C"
 {
@@ -104,6 +105,17 @@ bool GStitcherOGL::Init(const GStitcherConfig& stitcherConfig, const std::vector
 #endif //(defined __APPLE__) || (defined __ANDROID__)
 
 	m_config = stitcherConfig;
+	m_config.m_ptrProgramCache = m_ptrProgramCache;
+
+	//the scenes warmed up link their programs in the background, see GSceneWarmer::PrepareNext().
+	if (GGLSLBlenderGenerator::EnableParallelCompile())
+	{
+		GLOGGER(info) << "GStitcherOGL::Init(). Shaders are compiled in parallel.";
+	}
+	else
+	{
+		GLOGGER(info) << "GStitcherOGL::Init(). Parallel shader compile unavailable, at most one program is linked per frame in the background.";
+	}
 	m_vCameras = vCameras;
 
 	glFrontFace(GL_CCW);
@@ -135,22 +147,41 @@ bool GStitcherOGL::IsSceneExist(const std::string& sSceneName)
 bool GStitcherOGL::CreateScene(const std::string& sSceneName, enPanoType ePanoType, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
 {
 	//GLOGGER(info) << "==> GStitcherOGL::CreateScene().";
-	std::shared_ptr<GPanoSceneIF> ptrRenderScene = GPanoSceneFactory::CreatePanoScene(ePanoType);
 	if (m_mpRenderScenes.end() != m_mpRenderScenes.find(sSceneName))
 	{
-		m_mpRenderScenes[sSceneName]->Release();
+		ReleaseScene(sSceneName);
 	}
 
+	GStitcherConfig config = m_config;
+	std::string sKey = GSceneCache::CreateKey(ePanoType, m_vCameras, sK0Name, v4fCropRatios, config);
+	if (!config.m_sSceneCacheDirectory.empty())
+	{
+		config.m_sSceneCacheKey = sKey;
+	}
+
+	//a scene built in the background is ready to render.
+	std::shared_ptr<GPanoSceneIF> ptrWarmScene = m_sceneWarmer.Take(sKey);
+	if (nullptr != ptrWarmScene)
+	{
+		m_mpRenderScenes[sSceneName] = ptrWarmScene;
+		m_mpSceneKeys[sSceneName] = sKey;
+		//GLOGGER(info) << "GStitcherOGL::CreateScene() ==>";
+		return true;
+	}
+
+	std::shared_ptr<GPanoSceneIF> ptrRenderScene = GPanoSceneFactory::CreatePanoScene(ePanoType);
 	m_mpRenderScenes[sSceneName] = ptrRenderScene;
+	m_mpSceneKeys[sSceneName] = sKey;
 
 	bool bRet = false;
-	if (ptrRenderScene->Create(m_config, m_vCameras, sK0Name, v4fCropRatios))
+	if (ptrRenderScene->Create(config, m_vCameras, sK0Name, v4fCropRatios))
 	{
 		bRet = ptrRenderScene->Prepare();
 	}
 	else
 	{
 		m_mpRenderScenes.erase(sSceneName);
+		m_mpSceneKeys.erase(sSceneName);
 		GLOGGER(error) << "GStitcherOGL::CreateScene() ERROR.";
 	}
 
@@ -158,6 +189,26 @@ bool GStitcherOGL::CreateScene(const std::string& sSceneName, enPanoType ePanoTy
 	return bRet;
 }
 
+bool GStitcherOGL::UpdateScene(const std::string& sSceneName, enPanoType ePanoType, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios)
+{
+	//the adaptive surface was refined against the former projection and a remap table holds every pixel, both are created again.
+	auto itScene = m_mpRenderScenes.find(sSceneName);
+	if ((m_mpRenderScenes.end() == itScene) || (0.0f < m_config.m_fTessellationTolerance_px)
+		|| ((0 < m_config.m_iRemapTableWidth) && (0 < m_config.m_iRemapTableHeight)))
+	{
+		return CreateScene(sSceneName, ePanoType, sK0Name, v4fCropRatios);
+	}
+
+	if (!itScene->second->Update(m_vCameras, sK0Name, v4fCropRatios))
+	{
+		GLOGGER(info) << "GStitcherOGL::UpdateScene(). scene " << sSceneName << " can not be updated, creating it again.";
+		return CreateScene(sSceneName, ePanoType, sK0Name, v4fCropRatios);
+	}
+
+	m_mpSceneKeys[sSceneName] = GSceneCache::CreateKey(ePanoType, m_vCameras, sK0Name, v4fCropRatios, m_config);
+	return true;
+}
+
 bool GStitcherOGL::SwitchScene(const std::string& sSceneName)
 {
 	if (m_mpRenderScenes.end() == m_mpRenderScenes.find(sSceneName))
@@ -171,6 +222,159 @@ bool GStitcherOGL::SwitchScene(const std::string& sSceneName)
 	}
 }
 
+bool GStitcherOGL::RemoveScene(const std::string& sSceneName)
+{
+	auto itScene = m_mpRenderScenes.find(sSceneName);
+	if ((m_mpRenderScenes.end() == itScene) || (m_ptrCurrentScene == itScene->second))
+	{
+		return false;
+	}
+
+	ReleaseScene(sSceneName);
+	m_mpRenderScenes.erase(sSceneName);
+	m_mpSceneKeys.erase(sSceneName);
+	return true;
+}
+
+void GStitcherOGL::ReleaseScene(const std::string& sSceneName)
+{
+	std::shared_ptr<GPanoSceneIF> ptrScene = m_mpRenderScenes[sSceneName];
+	auto itKey = m_mpSceneKeys.find(sSceneName);
+	if ((m_mpSceneKeys.end() != itKey) && m_sceneWarmer.Return(itKey->second, ptrScene))
+	{
+		return;
+	}
+
+	ptrScene->Release();
+}
+
+void GStitcherOGL::SetTessellationLevel(int iTessellationLevel)
+{
+	m_config.m_iTessellationLevel = iTessellationLevel;
+}
+
+int GStitcherOGL::GetTessellationLevel() const
+{
+	return m_config.m_iTessellationLevel;
+}
+
+void GStitcherOGL::SetTessellationTolerance(float fTolerance_px, int iInputFrameWidth, int iInputFrameHeight)
+{
+	m_config.m_fTessellationTolerance_px = (fTolerance_px < 0.0f) ? 0.0f : fTolerance_px;
+	m_config.m_iInputFrameWidth = iInputFrameWidth;
+	m_config.m_iInputFrameHeight = iInputFrameHeight;
+}
+
+float GStitcherOGL::GetTessellationTolerance() const
+{
+	return m_config.m_fTessellationTolerance_px;
+}
+
+void GStitcherOGL::SetRemapTableSize(int iWidth, int iHeight)
+{
+	m_config.m_iRemapTableWidth = (iWidth < 0) ? 0 : iWidth;
+	m_config.m_iRemapTableHeight = (iHeight < 0) ? 0 : iHeight;
+}
+
+void GStitcherOGL::SetSceneCacheDirectory(const std::string& sDirectory)
+{
+	m_config.m_sSceneCacheDirectory = sDirectory;
+}
+
+void GStitcherOGL::SetProgramBinaryCacheDirectory(const std::string& sDirectory)
+{
+	m_ptrProgramCache->SetBinaryCacheDirectory(sDirectory);
+}
+
+void GStitcherOGL::WarmUpScenes(const std::vector<tWarmUpRequest>& vRequests)
+{
+	std::vector<GSceneWarmer::tRequest> vWarmerRequests;
+	for (const auto& request : vRequests)
+	{
+		GSceneWarmer::tRequest warmerRequest;
+		warmerRequest.ePanoType = request.ePanoType;
+		warmerRequest.sK0Name = request.sK0Name;
+		warmerRequest.v4fCropRatios = request.v4fCropRatios;
+		warmerRequest.config = m_config;
+		warmerRequest.config.m_fTessellationTolerance_px = (request.fTessellationTolerance_px < 0.0f) ? 0.0f : request.fTessellationTolerance_px;
+		warmerRequest.config.m_iInputFrameWidth = request.iInputFrameWidth;
+		warmerRequest.config.m_iInputFrameHeight = request.iInputFrameHeight;
+		warmerRequest.config.m_iRemapTableWidth = (request.iRemapTableWidth < 0) ? 0 : request.iRemapTableWidth;
+		warmerRequest.config.m_iRemapTableHeight = (request.iRemapTableHeight < 0) ? 0 : request.iRemapTableHeight;
+		warmerRequest.sKey = GSceneCache::CreateKey(request.ePanoType, m_vCameras, request.sK0Name, request.v4fCropRatios, warmerRequest.config);
+		if (!warmerRequest.config.m_sSceneCacheDirectory.empty())
+		{
+			warmerRequest.config.m_sSceneCacheKey = warmerRequest.sKey;
+		}
+		vWarmerRequests.push_back(warmerRequest);
+	}
+
+	std::set<std::string> stInUseKeys;
+	for (const auto& sceneKey : m_mpSceneKeys)
+	{
+		stInUseKeys.insert(sceneKey.second);
+	}
+
+	m_sceneWarmer.Start(vWarmerRequests, stInUseKeys, m_vCameras);
+}
+
+void GStitcherOGL::PrepareWarmScene()
+{
+	m_ptrProgramCache->Poll();
+	m_sceneWarmer.PrepareNext();
+
+	tSceneMemoryState state;
+	{
+		std::lock_guard<std::mutex> lock(m_mtSceneMemoryMutex);
+		state.ullBudget_Byte = m_ullSceneMemoryBudget_Byte;
+		state.ullEvictedScenes = m_sceneMemoryState.ullEvictedScenes;
+	}
+
+	std::set<std::shared_ptr<GPanoSceneIF>> stInUseScenes;
+	for (auto it = m_mpRenderScenes.begin(); it != m_mpRenderScenes.end(); ++it)
+	{
+		if (stInUseScenes.insert(it->second).second)
+		{
+			state.ullInUse_Byte += it->second->GetMemorySize();
+		}
+	}
+	state.iInUseScenes = static_cast<int>(stInUseScenes.size());
+
+	if (0 < state.ullBudget_Byte)
+	{
+		size_t ullCachedBudget_Byte = (state.ullInUse_Byte < state.ullBudget_Byte) ? (state.ullBudget_Byte - state.ullInUse_Byte) : 0;
+		state.ullEvictedScenes += m_sceneWarmer.Evict(ullCachedBudget_Byte);
+	}
+	state.ullCached_Byte = m_sceneWarmer.GetReadySize(state.iCachedScenes);
+
+	std::lock_guard<std::mutex> lock(m_mtSceneMemoryMutex);
+	m_sceneMemoryState = state;
+}
+
+GSceneWarmer::tState GStitcherOGL::GetWarmUpState()
+{
+	return m_sceneWarmer.GetState();
+}
+
+void GStitcherOGL::SetSceneMemoryBudget(size_t ullBudget_Byte)
+{
+	std::lock_guard<std::mutex> lock(m_mtSceneMemoryMutex);
+	m_ullSceneMemoryBudget_Byte = ullBudget_Byte;
+}
+
+GGLSLProgramCache::tStatistics GStitcherOGL::GetProgramCacheStatistics()
+{
+	return m_ptrProgramCache->GetStatistics();
+}
+
+GStitcherOGL::tSceneMemoryState GStitcherOGL::GetSceneMemoryState()
+{
+	std::lock_guard<std::mutex> lock(m_mtSceneMemoryMutex);
+	tSceneMemoryState state = m_sceneMemoryState;
+	state.ullBudget_Byte = m_ullSceneMemoryBudget_Byte;
+	return state;
+}
+
 bool GStitcherOGL::SetPreRenderCallBack(tRenderCallBack pPreRenderCallBack, void* pContext)
 {
 	m_PreRenderCallBack.pRenderCallBackFunc = pPreRenderCallBack;
@@ -194,6 +398,7 @@ bool GStitcherOGL::RenderPano(const GTextureGroup& textGroup, const glm::mat4& m
 	}
 
 	m_ptrCurrentScene->Render(textGroup, matP, matV);
+	AddRenderCounters(m_ptrCurrentScene);
 
 	if (nullptr != m_RenderCallBack.pRenderCallBackFunc)
 	{
@@ -209,6 +414,62 @@ bool GStitcherOGL::RenderPano(const GTextureGroup& textGroup, const glm::mat4& m
 	return true;
 }
 
+bool GStitcherOGL::RenderPano(const std::string& sSceneName, const GTextureGroup& textGroup, const glm::mat4& matP, const glm::mat4& matV)
+{
+	auto itScene = m_mpRenderScenes.find(sSceneName);
+	if (m_mpRenderScenes.end() == itScene)
+	{
+		return false;
+	}
+
+	itScene->second->Render(textGroup, matP, matV);
+	AddRenderCounters(itScene->second);
+
+	glFlush();
+
+	return true;
+}
+
+GRenderCounters GStitcherOGL::TakeRenderCounters()
+{
+	GRenderCounters counters = m_renderCounters;
+	m_renderCounters = GRenderCounters();
+	return counters;
+}
+
+void GStitcherOGL::AddRenderCounters(const std::shared_ptr<GPanoSceneIF>& ptrScene)
+{
+	GRenderCounters counters;
+	if (ptrScene->GetRenderCounters(counters))
+	{
+		m_renderCounters.iDrawCalls += counters.iDrawCalls;
+		m_renderCounters.iStateChanges += counters.iStateChanges;
+		m_renderCounters.dCPUTime_ms += counters.dCPUTime_ms;
+	}
+}
+
+bool GStitcherOGL::GetVisibleCameras(const std::string& sSceneName, const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible)
+{
+	std::shared_ptr<GPanoSceneIF> ptrScene = m_ptrCurrentScene;
+	if ("" != sSceneName)
+	{
+		auto itScene = m_mpRenderScenes.find(sSceneName);
+		ptrScene = (m_mpRenderScenes.end() == itScene) ? std::shared_ptr<GPanoSceneIF>(nullptr) : itScene->second;
+	}
+
+	if (nullptr == ptrScene)
+	{
+		return false;
+	}
+
+	if (vVisible.size() < m_vCameras.size())
+	{
+		vVisible.resize(m_vCameras.size(), false);
+	}
+
+	return ptrScene->GetVisibleCameras(matP, matV, vVisible);
+}
+
 bool GStitcherOGL::UnProjectPix2Physical(float fXPix, float fYPix, float fDepth, float& fX, float& fY, float& fZ, const glm::vec4& mvViewPort)
 {
 	if (1.0f == fDepth)
@@ -237,9 +498,14 @@ bool GStitcherOGL::UnProjectPix2Physical(float fXPix, float fYPix, float fDepth,
 
 void GStitcherOGL::Release()
 {
+	m_sceneWarmer.Release();
+
 	for (auto it = m_mpRenderScenes.begin(); it != m_mpRenderScenes.end(); ++it)
 	{
 		it->second->Release();
 	}
+
+	//after the scenes, which only forget the shared programs.
+	m_ptrProgramCache->Release();
 }
 
@@ -29,12 +29,15 @@
 #include "GCameraModel.h"
 
 #include <memory>
+#include <mutex>
 
 #include "PanoRender/GPanoRenderCommonIF.h"
 #include "GPanoCameraInfo.h"
 #include "GViewCamera.h"
 #include "PanoRender/GPanoSceneIF.h"
 #include "Common/Buffers/GTaskQueue.h"
+#include "GSceneWarmer.h"
+#include "GGLSLProgramGenerator.h"
 
 typedef void(G_CALL_BACK_CALL_CONVENTION *tRenderCallBack)(void* pContext);
 
@@ -44,6 +47,8 @@ public:
 	GStitcherOGL()
 		:m_config(GStitcherConfig())
 		, m_ptrCurrentScene(std::shared_ptr<GPanoSceneIF>(nullptr))
+		, m_ptrProgramCache(std::make_shared<GGLSLProgramCache>())
+		, m_ullSceneMemoryBudget_Byte(0)
 	{}
 
 	bool Init(const GStitcherConfig& stitcherConfig, const std::vector<CameraModel>& vCameras);
@@ -52,24 +57,121 @@ public:
 
 	bool CreateScene(const std::string& sSceneName, enPanoType ePanoType, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
 
+	//a scene of the same pano type and tessellation gets the texture coordinates of the new K0 or crop ratios in place,
+	//the others, and the ones whose patches would change, are created again.
+	bool UpdateScene(const std::string& sSceneName, enPanoType ePanoType, const std::string& sK0Name, const Eigen::Vector4f& v4fCropRatios);
+
 	bool SwitchScene(const std::string& sSceneName);
 
+	//the current scene can not be removed.
+	bool RemoveScene(const std::string& sSceneName);
+
+	//takes effect for the scenes created afterwards.
+	void SetTessellationLevel(int iTessellationLevel);
+
+	int GetTessellationLevel() const;
+
+	//adaptive subdivision of the scenes created afterwards, fTolerance_px is measured in pixels of the input frames.
+	//0 subdivides uniformly.
+	void SetTessellationTolerance(float fTolerance_px, int iInputFrameWidth, int iInputFrameHeight);
+
+	float GetTessellationTolerance() const;
+
+	//the plane surfaces of the scenes created afterwards are drawn from remap tables of this size, 0 draws the tessellated surfaces.
+	void SetRemapTableSize(int iWidth, int iHeight);
+
+	//scenes are loaded from and stored to the cache in sDirectory, empty disables the cache.
+	void SetSceneCacheDirectory(const std::string& sDirectory);
+
+	//the programs linked afterwards are loaded from and stored to the binaries in sDirectory, empty disables the cache.
+	void SetProgramBinaryCacheDirectory(const std::string& sDirectory);
+
+	struct tWarmUpRequest
+	{
+		enPanoType ePanoType;
+		std::string sK0Name;
+		Eigen::Vector4f v4fCropRatios;
+		float fTessellationTolerance_px;
+		int iInputFrameWidth;
+		int iInputFrameHeight;
+		int iRemapTableWidth;
+		int iRemapTableHeight;
+	};
+
+	//build the scenes of vRequests in the background, CreateScene() of the same inputs then takes the built scene.
+	//replaces the former requests, empty releases the scenes built so far.
+	void WarmUpScenes(const std::vector<tWarmUpRequest>& vRequests);
+
+	//take over the programs linked in the background and upload at most one scene built in the background, once per frame.
+	//the scenes kept ready are then evicted down to the memory budget left by the scenes in use.
+	void PrepareWarmScene();
+
+	//thread safe.
+	GSceneWarmer::tState GetWarmUpState();
+
+	struct tSceneMemoryState
+	{
+		tSceneMemoryState() :
+			ullInUse_Byte(0)
+			, ullCached_Byte(0)
+			, iInUseScenes(0)
+			, iCachedScenes(0)
+			, ullBudget_Byte(0)
+			, ullEvictedScenes(0)
+		{}
+
+		//scenes created by CreateScene().
+		size_t ullInUse_Byte;
+		//scenes kept ready by the warmer.
+		size_t ullCached_Byte;
+		int iInUseScenes;
+		int iCachedScenes;
+		size_t ullBudget_Byte;
+		unsigned long long ullEvictedScenes;
+	};
+
+	//bytes of the scenes in use and kept ready, 0 is unlimited. the scenes in use are never evicted. thread safe.
+	void SetSceneMemoryBudget(size_t ullBudget_Byte);
+
+	//as of the last PrepareWarmScene(). thread safe.
+	tSceneMemoryState GetSceneMemoryState();
+
+	//programs shared by the scenes of the context. thread safe.
+	GGLSLProgramCache::tStatistics GetProgramCacheStatistics();
+
 	bool SetPreRenderCallBack(tRenderCallBack pPreRenderCallBack, void* pContext);
 
 	bool SetRenderCallBack(tRenderCallBack pRenderCallBack, void* pContext);
 
 	bool RenderPano(const GTextureGroup& textGroup, const glm::mat4& matP, const glm::mat4& matV);
 
+	//render another scene than the current one, e.g. for an additional view. render callbacks are not invoked,
+	//and UnProjectPix2Physical() still refers to the last RenderPano() of the current scene.
+	bool RenderPano(const std::string& sSceneName, const GTextureGroup& textGroup, const glm::mat4& matP, const glm::mat4& matV);
+
+	//GL calls of the scenes rendered since the last call.
+	GRenderCounters TakeRenderCounters();
+
+	//mark the cameras seen by a scene, "" for the current scene. vVisible is resized to the number of cameras if needed.
+	bool GetVisibleCameras(const std::string& sSceneName, const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible);
+
 	bool UnProjectPix2Physical(float fXPix, float fYPix, float fDepth, float& fX, float& fY, float& fZ, const glm::vec4& mvViewPort);
 
 	void Release();
 
 private:
+	//the scene is handed back to the warmer if it is still requested, released otherwise.
+	void ReleaseScene(const std::string& sSceneName);
+
+	void AddRenderCounters(const std::shared_ptr<GPanoSceneIF>& ptrScene);
+
 	GStitcherConfig m_config;
 
 	std::vector<CameraModel> m_vCameras;
 
 	std::map<std::string, std::shared_ptr<GPanoSceneIF>> m_mpRenderScenes;
+	//key of the inputs of each scene, see GSceneCache::CreateKey().
+	std::map<std::string, std::string> m_mpSceneKeys;
 	std::shared_ptr<GPanoSceneIF> m_ptrCurrentScene;
 
 	glm::mat4 m_glmP;
@@ -87,6 +189,18 @@ private:
 
 	GRenderCallBack m_PreRenderCallBack;
 	GRenderCallBack m_RenderCallBack;
+
+	GSceneWarmer m_sceneWarmer;
+
+	//handed to the scenes through m_config, the programs are deleted by Release().
+	std::shared_ptr<GGLSLProgramCache> m_ptrProgramCache;
+
+	std::mutex m_mtSceneMemoryMutex;
+	//guarded by m_mtSceneMemoryMutex.
+	size_t m_ullSceneMemoryBudget_Byte;
+	tSceneMemoryState m_sceneMemoryState;
+
+	GRenderCounters m_renderCounters;
 };
 
 #endif //G_STITCHER_OGL_H_
\ No newline at end of file
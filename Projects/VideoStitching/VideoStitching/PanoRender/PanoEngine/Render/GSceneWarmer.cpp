@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#include "GSceneWarmer.h"
+
+#include <algorithm>
+
+#include "Common/GiraffeLogger/GiraffeLogger.h"
+
+GSceneWarmer::~GSceneWarmer()
+{
+	//the scenes hold GL objects, they have to be released by the render thread before.
+	std::unique_lock<std::mutex> lock(m_mtMutex);
+	m_bStop = true;
+	m_dqPending.clear();
+	lock.unlock();
+	m_cvWork.notify_all();
+
+	if (m_tdWorker.joinable())
+	{
+		m_tdWorker.join();
+	}
+}
+
+void GSceneWarmer::Start(const std::vector<tRequest>& vRequests, const std::set<std::string>& stInUseKeys, const std::vector<CameraModel>& vCameras)
+{
+	std::set<std::string> stRequestedKeys;
+	for (const auto& request : vRequests)
+	{
+		stRequestedKeys.insert(request.sKey);
+	}
+
+	//scenes of the former requests not requested any more.
+	std::vector<std::shared_ptr<GPanoSceneIF>> vObsoleteScenes;
+	for (auto it = m_mpReadyScenes.begin(); it != m_mpReadyScenes.end();)
+	{
+		if (stRequestedKeys.end() == stRequestedKeys.find(it->first))
+		{
+			vObsoleteScenes.push_back(it->second.ptrScene);
+			it = m_mpReadyScenes.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	std::unique_lock<std::mutex> lock(m_mtMutex);
+	m_stRequestedKeys = stRequestedKeys;
+	m_vCameras = vCameras;
+	m_iFailed = 0;
+
+	//a scene evicted before is warmed up again once it is requested anew.
+	for (auto it = m_stEvictedKeys.begin(); it != m_stEvictedKeys.end();)
+	{
+		if (m_stRequestedKeys.end() == m_stRequestedKeys.find(*it))
+		{
+			it = m_stEvictedKeys.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	//built scenes are never released here, they are not prepared and hold no GL objects.
+	for (auto it = m_vBuiltScenes.begin(); it != m_vBuiltScenes.end();)
+	{
+		if (m_stRequestedKeys.end() == m_stRequestedKeys.find(it->sKey))
+		{
+			m_stBuiltKeys.erase(it->sKey);
+			it = m_vBuiltScenes.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	std::set<std::string> stReadyKeys;
+	for (const auto& ready : m_mpReadyScenes)
+	{
+		stReadyKeys.insert(ready.first);
+	}
+	for (const auto& sKey : stInUseKeys)
+	{
+		if (m_stRequestedKeys.end() != m_stRequestedKeys.find(sKey))
+		{
+			stReadyKeys.insert(sKey);
+		}
+	}
+	m_stReadyKeys = stReadyKeys;
+
+	m_dqPending.clear();
+	for (const auto& request : vRequests)
+	{
+		if ((m_stReadyKeys.end() == m_stReadyKeys.find(request.sKey))
+			&& (m_stBuiltKeys.end() == m_stBuiltKeys.find(request.sKey))
+			&& (m_stEvictedKeys.end() == m_stEvictedKeys.find(request.sKey)))
+		{
+			m_dqPending.push_back(request);
+		}
+	}
+
+	bool bStartWorker = (!m_dqPending.empty()) && (!m_tdWorker.joinable());
+	if (bStartWorker)
+	{
+		m_bStop = false;
+	}
+	lock.unlock();
+
+	for (auto& ptrScene : vObsoleteScenes)
+	{
+		ptrScene->Release();
+	}
+
+	if (bStartWorker)
+	{
+		m_tdWorker = std::thread(&GSceneWarmer::Work, this);
+	}
+	m_cvWork.notify_one();
+}
+
+bool GSceneWarmer::PrepareNext()
+{
+	std::vector<tBuiltScene> vBuiltScenes;
+	{
+		std::lock_guard<std::mutex> lock(m_mtMutex);
+		if (m_vBuiltScenes.empty())
+		{
+			return false;
+		}
+		vBuiltScenes = m_vBuiltScenes;
+	}
+
+	//the programs of all the built scenes are linked at once, the first scene with all its programs linked is uploaded.
+	int iNextIdx = -1;
+	for (int i = 0; i < vBuiltScenes.size(); ++i)
+	{
+		bool bReady = (m_mpReadyScenes.end() != m_mpReadyScenes.find(vBuiltScenes[i].sKey)) || vBuiltScenes[i].ptrScene->RequestPrograms();
+		iNextIdx = ((iNextIdx < 0) && bReady) ? i : iNextIdx;
+	}
+	if (iNextIdx < 0)
+	{
+		return false;
+	}
+
+	tBuiltScene built = vBuiltScenes[iNextIdx];
+	{
+		//only the render thread removes built scenes, the worker just appends them.
+		std::lock_guard<std::mutex> lock(m_mtMutex);
+		auto itBuilt = std::find_if(m_vBuiltScenes.begin(), m_vBuiltScenes.end(), [&](const tBuiltScene& other)
+		{
+			return other.ptrScene == built.ptrScene;
+		});
+		if (m_vBuiltScenes.end() != itBuilt)
+		{
+			m_vBuiltScenes.erase(itBuilt);
+		}
+		m_stBuiltKeys.erase(built.sKey);
+	}
+
+	if (m_mpReadyScenes.end() != m_mpReadyScenes.find(built.sKey))
+	{
+		return true;
+	}
+
+	if (!built.ptrScene->Prepare())
+	{
+		GLOGGER(error) << "GSceneWarmer::PrepareNext(). Prepare failed. ==>";
+		built.ptrScene->Release();
+		std::lock_guard<std::mutex> lock(m_mtMutex);
+		++m_iFailed;
+		return true;
+	}
+
+	m_mpReadyScenes[built.sKey].ptrScene = built.ptrScene;
+	m_mpReadyScenes[built.sKey].ullLastUse = ++m_ullUseCount;
+	std::lock_guard<std::mutex> lock(m_mtMutex);
+	m_stReadyKeys.insert(built.sKey);
+	return true;
+}
+
+std::shared_ptr<GPanoSceneIF> GSceneWarmer::Take(const std::string& sKey)
+{
+	auto itScene = m_mpReadyScenes.find(sKey);
+	if (m_mpReadyScenes.end() == itScene)
+	{
+		return std::shared_ptr<GPanoSceneIF>(nullptr);
+	}
+
+	//the key stays ready, the scene is in use now.
+	std::shared_ptr<GPanoSceneIF> ptrScene = itScene->second.ptrScene;
+	m_mpReadyScenes.erase(itScene);
+	return ptrScene;
+}
+
+bool GSceneWarmer::Return(const std::string& sKey, std::shared_ptr<GPanoSceneIF> ptrScene)
+{
+	if (m_mpReadyScenes.end() != m_mpReadyScenes.find(sKey))
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mtMutex);
+	if (m_stRequestedKeys.end() == m_stRequestedKeys.find(sKey))
+	{
+		return false;
+	}
+
+	m_mpReadyScenes[sKey].ptrScene = ptrScene;
+	m_mpReadyScenes[sKey].ullLastUse = ++m_ullUseCount;
+	m_stReadyKeys.insert(sKey);
+	m_stEvictedKeys.erase(sKey);
+	return true;
+}
+
+size_t GSceneWarmer::GetReadySize(int& iSceneNum) const
+{
+	size_t ullSize_Byte = 0;
+	for (const auto& ready : m_mpReadyScenes)
+	{
+		ullSize_Byte += ready.second.ptrScene->GetMemorySize();
+	}
+	iSceneNum = static_cast<int>(m_mpReadyScenes.size());
+	return ullSize_Byte;
+}
+
+int GSceneWarmer::Evict(size_t ullBudget_Byte)
+{
+	int iSceneNum = 0;
+	size_t ullSize_Byte = GetReadySize(iSceneNum);
+	if (ullSize_Byte <= ullBudget_Byte)
+	{
+		return 0;
+	}
+
+	std::vector<std::pair<std::string, std::shared_ptr<GPanoSceneIF>>> vEvictedScenes;
+	while ((ullBudget_Byte < ullSize_Byte) && !m_mpReadyScenes.empty())
+	{
+		auto itLeastRecent = m_mpReadyScenes.begin();
+		for (auto it = m_mpReadyScenes.begin(); it != m_mpReadyScenes.end(); ++it)
+		{
+			if (it->second.ullLastUse < itLeastRecent->second.ullLastUse)
+			{
+				itLeastRecent = it;
+			}
+		}
+
+		size_t ullSceneSize_Byte = itLeastRecent->second.ptrScene->GetMemorySize();
+		ullSize_Byte = (ullSceneSize_Byte < ullSize_Byte) ? (ullSize_Byte - ullSceneSize_Byte) : 0;
+		vEvictedScenes.push_back(std::make_pair(itLeastRecent->first, itLeastRecent->second.ptrScene));
+		m_mpReadyScenes.erase(itLeastRecent);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mtMutex);
+		for (const auto& evicted : vEvictedScenes)
+		{
+			m_stReadyKeys.erase(evicted.first);
+			m_stEvictedKeys.insert(evicted.first);
+		}
+	}
+
+	for (auto& evicted : vEvictedScenes)
+	{
+		evicted.second->Release();
+	}
+
+	GLOGGER(info) << "GSceneWarmer::Evict(). " << vEvictedScenes.size() << " scenes released, "
+		<< ullSize_Byte / 1024 << " KB left of a budget of " << ullBudget_Byte / 1024 << " KB.";
+	return static_cast<int>(vEvictedScenes.size());
+}
+
+GSceneWarmer::tState GSceneWarmer::GetState()
+{
+	std::lock_guard<std::mutex> lock(m_mtMutex);
+	tState state;
+	state.iRequested = static_cast<int>(m_stRequestedKeys.size());
+	state.iReady = static_cast<int>(m_stReadyKeys.size());
+	state.iBuilt = state.iReady;
+	for (const auto& sKey : m_stBuiltKeys)
+	{
+		if (m_stReadyKeys.end() == m_stReadyKeys.find(sKey))
+		{
+			++state.iBuilt;
+		}
+	}
+	state.iFailed = m_iFailed;
+	return state;
+}
+
+void GSceneWarmer::Release()
+{
+	std::unique_lock<std::mutex> lock(m_mtMutex);
+	m_bStop = true;
+	m_dqPending.clear();
+	lock.unlock();
+	m_cvWork.notify_all();
+
+	if (m_tdWorker.joinable())
+	{
+		m_tdWorker.join();
+	}
+
+	lock.lock();
+	m_vBuiltScenes.clear();
+	m_stBuiltKeys.clear();
+	m_stRequestedKeys.clear();
+	m_stReadyKeys.clear();
+	m_stEvictedKeys.clear();
+	m_iFailed = 0;
+	lock.unlock();
+
+	for (auto it = m_mpReadyScenes.begin(); it != m_mpReadyScenes.end(); ++it)
+	{
+		it->second.ptrScene->Release();
+	}
+	m_mpReadyScenes.clear();
+}
+
+void GSceneWarmer::Work()
+{
+	GLOGGER(info) << "==> GSceneWarmer::Work().";
+	std::unique_lock<std::mutex> lock(m_mtMutex);
+	while (true)
+	{
+		m_cvWork.wait(lock, [this] { return m_bStop || !m_dqPending.empty(); });
+		if (m_bStop)
+		{
+			break;
+		}
+
+		tRequest request = m_dqPending.front();
+		m_dqPending.pop_front();
+		std::vector<CameraModel> vCameras = m_vCameras;
+		lock.unlock();
+
+		//CPU only, also fills the scene cache.
+		bool bCreated = false;
+		std::shared_ptr<GPanoSceneIF> ptrScene;
+		try
+		{
+			ptrScene = GPanoSceneFactory::CreatePanoScene(request.ePanoType);
+			bCreated = (nullptr != ptrScene) && ptrScene->Create(request.config, vCameras, request.sK0Name, request.v4fCropRatios);
+		}
+		catch (...)
+		{
+			bCreated = false;
+		}
+
+		lock.lock();
+		if (!bCreated)
+		{
+			GLOGGER(error) << "GSceneWarmer::Work(). Create failed. pano type: " << request.ePanoType << ". ==>";
+			++m_iFailed;
+		}
+		else if ((m_stRequestedKeys.end() != m_stRequestedKeys.find(request.sKey))
+			&& (m_stBuiltKeys.end() == m_stBuiltKeys.find(request.sKey))
+			&& (m_stReadyKeys.end() == m_stReadyKeys.find(request.sKey)))
+		{
+			tBuiltScene built;
+			built.sKey = request.sKey;
+			built.ptrScene = ptrScene;
+			m_vBuiltScenes.push_back(built);
+			m_stBuiltKeys.insert(request.sKey);
+		}
+	}
+	GLOGGER(info) << "GSceneWarmer::Work() ==>";
+}
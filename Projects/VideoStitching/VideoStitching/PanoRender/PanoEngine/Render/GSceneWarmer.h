@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#ifndef G_SCENE_WARMER_H_
+#define G_SCENE_WARMER_H_
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "GCameraModel.h"
+#include "PanoRender/GPanoRenderCommonIF.h"
+#include "PanoRender/GPanoSceneIF.h"
+
+//builds scenes ahead of their use. the surfaces and patches are generated on a worker thread,
+//the render thread uploads at most one built scene per frame, so a later switch to it costs no more than a frame.
+class GSceneWarmer
+{
+public:
+	struct tRequest
+	{
+		std::string sKey;
+		enPanoType ePanoType;
+		std::string sK0Name;
+		Eigen::Vector4f v4fCropRatios;
+		GStitcherConfig config;
+	};
+
+	struct tState
+	{
+		tState() :
+			iRequested(0)
+			, iBuilt(0)
+			, iReady(0)
+			, iFailed(0)
+		{}
+
+		int iRequested;
+		int iBuilt;
+		int iReady;
+		int iFailed;
+	};
+
+	GSceneWarmer() :
+		m_bStop(false)
+		, m_iFailed(0)
+		, m_ullUseCount(0)
+	{}
+
+	~GSceneWarmer();
+
+	//render thread. replaces the requests, scenes of the former requests not requested any more are released.
+	//stInUseKeys are the keys of the scenes already created, they are ready without being built again.
+	void Start(const std::vector<tRequest>& vRequests, const std::set<std::string>& stInUseKeys, const std::vector<CameraModel>& vCameras);
+
+	//render thread. uploads one built scene whose programs are linked, returns false if there was none.
+	//the programs of the others keep being linked in the background, see GPanoSceneIF::RequestPrograms().
+	bool PrepareNext();
+
+	//render thread. the uploaded scene of sKey, null if it is not ready. the scene is handed over to the caller.
+	std::shared_ptr<GPanoSceneIF> Take(const std::string& sKey);
+
+	//render thread. takes a scene back when it is replaced, false if it is not requested and should be released by the caller.
+	bool Return(const std::string& sKey, std::shared_ptr<GPanoSceneIF> ptrScene);
+
+	//render thread. bytes and number of the uploaded scenes not in use.
+	size_t GetReadySize(int& iSceneNum) const;
+
+	//render thread. releases the uploaded scenes not in use, least recently used first, until they take at most ullBudget_Byte.
+	//an evicted scene is not built again in the background while it is requested, CreateScene() builds it when it is used.
+	//returns the number of scenes released.
+	int Evict(size_t ullBudget_Byte);
+
+	//any thread.
+	tState GetState();
+
+	//render thread, stops the worker and releases the scenes.
+	void Release();
+
+private:
+	void Work();
+
+	struct tBuiltScene
+	{
+		std::string sKey;
+		std::shared_ptr<GPanoSceneIF> ptrScene;
+	};
+
+	struct tReadyScene
+	{
+		std::shared_ptr<GPanoSceneIF> ptrScene;
+		//m_ullUseCount when the scene was uploaded or returned, the smallest is the least recently used.
+		unsigned long long ullLastUse;
+	};
+
+	std::mutex m_mtMutex;
+	std::condition_variable m_cvWork;
+	//guarded by m_mtMutex.
+	std::deque<tRequest> m_dqPending;
+	std::vector<tBuiltScene> m_vBuiltScenes;
+	std::set<std::string> m_stRequestedKeys;
+	std::set<std::string> m_stBuiltKeys;
+	std::set<std::string> m_stReadyKeys;
+	std::set<std::string> m_stEvictedKeys;
+	std::vector<CameraModel> m_vCameras;
+	bool m_bStop;
+	int m_iFailed;
+
+	//render thread only.
+	std::map<std::string, tReadyScene> m_mpReadyScenes;
+	unsigned long long m_ullUseCount;
+	std::thread m_tdWorker;
+};
+
+#endif //G_SCENE_WARMER_H_
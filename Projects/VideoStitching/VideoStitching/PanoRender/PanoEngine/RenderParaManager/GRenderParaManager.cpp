@@ -42,6 +42,12 @@ void GRenderParameterManager::Init(const std::vector<GPanoTypeParas>& vPanoTypeL
 
 	InitViewCamera(m_tempRenderParas);
 	InitViewCamera(m_currentRenderParas);
+
+	m_publishedRenderParas = m_tempRenderParas;
+	for (int i = 0; i < 3; ++i)
+	{
+		m_aRenderParasSnapshots[i] = m_tempRenderParas;
+	}
 }
 
 void GRenderParameterManager::InitViewCamera(tRenderParameters& paras)
@@ -86,8 +92,15 @@ void GRenderParameterManager::InitViewCamera(tRenderParameters& paras)
 
 void GRenderParameterManager::SetInputFrameSize(int iWidth, int iHeight)
 {
+	//called for every input frame, only publish on change.
+	if ((iWidth == m_tempRenderParas.m_iCurrentInputFrameWidth) && (iHeight == m_tempRenderParas.m_iCurrentInputFrameHeight))
+	{
+		return;
+	}
+
 	m_tempRenderParas.m_iCurrentInputFrameWidth = iWidth;
 	m_tempRenderParas.m_iCurrentInputFrameHeight = iHeight;
+	PublishParameters();
 }
 
 void GRenderParameterManager::SetInteractionControllerDOF(const GInteractionControllerDOF& dof)
@@ -95,11 +108,13 @@ void GRenderParameterManager::SetInteractionControllerDOF(const GInteractionCont
 	m_tempRenderParas.m_fInteractionControllerDOF1 = dof.fHorizontal;
 	m_tempRenderParas.m_fInteractionControllerDOF2 = dof.fVertical;
 	m_tempRenderParas.m_fInteractionControllerDOFFOV = dof.fZoom;
+	PublishParameters();
 }
 
 void GRenderParameterManager::SetPanoType(enPanoType panoType)
 {
 	m_tempRenderParas.m_eCurrentPanoType = panoType;
+	PublishParameters();
 }
 
 void GRenderParameterManager::SetDrawRegion(int iX0, int iY0, int iWidth, int iHeight)
@@ -108,11 +123,12 @@ void GRenderParameterManager::SetDrawRegion(int iX0, int iY0, int iWidth, int iH
 	m_tempRenderParas.m_iCurrentDrawRegionY0 = iY0;
 	m_tempRenderParas.m_iCurrentDrawRegionWidth = iWidth;
 	m_tempRenderParas.m_iCurrentDrawRegionHeight = iHeight;
+	PublishParameters();
 }
 
 void GRenderParameterManager::FixDependencyPanoTypeSupport(const std::vector<GPanoTypeParas>& vPanoTypeInfo, tRenderParameters& current, tRenderParameters& temp)
 {
-	if (IsNewPanoType())
+	if (IsNewPanoType(current, temp))
 	{
 		if (!IsPanoTypeSupported(temp.m_eCurrentPanoType))
 		{
@@ -130,9 +146,9 @@ void GRenderParameterManager::FixDependencyZoomBound(const std::vector<GPanoType
 
 void GRenderParameterManager::FixDependencyPanoTypeSwitch(const std::vector<GPanoTypeParas>& vPanoTypeInfo, tRenderParameters& current, tRenderParameters& temp)
 {
-	if (IsNewPanoType())
+	if (IsNewPanoType(current, temp))
 	{
-		if (!IsNewDOF())
+		if (!IsNewDOF(current, temp))
 		{
 			InitViewCamera(temp);
 		}
@@ -179,49 +195,94 @@ void GRenderParameterManager::FixDependencyEyeLocationBound(const std::vector<GP
 	}
 }
 
-bool GRenderParameterManager::IsNewDOF() const
+bool GRenderParameterManager::IsNewDOF(const tRenderParameters& current, const tRenderParameters& temp)
+{
+	return (temp.m_fInteractionControllerDOF1 != current.m_fInteractionControllerDOF1) ||
+		(temp.m_fInteractionControllerDOF2 != current.m_fInteractionControllerDOF2) ||
+		(temp.m_fInteractionControllerDOFFOV != current.m_fInteractionControllerDOFFOV);
+}
+
+bool GRenderParameterManager::IsNewInputFrameSize(const tRenderParameters& current, const tRenderParameters& temp)
 {
-	return (m_tempRenderParas.m_fInteractionControllerDOF1 != m_currentRenderParas.m_fInteractionControllerDOF1) ||
-		(m_tempRenderParas.m_fInteractionControllerDOF2 != m_currentRenderParas.m_fInteractionControllerDOF2) ||
-		(m_tempRenderParas.m_fInteractionControllerDOFFOV != m_currentRenderParas.m_fInteractionControllerDOFFOV);
+	return (temp.m_iCurrentInputFrameWidth != current.m_iCurrentInputFrameWidth) ||
+		(temp.m_iCurrentInputFrameHeight != current.m_iCurrentInputFrameHeight);
 }
 
-bool GRenderParameterManager::IsNewInputFrameSize() const
+bool GRenderParameterManager::IsNewPanoType(const tRenderParameters& current, const tRenderParameters& temp)
 {
-	return (m_tempRenderParas.m_iCurrentInputFrameWidth != m_currentRenderParas.m_iCurrentInputFrameWidth) ||
-		(m_tempRenderParas.m_iCurrentInputFrameHeight != m_currentRenderParas.m_iCurrentInputFrameHeight);
+	return (temp.m_eCurrentPanoType != current.m_eCurrentPanoType);
 }
 
-bool GRenderParameterManager::IsNewPanoType() const
+bool GRenderParameterManager::IsNewDrawRegion(const tRenderParameters& current, const tRenderParameters& temp)
 {
-	return (m_tempRenderParas.m_eCurrentPanoType != m_currentRenderParas.m_eCurrentPanoType);
+	return (temp.m_iCurrentDrawRegionX0 != current.m_iCurrentDrawRegionX0) ||
+		(temp.m_iCurrentDrawRegionY0 != current.m_iCurrentDrawRegionY0) ||
+		(temp.m_iCurrentDrawRegionWidth != current.m_iCurrentDrawRegionWidth) ||
+		(temp.m_iCurrentDrawRegionHeight != current.m_iCurrentDrawRegionHeight);
 }
 
-bool GRenderParameterManager::IsNewDrawRegion() const
+void GRenderParameterManager::PublishParameters()
 {
-	return (m_tempRenderParas.m_iCurrentDrawRegionX0 != m_currentRenderParas.m_iCurrentDrawRegionX0) ||
-		(m_tempRenderParas.m_iCurrentDrawRegionY0 != m_currentRenderParas.m_iCurrentDrawRegionY0) ||
-		(m_tempRenderParas.m_iCurrentDrawRegionWidth != m_currentRenderParas.m_iCurrentDrawRegionWidth) ||
-		(m_tempRenderParas.m_iCurrentDrawRegionHeight != m_currentRenderParas.m_iCurrentDrawRegionHeight);
+	//check dependency against the last published snapshot, so readers of temp see the fixed values right away.
+	FixDependencyPanoTypeSupport(m_vPanoTypeInfo, m_publishedRenderParas, m_tempRenderParas);
+	FixDependencyZoomBound(m_vPanoTypeInfo, m_publishedRenderParas, m_tempRenderParas);
+	FixDependencyPanoTypeSwitch(m_vPanoTypeInfo, m_publishedRenderParas, m_tempRenderParas);
+	FixDependencyEyeLocationBound(m_vPanoTypeInfo, m_publishedRenderParas, m_tempRenderParas);
+
+	//fill the back slot and hand it over, the old middle slot becomes the new back slot.
+	m_aRenderParasSnapshots[m_iBackSnapshot] = m_tempRenderParas;
+	m_iBackSnapshot = m_iMiddleSnapshot.exchange(m_iBackSnapshot | eSnapshotFresh, std::memory_order_acq_rel) & eSnapshotIndexMask;
+
+	m_publishedRenderParas = m_tempRenderParas;
+}
+
+bool GRenderParameterManager::AcquireSnapshot()
+{
+	if (0 == (m_iMiddleSnapshot.load(std::memory_order_acquire) & eSnapshotFresh))
+	{
+		return false;
+	}
+
+	m_iFrontSnapshot = m_iMiddleSnapshot.exchange(m_iFrontSnapshot, std::memory_order_acq_rel) & eSnapshotIndexMask;
+	return true;
 }
 
 void GRenderParameterManager::ApplyParameters()
 {
-	//check dependency.
-	FixDependencyPanoTypeSupport(m_vPanoTypeInfo, m_currentRenderParas, m_tempRenderParas);
-	FixDependencyZoomBound(m_vPanoTypeInfo, m_currentRenderParas, m_tempRenderParas);
-	FixDependencyPanoTypeSwitch(m_vPanoTypeInfo, m_currentRenderParas, m_tempRenderParas);
-	FixDependencyEyeLocationBound(m_vPanoTypeInfo, m_currentRenderParas, m_tempRenderParas);
+	//the front slot may already have been acquired by LatchViewCamera(), so always compare against it.
+	AcquireSnapshot();
+	const tRenderParameters& latest = m_aRenderParasSnapshots[m_iFrontSnapshot];
 
 	//action flag.
-	m_bShouldCreateScene = (IsNewInputFrameSize() || IsNewPanoType()) && (0 != m_tempRenderParas.m_iCurrentInputFrameWidth) && (0 != m_tempRenderParas.m_iCurrentInputFrameHeight);
+	m_bShouldCreateScene = (IsNewInputFrameSize(m_currentRenderParas, latest) || IsNewPanoType(m_currentRenderParas, latest))
+		&& (0 != latest.m_iCurrentInputFrameWidth) && (0 != latest.m_iCurrentInputFrameHeight);
 
-	m_bShouldSetViewPort = IsNewDrawRegion();
+	m_bShouldUpdateScene = m_bShouldCreateScene && (!IsNewPanoType(m_currentRenderParas, latest))
+		&& (0 != m_currentRenderParas.m_iCurrentInputFrameWidth) && (0 != m_currentRenderParas.m_iCurrentInputFrameHeight);
 
-	m_bShouldSetOriginalPanoSize = IsNewDrawRegion() || IsNewInputFrameSize();
+	m_bShouldSetViewPort = IsNewDrawRegion(m_currentRenderParas, latest);
+
+	m_bShouldSetOriginalPanoSize = IsNewDrawRegion(m_currentRenderParas, latest) || IsNewInputFrameSize(m_currentRenderParas, latest);
 
 	//apply paras.
-	m_currentRenderParas = m_tempRenderParas;
+	m_currentRenderParas = latest;
+}
+
+bool GRenderParameterManager::LatchViewCamera()
+{
+	AcquireSnapshot();
+	const tRenderParameters& latest = m_aRenderParasSnapshots[m_iFrontSnapshot];
+
+	//the dof of another pano type or draw region does not fit the scene about to be drawn.
+	if (IsNewPanoType(m_currentRenderParas, latest) || IsNewDrawRegion(m_currentRenderParas, latest))
+	{
+		return false;
+	}
+
+	m_currentRenderParas.m_fInteractionControllerDOF1 = latest.m_fInteractionControllerDOF1;
+	m_currentRenderParas.m_fInteractionControllerDOF2 = latest.m_fInteractionControllerDOF2;
+	m_currentRenderParas.m_fInteractionControllerDOFFOV = latest.m_fInteractionControllerDOFFOV;
+	return true;
 }
 
 enPanoType GRenderParameterManager::GetPanoType() const
@@ -249,7 +310,7 @@ cv::Rect_<float> GRenderParameterManager::GetPanoRectOnCanvas() const
 
 cv::Rect_<float> GRenderParameterManager::GetPanoRectOnCanvas(enPanoType ePanoType) const
 {
-	return GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoType, GetCropRatios());
+	return GPanoTypeStaticParameters::GetPanoRectOnCanvas(ePanoType, GetCropRatios(ePanoType));
 }
 
 cv::Rect GRenderParameterManager::GetDrawRegion() const
@@ -273,6 +334,11 @@ bool GRenderParameterManager::ShouldCreateScene() const
 	return m_bShouldCreateScene;
 }
 
+bool GRenderParameterManager::ShouldUpdateScene() const
+{
+	return m_bShouldUpdateScene;
+}
+
 bool GRenderParameterManager::ShouldSetViewPort() const
 {
 	return m_bShouldSetViewPort;
@@ -285,9 +351,11 @@ bool GRenderParameterManager::ShouldSetOriginalPanoSize() const
 
 bool GRenderParameterManager::CalcInteractionControllerDOF(float fTheta, float fPhi, GInteractionControllerDOF& dof) const
 {
-	if (ePanoTypeImmersionSemiSphere == GetPanoType() ||
-		ePanoTypeImmersionFullSphere == GetPanoType() ||
-		ePanoTypeImmersionFullSphereInside == GetPanoType())
+	//called by ExternalControl, use the pano type the setters know.
+	enPanoType ePanoType = m_tempRenderParas.m_eCurrentPanoType;
+	if (ePanoTypeImmersionSemiSphere == ePanoType ||
+		ePanoTypeImmersionFullSphere == ePanoType ||
+		ePanoTypeImmersionFullSphereInside == ePanoType)
 	{
 		//for immersion panotype.
 		//generate optimal view camera according to this physical direction.
@@ -296,8 +364,8 @@ bool GRenderParameterManager::CalcInteractionControllerDOF(float fTheta, float f
 		dof.fVertical = (fTheta / M_PI);
 		//return false;
 	}
-	else if (ePanoTypeImmersionCylinder360 == GetPanoType() ||
-		ePanoTypeImmersionCylinder360Inside == GetPanoType())
+	else if (ePanoTypeImmersionCylinder360 == ePanoType ||
+		ePanoTypeImmersionCylinder360Inside == ePanoType)
 	{
 		float fX = sinf(fTheta)*cosf(fPhi);
 		float fY = sinf(fTheta)*sinf(fPhi);
@@ -314,13 +382,13 @@ bool GRenderParameterManager::CalcInteractionControllerDOF(float fTheta, float f
 		Eigen::Vector3f v3fPhysical(sinf(fTheta)*cosf(fPhi), sinf(fTheta)*sinf(fPhi), cosf(fTheta));
 
 		//scene point -> pix.
-		std::shared_ptr<GPanoSceneIF> ptrRenderScene = GPanoSceneFactory::CreatePanoScene(GetPanoType());
+		std::shared_ptr<GPanoSceneIF> ptrRenderScene = GPanoSceneFactory::CreatePanoScene(ePanoType);
 
 		Eigen::Vector3f v3fScene;
 		ptrRenderScene->Project(v3fPhysical, v3fScene);
 
 		//generate optimal view camera according to this pixel coordinate.
-		cv::Rect_<float> rtPanoRect = GetPanoRectOnCanvas();
+		cv::Rect_<float> rtPanoRect = GetPanoRectOnCanvas(ePanoType);
 		dof.fHorizontal = static_cast<float>(v3fScene[0] + (rtPanoRect.width / 2.0)) / rtPanoRect.width;
 		dof.fVertical = static_cast<float>(v3fScene[1] + (rtPanoRect.height / 2.0)) / rtPanoRect.height;
 		dof.fZoom = (0.0 == dof.fZoom) ? 1.0f : dof.fZoom;
@@ -379,13 +447,24 @@ cv::Size GRenderParameterManager::ReadOriginalPanoSize() const
 	}
 }
 
+cv::Size GRenderParameterManager::GetInputFrameSize() const
+{
+	return cv::Size(m_currentRenderParas.m_iCurrentInputFrameWidth, m_currentRenderParas.m_iCurrentInputFrameHeight);
+}
+
 Eigen::Vector4f GRenderParameterManager::GetCropRatios() const
 {
+	return GetCropRatios(GetPanoType());
+}
+
+Eigen::Vector4f GRenderParameterManager::GetCropRatios(enPanoType ePanoType) const
+{
+	GPanoTypeParas panoTypeInfo = GetPanoTypeInfo(ePanoType);
 	Eigen::Vector4f v4fCropRatios;
-	v4fCropRatios[0] = GetPanoTypeInfo(GetPanoType()).fLeftCropRatio;
-	v4fCropRatios[1] = GetPanoTypeInfo(GetPanoType()).fRightCropRatio;
-	v4fCropRatios[2] = GetPanoTypeInfo(GetPanoType()).fTopCropRatio;
-	v4fCropRatios[3] = GetPanoTypeInfo(GetPanoType()).fBottomCropRatio;
+	v4fCropRatios[0] = panoTypeInfo.fLeftCropRatio;
+	v4fCropRatios[1] = panoTypeInfo.fRightCropRatio;
+	v4fCropRatios[2] = panoTypeInfo.fTopCropRatio;
+	v4fCropRatios[3] = panoTypeInfo.fBottomCropRatio;
 	return v4fCropRatios;
 }
 
@@ -26,6 +26,7 @@
 #define G_RENDER_PARA_MANAGER_H_
 
 #include <mutex>
+#include <atomic>
 
 #include "PanoRender/GPanoRenderCommonIF.h"
 #include "GPanoCameraInfo.h"
@@ -55,43 +56,54 @@ class GRenderParameterManager
 {
 public:
 	GRenderParameterManager():
-		m_bShouldCreateScene(false)
+		m_iBackSnapshot(0)
+		, m_iMiddleSnapshot(1)
+		, m_iFrontSnapshot(2)
+		, m_iNumOfInputs(0)
+		, m_bShouldCreateScene(false)
+		, m_bShouldUpdateScene(false)
 		, m_bShouldSetViewPort(false)
 		, m_bShouldSetOriginalPanoSize(false)
-		, m_iNumOfInputs(0)
 	{}
-	//for ExternalControl.
+	//for ExternalControl. every setter publishes a complete snapshot, it never waits for the render thread.
 	void Init(const std::vector<GPanoTypeParas>& vPanoTypeList, int iNumOfInputs);
 	void SetInputFrameSize(int iWidth, int iHeight);
 	void SetInteractionControllerDOF(const GInteractionControllerDOF& dof);
 	void SetPanoType(enPanoType panoType);
 	void SetDrawRegion(int iX0, int iY0, int iWidth, int iHeight);
 
+	//for Render. picks up the latest published snapshot at frame start.
 	void ApplyParameters();
+	//re-sample the view camera of the latest snapshot just before drawing.
+	//returns false if the snapshot needs a new scene or viewport, it is then left to the next ApplyParameters().
+	bool LatchViewCamera();
 
-	//for Render.
 	enPanoType GetPanoType() const;
 	std::vector<enPanoType>	GetSupportedPanoTypeList() const;
 	bool IsPanoTypeSupported(enPanoType ePanoType) const;
 	enViewCameraType GetViewCameraType() const;
 	GInteractionControllerDOF ReadInteractionControllerDOF() const;
 	cv::Size ReadOriginalPanoSize() const;
+	cv::Size GetInputFrameSize() const;
 	cv::Rect_<float> GetPanoRectOnCanvas() const;
 	cv::Rect GetDrawRegion() const;
 	//v4fCropRatios = {left,right,top,down}.
 	Eigen::Vector4f GetCropRatios() const;
+	Eigen::Vector4f GetCropRatios(enPanoType ePanoType) const;
 
 	std::string GetK0Name() const;
 
 	GViewCamera4RenderIF* GetViewCamera();
 
 	bool ShouldCreateScene() const;
+	//the scene should be created for a new input frame size of the same pano type, only its K0 changes.
+	bool ShouldUpdateScene() const;
 	bool ShouldSetViewPort() const;
 	bool ShouldSetOriginalPanoSize() const;
 
 	bool CalcInteractionControllerDOF(float fTheta, float fPhi, GInteractionControllerDOF& dof) const;
 
-	//for ExternalReader.
+	//for ExternalControl and ExternalReader. serializes the setters, NOT taken by the render thread.
 	std::mutex m_mtManagerMutex;
 private:
 	struct tRenderParameters
@@ -134,13 +146,17 @@ private:
 
 	cv::Rect_<float> GetPanoRectOnCanvas(enPanoType ePanoType) const;
 
-	bool IsNewDOF() const;
+	static bool IsNewDOF(const tRenderParameters& current, const tRenderParameters& temp);
 
-	bool IsNewInputFrameSize() const;
+	static bool IsNewInputFrameSize(const tRenderParameters& current, const tRenderParameters& temp);
 
-	bool IsNewPanoType() const;
+	static bool IsNewPanoType(const tRenderParameters& current, const tRenderParameters& temp);
 	
-	bool IsNewDrawRegion() const;
+	static bool IsNewDrawRegion(const tRenderParameters& current, const tRenderParameters& temp);
+
+	void PublishParameters();
+
+	bool AcquireSnapshot();
 
 	void FixDependencyPanoTypeSupport(const std::vector<GPanoTypeParas>& vPanoTypeInfo, tRenderParameters& current, tRenderParameters& temp);
 	
@@ -152,12 +168,24 @@ private:
 
 private:
 	std::vector<GPanoTypeParas> m_vPanoTypeInfo;
+	//render thread only.
 	tRenderParameters m_currentRenderParas;
+	//guarded by m_mtManagerMutex.
 	tRenderParameters m_tempRenderParas;
+	tRenderParameters m_publishedRenderParas;
+
+	//triple buffered snapshots. the setters fill the back slot and swap it with the middle slot,
+	//the render thread swaps the middle slot with the front slot only if a fresh snapshot was published.
+	enum { eSnapshotIndexMask = 0x3, eSnapshotFresh = 0x4 };
+	tRenderParameters m_aRenderParasSnapshots[3];
+	int m_iBackSnapshot;
+	std::atomic<int> m_iMiddleSnapshot;
+	int m_iFrontSnapshot;
 
 	int m_iNumOfInputs;
 
 	bool m_bShouldCreateScene;
+	bool m_bShouldUpdateScene;
 	bool m_bShouldSetViewPort;
 	bool m_bShouldSetOriginalPanoSize;
 
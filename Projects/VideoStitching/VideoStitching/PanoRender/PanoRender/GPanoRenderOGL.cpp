@@ -24,6 +24,7 @@
  
 #include "GPanoRenderOGL.h"
 
+#include <algorithm>
 #include <bitset>
 #include <sstream>
 
@@ -31,12 +32,14 @@
 
 #include "GFileUtils.h"
 #include "GGlobalParametersManager.h"
+#include "GSceneCache.h"
 #include "Common/GiraffeLogger/GiraffeLogger.h"
 #include "GGLError.h"
 
 
 #if defined WIN32
 #include "Windows.h"
+#include "GL/wglew.h"
 #elif __APPLE__
 #elif __ANDROID__
 #elif __linux__
@@ -128,13 +131,11 @@ unsigned long GStitcherOGLWrapper_PanoRender::GetTasks()
 	//Task InitGL.
 	else if (ePanoRenderStateCreated == m_ePanoRenderState)
 	{
-		std::unique_lock<std::mutex> lk(m_mtHWNDMutex);
-		m_cvInitFlag.wait(lk, [this]()
+		std::lock_guard<std::mutex> lk(m_mtHWNDMutex);
+		if (m_bInitCalled)
 		{
-			return ((!this->m_bRendering) || m_bInitCalled);
-		});
-
-		bsRet.set((m_bRendering) ? ePanoRenderTaskInit : ePanoRenderTaskDestroy);
+			bsRet.set(ePanoRenderTaskInit);
+		}
 	}
 	//Task CreateScene & SetViewPort & SetOriginalPanoSize.
 	else if (ePanoRenderStateInited <= m_ePanoRenderState)
@@ -145,12 +146,16 @@ unsigned long GStitcherOGLWrapper_PanoRender::GetTasks()
 			return bsRet.to_ulong();
 		}
 
-		{
-			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
-			m_RenderParameterManager.ApplyParameters();
-		}
+		//lock free, picks up the latest snapshot published by the setters.
+		m_RenderParameterManager.ApplyParameters();
 
-		if (m_RenderParameterManager.ShouldCreateScene())
+		//a new tessellation level of the quality controller, a new tessellation tolerance or a new render path rebuilds the scene as well.
+		if (m_RenderParameterManager.ShouldCreateScene() ||
+			((ePanoRenderStateSceneCreated <= m_ePanoRenderState) && (m_iSceneTessellationLevel != m_QualityLevel.iTessellationLevel)) ||
+			((ePanoRenderStateSceneCreated <= m_ePanoRenderState) && (m_fSceneTessellationTolerance_px != CalcTessellationTolerance(
+				m_RenderParameterManager.GetPanoType(), cv::Size(m_iPanoOriginalWidth, m_iPanoOriginalHeight)))) ||
+			((ePanoRenderStateSceneCreated <= m_ePanoRenderState) && (m_szSceneRemapTable != CalcRemapTableSize(
+				m_RenderParameterManager.GetPanoType(), cv::Size(m_iPanoOriginalWidth, m_iPanoOriginalHeight)))))
 		{
 			bsRet.set(ePanoRenderTaskCreateScene);
 		}
@@ -165,1743 +170,3964 @@ unsigned long GStitcherOGLWrapper_PanoRender::GetTasks()
 			bsRet.set(ePanoRenderTaskSetOriginalPanoSize);
 		}
 
+		{
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			if (m_bWarmUpChanged)
+			{
+				bsRet.set(ePanoRenderTaskWarmUp);
+			}
+		}
+
 		if (m_UnprojectContext.bNeedUnProject)
 		{
 			bsRet.set(ePanoRenderTaskUnProject);
 		}
 
-		bsRet.set(ePanoRenderTaskRender);
+		{
+			std::lock_guard<std::mutex> lk(m_FrameGroupContext.mtTaskMutex);
+			if (m_FrameGroupContext.bPending)
+			{
+				bsRet.set(ePanoRenderTaskRenderFrameGroup);
+			}
+		}
+
+		if (GStitcherConfig::eRenderingModeOffScreen != m_Config.m_eRenderingMode)
+		{
+			bsRet.set(ePanoRenderTaskRender);
+		}
+		else
+		{
+			//off screen mode renders exactly one output for every complete group of input frames.
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			if (IsFrameGroupReady())
+			{
+				bsRet.set(ePanoRenderTaskRender);
+			}
+		}
 	}
 
 	return bsRet.to_ulong();
 }
 
-void GStitcherOGLWrapper_PanoRender::RenderingLoop(GStitcherOGLWrapper_PanoRender* pPanoRender)
+void GStitcherOGLWrapper_PanoRender::WaitForEvents(bool bUrgentOnly)
 {
-	try
-	{
-		GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderingLoop().";
-
-		while (true)
-		{
-			unsigned long ulTasks = 0;
-			ulTasks = pPanoRender->GetTasks();
-
-			if (0 == ulTasks)
-			{
-				std::this_thread::sleep_for(std::chrono::milliseconds(10));
-				continue;
-			}
+	std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+	m_NextStep.eWait = eStepWaitForEvents;
+	m_NextStep.bUrgentOnly = bUrgentOnly;
+}
 
-			if (ulTasks & (1 << ePanoRenderTaskInit))
-			{
-				if (!pPanoRender->InitOpenGL())
-				{
-					GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). InitPanoRender ERROR, Terminating.";
-					pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-					break;
-				}
+void GStitcherOGLWrapper_PanoRender::WaitForEventsUntil(const std::chrono::steady_clock::time_point& tpDeadline)
+{
+	std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+	m_NextStep.eWait = eStepWaitUntil;
+	m_NextStep.bUrgentOnly = true;
+	m_NextStep.tpDeadline = tpDeadline;
+}
 
-				if (!pPanoRender->InitStitcher())
-				{
-					GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). Init StitcherOGL ERROR. Terminating.";
-					pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-					break;
-				}
+bool GStitcherOGLWrapper_PanoRender::IsWaitOver(const std::chrono::steady_clock::time_point& tpNow
+	, std::chrono::steady_clock::time_point& tpReadySince, std::chrono::steady_clock::time_point& tpWakeUp) const
+{
+	tpWakeUp = (std::chrono::steady_clock::time_point::max)();
 
-				pPanoRender->m_ePanoRenderState = ePanoRenderStateInited;
-			}
+	if (eStepWaitNone == m_NextStep.eWait)
+	{
+		tpReadySince = m_NextStep.tpScheduled;
+		return true;
+	}
 
-			if (ulTasks & (1 << ePanoRenderTaskCreateScene))
-			{
-				GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). Should Create Scene with new size. ";
+	if (((!m_NextStep.bUrgentOnly) && m_bNewEvent) || m_bUrgentEvent || IsFrameGroupReady())
+	{
+		tpReadySince = m_tpEventTime;
+		return true;
+	}
 
-				std::lock_guard<std::mutex> lockGuard(pPanoRender->m_mtStitcherOGLMutex);
+	if (eStepWaitUntil == m_NextStep.eWait)
+	{
+		if (tpNow >= m_NextStep.tpDeadline)
+		{
+			tpReadySince = m_NextStep.tpDeadline;
+			return true;
+		}
 
-				if (!pPanoRender->m_stitcherOGL.CreateScene("default", pPanoRender->m_RenderParameterManager.GetPanoType()
-					, pPanoRender->m_RenderParameterManager.GetK0Name(), pPanoRender->m_RenderParameterManager.GetCropRatios()))
-				{
-					GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). Create scene ERROR. Terminating.";
-					pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-					break;
-				}
+		tpWakeUp = m_NextStep.tpDeadline;
+	}
 
-				if (!pPanoRender->m_stitcherOGL.SwitchScene("default"))
-				{
-					GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). Switch scene ERROR. Terminating.";
-					pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-					break;
-				}
+	return false;
+}
 
-				pPanoRender->m_ePanoRenderState = ePanoRenderStateSceneCreated;
-			}
+void GStitcherOGLWrapper_PanoRender::WaitForNextStep()
+{
+	std::unique_lock<std::mutex> lk(m_mtWakeUpMutex);
 
-			if (ulTasks & (1 << ePanoRenderTaskSetViewPort))
-			{
-				cv::Rect rect = pPanoRender->m_RenderParameterManager.GetDrawRegion();
+	std::chrono::steady_clock::time_point tpReadySince;
+	std::chrono::steady_clock::time_point tpWakeUp;
+	while (!IsWaitOver(std::chrono::steady_clock::now(), tpReadySince, tpWakeUp))
+	{
+		if ((std::chrono::steady_clock::time_point::max)() == tpWakeUp)
+		{
+			m_cvWakeUp.wait(lk);
+		}
+		else
+		{
+			m_cvWakeUp.wait_until(lk, tpWakeUp);
+		}
+	}
+}
 
-				{
-					std::lock_guard<std::mutex> lockGuard(pPanoRender->m_mtStitcherOGLMutex);
-					pPanoRender->m_FBODisplay.SetViewPort(rect.tl().x, rect.tl().y, rect.width, rect.height);
-				}
-			}
+bool GStitcherOGLWrapper_PanoRender::IsRunnable(const std::chrono::steady_clock::time_point& tpNow
+	, std::chrono::steady_clock::time_point& tpReadySince, std::chrono::steady_clock::time_point& tpWakeUp)
+{
+	std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+	return IsWaitOver(tpNow, tpReadySince, tpWakeUp);
+}
 
-			if (ulTasks & (1 << ePanoRenderTaskSetOriginalPanoSize))
-			{
-				cv::Size szOriginalPanoSize = pPanoRender->m_RenderParameterManager.ReadOriginalPanoSize();
+void GStitcherOGLWrapper_PanoRender::WakeUpRenderingLoop(bool bUrgent)
+{
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		if ((!m_bNewEvent) && (!m_bUrgentEvent))
+		{
+			m_tpEventTime = std::chrono::steady_clock::now();
+		}
+		m_bNewEvent = true;
+		m_bUrgentEvent |= bUrgent;
+	}
+	m_cvWakeUp.notify_one();
 
-				{
-					std::lock_guard<std::mutex> lockGuard(pPanoRender->m_mtStitcherOGLMutex);
-					pPanoRender->m_iPanoOriginalWidth = szOriginalPanoSize.width;
-					pPanoRender->m_iPanoOriginalHeight = szOriginalPanoSize.height;
-				}
-			}
+	if (nullptr != m_ptrRenderExecutor)
+	{
+		m_ptrRenderExecutor->Notify(this);
+	}
+}
 
-			if (ulTasks & (1 << ePanoRenderTaskRender))
-			{
-				auto start = std::chrono::high_resolution_clock::now();
+bool GStitcherOGLWrapper_PanoRender::IsFrameGroupReady() const
+{
+	bool bOffScreen = (GStitcherConfig::eRenderingModeOffScreen == m_Config.m_eRenderingMode);
+	if ((!bOffScreen) && (eFramePacingModeInputDriven != m_eFramePacingMode))
+	{
+		return false;
+	}
 
-				if (!pPanoRender->Render())
-				{
-					GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). Render ERROR. Terminating.";
-					pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-					break;
-				}
+	//in input driven mode, cameras that never input a frame are not waited for.
+	//off screen mode waits for all cameras, so that every output is stitched from a complete group.
+	bool bAnyPending = false;
+	for (int iCamera = 0; iCamera < m_vPendingFrameNum.size(); ++iCamera)
+	{
+		if ((bOffScreen || m_vCameraActive[iCamera]) && (0 == m_vPendingFrameNum[iCamera]))
+		{
+			return false;
+		}
 
-				if (ulTasks & (1 << ePanoRenderTaskUnProject))
-				{
-					{
-						std::lock_guard<std::mutex> lockGuard(pPanoRender->m_mtStitcherOGLMutex);
-						for (int i = 0; i < pPanoRender->m_UnprojectContext.vfInputPoints.size(); ++i)
-						{
-							cv::Point2f& ptSrc = pPanoRender->m_UnprojectContext.vfInputPoints[i];
-							cv::Point3f& ptDst = pPanoRender->m_UnprojectContext.vfOutputPoints[i];
-
-							float fDepth = 0.0;
-							glm::vec4 mvViewPort;
-							cv::Point2i ptPix = cv::Point2i(0, 0);
-							if (GStitcherConfig::eRenderingModeOnScreen == pPanoRender->m_Config.m_eRenderingMode)
-							{
-								fDepth = pPanoRender->m_FBODisplay.GetDepth(ptSrc.x, ptSrc.y);
-								mvViewPort = pPanoRender->m_FBODisplay.GetViewPort();
-								ptPix = pPanoRender->m_FBODisplay.NormalizedPix2Pix(ptSrc);
-							}
-							else
-							{
-								fDepth = pPanoRender->m_downloaders.GrabTask()->GetDepth(ptSrc.x, ptSrc.y);
-								mvViewPort = pPanoRender->m_downloaders.GrabTask()->GetViewPort();
-								ptPix = pPanoRender->m_downloaders.GrabTask()->NormalizedPix2Pix(ptSrc);
-							}
-
-							pPanoRender->m_UnprojectContext.bRet =
-								pPanoRender->m_stitcherOGL.UnProjectPix2Physical(ptPix.x, ptPix.y, fDepth
-								, ptDst.x, ptDst.y, ptDst.z
-								, mvViewPort);
-						}
-					}
+		bAnyPending |= (0 < m_vPendingFrameNum[iCamera]);
+	}
 
-					{
-						std::lock_guard<std::mutex> lk(pPanoRender->m_UnprojectContext.mtTaskMutex);
-						pPanoRender->m_UnprojectContext.bNeedUnProject = false;
-					}
-					pPanoRender->m_UnprojectContext.cvTaskDone.notify_one();
-				}
+	return bAnyPending;
+}
 
-#ifdef WIN32
-				if ((GStitcherConfig::eRenderingModeOnScreen == pPanoRender->m_Config.m_eRenderingMode) &&
-					(!SwapBuffers(pPanoRender->m_HDC)))
-				{
-					GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). Swap buffers ERROR. Terminating.";
-					pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-					break;
-				}
-#elif __APPLE__
-#elif (defined __ANDROID__) || (defined __linux__)
-				if ((GStitcherConfig::eRenderingModeOnScreen == pPanoRender->m_Config.m_eRenderingMode) &&
-					(EGL_FALSE == eglSwapBuffers(pPanoRender->m_Display, pPanoRender->m_Surface)))
-				{
-					GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). Swap buffers ERROR. Terminating.";
-					pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-					break;
-				}
-#endif // WIN32
+void GStitcherOGLWrapper_PanoRender::OnMakeCurrentFailed()
+{
+	m_ePanoRenderState = ePanoRenderStateError;
+
+	//the pending frames would keep the task runnable, the queues are dropped with the task anyway.
+	std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+	m_bNewEvent = false;
+	m_bUrgentEvent = false;
+	std::fill(m_vPendingFrameNum.begin(), m_vPendingFrameNum.end(), 0);
+	m_NextStep = tNextStep();
+	m_NextStep.eWait = eStepWaitForEvents;
+	m_NextStep.bUrgentOnly = true;
+}
 
-				auto end = std::chrono::high_resolution_clock::now();
-				auto sleepFor = (std::chrono::milliseconds(1000 / pPanoRender->m_iFPS) - std::chrono::duration_cast<std::chrono::milliseconds>(end - start)).count();
-				sleepFor = (sleepFor < 0) ? 0 : sleepFor;
-				std::this_thread::sleep_for(std::chrono::milliseconds(sleepFor));
-			}
+std::chrono::steady_clock::time_point GStitcherOGLWrapper_PanoRender::BeginFrame()
+{
+	bool bFramePacingChanged = false;
+	enFramePacingMode eFramePacingMode = eFramePacingModeFixedFPS;
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		bFramePacingChanged = m_bFramePacingChanged;
+		eFramePacingMode = m_eFramePacingMode;
+		m_bFramePacingChanged = false;
+	}
 
-			if (ulTasks & (1 << ePanoRenderTaskDestroy))
-			{
-				break;
-			}
-		}//while
+	//the swap interval is left to the driver until a pacing mode is set.
+	if (bFramePacingChanged &&
+		(GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode))
+	{
+		SetSwapInterval((eFramePacingModeUnthrottled == eFramePacingMode) ? 0 : 1);
+	}
 
-		pPanoRender->Release();
+	std::chrono::steady_clock::time_point tpFrameStart = std::chrono::steady_clock::now();
 
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderingLoop() ==>";
-	}
-	catch (...)
+	//the idle time of an input driven frame is known when the next frame starts.
+	if (m_bMeasureIdleSlack)
 	{
-		pPanoRender->m_ePanoRenderState = ePanoRenderStateError;
-		pPanoRender->Release();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderingLoop(). EXCEPTION. ==>";
-		return;
+		std::lock_guard<std::mutex> lk(m_RenderStatistics.mtStatisticsMutex);
+		m_RenderStatistics.cbSlacks_ms.push_back(std::chrono::duration<double, std::milli>(tpFrameStart - m_tpLastFrameEnd).count());
+		m_bMeasureIdleSlack = false;
 	}
+
+	return tpFrameStart;
 }
 
-bool GStitcherOGLWrapper_PanoRender::Create(G_tPanoRenderConfig panoRenderConfig, const char* pModel, unsigned int uiSize_Byte)
+void GStitcherOGLWrapper_PanoRender::ScheduleNextFrame(const std::chrono::steady_clock::time_point& tpFrameStart)
 {
-	try
+	enFramePacingMode eFramePacingMode = eFramePacingModeFixedFPS;
+	float fTargetFPS = 0.0f;
 	{
-		GPanoCameraProfile panoCameraInfo;
-		//LoadGraphFromFileBin("E:\\model_5_360_2.bin", mGraph);
-		LoadObjectFromFileBinRawData(pModel, static_cast<int>(uiSize_Byte), panoCameraInfo);
-		SortByCameraName(panoCameraInfo.vCameraModels);
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		eFramePacingMode = m_eFramePacingMode;
+		fTargetFPS = m_fTargetFPS;
+	}
 
-		if (panoCameraInfo.vPanoTypeList.empty())
+	std::chrono::steady_clock::time_point tpFrameEnd = std::chrono::steady_clock::now();
+	double dSlack_ms = 0.0;
+	m_tpLastFrameEnd = tpFrameEnd;
+
+	if (GStitcherConfig::eRenderingModeOffScreen == m_Config.m_eRenderingMode)
+	{
+		//as fast as possible, GetTasks() holds the rendering back until the next group of input frames is complete.
+		m_tpNextFrame = tpFrameEnd;
+	}
+	else if (eFramePacingModeFixedFPS == eFramePacingMode)
+	{
+		//deadline based pacing: frames are scheduled on a fixed grid, so the time spent on rendering does not accumulate as drift.
+		//if rendering falls behind, restart the grid from now instead of rendering a burst of late frames.
+		//a frame rendered early for an urgent event does not move the grid.
+		if (tpFrameEnd >= m_tpNextFrame)
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Create(). pano type list is empty. Create failed.";
-			return false;
+			m_tpNextFrame += std::chrono::microseconds(static_cast<long long>(1000000.0 / fTargetFPS));
 		}
 
-		TransPanoCameraProfile2CameraModel(panoCameraInfo, m_vCameras);
-
-		m_RenderParameterManager.Init(panoCameraInfo.vPanoTypeList, panoCameraInfo.vCameraModels.size());
+		dSlack_ms = std::chrono::duration<double, std::milli>(m_tpNextFrame - tpFrameEnd).count();
+		m_tpNextFrame = (m_tpNextFrame < tpFrameEnd) ? tpFrameEnd : m_tpNextFrame;
 
-		//Set up config parameters.
-		switch (panoRenderConfig.eInputFormat)
+		WaitForEventsUntil(m_tpNextFrame);
+	}
+	else if (eFramePacingModeInputDriven == eFramePacingMode)
+	{
+		if (fTargetFPS > 0.0f)
 		{
-		case G_eInputFormatRGB:
-			m_Config.m_eInputFrameFormat = eFrameFormatRGB;
-			break;
-		case G_eInputFormatYUV420P:
-			m_Config.m_eInputFrameFormat = eFrameFormatYUV420P;
-			break;
-		case G_eInputFormatYV12:
-			m_Config.m_eInputFrameFormat = eFrameFormatYV12;
-			break;
-		case G_eInputFormatNV12:
-			m_Config.m_eInputFrameFormat = eFrameFormatNV12;
-			break;
-		default:
-			break;
+			WaitForEventsUntil(tpFrameEnd + std::chrono::microseconds(static_cast<long long>(1000000.0 / fTargetFPS)));
 		}
-
-		switch (panoRenderConfig.eRenderingMode)
+		else
 		{
-		case G_eRenderingModeOnScreen:
-			m_Config.m_eRenderingMode = GStitcherConfig::eRenderingModeOnScreen;
-			break;
-		case G_eRenderingModeOffScreen:
-			m_Config.m_eRenderingMode = GStitcherConfig::eRenderingModeOffScreen;
-			break;
-		case G_eRenderingModeOffScreenRealTime:
-			m_Config.m_eRenderingMode = GStitcherConfig::eRenderingModeOffScreenRealTime;
-			break;
-		default:
-			break;
+			WaitForEvents(true);
 		}
 
-		m_Config.m_eOptionUploading = GStitcherConfig::eOptionUploadingPBO;
-		m_Config.m_eOptionDownloading = GStitcherConfig::eOptionDownloadingPBO;
+		m_bMeasureIdleSlack = true;
+	}
+	else
+	{
+		//unthrottled, or throttled by swapping buffers in vsync mode.
+		m_tpNextFrame = tpFrameEnd;
+	}
+
+	std::lock_guard<std::mutex> lk(m_RenderStatistics.mtStatisticsMutex);
+	m_RenderStatistics.cbFrameStartTimes.push_back(tpFrameStart);
+	m_RenderStatistics.cbFrameTimes_ms.push_back(std::chrono::duration<double, std::milli>(tpFrameEnd - tpFrameStart).count());
+	if (!m_bMeasureIdleSlack)
+	{
+		m_RenderStatistics.cbSlacks_ms.push_back(dSlack_ms);
+	}
+	++m_RenderStatistics.ullRenderedFrames;
+	m_RenderStatistics.ullLateFrames += (dSlack_ms < 0.0) ? 1 : 0;
+}
 
+void GStitcherOGLWrapper_PanoRender::UpdateQuality(double dFrameTime_ms)
+{
+	bool bConfigChanged = false;
+	bool bEnabled = false;
+	G_tQualityControllerConfig config;
+	G_tQualityCallBack pQualityCallBack = nullptr;
+	void* pQualityCallBackContext = nullptr;
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		bConfigChanged = m_bQualityControllerChanged;
+		bEnabled = m_bQualityControllerEnabled;
+		config = m_QualityControllerConfig;
+		pQualityCallBack = m_pQualityCallBack;
+		pQualityCallBackContext = m_pQualityCallBackContext;
+		m_bQualityControllerChanged = false;
+	}
 
-		m_ePanoRenderState = ePanoRenderStateCreated;
+	//a new configuration restarts at the full quality.
+	bool bLevelChanged = false;
+	if (bConfigChanged)
+	{
+		m_QualityController.Init(bEnabled ? &config : nullptr, m_Config.m_iTessellationLevel);
+		bLevelChanged = true;
+	}
+	else
+	{
+		bLevelChanged = m_QualityController.AddFrameTime(dFrameTime_ms);
+	}
 
-		m_iFPS = 30;
-		m_tdRendering = std::thread(GStitcherOGLWrapper_PanoRender::RenderingLoop, this);
+	G_tQualityState qualityState;
+	m_QualityController.GetState(qualityState);
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		m_QualityState = qualityState;
+	}
 
-		return true;
+	if (!bLevelChanged)
+	{
+		return;
 	}
-	catch (...)
+
+	//the scenes are rebuilt with the new tessellation level before the next frame, see GetTasks() and UpdateViews().
+	const GQualityController::tLevel& level = m_QualityController.GetLevel();
+	if (level.iTessellationLevel != m_QualityLevel.iTessellationLevel)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Create(). EXCEPTION. ==>";
+		std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+		m_stitcherOGL.SetTessellationLevel(level.iTessellationLevel);
+	}
+	m_QualityLevel = level;
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::UpdateQuality(). Quality level: " << qualityState.iLevel << "/" << qualityState.iLevelNum
+		<< ", Resolution Scale: " << level.fResolutionScale << ", Output Scale: " << level.fOutputScale
+		<< ", Tessellation Level: " << level.iTessellationLevel << ", Skip Invisible Cameras: " << level.bSkipInvisibleCameras << ". ==>";
+
+	if (nullptr != pQualityCallBack)
+	{
+		pQualityCallBack(&qualityState, pQualityCallBackContext);
+	}
+}
+
+int GStitcherOGLWrapper_PanoRender::ScaleByQuality(int iSize) const
+{
+	return std::max(1, static_cast<int>(iSize * m_QualityLevel.fResolutionScale + 0.5f));
+}
+
+#ifdef WIN32
+bool GStitcherOGLWrapper_PanoRender::SetSwapInterval(int iInterval)
+{
+	if ((!WGLEW_EXT_swap_control) || (!wglSwapIntervalEXT(iInterval)))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetSwapInterval(). wglSwapIntervalEXT FAILED.";
+		return false;
+	}
+
+	return true;
+}
+#elif __APPLE__
+#elif (defined __ANDROID__) || (defined __linux__)
+bool GStitcherOGLWrapper_PanoRender::SetSwapInterval(int iInterval)
+{
+	if (EGL_FALSE == eglSwapInterval(m_Display, iInterval))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetSwapInterval(). eglSwapInterval FAILED. EGL Error: "
+			<< eglGetError();
 		return false;
 	}
+
+	return true;
 }
+#endif // WIN32
 
-bool GStitcherOGLWrapper_PanoRender::InitPanoRender(void* hWnd)
+void GStitcherOGLWrapper_PanoRender::RenderingLoop(GStitcherOGLWrapper_PanoRender* pPanoRender)
+{
+	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderingLoop().";
+
+	while (pPanoRender->RunStep())
+	{
+		pPanoRender->WaitForNextStep();
+	}
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderingLoop() ==>";
+}
+
+bool GStitcherOGLWrapper_PanoRender::RunStep()
 {
 	try
 	{
-		if (m_ePanoRenderState != ePanoRenderStateCreated)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitPanoRender(). Not Ready or already Inited. ==>";
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_bNewEvent = false;
+			m_bUrgentEvent = false;
+			m_tpEventTime = std::chrono::steady_clock::now();
+			m_NextStep = tNextStep();
+			m_idRenderingThread = std::this_thread::get_id();
+		}
+
+		if (!RunTasks())
+		{
+			Release();
 			return false;
 		}
 
 		{
-			std::lock_guard<std::mutex> lk(m_mtHWNDMutex);
-			m_HWND = hWnd;
-		    m_bInitCalled = true;
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_NextStep.tpScheduled = std::chrono::steady_clock::now();
 		}
-		m_cvInitFlag.notify_one();
 
 		return true;
 	}
 	catch (...)
 	{
 		m_ePanoRenderState = ePanoRenderStateError;
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitPanoRender(). EXCEPTION. ==>";
+		Release();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunStep(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-#ifdef WIN32
-
-bool GStitcherOGLWrapper_PanoRender::InitOpenGL()
+bool GStitcherOGLWrapper_PanoRender::RunTasks()
 {
-	try
+	//the fixed fps grid starts from the first frame after being idle.
+	if (m_bRestartFrameGrid)
 	{
-		m_HDC = GetDC((HWND)m_HWND);
-		if (nullptr == m_HDC)
-		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). GetDC FAILED.";
-			return false;
-		}
+		m_tpNextFrame = std::chrono::steady_clock::now();
+		m_bRestartFrameGrid = false;
+	}
 
-		m_GLContext = wglCreateContext(m_HDC);
-		if (nullptr == m_GLContext)
+	unsigned long ulTasks = 0;
+	ulTasks = GetTasks();
+
+	if (0 == ulTasks)
+	{
+		if ((GStitcherConfig::eRenderingModeOffScreen == m_Config.m_eRenderingMode) &&
+			(ePanoRenderStateInited <= m_ePanoRenderState))
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Create OpenGL context FAILED.";
-			return false;
+			FlushOutput();
 		}
 
-		if (!wglMakeCurrent(m_HDC, m_GLContext))
+		WaitForEvents();
+		m_bRestartFrameGrid = true;
+		return true;
+	}
+
+	if (ulTasks & (1 << ePanoRenderTaskInit))
+	{
+		if (!InitOpenGL())
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Bind OpenGL Context FAILED. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunTasks(). InitPanoRender ERROR, Terminating.";
+			m_ePanoRenderState = ePanoRenderStateError;
 			return false;
 		}
 
-		if (glewInit() != GLEW_OK)
+		if (!InitStitcher())
 		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Init StitcherOGL ERROR. Terminating.";
 			m_ePanoRenderState = ePanoRenderStateError;
-			GLOGGER(error) << "GLEW init failed. ";
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). ==>";
 			return false;
 		}
 
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). OpenGL Inited. ==>";
-		return true;
-	}
-	catch (...)
-	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		Release();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). EXCEPTION. ==>";
-		return false;
-	}
-}
-#elif __APPLE__
-#elif (defined __ANDROID__) || (defined __linux__)
-bool GStitcherOGLWrapper_PanoRender::GetDisplay(void* pNativeWindow)
-{
-	//todo. How to get Display of specified pNativeWindow?
-	m_Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-	if (EGL_NO_DISPLAY == m_Display)
-	{
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). eglGetDisplay FAILED. EGL Error: "
-			<< eglGetError();
-		return false;
+		m_ePanoRenderState = ePanoRenderStateInited;
 	}
 
-	EGLint iMajorVersion = 0;
-	EGLint iMinorVersion = 0;
-	if (EGL_FALSE == eglInitialize(m_Display, &iMajorVersion, &iMinorVersion))
+	if (ulTasks & (1 << ePanoRenderTaskCreateScene))
 	{
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). eglInitialize FAILED. EGL Error: "
-			<< eglGetError();
-		return false;
-	}
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Should Create Scene with new size. ";
 
-	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). EGL Version: " << iMajorVersion << "." << iMinorVersion;
+		//the original pano size of a new pano type is set below, the tolerance is calculated from it directly.
+		float fTolerance_px = CalcTessellationTolerance(m_RenderParameterManager.GetPanoType(), m_RenderParameterManager.ReadOriginalPanoSize());
+		cv::Size szRemapTable = CalcRemapTableSize(m_RenderParameterManager.GetPanoType(), m_RenderParameterManager.ReadOriginalPanoSize());
+		cv::Size szInputFrameSize = m_RenderParameterManager.GetInputFrameSize();
+		std::string sSceneCacheDirectory = GetSceneCacheDirectory();
+		std::string sProgramBinaryCacheDirectory = GetProgramBinaryCacheDirectory();
 
-	if (!((iMajorVersion > 1) || ((1 == iMajorVersion) && (iMinorVersion >= 4))))
-	{
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). Error: EGL Version should be 1.4 or later.";
-		return false;
-	}
+		//a new input frame size of the same scene only changes its texture coordinates.
+		bool bUpdate = m_RenderParameterManager.ShouldUpdateScene() && (ePanoRenderStateSceneCreated <= m_ePanoRenderState)
+			&& (m_iSceneTessellationLevel == m_QualityLevel.iTessellationLevel) && (m_fSceneTessellationTolerance_px == fTolerance_px)
+			&& (m_szSceneRemapTable == szRemapTable);
 
-	return true;
-}
+		std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
 
-bool GStitcherOGLWrapper_PanoRender::GetConfig(EGLConfig& eglConfig)
-{
-#ifdef __ANDROID__
-	std::vector<EGLint>  vCfgAttribs =
-	{
-		EGL_SURFACE_TYPE, (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode) ? EGL_WINDOW_BIT : EGL_PBUFFER_BIT,
-		EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
-		EGL_RED_SIZE, 5,
-		EGL_GREEN_SIZE, 6,
-		EGL_BLUE_SIZE, 5,
-		EGL_DEPTH_SIZE, 1,
-		EGL_NONE
-	};
-#elif __linux__
-	std::vector<EGLint> vCfgAttribs =
-	{
-		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
-		EGL_RED_SIZE, 5,
-		EGL_GREEN_SIZE, 6,
-		EGL_BLUE_SIZE, 5,
-		EGL_DEPTH_SIZE, 1,
-		EGL_NONE
-	};
+		m_stitcherOGL.SetTessellationLevel(m_QualityLevel.iTessellationLevel);
+		m_stitcherOGL.SetTessellationTolerance(fTolerance_px, szInputFrameSize.width, szInputFrameSize.height);
+		m_stitcherOGL.SetRemapTableSize(szRemapTable.width, szRemapTable.height);
+		m_stitcherOGL.SetSceneCacheDirectory(sSceneCacheDirectory);
+		m_stitcherOGL.SetProgramBinaryCacheDirectory(sProgramBinaryCacheDirectory);
+		bool bCreated = bUpdate ?
+			m_stitcherOGL.UpdateScene("default", m_RenderParameterManager.GetPanoType(), m_RenderParameterManager.GetK0Name(), m_RenderParameterManager.GetCropRatios())
+			: m_stitcherOGL.CreateScene("default", m_RenderParameterManager.GetPanoType(), m_RenderParameterManager.GetK0Name(), m_RenderParameterManager.GetCropRatios());
+		if (!bCreated)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Create scene ERROR. Terminating.";
+			m_ePanoRenderState = ePanoRenderStateError;
+			return false;
+		}
 
-	if(GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
-	{
-		vCfgAttribs[vCfgAttribs.size() - 1] = EGL_SURFACE_TYPE;
-		vCfgAttribs.push_back(EGL_WINDOW_BIT);
-		vCfgAttribs.push_back(EGL_NONE);
-	}
+		if (!m_stitcherOGL.SwitchScene("default"))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Switch scene ERROR. Terminating.";
+			m_ePanoRenderState = ePanoRenderStateError;
+			return false;
+		}
 
-#endif
+		m_iSceneTessellationLevel = m_QualityLevel.iTessellationLevel;
+		m_fSceneTessellationTolerance_px = fTolerance_px;
+		m_szSceneRemapTable = szRemapTable;
 
-	EGLint iNumConfigs = 0;
-	if (EGL_FALSE == eglGetConfigs(m_Display, NULL, 0, &iNumConfigs))
-	{
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetConfig(). eglGetConfigs FAILED. EGL Error: "
-			<< eglGetError();
-		return false;
+		//the programs of the first scene are linked at start-up.
+		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		{
+			GGLSLProgramCache::tStatistics statistics = m_stitcherOGL.GetProgramCacheStatistics();
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Programs at start-up: " << statistics.iPrograms
+				<< ", loaded from binaries: " << statistics.ullBinaryLoads << ", link time: " << statistics.dCompileTime_ms << " ms.";
+		}
+		m_ePanoRenderState = ePanoRenderStateSceneCreated;
 	}
 
-	if (EGL_FALSE == eglChooseConfig(m_Display, &(vCfgAttribs[0]), &eglConfig, 1, &iNumConfigs))
+	if (ulTasks & (1 << ePanoRenderTaskSetViewPort))
 	{
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetConfig(). eglChooseConfig FAILED. EGL Error: "
-			<< eglGetError();
-		return false;
-	}
+		cv::Rect rect = m_RenderParameterManager.GetDrawRegion();
 
-	return true;
-}
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			m_FBODisplay.SetViewPort(rect.tl().x, rect.tl().y, rect.width, rect.height);
+		}
+	}
 
-bool GStitcherOGLWrapper_PanoRender::GetSurface(EGLConfig eglConfig, void* pNativeWindow)
-{
-	if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+	if (ulTasks & (1 << ePanoRenderTaskSetOriginalPanoSize))
 	{
-		m_Surface = eglCreateWindowSurface(m_Display, eglConfig, (EGLNativeWindowType)pNativeWindow, NULL);
-		if (EGL_NO_SURFACE == m_Surface)
+		cv::Size szOriginalPanoSize = m_RenderParameterManager.ReadOriginalPanoSize();
+
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetSurface(). eglCreateWindowSurface FAILED. EGL Error: "
-				<< eglGetError();
-			return false;
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			m_iPanoOriginalWidth = szOriginalPanoSize.width;
+			m_iPanoOriginalHeight = szOriginalPanoSize.height;
 		}
 	}
-	else
+
+	//a new scene may change the parameters of the scenes to warm up as well.
+	if ((ulTasks & (1 << ePanoRenderTaskWarmUp)) || (ulTasks & (1 << ePanoRenderTaskCreateScene)))
 	{
-		m_Surface = EGL_NO_SURFACE;
+		WarmUpScenes();
 	}
 
-	return true;
-}
-
-bool GStitcherOGLWrapper_PanoRender::InitOpenGL()
-{
-	try
+	//the scene and the panorama size of the frame group are set up above.
+	if (ulTasks & (1 << ePanoRenderTaskRenderFrameGroup))
 	{
-		if (!GetDisplay((void*)(m_HWND)))
+		bool bRet = RenderRequestedFrameGroup();
+
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: GetDisplay FAILED. EGL Error: "
-				<< eglGetError();
-			return false;
+			std::lock_guard<std::mutex> lk(m_FrameGroupContext.mtTaskMutex);
+			m_FrameGroupContext.bRet = bRet;
+			m_FrameGroupContext.bPending = false;
 		}
+		m_FrameGroupContext.cvTaskDone.notify_one();
+	}
 
-		EGLConfig eglConfig;
-		if (!GetConfig(eglConfig))
+	std::chrono::steady_clock::time_point tpFrameStart = m_tpNextFrame;
+	if (ulTasks & (1 << ePanoRenderTaskRender))
+	{
+		tpFrameStart = BeginFrame();
+
+		if (!Render())
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: GetConfig FAILED. EGL Error: "
-				<< eglGetError();
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Render ERROR. Terminating.";
+			m_ePanoRenderState = ePanoRenderStateError;
 			return false;
 		}
 
-		if (!GetSurface(eglConfig, (void*)(m_HWND)))
+		//the budget covers the work of the rendering thread, swapping buffers only waits for the display.
+		UpdateQuality(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpFrameStart).count());
+
+		//the GL objects of the scenes built in the background are created one scene per frame.
+		GRenderCounters renderCounters;
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: GetSurface FAILED. EGL Error: "
-				<< eglGetError();
-			return false;
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			renderCounters = m_stitcherOGL.TakeRenderCounters();
+			m_stitcherOGL.PrepareWarmScene();
 		}
 
-#ifdef __ANDROID__
-#elif __linux__
-		if (!eglBindAPI(EGL_OPENGL_API))
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: EGL_OPENGL_API is not supported. EGL Error: "
-				<< eglGetError();
-			return false;
+			std::lock_guard<std::mutex> lk(m_RenderStatistics.mtStatisticsMutex);
+			m_RenderStatistics.cbDrawCalls.push_back(renderCounters.iDrawCalls);
+			m_RenderStatistics.cbStateChanges.push_back(renderCounters.iStateChanges);
+			m_RenderStatistics.cbSceneCPUTimes_ms.push_back(renderCounters.dCPUTime_ms);
 		}
-#endif
+	}
 
-#ifdef __ANDROID__
-		EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
-#elif __linux__
-		EGLint contextAttribs[] = { EGL_NONE };
-#endif
-		m_GLContext = eglCreateContext(m_Display, eglConfig, EGL_NO_CONTEXT, contextAttribs);
-		if (EGL_NO_CONTEXT == m_GLContext)
+	//off screen mode may unproject without rendering a new frame.
+	if (ulTasks & (1 << ePanoRenderTaskUnProject))
+	{
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). eglCreateContext FAILED. EGL Error: "
-				<< eglGetError();
-			return false;
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			for (int i = 0; i < m_UnprojectContext.vfInputPoints.size(); ++i)
+			{
+				cv::Point2f& ptSrc = m_UnprojectContext.vfInputPoints[i];
+				cv::Point3f& ptDst = m_UnprojectContext.vfOutputPoints[i];
+
+				float fDepth = 0.0;
+				glm::vec4 mvViewPort;
+				cv::Point2i ptPix = cv::Point2i(0, 0);
+				if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+				{
+					fDepth = m_FBODisplay.GetDepth(ptSrc.x, ptSrc.y);
+					mvViewPort = m_FBODisplay.GetViewPort();
+					ptPix = m_FBODisplay.NormalizedPix2Pix(ptSrc);
+				}
+				else
+				{
+					GFrameDownloader* pDownloader = m_downloaders.GrabTask();
+					if (nullptr == pDownloader)
+					{
+						m_UnprojectContext.bRet = false;
+						continue;
+					}
+
+					fDepth = pDownloader->GetDepth(ptSrc.x, ptSrc.y);
+					mvViewPort = pDownloader->GetViewPort();
+					ptPix = pDownloader->NormalizedPix2Pix(ptSrc);
+				}
+
+				m_UnprojectContext.bRet =
+					m_stitcherOGL.UnProjectPix2Physical(ptPix.x, ptPix.y, fDepth
+					, ptDst.x, ptDst.y, ptDst.z
+					, mvViewPort);
+			}
 		}
 
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). OpenGL context Created.";
+		{
+			std::lock_guard<std::mutex> lk(m_UnprojectContext.mtTaskMutex);
+			m_UnprojectContext.bNeedUnProject = false;
+		}
+		m_UnprojectContext.cvTaskDone.notify_one();
+	}
 
-		if (EGL_FALSE == eglMakeCurrent(m_Display, m_Surface, m_Surface, m_GLContext))
+	if (ulTasks & (1 << ePanoRenderTaskRender))
+	{
+#ifdef WIN32
+		if ((GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode) &&
+			(!SwapBuffers(m_HDC)))
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). eglMakeCurrent FAILED. EGL Error: "
-				<< eglGetError();
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Swap buffers ERROR. Terminating.";
+			m_ePanoRenderState = ePanoRenderStateError;
 			return false;
 		}
-
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). GLEW Initializing.";
-
-		if (glewInit() != GLEW_OK)
+#elif __APPLE__
+#elif (defined __ANDROID__) || (defined __linux__)
+		if ((GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode) &&
+			(EGL_FALSE == eglSwapBuffers(m_Display, m_Surface)))
 		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RunTasks(). Swap buffers ERROR. Terminating.";
 			m_ePanoRenderState = ePanoRenderStateError;
-			GLOGGER(error) << "GLEW init failed. ";
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). ==>";
 			return false;
 		}
+#endif // WIN32
 
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). OpenGL Inited. ==>";
+		ScheduleNextFrame(tpFrameStart);
+	}
+
+	if (ulTasks & (1 << ePanoRenderTaskDestroy))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+#ifdef WIN32
+bool GStitcherOGLWrapper_PanoRender::MakeCurrent()
+{
+	if (nullptr == m_GLContext)
+	{
 		return true;
 	}
-	catch (...)
+
+	if (!wglMakeCurrent(m_HDC, m_GLContext))
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		Release();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::MakeCurrent(). Bind OpenGL Context FAILED.";
+		OnMakeCurrentFailed();
+		return false;
+	}
+
+	return true;
+}
+#elif __APPLE__
+bool GStitcherOGLWrapper_PanoRender::MakeCurrent()
+{
+	return true;
+}
+#elif (defined __ANDROID__) || (defined __linux__)
+bool GStitcherOGLWrapper_PanoRender::MakeCurrent()
+{
+	if (EGL_NO_CONTEXT == m_GLContext)
+	{
+		return true;
+	}
+
+	if (EGL_FALSE == eglMakeCurrent(m_Display, m_Surface, m_Surface, m_GLContext))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::MakeCurrent(). eglMakeCurrent FAILED. EGL Error: "
+			<< eglGetError();
+		OnMakeCurrentFailed();
 		return false;
 	}
+
+	return true;
 }
 #endif // WIN32
 
-bool GStitcherOGLWrapper_PanoRender::InitStitcher()
+bool GStitcherOGLWrapper_PanoRender::Create(G_tPanoRenderConfig panoRenderConfig, const char* pModel, unsigned int uiSize_Byte
+	, std::shared_ptr<GRenderExecutor> ptrRenderExecutor)
 {
 	try
 	{
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitStitcher().";
-
-		std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+		GPanoCameraProfile panoCameraInfo;
+		//LoadGraphFromFileBin("E:\\model_5_360_2.bin", mGraph);
+		LoadObjectFromFileBinRawData(pModel, static_cast<int>(uiSize_Byte), panoCameraInfo);
+		SortByCameraName(panoCameraInfo.vCameraModels);
 
-		if (!m_stitcherOGL.Init(m_Config, m_vCameras))
+		if (panoCameraInfo.vPanoTypeList.empty())
 		{
-			GLOGGER(error) << "StitcherOGL init failed. ";
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitStitcher(). ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Create(). pano type list is empty. Create failed.";
 			return false;
 		}
 
-		m_uploader.Init(m_Config.m_eOptionUploading, m_Config.m_eInputFrameFormat, m_vCameras.size());
+		TransPanoCameraProfile2CameraModel(panoCameraInfo, m_vCameras);
 
-		m_downloaders.Init((GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode) ? 1 : 3, [](GFrameDownloader& downloader)
-		{
-			downloader.Init(10, 10);
-		});
+		m_RenderParameterManager.Init(panoCameraInfo.vPanoTypeList, panoCameraInfo.vCameraModels.size());
+		m_vPanoTypeList = panoCameraInfo.vPanoTypeList;
 
-		m_FBODisplay.Create(eGOpenGLFrameBufferTypeDisplay);
+		//Set up config parameters.
+		switch (panoRenderConfig.eInputFormat)
+		{
+		case G_eInputFormatRGB:
+			m_Config.m_eInputFrameFormat = eFrameFormatRGB;
+			break;
+		case G_eInputFormatYUV420P:
+			m_Config.m_eInputFrameFormat = eFrameFormatYUV420P;
+			break;
+		case G_eInputFormatYV12:
+			m_Config.m_eInputFrameFormat = eFrameFormatYV12;
+			break;
+		case G_eInputFormatNV12:
+			m_Config.m_eInputFrameFormat = eFrameFormatNV12;
+			break;
+		default:
+			break;
+		}
 
-		m_vPtrFrameQueues.resize(m_vCameras.size());
-		for (int iQue = 0; iQue < m_vPtrFrameQueues.size(); ++iQue)
+		switch (panoRenderConfig.eRenderingMode)
 		{
-			m_vPtrFrameQueues[iQue] = GFrameQueueFactory::CreateFrameQueue();
+		case G_eRenderingModeOnScreen:
+			m_Config.m_eRenderingMode = GStitcherConfig::eRenderingModeOnScreen;
+			break;
+		case G_eRenderingModeOffScreen:
+			m_Config.m_eRenderingMode = GStitcherConfig::eRenderingModeOffScreen;
+			break;
+		case G_eRenderingModeOffScreenRealTime:
+			m_Config.m_eRenderingMode = GStitcherConfig::eRenderingModeOffScreenRealTime;
+			break;
+		default:
+			break;
+		}
+
+		m_Config.m_eOptionUploading = GStitcherConfig::eOptionUploadingPBO;
+		m_Config.m_eOptionDownloading = GStitcherConfig::eOptionDownloadingPBO;
+
+		//full quality until a quality controller is enabled.
+		m_QualityController.Init(nullptr, m_Config.m_iTessellationLevel);
+		m_QualityController.GetState(m_QualityState);
+		m_QualityLevel = m_QualityController.GetLevel();
+		m_iSceneTessellationLevel = m_QualityLevel.iTessellationLevel;
+
+		m_ePanoRenderState = ePanoRenderStateCreated;
+
+		if (nullptr != ptrRenderExecutor)
+		{
+			m_ptrRenderExecutor = ptrRenderExecutor;
+			if (!m_ptrRenderExecutor->Attach(this))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Create(). Attach to render executor FAILED.";
+				m_ptrRenderExecutor = nullptr;
+				m_ePanoRenderState = ePanoRenderStateError;
+				return false;
+			}
+		}
+		else
+		{
+			m_tdRendering = std::thread(GStitcherOGLWrapper_PanoRender::RenderingLoop, this);
 		}
 
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitStitcher(). ==>";
 		return true;
 	}
 	catch (...)
 	{
 		m_ePanoRenderState = ePanoRenderStateError;
-		Release();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitStitcher(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Create(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::UploadTextures()
+bool GStitcherOGLWrapper_PanoRender::InitPanoRender(void* hWnd)
 {
-	static bool bHasTextureGroup = false;
+	try
+	{
+		if (m_ePanoRenderState != ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitPanoRender(). Not Ready or already Inited. ==>";
+			return false;
+		}
 
-	std::vector<std::shared_ptr<GFrameSourceIF>> vFrameQueSources(m_vCameras.size());
-	for (int iQue = 0; iQue < m_vPtrFrameQueues.size(); ++iQue)
+		{
+			std::lock_guard<std::mutex> lk(m_mtHWNDMutex);
+			m_HWND = hWnd;
+		    m_bInitCalled = true;
+		}
+		WakeUpRenderingLoop(true);
+
+		return true;
+	}
+	catch (...)
 	{
-		vFrameQueSources[iQue] = m_vPtrFrameQueues[iQue];
+		m_ePanoRenderState = ePanoRenderStateError;
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitPanoRender(). EXCEPTION. ==>";
+		return false;
 	}
-
-	//Upload textures.
-	bHasTextureGroup |= m_uploader.Upload(vFrameQueSources, m_textureGroup);
-	return bHasTextureGroup;
 }
 
-bool GStitcherOGLWrapper_PanoRender::Render()
+bool GStitcherOGLWrapper_PanoRender::InitPanoRenderHeadless(G_enHeadlessPlatform eHeadlessPlatform)
 {
-	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::Render().";
-
-	std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
-
-	if (m_stitcherOGL.IsSceneExist(""))
+	try
 	{
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Render(). Render pano.";
-		GViewCamera4RenderIF* pViewCamera = m_RenderParameterManager.GetViewCamera();
-
+#ifdef WIN32
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitPanoRenderHeadless(). Error: Headless rendering is not supported on Windows. ==>";
+		return false;
+#else
+		if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitPanoRenderHeadless(). Error: On screen mode needs a window. ==>";
+			return false;
+		}
 
-		if (!UploadTextures())
+		enHeadlessPlatform ePlatform = eHeadlessPlatformAuto;
+		switch (eHeadlessPlatform)
 		{
+		case G_eHeadlessPlatformAuto:
+			ePlatform = eHeadlessPlatformAuto;
+			break;
+		case G_eHeadlessPlatformSurfaceless:
+			ePlatform = eHeadlessPlatformSurfaceless;
+			break;
+		case G_eHeadlessPlatformDevice:
+			ePlatform = eHeadlessPlatformDevice;
+			break;
+		case G_eHeadlessPlatformPBuffer:
+			ePlatform = eHeadlessPlatformPBuffer;
+			break;
+		default:
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitPanoRenderHeadless(). Error: Unknown headless platform: " << eHeadlessPlatform << ". ==>";
 			return false;
 		}
 
-		if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+		if (m_ePanoRenderState != ePanoRenderStateCreated)
 		{
-			//Online.
-			if (!m_mpWriteOutCallBack.empty())
-			{
-				if (opengl_compatible(3, 0))
-				{
-					return RenderWithOutput(pViewCamera->CalcP(), pViewCamera->CalcV());
-				}
-				else
-				{
-					return RenderWithOutput4EarlyVersion(pViewCamera->CalcP(), pViewCamera->CalcV());
-				}
-			}
-			else
-			{
-				return RenderOnly(pViewCamera->CalcP(), pViewCamera->CalcV());
-			}
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitPanoRenderHeadless(). Not Ready or already Inited. ==>";
+			return false;
 		}
-		else
+
 		{
-			//Offline.
-			return RenderWithOutput(pViewCamera->CalcP(), pViewCamera->CalcV());
+			std::lock_guard<std::mutex> lk(m_mtHWNDMutex);
+			m_eHeadlessPlatform = ePlatform;
 		}
 
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Render(). ==>";
+		return InitPanoRender(nullptr);
+#endif // WIN32
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitPanoRenderHeadless(). EXCEPTION. ==>";
+		return false;
 	}
-
-	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Render(). ==>";
-	return true;
 }
 
-bool GStitcherOGLWrapper_PanoRender::RenderOnly(const glm::mat4& matP, const glm::mat4& matV)
-{
-	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderOnly().";
-
-	//Prepare for rendering.
-	m_FBODisplay.Bind();
-	m_FBODisplay.SetViewPort();
-	m_FBODisplay.Clear();
-
-	bool bRet = m_stitcherOGL.RenderPano(m_textureGroup, matP, matV);
-
-	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderOnly(). ==>";
-	return bRet;
-}
+#ifdef WIN32
 
-bool GStitcherOGLWrapper_PanoRender::RenderWithOutput(const glm::mat4& matP, const glm::mat4& matV)
+bool GStitcherOGLWrapper_PanoRender::InitOpenGL()
 {
-	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderWithOutput().";
-
-	//Render and start downloading.
-	GFrameDownloader* pNewDownloader = m_downloaders.CreateTask();
-	if (nullptr != pNewDownloader)
+	try
 	{
-		//Prepare for rendering.
-		pNewDownloader->Bind();
-		if (!pNewDownloader->ChangeFrameSize(m_iPanoOriginalWidth, m_iPanoOriginalHeight))
+		m_HDC = GetDC((HWND)m_HWND);
+		if (nullptr == m_HDC)
 		{
-			GLOGGER(error) << "GStitcherOGL::RenderWithOutput(). Change original pano buffer size Failed. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). GetDC FAILED.";
 			return false;
 		}
-		pNewDownloader->SetViewPort(0, 0, m_iPanoOriginalWidth, m_iPanoOriginalHeight);
-		pNewDownloader->Clear();
 
+		m_GLContext = wglCreateContext(m_HDC);
+		if (nullptr == m_GLContext)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Create OpenGL context FAILED.";
+			return false;
+		}
 
-		//Render.
-		bool bRet = m_stitcherOGL.RenderPano(m_textureGroup, matP, matV);
+		if (!wglMakeCurrent(m_HDC, m_GLContext))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Bind OpenGL Context FAILED. ==>";
+			return false;
+		}
 
-		//Start downloading.
-		for (auto itCallBack = m_mpWriteOutCallBack.begin(); itCallBack != m_mpWriteOutCallBack.end(); ++itCallBack)
+		if (glewInit() != GLEW_OK)
 		{
-			GWriteOutCallBack& task = itCallBack->second;
-			if (!pNewDownloader->IsActivated(task.fScale))
-			{
-				pNewDownloader->StartDownload(task.fScale, m_Config.m_eOptionDownloading);
-			}
+			m_ePanoRenderState = ePanoRenderStateError;
+			GLOGGER(error) << "GLEW init failed. ";
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). ==>";
+			return false;
 		}
 
-		m_downloaders.CompleteTask();
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). OpenGL Inited. ==>";
+		return true;
 	}
-
-	//Output & Display.
-	GFrameDownloader* pDownloader = m_downloaders.GrabTask();
-	if (nullptr != pDownloader)
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		Release();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). EXCEPTION. ==>";
+		return false;
+	}
+}
+#elif __APPLE__
+#elif (defined __ANDROID__) || (defined __linux__)
+bool GStitcherOGLWrapper_PanoRender::HasEGLExtension(const char* pExtensions, const std::string& sExtension)
+{
+	if (nullptr == pExtensions)
 	{
-		OutputCallBackwithScale(pDownloader);
+		return false;
+	}
 
-		if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+	std::istringstream issExtensions(pExtensions);
+	std::string sName;
+	while (issExtensions >> sName)
+	{
+		if (sExtension == sName)
 		{
-			m_FBODisplay.Bind();
-			m_FBODisplay.SetViewPort();
-			pDownloader->GetFBO() >> m_FBODisplay;
+			return true;
 		}
-
-		m_downloaders.ReleaseTask();
 	}
 
-	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderWithOutput(). ==>";
-	return true;
+	return false;
 }
 
-bool GStitcherOGLWrapper_PanoRender::RenderWithOutput4EarlyVersion(const glm::mat4& matP, const glm::mat4& matV)
+EGLDisplay GStitcherOGLWrapper_PanoRender::GetHeadlessDisplay()
 {
-	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderWithOutput4EarlyVersion().";
+	if (eHeadlessPlatformPBuffer == m_eHeadlessPlatform)
+	{
+		return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
 
-	//Prepare for rendering.
-	m_FBODisplay.Bind();
-	m_FBODisplay.SetViewPort();
-	m_FBODisplay.Clear();
+#ifdef __ANDROID__
+	GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetHeadlessDisplay(). Error: Only the pbuffer platform is supported on Android.";
+	return EGL_NO_DISPLAY;
+#elif __linux__
+	//platform displays are client extensions, which are queried without a display.
+	const char* pClientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	PFNEGLGETPLATFORMDISPLAYEXTPROC pfnGetPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+	if ((!HasEGLExtension(pClientExtensions, "EGL_EXT_platform_base")) || (nullptr == pfnGetPlatformDisplay))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetHeadlessDisplay(). Error: EGL_EXT_platform_base is not supported.";
+		return EGL_NO_DISPLAY;
+	}
 
-	//Render.
-	bool bRet = m_stitcherOGL.RenderPano(m_textureGroup, matP, matV);
+	if (eHeadlessPlatformSurfaceless == m_eHeadlessPlatform)
+	{
+		if (!HasEGLExtension(pClientExtensions, "EGL_MESA_platform_surfaceless"))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetHeadlessDisplay(). Error: EGL_MESA_platform_surfaceless is not supported.";
+			return EGL_NO_DISPLAY;
+		}
 
-	//Output.
-	m_mPanoBuffer.create(m_FBODisplay.ViewPortHeight(), m_FBODisplay.ViewPortWidth(), CV_8UC3);
-	m_FBODisplay >> m_mPanoBuffer;
-	OutputCallBack(m_mPanoBuffer.data, m_mPanoBuffer.cols, m_mPanoBuffer.rows);
+		return pfnGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	else if (eHeadlessPlatformDevice == m_eHeadlessPlatform)
+	{
+		PFNEGLQUERYDEVICESEXTPROC pfnQueryDevices = (PFNEGLQUERYDEVICESEXTPROC)(eglGetProcAddress("eglQueryDevicesEXT"));
+		if ((!HasEGLExtension(pClientExtensions, "EGL_EXT_platform_device")) || (nullptr == pfnQueryDevices))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetHeadlessDisplay(). Error: EGL_EXT_platform_device is not supported.";
+			return EGL_NO_DISPLAY;
+		}
 
-	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderWithOutput4EarlyVersion(). ==>";
-	return true;
+		//use the first device.
+		EGLDeviceEXT eglDevice = EGL_NO_DEVICE_EXT;
+		EGLint iNumDevices = 0;
+		if ((EGL_FALSE == pfnQueryDevices(1, &eglDevice, &iNumDevices)) || (iNumDevices < 1))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetHeadlessDisplay(). Error: No EGL device found. EGL Error: "
+				<< eglGetError();
+			return EGL_NO_DISPLAY;
+		}
+
+		return pfnGetPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, eglDevice, NULL);
+	}
+
+	return EGL_NO_DISPLAY;
+#endif
 }
 
-void GStitcherOGLWrapper_PanoRender::OutputCallBack(unsigned char* pData, int iWidth, int iHeight)
+bool GStitcherOGLWrapper_PanoRender::GetDisplay(void* pNativeWindow)
 {
-	auto itCallBack = m_mpWriteOutCallBack.begin();
-	while (itCallBack != m_mpWriteOutCallBack.end())
+	EGLint iMajorVersion = 0;
+	EGLint iMinorVersion = 0;
+
+	if (eHeadlessPlatformNone == m_eHeadlessPlatform)
 	{
-		GWriteOutCallBack& task = itCallBack->second;
-		if (1 < task.iCallBackTimes)
+		//todo. How to get Display of specified pNativeWindow?
+		m_Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		if (EGL_NO_DISPLAY == m_Display)
 		{
-			(*(task.pCallBackFunc))(iWidth, iHeight, pData, task.pContext);
-			--task.iCallBackTimes;
-		}
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). eglGetDisplay FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+
+		if (EGL_FALSE == eglInitialize(m_Display, &iMajorVersion, &iMinorVersion))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). eglInitialize FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+	}
+	else
+	{
+		//try the platforms from the most to the least headless one, the first display that can be initialized wins.
+		std::vector<enHeadlessPlatform> vPlatforms;
+		if (eHeadlessPlatformAuto == m_eHeadlessPlatform)
+		{
+			vPlatforms = { eHeadlessPlatformSurfaceless, eHeadlessPlatformDevice, eHeadlessPlatformPBuffer };
+		}
+		else
+		{
+			vPlatforms = { m_eHeadlessPlatform };
+		}
+
+		m_Display = EGL_NO_DISPLAY;
+		for (size_t iPlatform = 0; (iPlatform < vPlatforms.size()) && (EGL_NO_DISPLAY == m_Display); ++iPlatform)
+		{
+			m_eHeadlessPlatform = vPlatforms[iPlatform];
+			m_Display = GetHeadlessDisplay();
+			if (EGL_NO_DISPLAY == m_Display)
+			{
+				continue;
+			}
+
+			if (EGL_FALSE == eglInitialize(m_Display, &iMajorVersion, &iMinorVersion))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). eglInitialize FAILED for headless platform "
+					<< m_eHeadlessPlatform << ". EGL Error: " << eglGetError();
+				m_Display = EGL_NO_DISPLAY;
+			}
+			else if (!((iMajorVersion > 1) || ((1 == iMajorVersion) && (iMinorVersion >= 4))))
+			{
+				//release the rejected display before the next platform is tried.
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). Error: EGL Version of headless platform "
+					<< m_eHeadlessPlatform << " is " << iMajorVersion << "." << iMinorVersion << ", 1.4 or later is required.";
+				eglTerminate(m_Display);
+				m_Display = EGL_NO_DISPLAY;
+			}
+		}
+
+		if (EGL_NO_DISPLAY == m_Display)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). Error: No headless EGL display available.";
+			return false;
+		}
+
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). Headless platform: " << m_eHeadlessPlatform
+			<< ", EGL vendor: " << eglQueryString(m_Display, EGL_VENDOR);
+	}
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). EGL Version: " << iMajorVersion << "." << iMinorVersion;
+
+	if (!((iMajorVersion > 1) || ((1 == iMajorVersion) && (iMinorVersion >= 4))))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetDisplay(). Error: EGL Version should be 1.4 or later.";
+		return false;
+	}
+
+	return true;
+}
+
+bool GStitcherOGLWrapper_PanoRender::GetConfig(EGLConfig& eglConfig)
+{
+#ifdef __ANDROID__
+	std::vector<EGLint>  vCfgAttribs =
+	{
+		EGL_SURFACE_TYPE, (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode) ? EGL_WINDOW_BIT : EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+		EGL_RED_SIZE, 5,
+		EGL_GREEN_SIZE, 6,
+		EGL_BLUE_SIZE, 5,
+		EGL_DEPTH_SIZE, 1,
+		EGL_NONE
+	};
+#elif __linux__
+	std::vector<EGLint> vCfgAttribs =
+	{
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 5,
+		EGL_GREEN_SIZE, 6,
+		EGL_BLUE_SIZE, 5,
+		EGL_DEPTH_SIZE, 1,
+		EGL_NONE
+	};
+
+	if(GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+	{
+		vCfgAttribs[vCfgAttribs.size() - 1] = EGL_SURFACE_TYPE;
+		vCfgAttribs.push_back(EGL_WINDOW_BIT);
+		vCfgAttribs.push_back(EGL_NONE);
+	}
+	else if (eHeadlessPlatformNone != m_eHeadlessPlatform)
+	{
+		//headless displays usually have no window capable configs, which eglChooseConfig() asks for by default.
+		vCfgAttribs[vCfgAttribs.size() - 1] = EGL_SURFACE_TYPE;
+		vCfgAttribs.push_back(EGL_PBUFFER_BIT);
+		vCfgAttribs.push_back(EGL_NONE);
+	}
+
+#endif
+
+	EGLint iNumConfigs = 0;
+	if (EGL_FALSE == eglGetConfigs(m_Display, NULL, 0, &iNumConfigs))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetConfig(). eglGetConfigs FAILED. EGL Error: "
+			<< eglGetError();
+		return false;
+	}
+
+	if (EGL_FALSE == eglChooseConfig(m_Display, &(vCfgAttribs[0]), &eglConfig, 1, &iNumConfigs))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetConfig(). eglChooseConfig FAILED. EGL Error: "
+			<< eglGetError();
+		return false;
+	}
+
+	if (iNumConfigs < 1)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetConfig(). Error: No matching EGL config.";
+		return false;
+	}
+
+	return true;
+}
+
+bool GStitcherOGLWrapper_PanoRender::GetSurface(EGLConfig eglConfig, void* pNativeWindow)
+{
+	if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+	{
+		m_Surface = eglCreateWindowSurface(m_Display, eglConfig, (EGLNativeWindowType)pNativeWindow, NULL);
+		if (EGL_NO_SURFACE == m_Surface)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetSurface(). eglCreateWindowSurface FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+	}
+	else if ((eHeadlessPlatformPBuffer == m_eHeadlessPlatform) ||
+		((eHeadlessPlatformNone != m_eHeadlessPlatform) &&
+		(!HasEGLExtension(eglQueryString(m_Display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))))
+	{
+		//all the rendering goes to frame buffer objects, a minimal pbuffer is only there to make the context current.
+		EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+		m_Surface = eglCreatePbufferSurface(m_Display, eglConfig, pbufferAttribs);
+		if (EGL_NO_SURFACE == m_Surface)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetSurface(). eglCreatePbufferSurface FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+	}
+	else
+	{
+		m_Surface = EGL_NO_SURFACE;
+	}
+
+	return true;
+}
+
+bool GStitcherOGLWrapper_PanoRender::InitOpenGL()
+{
+	try
+	{
+		if (!GetDisplay((void*)(m_HWND)))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: GetDisplay FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+
+		EGLConfig eglConfig;
+		if (!GetConfig(eglConfig))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: GetConfig FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+
+		if (!GetSurface(eglConfig, (void*)(m_HWND)))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: GetSurface FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+
+#ifdef __ANDROID__
+#elif __linux__
+		if (!eglBindAPI(EGL_OPENGL_API))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). Error: EGL_OPENGL_API is not supported. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+#endif
+
+#ifdef __ANDROID__
+		EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
+#elif __linux__
+		EGLint contextAttribs[] = { EGL_NONE };
+#endif
+		m_GLContext = eglCreateContext(m_Display, eglConfig, EGL_NO_CONTEXT, contextAttribs);
+		if (EGL_NO_CONTEXT == m_GLContext)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). eglCreateContext FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). OpenGL context Created.";
+
+		if (EGL_FALSE == eglMakeCurrent(m_Display, m_Surface, m_Surface, m_GLContext))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). eglMakeCurrent FAILED. EGL Error: "
+				<< eglGetError();
+			return false;
+		}
+
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). GLEW Initializing.";
+
+		GLenum eGlewRet = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+		//GLEW built for GLX fails on its GLX part without an X display, the OpenGL functions are loaded already.
+		if ((eHeadlessPlatformNone != m_eHeadlessPlatform) && (GLEW_ERROR_NO_GLX_DISPLAY == eGlewRet))
+		{
+			eGlewRet = GLEW_OK;
+		}
+#endif
+		if (GLEW_OK != eGlewRet)
+		{
+			m_ePanoRenderState = ePanoRenderStateError;
+			GLOGGER(error) << "GLEW init failed. ";
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). ==>";
+			return false;
+		}
+
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). OpenGL Inited. ==>";
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		Release();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitOpenGL(). EXCEPTION. ==>";
+		return false;
+	}
+}
+#endif // WIN32
+
+bool GStitcherOGLWrapper_PanoRender::InitStitcher()
+{
+	try
+	{
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitStitcher().";
+
+		std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+
+		if (!m_stitcherOGL.Init(m_Config, m_vCameras))
+		{
+			GLOGGER(error) << "StitcherOGL init failed. ";
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitStitcher(). ==>";
+			return false;
+		}
+
+		m_uploader.Init(m_Config.m_eOptionUploading, m_Config.m_eInputFrameFormat, m_vCameras.size());
+		m_bHasTextureGroup = false;
+
+		m_downloaders.Init((GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode) ? 1 : 3, [](GFrameDownloader& downloader)
+		{
+			downloader.Init(10, 10);
+		});
+
+		m_FrameGroupDownloader.Init(10, 10);
+
+		m_FBODisplay.Create(eGOpenGLFrameBufferTypeDisplay);
+
+		m_vPtrFrameQueues.resize(m_vCameras.size());
+		for (int iQue = 0; iQue < m_vPtrFrameQueues.size(); ++iQue)
+		{
+			m_vPtrFrameQueues[iQue] = GFrameQueueFactory::CreateFrameQueue();
+		}
+
+		std::vector<std::atomic<unsigned long long>> vInputFrameCounters(m_vCameras.size());
+		for (int iCamera = 0; iCamera < vInputFrameCounters.size(); ++iCamera)
+		{
+			vInputFrameCounters[iCamera] = 0;
+		}
+		m_vInputFrameCounters.swap(vInputFrameCounters);
+
+		{
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_vCameraActive.assign(m_vCameras.size(), false);
+			m_vPendingFrameNum.assign(m_vCameras.size(), 0);
+		}
+
+		//off screen mode is lossless: InputFrame() waits for the rendering instead of dropping frames.
+		if (GStitcherConfig::eRenderingModeOffScreen == m_Config.m_eRenderingMode)
+		{
+			for (int iQue = 0; iQue < m_vPtrFrameQueues.size(); ++iQue)
+			{
+				m_vPtrFrameQueues[iQue]->SetBlockWhenFull(true);
+			}
+		}
+
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InitStitcher(). ==>";
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		Release();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InitStitcher(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::UploadTextures(const std::vector<bool>& vUploadMask)
+{
+	std::vector<std::shared_ptr<GFrameSourceIF>> vFrameQueSources(m_vCameras.size());
+	for (int iQue = 0; iQue < m_vPtrFrameQueues.size(); ++iQue)
+	{
+		vFrameQueSources[iQue] = m_vPtrFrameQueues[iQue];
+	}
+
+	//Upload textures.
+	m_bHasTextureGroup |= m_uploader.Upload(vFrameQueSources, m_textureGroup, vUploadMask);
+
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		const std::vector<int>& vUpdatedFrameIdx = m_uploader.GetUpdatedFrameIdx();
+		for (int i = 0; i < vUpdatedFrameIdx.size(); ++i)
+		{
+			--m_vPendingFrameNum[vUpdatedFrameIdx[i]];
+		}
+	}
+
+	return m_bHasTextureGroup;
+}
+
+void GStitcherOGLWrapper_PanoRender::GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible)
+{
+	vVisible.assign(m_vCameras.size(), false);
+
+	//upload everything if the visibility is unknown.
+	if (!m_stitcherOGL.GetVisibleCameras("", matP, matV, vVisible))
+	{
+		vVisible.assign(m_vCameras.size(), true);
+		return;
+	}
+
+	std::vector<std::shared_ptr<tView>> vPtrViews;
+	{
+		std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+		for (auto itView = m_mpViews.begin(); itView != m_mpViews.end(); ++itView)
+		{
+			vPtrViews.push_back(itView->second);
+		}
+	}
+
+	for (int iView = 0; iView < vPtrViews.size(); ++iView)
+	{
+		tView& view = *(vPtrViews[iView]);
+		if ((!view.bInited) || (!view.bSceneCreated) || view.mpWriteOutCallBack.empty())
+		{
+			continue;
+		}
+
+		GViewCamera4RenderIF* pViewCamera = view.RenderParameterManager.GetViewCamera();
+		if (!m_stitcherOGL.GetVisibleCameras(view.sSceneName, pViewCamera->CalcP(), pViewCamera->CalcV(), vVisible))
+		{
+			vVisible.assign(m_vCameras.size(), true);
+			return;
+		}
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::Render()
+{
+	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::Render().";
+
+	std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+
+	if (m_stitcherOGL.IsSceneExist(""))
+	{
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Render(). Render pano.";
+		long long llRenderStartTime_us = GetTimeStamp_us();
+
+		if (!UpdateViews())
+		{
+			return false;
+		}
+
+		//the quality controller may skip the frames of the cameras that no output can see. a camera coming into sight
+		//shows its last uploaded frame until the next frame.
+		std::vector<bool> vUploadMask;
+		if (m_QualityLevel.bSkipInvisibleCameras)
+		{
+			GViewCamera4RenderIF* pViewCamera = m_RenderParameterManager.GetViewCamera();
+			GetVisibleCameras(pViewCamera->CalcP(), pViewCamera->CalcV(), vUploadMask);
+		}
+
+		if (!UploadTextures(vUploadMask))
+		{
+			return false;
+		}
+
+		UpdateFrameInfo(llRenderStartTime_us);
+
+		bool bLateLatch = false;
+		{
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			bLateLatch = m_bLateLatchViewCamera;
+		}
+
+		//the uploads may take a while, pick up the view camera set meanwhile.
+		if (bLateLatch)
+		{
+			m_RenderParameterManager.LatchViewCamera();
+		}
+		GViewCamera4RenderIF* pViewCamera = m_RenderParameterManager.GetViewCamera();
+
+		bool bRet = false;
+		if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+		{
+			//Online.
+			if (!m_mpWriteOutCallBack.empty())
+			{
+				if (opengl_compatible(3, 0))
+				{
+					bRet = RenderWithOutput(pViewCamera->CalcP(), pViewCamera->CalcV());
+				}
+				else
+				{
+					bRet = RenderWithOutput4EarlyVersion(pViewCamera->CalcP(), pViewCamera->CalcV());
+				}
+			}
+			else
+			{
+				bRet = RenderOnly(pViewCamera->CalcP(), pViewCamera->CalcV());
+			}
+		}
+		else
+		{
+			//Offline.
+			bRet = RenderWithOutput(pViewCamera->CalcP(), pViewCamera->CalcV());
+		}
+
+		//the views share the textures uploaded for this frame.
+		bRet = bRet && RenderViews(bLateLatch);
+
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Render(). ==>";
+		return bRet;
+	}
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Render(). ==>";
+	return true;
+}
+
+bool GStitcherOGLWrapper_PanoRender::RenderOnly(const glm::mat4& matP, const glm::mat4& matV)
+{
+	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderOnly().";
+
+	//Prepare for rendering.
+	m_FBODisplay.Bind();
+	m_FBODisplay.SetViewPort();
+	m_FBODisplay.Clear();
+
+	bool bRet = m_stitcherOGL.RenderPano(m_textureGroup, matP, matV);
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderOnly(). ==>";
+	return bRet;
+}
+
+bool GStitcherOGLWrapper_PanoRender::RenderWithOutput(const glm::mat4& matP, const glm::mat4& matV)
+{
+	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderWithOutput().";
+
+	//Render and start downloading.
+	GFrameDownloader* pNewDownloader = m_downloaders.CreateTask();
+	if (nullptr != pNewDownloader)
+	{
+		//Prepare for rendering.
+		int iWidth = ScaleByQuality(m_iPanoOriginalWidth);
+		int iHeight = ScaleByQuality(m_iPanoOriginalHeight);
+
+		pNewDownloader->Bind();
+		if (!pNewDownloader->ChangeFrameSize(iWidth, iHeight))
+		{
+			GLOGGER(error) << "GStitcherOGL::RenderWithOutput(). Change original pano buffer size Failed. ==>";
+			return false;
+		}
+		pNewDownloader->SetViewPort(0, 0, iWidth, iHeight);
+		pNewDownloader->Clear();
+		pNewDownloader->SetFrameInfo(m_CurrentFrameInfo);
+		pNewDownloader->SetOutputScale(m_QualityLevel.fOutputScale);
+
+
+		//Render.
+		bool bRet = m_stitcherOGL.RenderPano(m_textureGroup, matP, matV);
+
+		//Start downloading.
+		for (auto itCallBack = m_mpWriteOutCallBack.begin(); itCallBack != m_mpWriteOutCallBack.end(); ++itCallBack)
+		{
+			float fScale = itCallBack->second.fScale * pNewDownloader->GetOutputScale();
+			if (!pNewDownloader->IsActivated(fScale))
+			{
+				pNewDownloader->StartDownload(fScale, m_Config.m_eOptionDownloading);
+			}
+		}
+
+		m_downloaders.CompleteTask();
+	}
+
+	//Output & Display.
+	GFrameDownloader* pDownloader = m_downloaders.GrabTask();
+	if (nullptr != pDownloader)
+	{
+		OutputCallBackwithScale(pDownloader, m_mpWriteOutCallBack);
+
+		if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+		{
+			m_FBODisplay.Bind();
+			m_FBODisplay.SetViewPort();
+			pDownloader->GetFBO() >> m_FBODisplay;
+		}
+
+		m_downloaders.ReleaseTask();
+	}
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderWithOutput(). ==>";
+	return true;
+}
+
+bool GStitcherOGLWrapper_PanoRender::RenderWithOutput4EarlyVersion(const glm::mat4& matP, const glm::mat4& matV)
+{
+	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderWithOutput4EarlyVersion().";
+
+	//Prepare for rendering.
+	m_FBODisplay.Bind();
+	m_FBODisplay.SetViewPort();
+	m_FBODisplay.Clear();
+
+	//Render.
+	bool bRet = m_stitcherOGL.RenderPano(m_textureGroup, matP, matV);
+
+	//Output.
+	m_mPanoBuffer.create(m_FBODisplay.ViewPortHeight(), m_FBODisplay.ViewPortWidth(), CV_8UC3);
+	m_FBODisplay >> m_mPanoBuffer;
+	m_CurrentFrameInfo.llRenderEndTime_us = GetTimeStamp_us();
+	OutputCallBack(m_mPanoBuffer.data, m_mPanoBuffer.cols, m_mPanoBuffer.rows, m_CurrentFrameInfo);
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderWithOutput4EarlyVersion(). ==>";
+	return true;
+}
+
+void GStitcherOGLWrapper_PanoRender::UpdateFrameInfo(long long llRenderStartTime_us)
+{
+	const std::vector<GFrameType>& vCurrentFrameType = m_uploader.GetCurrentFrameTypes();
+	const std::vector<int>& vUpdatedFrameIdx = m_uploader.GetUpdatedFrameIdx();
+
+	++m_ullOutputSequenceNumber;
+
+	m_CurrentFrameInfo.ullSequenceNumber = m_ullOutputSequenceNumber;
+	m_CurrentFrameInfo.llRenderStartTime_us = llRenderStartTime_us;
+	m_CurrentFrameInfo.llRenderEndTime_us = 0;
+
+	m_CurrentFrameInfo.vInputFrameIDs.resize(vCurrentFrameType.size());
+	m_CurrentFrameInfo.vInputTimeStamps.resize(vCurrentFrameType.size());
+	for (int iFrameIdx = 0; iFrameIdx < vCurrentFrameType.size(); ++iFrameIdx)
+	{
+		m_CurrentFrameInfo.vInputFrameIDs[iFrameIdx] = vCurrentFrameType[iFrameIdx].ullFrameID;
+		m_CurrentFrameInfo.vInputTimeStamps[iFrameIdx] = vCurrentFrameType[iFrameIdx].llTimeStamp;
+	}
+
+	//only frames consumed by this render pass count, frames kept from previous passes have been accounted for already.
+	m_CurrentFrameInfo.llQueueWait_us = 0;
+	for (int i = 0; i < vUpdatedFrameIdx.size(); ++i)
+	{
+		long long llQueueWait_us = llRenderStartTime_us - vCurrentFrameType[vUpdatedFrameIdx[i]].llArrivalTime_us;
+		m_CurrentFrameInfo.llQueueWait_us = (m_CurrentFrameInfo.llQueueWait_us > llQueueWait_us) ? m_CurrentFrameInfo.llQueueWait_us : llQueueWait_us;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup()
+{
+	GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup().";
+
+	std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+
+	if (!m_stitcherOGL.IsSceneExist(""))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup(). Scene not created. ==>";
+		return false;
+	}
+
+	long long llRenderStartTime_us = GetTimeStamp_us();
+
+	if (!m_uploader.Upload(m_FrameGroupContext.vPtrSources, m_textureGroup))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup(). Upload failed. ==>";
+		return false;
+	}
+
+	UpdateFrameInfo(llRenderStartTime_us);
+
+	GViewCamera4RenderIF* pViewCamera = m_RenderParameterManager.GetViewCamera();
+
+	m_FrameGroupDownloader.Bind();
+	if (!m_FrameGroupDownloader.ChangeFrameSize(m_iPanoOriginalWidth, m_iPanoOriginalHeight))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup(). Change original pano buffer size Failed. ==>";
+		return false;
+	}
+	m_FrameGroupDownloader.SetViewPort(0, 0, m_iPanoOriginalWidth, m_iPanoOriginalHeight);
+	m_FrameGroupDownloader.Clear();
+	m_FrameGroupDownloader.SetFrameInfo(m_CurrentFrameInfo);
+
+	if (!m_stitcherOGL.RenderPano(m_textureGroup, pViewCamera->CalcP(), pViewCamera->CalcV()))
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup(). Render failed. ==>";
+		return false;
+	}
+
+	//start all downloads before waiting for the first one.
+	G_tFrameGroupOutput* pOutputs = m_FrameGroupContext.pOutputs;
+	for (int iOutput = 0; iOutput < m_FrameGroupContext.uiOutputNum; ++iOutput)
+	{
+		if (!m_FrameGroupDownloader.IsActivated(pOutputs[iOutput].fScale))
+		{
+			m_FrameGroupDownloader.StartDownload(pOutputs[iOutput].fScale, m_Config.m_eOptionDownloading);
+		}
+	}
+
+	bool bRet = true;
+	for (int iOutput = 0; iOutput < m_FrameGroupContext.uiOutputNum; ++iOutput)
+	{
+		G_tFrameGroupOutput& output = pOutputs[iOutput];
+		unsigned int uiWidth = static_cast<unsigned int>(m_FrameGroupDownloader.Width(output.fScale));
+		unsigned int uiHeight = static_cast<unsigned int>(m_FrameGroupDownloader.Height(output.fScale));
+
+		if ((uiWidth * uiHeight > output.uiWidth * output.uiHeight) ||
+			(nullptr == output.pRGBData))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup(). No enough storage space. Pano width: "
+				<< uiWidth << ", pano height: " << uiHeight
+				<< ". buffer width: " << output.uiWidth << ", buffer height: " << output.uiHeight << ".";
+			output.uiWidth = uiWidth;
+			output.uiHeight = uiHeight;
+			bRet = false;
+			continue;
+		}
+
+		unsigned char* pData = m_FrameGroupDownloader.MapFrame(output.fScale);
+		if (nullptr == pData)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup(). Map frame failed.";
+			bRet = false;
+			continue;
+		}
+
+		std::copy(pData, pData + uiWidth * uiHeight * 3, output.pRGBData);
+		output.uiWidth = uiWidth;
+		output.uiHeight = uiHeight;
+
+		m_FrameGroupDownloader.UnmapFrame(output.fScale);
+	}
+
+	GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderRequestedFrameGroup(). ==>";
+	return bRet;
+}
+
+void GStitcherOGLWrapper_PanoRender::InvokeOutputCallBack(const GWriteOutCallBack& task
+	, int iWidth, int iHeight, const unsigned char* pData, const GOutputFrameInfo& frameInfo)
+{
+	if (nullptr != task.pCallBackFuncEx)
+	{
+		G_tOutputFrameInfo outputFrameInfo;
+		outputFrameInfo.ullSequenceNumber = frameInfo.ullSequenceNumber;
+		outputFrameInfo.uiCameraNum = static_cast<unsigned int>(frameInfo.vInputFrameIDs.size());
+		outputFrameInfo.pInputFrameIDs = frameInfo.vInputFrameIDs.data();
+		outputFrameInfo.pInputTimeStamps = frameInfo.vInputTimeStamps.data();
+		outputFrameInfo.llQueueWait_us = frameInfo.llQueueWait_us;
+		outputFrameInfo.llRenderStartTime_us = frameInfo.llRenderStartTime_us;
+		outputFrameInfo.llRenderEndTime_us = frameInfo.llRenderEndTime_us;
+
+		(*(task.pCallBackFuncEx))(iWidth, iHeight, pData, &outputFrameInfo, task.pContext);
+	}
+	else
+	{
+		(*(task.pCallBackFunc))(iWidth, iHeight, pData, task.pContext);
+	}
+}
+
+long long GStitcherOGLWrapper_PanoRender::GetTimeStamp_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void GStitcherOGLWrapper_PanoRender::OutputCallBack(unsigned char* pData, int iWidth, int iHeight, const GOutputFrameInfo& frameInfo)
+{
+	auto itCallBack = m_mpWriteOutCallBack.begin();
+	while (itCallBack != m_mpWriteOutCallBack.end())
+	{
+		GWriteOutCallBack& task = itCallBack->second;
+		if (1 < task.iCallBackTimes)
+		{
+			InvokeOutputCallBack(task, iWidth, iHeight, pData, frameInfo);
+			--task.iCallBackTimes;
+		}
 		else if (1 == task.iCallBackTimes)
 		{
-			(*(task.pCallBackFunc))(iWidth, iHeight, pData, task.pContext);
-			auto itToErase = itCallBack;
-			++itCallBack;
-			m_mpWriteOutCallBack.erase(itToErase);
-			continue;
+			InvokeOutputCallBack(task, iWidth, iHeight, pData, frameInfo);
+			auto itToErase = itCallBack;
+			++itCallBack;
+			m_mpWriteOutCallBack.erase(itToErase);
+			continue;
+		}
+		else if (0 == task.iCallBackTimes)
+		{
+			auto itToErase = itCallBack;
+			++itCallBack;
+			m_mpWriteOutCallBack.erase(itToErase);
+			continue;
+		}
+		else if (0 > task.iCallBackTimes)
+		{
+			InvokeOutputCallBack(task, iWidth, iHeight, pData, frameInfo);
+		}
+
+		++itCallBack;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::OutputCallBackwithScale(GFrameDownloader* pDownloader, std::map <std::string, GWriteOutCallBack>& mpWriteOutCallBack)
+{
+	bool bDelivered = false;
+	std::vector<float> vProcessedScales;
+	std::vector<std::map <std::string, GWriteOutCallBack>::iterator> vIterators2Del;
+
+	//the frame is downloaded at the scales of the callbacks times the output scale it was rendered with.
+	float fOutputScale = pDownloader->GetOutputScale();
+
+	for (auto it = mpWriteOutCallBack.begin(); it != mpWriteOutCallBack.end(); ++it)
+	{
+		float fScale = it->second.fScale * fOutputScale;
+
+		//avoid process the same scale value again.
+		if (vProcessedScales.end() != std::find(vProcessedScales.begin(), vProcessedScales.end(), it->second.fScale))
+		{
+			continue;
+		}
+
+		unsigned char* pData = pDownloader->MapFrame(fScale);
+		if (nullptr == pData)
+		{
+			vProcessedScales.push_back(it->second.fScale);
+			continue;
+		}
+
+		//the first successful map is the moment the rendered pixels become available on CPU side.
+		GOutputFrameInfo& frameInfo = pDownloader->GetFrameInfo();
+		if (0 == frameInfo.llRenderEndTime_us)
+		{
+			frameInfo.llRenderEndTime_us = GetTimeStamp_us();
+		}
+
+		//find all callbacks with the same scale value.
+		for (auto itt = mpWriteOutCallBack.begin(); itt != mpWriteOutCallBack.end(); ++itt)
+		{
+			GWriteOutCallBack& task = itt->second;
+
+			if (it->second.fScale != task.fScale)
+			{
+				continue;
+			}
+
+			if (1 < task.iCallBackTimes)
+			{
+				InvokeOutputCallBack(task, pDownloader->Width(fScale), pDownloader->Height(fScale), pData, frameInfo);
+				bDelivered = true;
+				--task.iCallBackTimes;
+			}
+			else if (1 == task.iCallBackTimes)
+			{
+				InvokeOutputCallBack(task, pDownloader->Width(fScale), pDownloader->Height(fScale), pData, frameInfo);
+				bDelivered = true;
+				vIterators2Del.push_back(itt);
+			}
+			else if (0 == task.iCallBackTimes)
+			{
+				vIterators2Del.push_back(itt);
+			}
+			else if (0 > task.iCallBackTimes)
+			{
+				InvokeOutputCallBack(task, pDownloader->Width(fScale), pDownloader->Height(fScale), pData, frameInfo);
+				bDelivered = true;
+			}
+		}
+
+		vProcessedScales.push_back(it->second.fScale);
+
+		pDownloader->UnmapFrame(fScale);
+	}
+
+	for (int i = 0; i < vIterators2Del.size(); ++i)
+	{
+		mpWriteOutCallBack.erase(vIterators2Del[i]);
+	}
+
+	return bDelivered;
+}
+
+void GStitcherOGLWrapper_PanoRender::FlushOutput()
+{
+	std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+
+	GFrameDownloader* pDownloader = m_downloaders.GrabOldestTask();
+	while (nullptr != pDownloader)
+	{
+		OutputCallBackwithScale(pDownloader, m_mpWriteOutCallBack);
+		m_downloaders.ReleaseTask();
+
+		pDownloader = m_downloaders.GrabOldestTask();
+	}
+
+	std::vector<std::shared_ptr<tView>> vPtrViews;
+	{
+		std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+		for (auto itView = m_mpViews.begin(); itView != m_mpViews.end(); ++itView)
+		{
+			vPtrViews.push_back(itView->second);
+		}
+	}
+
+	for (int iView = 0; iView < vPtrViews.size(); ++iView)
+	{
+		tView& view = *(vPtrViews[iView]);
+		if (!view.bInited)
+		{
+			continue;
+		}
+
+		pDownloader = view.downloaders.GrabOldestTask();
+		while (nullptr != pDownloader)
+		{
+			OutputView(view, pDownloader);
+			view.downloaders.ReleaseTask();
+
+			pDownloader = view.downloaders.GrabOldestTask();
+		}
+	}
+}
+
+std::shared_ptr<GStitcherOGLWrapper_PanoRender::tView> GStitcherOGLWrapper_PanoRender::FindView(const std::string& sViewName)
+{
+	std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+	auto itView = m_mpViews.find(sViewName);
+	return (m_mpViews.end() == itView) ? nullptr : itView->second;
+}
+
+bool GStitcherOGLWrapper_PanoRender::UpdateViews()
+{
+	std::vector<std::shared_ptr<tView>> vPtrViews;
+	std::vector<std::shared_ptr<tView>> vPtrRemovedViews;
+	{
+		std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+		for (auto itView = m_mpViews.begin(); itView != m_mpViews.end(); ++itView)
+		{
+			vPtrViews.push_back(itView->second);
+		}
+		vPtrRemovedViews.swap(m_vRemovedViews);
+	}
+
+	for (int iView = 0; iView < vPtrRemovedViews.size(); ++iView)
+	{
+		tView& view = *(vPtrRemovedViews[iView]);
+		if (view.bInited)
+		{
+			view.downloaders.Release([](GFrameDownloader& downloader)
+			{
+				downloader.Release();
+			});
+		}
+
+		m_stitcherOGL.RemoveScene(view.sSceneName);
+	}
+
+	//the views render the same input frames as the panorama.
+	cv::Size szInputFrameSize = m_RenderParameterManager.GetInputFrameSize();
+
+	for (int iView = 0; iView < vPtrViews.size(); ++iView)
+	{
+		tView& view = *(vPtrViews[iView]);
+
+		if (!view.bInited)
+		{
+			view.downloaders.Init(3, [](GFrameDownloader& downloader)
+			{
+				downloader.Init(10, 10);
+			});
+			view.bInited = true;
+		}
+
+		{
+			std::lock_guard<std::mutex> lockGuard(view.RenderParameterManager.m_mtManagerMutex);
+			view.RenderParameterManager.SetInputFrameSize(szInputFrameSize.width, szInputFrameSize.height);
+		}
+		view.RenderParameterManager.ApplyParameters();
+
+		float fTolerance_px = CalcTessellationTolerance(view.RenderParameterManager.GetPanoType(), cv::Size(view.iOutputWidth, view.iOutputHeight));
+		cv::Size szRemapTable = CalcRemapTableSize(view.RenderParameterManager.GetPanoType(), cv::Size(view.iOutputWidth, view.iOutputHeight));
+		if (view.RenderParameterManager.ShouldCreateScene() ||
+			(view.bSceneCreated && (view.iTessellationLevel != m_stitcherOGL.GetTessellationLevel())) ||
+			(view.bSceneCreated && (view.fTessellationTolerance_px != fTolerance_px)) ||
+			(view.bSceneCreated && (view.szRemapTable != szRemapTable)))
+		{
+			bool bUpdate = view.RenderParameterManager.ShouldUpdateScene() && view.bSceneCreated
+				&& (view.iTessellationLevel == m_stitcherOGL.GetTessellationLevel()) && (view.fTessellationTolerance_px == fTolerance_px)
+				&& (view.szRemapTable == szRemapTable);
+			view.iTessellationLevel = m_stitcherOGL.GetTessellationLevel();
+			view.fTessellationTolerance_px = fTolerance_px;
+			view.szRemapTable = szRemapTable;
+			m_stitcherOGL.SetTessellationTolerance(fTolerance_px, szInputFrameSize.width, szInputFrameSize.height);
+			m_stitcherOGL.SetRemapTableSize(szRemapTable.width, szRemapTable.height);
+			m_stitcherOGL.SetSceneCacheDirectory(GetSceneCacheDirectory());
+			m_stitcherOGL.SetProgramBinaryCacheDirectory(GetProgramBinaryCacheDirectory());
+			view.bSceneCreated = bUpdate ?
+				m_stitcherOGL.UpdateScene(view.sSceneName, view.RenderParameterManager.GetPanoType(), view.RenderParameterManager.GetK0Name(), view.RenderParameterManager.GetCropRatios())
+				: m_stitcherOGL.CreateScene(view.sSceneName, view.RenderParameterManager.GetPanoType(), view.RenderParameterManager.GetK0Name(), view.RenderParameterManager.GetCropRatios());
+			if (!view.bSceneCreated)
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::UpdateViews(). Create scene of view " << view.sSceneName << " ERROR.";
+			}
+		}
+	}
+
+	return true;
+}
+
+bool GStitcherOGLWrapper_PanoRender::RenderViews(bool bLateLatch)
+{
+	if (!opengl_compatible(3, 0))
+	{
+		return true;
+	}
+
+	std::vector<std::shared_ptr<tView>> vPtrViews;
+	{
+		std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+		for (auto itView = m_mpViews.begin(); itView != m_mpViews.end(); ++itView)
+		{
+			vPtrViews.push_back(itView->second);
+		}
+	}
+
+	for (int iView = 0; iView < vPtrViews.size(); ++iView)
+	{
+		tView& view = *(vPtrViews[iView]);
+		if ((!view.bInited) || (!view.bSceneCreated) || view.mpWriteOutCallBack.empty())
+		{
+			continue;
+		}
+
+		long long llViewStartTime_us = GetTimeStamp_us();
+
+		//Render and start downloading.
+		GFrameDownloader* pNewDownloader = view.downloaders.CreateTask();
+		if (nullptr != pNewDownloader)
+		{
+			if (bLateLatch)
+			{
+				view.RenderParameterManager.LatchViewCamera();
+			}
+			GViewCamera4RenderIF* pViewCamera = view.RenderParameterManager.GetViewCamera();
+
+			int iWidth = ScaleByQuality(view.iOutputWidth);
+			int iHeight = ScaleByQuality(view.iOutputHeight);
+
+			pNewDownloader->Bind();
+			if (!pNewDownloader->ChangeFrameSize(iWidth, iHeight))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderViews(). Change frame size of view " << view.sSceneName << " Failed. ==>";
+				return false;
+			}
+			pNewDownloader->SetViewPort(0, 0, iWidth, iHeight);
+			pNewDownloader->Clear();
+			pNewDownloader->SetFrameInfo(m_CurrentFrameInfo);
+			pNewDownloader->SetOutputScale(m_QualityLevel.fOutputScale);
+
+			m_stitcherOGL.RenderPano(view.sSceneName, m_textureGroup, pViewCamera->CalcP(), pViewCamera->CalcV());
+
+			for (auto itCallBack = view.mpWriteOutCallBack.begin(); itCallBack != view.mpWriteOutCallBack.end(); ++itCallBack)
+			{
+				float fScale = itCallBack->second.fScale * pNewDownloader->GetOutputScale();
+				if (!pNewDownloader->IsActivated(fScale))
+				{
+					pNewDownloader->StartDownload(fScale, m_Config.m_eOptionDownloading);
+				}
+			}
+
+			view.downloaders.CompleteTask();
+
+			++view.ullRenderedFrames;
+			view.cbRenderTimes_ms.push_back(static_cast<double>(GetTimeStamp_us() - llViewStartTime_us) / 1000.0);
+		}
+
+		//Output.
+		GFrameDownloader* pDownloader = view.downloaders.GrabTask();
+		if (nullptr != pDownloader)
+		{
+			OutputView(view, pDownloader);
+			view.downloaders.ReleaseTask();
+		}
+	}
+
+	return true;
+}
+
+void GStitcherOGLWrapper_PanoRender::OutputView(tView& view, GFrameDownloader* pDownloader)
+{
+	if (!OutputCallBackwithScale(pDownloader, view.mpWriteOutCallBack))
+	{
+		return;
+	}
+
+	const GOutputFrameInfo& frameInfo = pDownloader->GetFrameInfo();
+	++view.ullDeliveredFrames;
+	view.cbOutputLatencies_ms.push_back(static_cast<double>(frameInfo.llRenderEndTime_us - frameInfo.llRenderStartTime_us) / 1000.0);
+}
+
+void GStitcherOGLWrapper_PanoRender::Release()
+{
+	//a RenderFrameGroup() call waiting for the rendering thread fails.
+	{
+		std::lock_guard<std::mutex> lk(m_FrameGroupContext.mtTaskMutex);
+		m_FrameGroupContext.bRet = false;
+		m_FrameGroupContext.bPending = false;
+		m_FrameGroupContext.bReleased = true;
+	}
+	m_FrameGroupContext.cvTaskDone.notify_one();
+
+	if (nullptr != m_GLContext)
+	{
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			m_stitcherOGL.Release();
+
+			m_uploader.Release();
+
+			m_downloaders.Release([](GFrameDownloader& downloader)
+			{
+				downloader.Release();
+			});
+
+			m_FrameGroupDownloader.Release();
+
+			std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+			std::vector<std::shared_ptr<tView>> vPtrViews = m_vRemovedViews;
+			for (auto itView = m_mpViews.begin(); itView != m_mpViews.end(); ++itView)
+			{
+				vPtrViews.push_back(itView->second);
+			}
+
+			for (int iView = 0; iView < vPtrViews.size(); ++iView)
+			{
+				if (vPtrViews[iView]->bInited)
+				{
+					vPtrViews[iView]->downloaders.Release([](GFrameDownloader& downloader)
+					{
+						downloader.Release();
+					});
+					vPtrViews[iView]->bInited = false;
+				}
+			}
+		}
+	}
+
+#ifdef WIN32
+	if (nullptr != m_HDC)
+	{
+		if (!wglMakeCurrent(m_HDC, nullptr))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Unbind OpenGL context FAILED.";
+		}
+	}
+
+	if ((nullptr != m_HWND) && (nullptr != m_HDC))
+	{
+		if (1 != ReleaseDC((HWND)m_HWND, m_HDC))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). ReleaseDC FAILED.";
+		}
+		else
+		{
+			m_HDC = nullptr;
+		}
+	}
+
+	if (nullptr != m_GLContext)
+	{
+		if (!wglDeleteContext(m_GLContext))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Delete OpenGL Context FAILED.";
+		}
+		else
+		{
+			m_GLContext = nullptr;
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Release(). OpenGL Context Deleted.";
+		}
+	}
+
+	m_HWND = nullptr;
+#elif __APPLE__
+#elif (defined __ANDROID__) || (defined __linux__)
+	if (m_Display != EGL_NO_DISPLAY)
+	{
+		if (EGL_FALSE == eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Unbind OpenGL context FAILED.";
+		}
+
+		if (m_GLContext != EGL_NO_CONTEXT)
+		{
+			if (EGL_FALSE == eglDestroyContext(m_Display, m_GLContext))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Delete OpenGL Context FAILED.";
+			}
+			else
+			{
+				m_GLContext = EGL_NO_CONTEXT;
+			}
+		}
+
+		if (m_Surface != EGL_NO_SURFACE)
+		{
+			if (EGL_FALSE == eglDestroySurface(m_Display, m_Surface))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Delete Surface FAILED.";
+			}
+			else
+			{
+				m_Surface = EGL_NO_SURFACE;
+			}
+		}
+
+		if (EGL_FALSE == eglTerminate(m_Display))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). eglTerminate() FAILED.";
+		}
+		else
+		{
+			m_Display = EGL_NO_DISPLAY;
+		}
+	}
+
+	m_HWND = nullptr;
+#endif // WIN32
+}
+
+bool GStitcherOGLWrapper_PanoRender::GetSupportedPanoTypeList(std::vector<G_enPanoType>& vSupportedPanoTypeList)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetSupportedPanoTypeList(). Not Ready. ==>";
+			return false;
+		}
+
+		vSupportedPanoTypeList.clear();
+		std::vector<enPanoType> vList = m_RenderParameterManager.GetSupportedPanoTypeList();
+		for (int i = 0; i < vList.size(); ++i)
+		{
+			switch (vList[i])
+			{
+			case ePanoTypeImmersionSemiSphere:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionSemiSphere);
+				break;
+			case ePanoTypeUnwrappedCylinder180:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder180);
+				break;
+			case ePanoTypeUnwrappedCylinder360:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder360);
+				break;
+			case ePanoTypeImmersionCylinder360:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionCylinder360);
+				break;
+			case ePanoTypeImmersionCylinder360Inside:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionCylinder360Inside);
+				break;
+			case ePanoTypeUnwrappedCylinderSplited:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinderSplited);
+				break;
+			case ePanoTypeUnwrappedCylinderSplitedFrontBack:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinderSplitedFrontBack);
+				break;
+			case ePanoTypeUnwrappedSphere180:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedSphere180);
+				break;
+			case ePanoTypeUnwrappedSphere360:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedSphere360);
+				break;
+			case ePanoTypeUnwrappedSphere360Flip:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedSphere360Flip);
+				break;
+			case ePanoTypeUnwrappedCylinder180Flip:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder180Flip);
+				break;
+			case ePanoTypeUnwrappedCylinder360Flip:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder360Flip);
+				break;
+			case ePanoTypeImmersionFullSphere:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionFullSphere);
+				break;
+			case ePanoTypeUnwrappedFullSphere360:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedFullSphere360);
+				break;
+			case ePanoTypeUnwrappedFullSphere360Flip:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedFullSphere360Flip);
+				break;
+			case ePanoTypeUnwrappedFullSphere360Binocular:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedFullSphere360Binocular);
+				break;
+			case ePanoTypeImmersionFullSphereInside:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionFullSphereInside);
+				break;
+			case ePanoTypeOriginal:
+				vSupportedPanoTypeList.push_back(G_ePanoTypeOriginal);
+				break;
+			default:
+				//todo.
+				break;
+			}
+		}
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetSupportedPanoTypeList(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::GetViewCamera(G_tViewCamera& viewCamera)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetViewCamera(). Not Ready. ==>";
+			return false;
+		}
+
+		GInteractionControllerDOF dof;
+		{
+			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
+			dof = m_RenderParameterManager.ReadInteractionControllerDOF();
+		}
+
+		viewCamera.fHorizontal = dof.fHorizontal;
+		viewCamera.fVertical = dof.fVertical;
+		viewCamera.fZoom = dof.fZoom;
+
+		//GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::GetViewCamera(). Pan: " << viewCamera.fPan
+		//	<< ", Tilt: " << viewCamera.fTilt << ", Zoom: " << viewCamera.fZoom;
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetViewCamera(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::GetOriginalPanoSize(unsigned int& uiWidth, unsigned int& uiHeight)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetOriginalPanoSize(). Not Ready. ==>";
+			return false;
+		}
+
+		cv::Size panoSize;
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			panoSize = cv::Size(m_iPanoOriginalWidth, m_iPanoOriginalHeight);
+		}
+
+		int iWidth4n = (0 != (panoSize.width % 4)) ? (panoSize.width / 4) * 4 + 4 : (panoSize.width / 4) * 4;
+
+		uiWidth = static_cast<unsigned int>(iWidth4n);
+		uiHeight = static_cast<unsigned int>(panoSize.height);
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetOriginalPanoSize(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::SetViewCamera(G_tViewCamera viewCamera)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetViewCamera(). Not Ready. ==>";
+			return false;
+		}
+
+		//G_tViewCamera viewCameraOld;
+		//GetViewCamera(viewCameraOld);
+		//GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::SetViewCamera(). Pan: " << viewCameraOld.fHorizontal
+		//	<< ", Tilt: " << viewCameraOld.fVertical << ", Zoom: " << viewCameraOld.fZoom
+		//	<< " ---> Pan: " << viewCamera.fHorizontal
+		//	<< ", Tilt: " << viewCamera.fVertical << ", Zoom: " << viewCamera.fZoom;
+
+		GInteractionControllerDOF dof;
+		dof.fHorizontal = viewCamera.fHorizontal;
+		dof.fVertical = viewCamera.fVertical;
+		dof.fZoom = viewCamera.fZoom;
+
+		{
+			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
+			m_RenderParameterManager.SetInteractionControllerDOF(dof);
+		}
+		WakeUpRenderingLoop();
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetViewCamera(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::SetViewCameraLateLatch(bool bEnable)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetViewCameraLateLatch(). Not Ready. ==>";
+			return false;
+		}
+
+		GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::SetViewCameraLateLatch(). Enable: " << bEnable;
+
+		{
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_bLateLatchViewCamera = bEnable;
+		}
+
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetViewCameraLateLatch(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::SetDrawingRegion(unsigned int uiX0, unsigned int uiY0, unsigned int uiWidth, unsigned int uiHeight)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetDrawingRegion(). Not Ready. ==>";
+			return false;
+		}
+
+		GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::SetDrawingRegion(). X0: " << uiX0
+			<< "; Y0: " << uiY0 << "; Width: " << uiWidth << "; Height: " << uiHeight;
+
+		{
+			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
+			m_RenderParameterManager.SetDrawRegion(static_cast<int>(uiX0), static_cast<int>(uiY0)
+				, static_cast<int>(uiWidth), static_cast<int>(uiHeight));
+		}
+		WakeUpRenderingLoop(true);
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetDrawingRegion(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+GFrameType GStitcherOGLWrapper_PanoRender::CreateFrameType(int iCameraIdx, unsigned int uiWidth, unsigned int uiHeight, const unsigned int uiStep_Byte[3]
+	, const long long* pllTimeStamp)
+{
+	GFrameType frameType;
+	frameType.eFrameFormat = m_Config.m_eInputFrameFormat;
+	frameType.iWidth = static_cast<int>(uiWidth);
+	frameType.iHeight = static_cast<int>(uiHeight);
+	frameType.step_Byte[0] = static_cast<int>(uiStep_Byte[0]);
+	frameType.step_Byte[1] = static_cast<int>(uiStep_Byte[1]);
+	frameType.step_Byte[2] = static_cast<int>(uiStep_Byte[2]);
+
+	//count every input frame, so that dropped frames show up as gaps of frame IDs.
+	frameType.ullFrameID = ++m_vInputFrameCounters[iCameraIdx];
+	frameType.llArrivalTime_us = GetTimeStamp_us();
+	frameType.llTimeStamp = (nullptr != pllTimeStamp) ? (*pllTimeStamp) : frameType.llArrivalTime_us;
+
+	return frameType;
+}
+
+void GStitcherOGLWrapper_PanoRender::CopyFrame(const GFrameType& frameType, void* const pData[3], unsigned char* pBuffer) const
+{
+	unsigned int uiWidth = static_cast<unsigned int>(frameType.iWidth);
+	unsigned int uiHeight = static_cast<unsigned int>(frameType.iHeight);
+
+	if (eFrameFormatRGB == frameType.eFrameFormat ||
+		eFrameFormatBGR == frameType.eFrameFormat)
+	{
+		unsigned int uiWidth_Byte = uiWidth * 3;
+		for (int iLine = 0; iLine < uiHeight; ++iLine)
+		{
+			unsigned char* pSrc = (unsigned char*)(pData[0]) + iLine * frameType.step_Byte[0];
+			unsigned char* pDst = pBuffer + iLine * uiWidth_Byte;
+			std::copy(pSrc, pSrc + uiWidth_Byte, pDst);
+		}
+	}
+	else if (eFrameFormatYUV420P == frameType.eFrameFormat ||
+		eFrameFormatYV12 == frameType.eFrameFormat)
+	{
+		unsigned char* pDataY = (unsigned char*)(pData[0]);
+		unsigned char* pDataU = (unsigned char*)(pData[1]);
+		unsigned char* pDataV = (unsigned char*)(pData[2]);
+
+		for (int iLineY = 0; iLineY < uiHeight; ++iLineY)
+		{
+			unsigned char* pSrc = pDataY + iLineY * frameType.step_Byte[0];
+			unsigned char* pDst = pBuffer + iLineY * uiWidth;
+			std::copy(pSrc, pSrc + uiWidth, pDst);
+		}
+
+		unsigned int uiHalfWidth = uiWidth / 2;
+
+		unsigned char* pUStart = pBuffer + uiWidth * uiHeight;
+		for (int iLineU = 0; iLineU < uiHeight / 2; ++iLineU)
+		{
+			unsigned char* pSrc = pDataU + iLineU * frameType.step_Byte[1];
+			std::copy(pSrc, pSrc + uiHalfWidth, pUStart + iLineU * uiHalfWidth);
+		}
+
+		unsigned char* pVStart = pBuffer + (uiWidth * uiHeight * 5) / 4;
+		for (int iLineV = 0; iLineV < uiHeight / 2; ++iLineV)
+		{
+			unsigned char* pSrc = pDataV + iLineV * frameType.step_Byte[2];
+			std::copy(pSrc, pSrc + uiHalfWidth, pVStart + iLineV * uiHalfWidth);
+		}
+	}
+	else if (eFrameFormatNV12 == frameType.eFrameFormat)
+	{
+		unsigned char* pDataY = (unsigned char*)(pData[0]);
+		unsigned char* pDataUV = (unsigned char*)(pData[1]);
+
+		for (int iLineY = 0; iLineY < uiHeight; ++iLineY)
+		{
+			unsigned char* pSrc = pDataY + iLineY * frameType.step_Byte[0];
+			unsigned char* pDst = pBuffer + iLineY * uiWidth;
+			std::copy(pSrc, pSrc + uiWidth, pDst);
+		}
+
+		unsigned char* pUVStart = pBuffer + uiWidth * uiHeight;
+		for (int iLineUV = 0; iLineUV < uiHeight / 2; ++iLineUV)
+		{
+			unsigned char* pSrc = pDataUV + iLineUV * frameType.step_Byte[1];
+			std::copy(pSrc, pSrc + uiWidth, pUVStart + iLineUV * uiWidth);
 		}
-		else if (0 == task.iCallBackTimes)
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::InputFrame(int iCameraIdx, unsigned int uiWidth, unsigned int uiHeight, void* pData[3], unsigned int uiStep_Byte[3]
+	, const long long* pllTimeStamp)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateInited)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InputFrame(). Not Ready. ==>";
+			return false;
+		}
+
+		if ((iCameraIdx >= m_vPtrFrameQueues.size()) ||
+			(iCameraIdx < 0))
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InputFrame(). Wrong CameraIdx or Camera not supported in this profile: " << iCameraIdx << "  ==>";
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
+			m_RenderParameterManager.SetInputFrameSize(static_cast<int>(uiWidth), static_cast<int>(uiHeight));
+		}
+
+		GFrameType frameType = CreateFrameType(iCameraIdx, uiWidth, uiHeight, uiStep_Byte, pllTimeStamp);
+
+		if (!m_vPtrFrameQueues[iCameraIdx]->CreateFrame(frameType))
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InputFrame(). CreateFrame failed.";
+			return false;
+		}
+
+		CopyFrame(frameType, pData, (unsigned char*)(m_vPtrFrameQueues[iCameraIdx]->InMapFrame()));
+
+		m_vPtrFrameQueues[iCameraIdx]->CompleteFrame();
+
+		m_bDataArrived = true;
+
+		{
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_vCameraActive[iCameraIdx] = true;
+			++m_vPendingFrameNum[iCameraIdx];
+		}
+		WakeUpRenderingLoop();
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InputFrame(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::RenderFrameGroup(const G_tInputFrame* pInputFrames, unsigned int uiInputFrameNum
+	, G_tFrameGroupOutput* pOutputs, unsigned int uiOutputNum)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateInited)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::RenderFrameGroup(). Not Ready. ==>";
+			return false;
+		}
+
+		if (GStitcherConfig::eRenderingModeOnScreen == m_Config.m_eRenderingMode)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderFrameGroup(). Error: Only available in off screen modes. ==>";
+			return false;
+		}
+
+		if (uiInputFrameNum != m_vCameras.size())
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderFrameGroup(). Error: " << uiInputFrameNum
+				<< " input frames for " << m_vCameras.size() << " cameras. ==>";
+			return false;
+		}
+
+		for (int iOutput = 0; iOutput < uiOutputNum; ++iOutput)
+		{
+			if ((pOutputs[iOutput].fScale <= 0.0f) || (pOutputs[iOutput].fScale > 1.0f))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderFrameGroup(). Error: Output scale should be in (0.0, 1.0]. ==>";
+				return false;
+			}
+		}
+
+		//the task runs on the rendering thread, a call from a callback would wait for itself.
+		{
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			if (std::this_thread::get_id() == m_idRenderingThread)
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderFrameGroup(). Error: Not allowed on the rendering thread. ==>";
+				return false;
+			}
+		}
+
+		std::lock_guard<std::mutex> lkCall(m_FrameGroupContext.mtCallMutex);
+
+		//copy the frames on the calling thread, the rendering thread only uploads them.
+		std::vector<std::shared_ptr<GFrameSourceIF>> vPtrSources(uiInputFrameNum);
+		for (int iCameraIdx = 0; iCameraIdx < uiInputFrameNum; ++iCameraIdx)
+		{
+			const G_tInputFrame& inputFrame = pInputFrames[iCameraIdx];
+			GFrameType frameType = CreateFrameType(iCameraIdx, inputFrame.uiWidth, inputFrame.uiHeight, inputFrame.uiStep_Byte, &inputFrame.llTimeStamp);
+
+			std::shared_ptr<tFrameGroupSource> ptrSource = std::make_shared<tFrameGroupSource>(frameType);
+			CopyFrame(frameType, inputFrame.pData, ptrSource->vBuffer.data());
+			vPtrSources[iCameraIdx] = ptrSource;
+		}
+
+		{
+			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
+			m_RenderParameterManager.SetInputFrameSize(static_cast<int>(pInputFrames[0].uiWidth), static_cast<int>(pInputFrames[0].uiHeight));
+		}
+
+		m_bDataArrived = true;
+
+		{
+			std::lock_guard<std::mutex> lk(m_FrameGroupContext.mtTaskMutex);
+			if (m_FrameGroupContext.bReleased)
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderFrameGroup(). Error: Already released. ==>";
+				return false;
+			}
+
+			m_FrameGroupContext.vPtrSources.swap(vPtrSources);
+			m_FrameGroupContext.pOutputs = pOutputs;
+			m_FrameGroupContext.uiOutputNum = uiOutputNum;
+			m_FrameGroupContext.bRet = false;
+			m_FrameGroupContext.bPending = true;
+		}
+		WakeUpRenderingLoop(true);
+
+		std::unique_lock<std::mutex> lk(m_FrameGroupContext.mtTaskMutex);
+		m_FrameGroupContext.cvTaskDone.wait(lk, [this]()
+		{
+			return (!this->m_FrameGroupContext.bPending);
+		});
+
+		m_FrameGroupContext.vPtrSources.clear();
+		m_FrameGroupContext.pOutputs = nullptr;
+		m_FrameGroupContext.uiOutputNum = 0;
+
+		return m_FrameGroupContext.bRet;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RenderFrameGroup(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::GetCurrentPanoType(int* pCurrentPanoType) const
+{
+	if (m_ePanoRenderState < ePanoRenderStateCreated)
+	{
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetCurrentPanoType(). Not Ready.";
+		return false;
+	}
+
+	switch (m_RenderParameterManager.GetPanoType())
+	{
+	case ePanoTypeImmersionSemiSphere:
+		(*pCurrentPanoType) = G_ePanoTypeImmersionSemiSphere;
+		break;
+	case ePanoTypeUnwrappedCylinder180:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder180;
+		break;
+	case ePanoTypeUnwrappedCylinder360:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder360;
+		break;
+	case ePanoTypeImmersionCylinder360:
+		(*pCurrentPanoType) = G_ePanoTypeImmersionCylinder360;
+		break;
+	case ePanoTypeImmersionCylinder360Inside:
+		(*pCurrentPanoType) = G_ePanoTypeImmersionCylinder360Inside;
+		break;
+	case ePanoTypeUnwrappedCylinderSplited:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinderSplited;
+		break;
+	case ePanoTypeUnwrappedCylinderSplitedFrontBack:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinderSplitedFrontBack;
+		break;
+	case ePanoTypeUnwrappedSphere180:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedSphere180;
+		break;
+	case ePanoTypeUnwrappedSphere360:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedSphere360;
+		break;
+	case ePanoTypeUnwrappedSphere360Flip:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedSphere360Flip;
+		break;
+	case ePanoTypeUnwrappedCylinder180Flip:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder180Flip;
+		break;
+	case ePanoTypeUnwrappedCylinder360Flip:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder360Flip;
+		break;
+	case ePanoTypeImmersionFullSphere:
+		(*pCurrentPanoType) = G_ePanoTypeImmersionFullSphere;
+		break;
+	case ePanoTypeUnwrappedFullSphere360:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedFullSphere360;
+		break;
+	case ePanoTypeUnwrappedFullSphere360Flip:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedFullSphere360Flip;
+		break;
+	case ePanoTypeUnwrappedFullSphere360Binocular:
+		(*pCurrentPanoType) = G_ePanoTypeUnwrappedFullSphere360Binocular;
+		break;
+	case ePanoTypeImmersionFullSphereInside:
+		(*pCurrentPanoType) = G_ePanoTypeImmersionFullSphereInside;
+		break;
+	case ePanoTypeOriginal:
+		(*pCurrentPanoType) = G_ePanoTypeOriginal;
+		break;
+	default:
+		//todo.
+		break;
+	}
+
+	return true;
+}
+
+enPanoType GStitcherOGLWrapper_PanoRender::ToPanoType(G_enPanoType ePanoType)
+{
+	enPanoType eCurrentPanoType = ePanoTypeImmersionSemiSphere;
+	switch (ePanoType)
+	{
+	case G_ePanoTypeImmersionSemiSphere:
+		eCurrentPanoType = ePanoTypeImmersionSemiSphere;
+		break;
+	case G_ePanoTypeUnwrappedCylinder180:
+		eCurrentPanoType = ePanoTypeUnwrappedCylinder180;
+		break;
+	case G_ePanoTypeUnwrappedCylinder360:
+		eCurrentPanoType = ePanoTypeUnwrappedCylinder360;
+		break;
+	case G_ePanoTypeImmersionCylinder360:
+		eCurrentPanoType = ePanoTypeImmersionCylinder360;
+		break;
+	case G_ePanoTypeImmersionCylinder360Inside:
+		eCurrentPanoType = ePanoTypeImmersionCylinder360Inside;
+		break;
+	case G_ePanoTypeUnwrappedCylinderSplited:
+		eCurrentPanoType = ePanoTypeUnwrappedCylinderSplited;
+		break;
+	case G_ePanoTypeUnwrappedCylinderSplitedFrontBack:
+		eCurrentPanoType = ePanoTypeUnwrappedCylinderSplitedFrontBack;
+		break;
+	case G_ePanoTypeUnwrappedSphere180:
+		eCurrentPanoType = ePanoTypeUnwrappedSphere180;
+		break;
+	case  G_ePanoTypeUnwrappedSphere360:
+		eCurrentPanoType = ePanoTypeUnwrappedSphere360;
+		break;
+	case  G_ePanoTypeUnwrappedSphere360Flip:
+		eCurrentPanoType = ePanoTypeUnwrappedSphere360Flip;
+		break;
+	case  G_ePanoTypeUnwrappedCylinder180Flip:
+		eCurrentPanoType = ePanoTypeUnwrappedCylinder180Flip;
+		break;
+	case  G_ePanoTypeUnwrappedCylinder360Flip:
+		eCurrentPanoType = ePanoTypeUnwrappedCylinder360Flip;
+		break;
+	case G_ePanoTypeImmersionFullSphere:
+		eCurrentPanoType = ePanoTypeImmersionFullSphere;
+		break;
+	case G_ePanoTypeUnwrappedFullSphere360:
+		eCurrentPanoType = ePanoTypeUnwrappedFullSphere360;
+		break;
+	case G_ePanoTypeUnwrappedFullSphere360Flip:
+		eCurrentPanoType = ePanoTypeUnwrappedFullSphere360Flip;
+		break;
+	case G_ePanoTypeUnwrappedFullSphere360Binocular:
+		eCurrentPanoType = ePanoTypeUnwrappedFullSphere360Binocular;
+		break;
+	case G_ePanoTypeImmersionFullSphereInside:
+		eCurrentPanoType = ePanoTypeImmersionFullSphereInside;
+		break;
+	case G_ePanoTypeOriginal:
+		eCurrentPanoType = ePanoTypeOriginal;
+		break;
+	default:
+		//todo.
+		break;
+	}
+
+	return eCurrentPanoType;
+}
+
+bool GStitcherOGLWrapper_PanoRender::SwitchPanoType(G_enPanoType eNewPanoType)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SwitchPanoType(). Not Ready. ==>";
+			return false;
+		}
+
+		enPanoType eCurrentPanoType = ToPanoType(eNewPanoType);
+
+		{
+			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
+			m_RenderParameterManager.SetPanoType(eCurrentPanoType);
+		}
+		WakeUpRenderingLoop(true);
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SwitchPanoType(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::GrabPano(unsigned int* puiWidth, unsigned int* puiHeight, unsigned char* pRGBData)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GrabPano(). Not Ready. ==>";
+			return false;
+		}
+
+		GGrabCallBackContext grabContext;
+		grabContext.uiWidth = *puiWidth;
+		grabContext.uiHeight = *puiHeight;
+		grabContext.pContext = pRGBData;
+
 		{
-			auto itToErase = itCallBack;
-			++itCallBack;
-			m_mpWriteOutCallBack.erase(itToErase);
-			continue;
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+
+			GWriteOutCallBack callBack;
+			callBack.pCallBackFunc = GrabCallBack;
+			callBack.pCallBackFuncEx = nullptr;
+			callBack.iCallBackTimes = 1;
+			callBack.fScale = 1.0f;
+			callBack.pContext = &grabContext;
+			m_mpWriteOutCallBack["GrabPano"] = callBack;
 		}
-		else if (0 > task.iCallBackTimes)
+
+		std::unique_lock<std::mutex> lk(grabContext.mtTaskMutex);
+		grabContext.cvTaskDone.wait(lk, [&grabContext]()
+		{
+			return grabContext.bTaskDone;
+		});
+
+		if (nullptr == grabContext.pContext)
 		{
-			(*(task.pCallBackFunc))(iWidth, iHeight, pData, task.pContext);
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GrabPano(). No enough storage space. ==>";
+			return false;
 		}
 
-		++itCallBack;
+		*puiWidth = grabContext.uiWidth;
+		*puiHeight = grabContext.uiHeight;
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GrabPano(). EXCEPTION. ==>";
+		return false;
 	}
 }
 
-void GStitcherOGLWrapper_PanoRender::OutputCallBackwithScale(GFrameDownloader* pDownloader)
+bool GStitcherOGLWrapper_PanoRender::SetOutputCallBack(G_tOutputCallBack outputCallBackFunc, float fScale, void* pContext)
 {
-	std::vector<float> vProcessedScales;
-	std::vector<std::map <std::string, GWriteOutCallBack>::iterator> vIterators2Del;
-
-	for (auto it = m_mpWriteOutCallBack.begin(); it != m_mpWriteOutCallBack.end(); ++it)
+	try
 	{
-		//avoid process the same scale value again.
-		if (vProcessedScales.end() != std::find(vProcessedScales.begin(), vProcessedScales.end(), it->second.fScale))
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
 		{
-			continue;
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBack(). Not Ready. ==>";
+			return false;
 		}
 
-		unsigned char* pData = pDownloader->MapFrame(it->second.fScale);
-		if (nullptr == pData)
 		{
-			vProcessedScales.push_back(it->second.fScale);
-			continue;
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+
+			if (nullptr != outputCallBackFunc)
+			{
+				GWriteOutCallBack callBack;
+				callBack.pCallBackFunc = outputCallBackFunc;
+				callBack.pCallBackFuncEx = nullptr;
+				callBack.iCallBackTimes = -1;
+				callBack.fScale = fScale;
+				callBack.pContext = pContext;
+				m_mpWriteOutCallBack["OutputCallBack"] = callBack;
+			}
+			else
+			{
+				m_mpWriteOutCallBack.erase("OutputCallBack");
+			}
+
+			return true;
+
 		}
 
-		//find all callbacks with the same scale value.
-		for (auto itt = m_mpWriteOutCallBack.begin(); itt != m_mpWriteOutCallBack.end(); ++itt)
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBack(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::SetOutputCallBackEx(G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
 		{
-			GWriteOutCallBack& task = itt->second;
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBackEx(). Not Ready. ==>";
+			return false;
+		}
 
-			if (it->second.fScale != task.fScale)
-			{
-				continue;
-			}
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
 
-			if (1 < task.iCallBackTimes)
+			if (nullptr != outputCallBackFunc)
 			{
-				(*(task.pCallBackFunc))(pDownloader->Width(task.fScale), pDownloader->Height(task.fScale), pData, task.pContext);
-				--task.iCallBackTimes;
+				GWriteOutCallBack callBack;
+				callBack.pCallBackFunc = nullptr;
+				callBack.pCallBackFuncEx = outputCallBackFunc;
+				callBack.iCallBackTimes = -1;
+				callBack.fScale = fScale;
+				callBack.pContext = pContext;
+				m_mpWriteOutCallBack["OutputCallBackEx"] = callBack;
 			}
-			else if (1 == task.iCallBackTimes)
+			else
 			{
-				(*(task.pCallBackFunc))(pDownloader->Width(task.fScale), pDownloader->Height(task.fScale), pData, task.pContext);
-				vIterators2Del.push_back(itt);
+				m_mpWriteOutCallBack.erase("OutputCallBackEx");
 			}
-			else if (0 == task.iCallBackTimes)
+		}
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBackEx(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::SetPreRenderCallBack(G_tRenderCallBack renderCallBackFunc, void* pContext)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetPreRenderCallBack(). Not Ready. ==>";
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			m_stitcherOGL.SetPreRenderCallBack((tRenderCallBack)(renderCallBackFunc), pContext);
+		}
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetPreRenderCallBack(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::SetRenderCallBack(G_tRenderCallBack renderCallBackFunc, void* pContext)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetRenderCallBack(). Not Ready. ==>";
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+			m_stitcherOGL.SetRenderCallBack((tRenderCallBack)(renderCallBackFunc), pContext);
+		}
+
+		return true;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetRenderCallBack(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::UnProject(G_tNormalizedPixelCoordinate* pPoints, unsigned int uiPointsSize, G_tPhysicalDirection* pPhysicalDirection)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::UnProject(). Not Ready. ==>";
+			return false;
+		}
+
+		m_UnprojectContext.vfInputPoints.clear();
+		m_UnprojectContext.vfOutputPoints.clear();
+
+		for (int i = 0; i < uiPointsSize; ++i)
+		{
+			cv::Point2f point2f;
+			point2f.x = pPoints[i].fX;
+			point2f.y = pPoints[i].fY;
+
+			if (point2f.x < 0.0 || point2f.x > 1.0 || point2f.y < 0.0 || point2f.y > 1.0)
 			{
-				vIterators2Del.push_back(itt);
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::UnProject(). Error: Invalid normalized pixel coordinate value. ==>";
+				return false;
 			}
-			else if (0 > task.iCallBackTimes)
+
+			m_UnprojectContext.vfInputPoints.push_back(point2f);
+		}
+
+		m_UnprojectContext.vfOutputPoints.resize(uiPointsSize);
+		m_UnprojectContext.bNeedUnProject = true;
+		WakeUpRenderingLoop(true);
+
+		std::unique_lock<std::mutex> lk(m_UnprojectContext.mtTaskMutex);
+		m_UnprojectContext.cvTaskDone.wait(lk, [this]()
+		{
+			return (!this->m_UnprojectContext.bNeedUnProject);
+		});
+
+		//for pix with a infinit depth, return FLT_MAX.
+		for (int i = 0; i < uiPointsSize; ++i)
+		{
+			if (FLT_MAX == m_UnprojectContext.vfOutputPoints[i].x &&
+				FLT_MAX == m_UnprojectContext.vfOutputPoints[i].y &&
+				FLT_MAX == m_UnprojectContext.vfOutputPoints[i].z)
 			{
-				(*(task.pCallBackFunc))(pDownloader->Width(task.fScale), pDownloader->Height(task.fScale), pData, task.pContext);
+				pPhysicalDirection[i].fTheta = FLT_MAX;
+				pPhysicalDirection[i].fPhi = FLT_MAX;
+				return true;
 			}
 		}
 
-		vProcessedScales.push_back(it->second.fScale);
+		//convert 3D coordinate to direction.
+		//theta: start from +z.
+		//phi: start from +x, x -> y.
+		for (int i = 0; i < uiPointsSize; ++i)
+		{
+			cv::Point3f point3f;
+			point3f.x = m_UnprojectContext.vfOutputPoints[i].x;
+			point3f.y = m_UnprojectContext.vfOutputPoints[i].y;
+			point3f.z = m_UnprojectContext.vfOutputPoints[i].z;
+
+			pPhysicalDirection[i].fTheta = atan2f(sqrtf(point3f.x*point3f.x + point3f.y*point3f.y), point3f.z);
+			pPhysicalDirection[i].fPhi = atan2f(point3f.y, point3f.x);
+		}
+
+		return m_UnprojectContext.bRet;
+	}
+	catch (...)
+	{
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::UnProject(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GStitcherOGLWrapper_PanoRender::CalcViewCamera(G_tPhysicalDirection pPhysicalDirection, G_tViewCamera* pViewCamera)
+{
+	try
+	{
+		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		{
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::CalcViewCamera(). Not Ready. ==>";
+			return false;
+		}
+
+		GInteractionControllerDOF dof;
+		dof.fZoom = pViewCamera->fZoom;
+
+		bool bRet = false;
+		{
+			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
+			bRet = m_RenderParameterManager.CalcInteractionControllerDOF(pPhysicalDirection.fTheta, pPhysicalDirection.fPhi, dof);
+		}
+
+		pViewCamera->fHorizontal = dof.fHorizontal;
+		pViewCamera->fVertical = dof.fVertical;
+		pViewCamera->fZoom = dof.fZoom;
 
-		pDownloader->UnmapFrame(it->second.fScale);
+		return bRet;
 	}
-
-	for (int i = 0; i < vIterators2Del.size(); ++i)
+	catch (...)
 	{
-		m_mpWriteOutCallBack.erase(vIterators2Del[i]);
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::CalcViewCamera(). EXCEPTION. ==>";
+		return false;
 	}
 }
 
-void GStitcherOGLWrapper_PanoRender::Release()
+bool GStitcherOGLWrapper_PanoRender::GetCameraParameters(int iCameraIdx, char* sCameraMode, float* fK, float* fDistortion, float* fR, G_enCameraModelType* peCameraModelType)
 {
-	if (nullptr != m_GLContext)
+	try
 	{
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
 		{
-			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
-			m_stitcherOGL.Release();
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetCameraParameters(). Not Ready. ==>";
+			return false;
+		}
 
-			m_uploader.Release();
+		bool bRet = false;
+		if ((iCameraIdx >= 0) && (iCameraIdx < m_vCameras.size()))
+		{
+			cv::Mat mK(cv::Size(3, 3), CV_32FC1, fK);
+			cv::Mat mR(cv::Size(3, 3), CV_32FC1, fR);
 
-			m_downloaders.Release([](GFrameDownloader& downloader)
+			if (eCameraTypeNormal == m_vCameras[iCameraIdx].eCameraType)
 			{
-				downloader.Release();
-			});
-		}
-	}
+				cv::Mat mDist(cv::Size(5, 1), CV_32FC1, fDistortion);
+				m_vCameras[iCameraIdx].distorsionCoefficients.convertTo(mDist, CV_32FC1);
+				*peCameraModelType = G_eCameraModelTypeNormal2r2t1r;
+			}
+			else if (eCameraTypeFisheye == m_vCameras[iCameraIdx].eCameraType)
+			{
+				cv::Mat mDist(cv::Size(4, 1), CV_32FC1, fDistortion);
+				m_vCameras[iCameraIdx].distorsionCoefficients.convertTo(mDist, CV_32FC1);
+				*peCameraModelType = G_eCameraModelTypeFisheye4theta;
+			}
+			else if (eCameraTypeFisheyeAnglePoly5 == m_vCameras[iCameraIdx].eCameraType)
+			{
+				cv::Mat mDist(cv::Size(5, 1), CV_32FC1, fDistortion);
+				m_vCameras[iCameraIdx].distorsionCoefficients.convertTo(mDist, CV_32FC1);
+				*peCameraModelType = G_eCameraModelTypeFisheyeAnglePoly5;
+			}
 
-#ifdef WIN32
-	if (nullptr != m_HDC)
-	{
-		if (!wglMakeCurrent(m_HDC, nullptr))
-		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Unbind OpenGL context FAILED.";
-		}
-	}
+			m_vCameras[iCameraIdx].m_mpMultiK0Map[std::string(sCameraMode)].convertTo(mK, CV_32FC1);
 
-	if ((nullptr != m_HWND) && (nullptr != m_HDC))
-	{
-		if (1 != ReleaseDC((HWND)m_HWND, m_HDC))
-		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). ReleaseDC FAILED.";
+			cv::Mat mTemp;
+			m_vCameras[iCameraIdx].R.convertTo(mTemp, CV_32FC1);
+
+			cv::SVD svd;
+			svd(mTemp, cv::SVD::FULL_UV);
+			mTemp = svd.u * svd.vt;
+			if (cv::determinant(mTemp) < 0)
+			{
+				mTemp *= -1;
+			}
+			mTemp.convertTo(mR, CV_32FC1);
+
+			bRet = true;
 		}
 		else
 		{
-			m_HDC = nullptr;
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetCameraParameters(). ERROR: Invalid iCameraIdx: " << iCameraIdx << ". ==>";
+			return false;
 		}
+		return bRet;
 	}
-
-	if (nullptr != m_GLContext)
+	catch (...)
 	{
-		if (!wglDeleteContext(m_GLContext))
-		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Delete OpenGL Context FAILED.";
-		}
-		else
-		{
-			m_GLContext = nullptr;
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::Release(). OpenGL Context Deleted.";
-		}
+		m_ePanoRenderState = ePanoRenderStateError;
+		DestroyPanoRender();
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetCameraParameters(). EXCEPTION. ==>";
+		return false;
 	}
+}
 
-	m_HWND = nullptr;
-#elif __APPLE__
-#elif (defined __ANDROID__) || (defined __linux__)
-	if (m_Display != EGL_NO_DISPLAY)
+bool GStitcherOGLWrapper_PanoRender::SetFramePacing(G_enFramePacingMode eFramePacingMode, float fTargetFPS)
+{
+	try
 	{
-		if (EGL_FALSE == eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT))
+		if (GStitcherConfig::eRenderingModeOffScreen == m_Config.m_eRenderingMode)
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Unbind OpenGL context FAILED.";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetFramePacing(). Error: Off screen mode always renders as fast as the input frames allow. ==>";
+			return false;
 		}
 
-		if (m_GLContext != EGL_NO_CONTEXT)
+		enFramePacingMode eMode = eFramePacingModeFixedFPS;
+		switch (eFramePacingMode)
 		{
-			if (EGL_FALSE == eglDestroyContext(m_Display, m_GLContext))
+		case G_eFramePacingModeFixedFPS:
+			if (fTargetFPS <= 0.0f)
 			{
-				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Delete OpenGL Context FAILED.";
-			}
-			else
-			{
-				m_GLContext = EGL_NO_CONTEXT;
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetFramePacing(). Error: Target FPS should be positive. ==>";
+				return false;
 			}
-		}
-
-		if (m_Surface != EGL_NO_SURFACE)
-		{
-			if (EGL_FALSE == eglDestroySurface(m_Display, m_Surface))
+			eMode = eFramePacingModeFixedFPS;
+			break;
+		case G_eFramePacingModeInputDriven:
+			if (fTargetFPS < 0.0f)
 			{
-				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). Delete Surface FAILED.";
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetFramePacing(). Error: Minimum FPS should not be negative. ==>";
+				return false;
 			}
-			else
+			eMode = eFramePacingModeInputDriven;
+			break;
+		case G_eFramePacingModeUnthrottled:
+			eMode = eFramePacingModeUnthrottled;
+			break;
+		case G_eFramePacingModeVSync:
+			if (GStitcherConfig::eRenderingModeOnScreen != m_Config.m_eRenderingMode)
 			{
-				m_Surface = EGL_NO_SURFACE;
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetFramePacing(). Error: VSync is only available in on screen mode. ==>";
+				return false;
 			}
+			eMode = eFramePacingModeVSync;
+			break;
+		default:
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetFramePacing(). Error: Unknown pacing mode: " << eFramePacingMode << ". ==>";
+			return false;
 		}
 
-		if (EGL_FALSE == eglTerminate(m_Display))
-		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::Release(). eglTerminate() FAILED.";
-		}
-		else
 		{
-			m_Display = EGL_NO_DISPLAY;
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_eFramePacingMode = eMode;
+			m_fTargetFPS = fTargetFPS;
+			m_bFramePacingChanged = true;
 		}
-	}
+		WakeUpRenderingLoop(true);
 
-	m_HWND = nullptr;
-#endif // WIN32
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetFramePacing(). EXCEPTION. ==>";
+		return false;
+	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::GetSupportedPanoTypeList(std::vector<G_enPanoType>& vSupportedPanoTypeList)
+bool GStitcherOGLWrapper_PanoRender::GetRenderStatistics(G_tRenderStatistics& renderStatistics)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		std::lock_guard<std::mutex> lk(m_RenderStatistics.mtStatisticsMutex);
+
+		renderStatistics.fAchievedFPS = 0.0f;
+		renderStatistics.fAverageFrameTime_ms = 0.0f;
+		renderStatistics.fAverageSlack_ms = 0.0f;
+		renderStatistics.fMinSlack_ms = 0.0f;
+		renderStatistics.fAverageDrawCalls = 0.0f;
+		renderStatistics.fAverageStateChanges = 0.0f;
+		renderStatistics.fAverageSceneCPUTime_ms = 0.0f;
+		renderStatistics.ullRenderedFrames = m_RenderStatistics.ullRenderedFrames;
+		renderStatistics.ullLateFrames = m_RenderStatistics.ullLateFrames;
+
+		if (m_RenderStatistics.cbFrameStartTimes.size() >= 2)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetSupportedPanoTypeList(). Not Ready. ==>";
-			return false;
+			double dDuration_s = std::chrono::duration<double>(m_RenderStatistics.cbFrameStartTimes.back()
+				- m_RenderStatistics.cbFrameStartTimes.front()).count();
+			if (dDuration_s > 0.0)
+			{
+				renderStatistics.fAchievedFPS = static_cast<float>((m_RenderStatistics.cbFrameStartTimes.size() - 1) / dDuration_s);
+			}
 		}
 
-		vSupportedPanoTypeList.clear();
-		std::vector<enPanoType> vList = m_RenderParameterManager.GetSupportedPanoTypeList();
-		for (int i = 0; i < vList.size(); ++i)
+		if (!m_RenderStatistics.cbFrameTimes_ms.empty())
 		{
-			switch (vList[i])
+			double dSumFrameTime_ms = 0.0;
+			double dSumSlack_ms = 0.0;
+			double dMinSlack_ms = m_RenderStatistics.cbSlacks_ms.front();
+			for (int i = 0; i < m_RenderStatistics.cbFrameTimes_ms.size(); ++i)
 			{
-			case ePanoTypeImmersionSemiSphere:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionSemiSphere);
-				break;
-			case ePanoTypeUnwrappedCylinder180:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder180);
-				break;
-			case ePanoTypeUnwrappedCylinder360:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder360);
-				break;
-			case ePanoTypeImmersionCylinder360:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionCylinder360);
-				break;
-			case ePanoTypeImmersionCylinder360Inside:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionCylinder360Inside);
-				break;
-			case ePanoTypeUnwrappedCylinderSplited:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinderSplited);
-				break;
-			case ePanoTypeUnwrappedCylinderSplitedFrontBack:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinderSplitedFrontBack);
-				break;
-			case ePanoTypeUnwrappedSphere180:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedSphere180);
-				break;
-			case ePanoTypeUnwrappedSphere360:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedSphere360);
-				break;
-			case ePanoTypeUnwrappedSphere360Flip:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedSphere360Flip);
-				break;
-			case ePanoTypeUnwrappedCylinder180Flip:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder180Flip);
-				break;
-			case ePanoTypeUnwrappedCylinder360Flip:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedCylinder360Flip);
-				break;
-			case ePanoTypeImmersionFullSphere:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionFullSphere);
-				break;
-			case ePanoTypeUnwrappedFullSphere360:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedFullSphere360);
-				break;
-			case ePanoTypeUnwrappedFullSphere360Flip:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedFullSphere360Flip);
-				break;
-			case ePanoTypeUnwrappedFullSphere360Binocular:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeUnwrappedFullSphere360Binocular);
-				break;
-			case ePanoTypeImmersionFullSphereInside:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeImmersionFullSphereInside);
-				break;
-			case ePanoTypeOriginal:
-				vSupportedPanoTypeList.push_back(G_ePanoTypeOriginal);
-				break;
-			default:
-				//todo.
-				break;
+				dSumFrameTime_ms += m_RenderStatistics.cbFrameTimes_ms[i];
+				dSumSlack_ms += m_RenderStatistics.cbSlacks_ms[i];
+				dMinSlack_ms = std::min(dMinSlack_ms, m_RenderStatistics.cbSlacks_ms[i]);
 			}
+
+			renderStatistics.fAverageFrameTime_ms = static_cast<float>(dSumFrameTime_ms / m_RenderStatistics.cbFrameTimes_ms.size());
+			renderStatistics.fAverageSlack_ms = static_cast<float>(dSumSlack_ms / m_RenderStatistics.cbSlacks_ms.size());
+			renderStatistics.fMinSlack_ms = static_cast<float>(dMinSlack_ms);
+		}
+
+		if (!m_RenderStatistics.cbDrawCalls.empty())
+		{
+			double dSumDrawCalls = 0.0;
+			double dSumStateChanges = 0.0;
+			double dSumSceneCPUTime_ms = 0.0;
+			for (int i = 0; i < m_RenderStatistics.cbDrawCalls.size(); ++i)
+			{
+				dSumDrawCalls += m_RenderStatistics.cbDrawCalls[i];
+				dSumStateChanges += m_RenderStatistics.cbStateChanges[i];
+				dSumSceneCPUTime_ms += m_RenderStatistics.cbSceneCPUTimes_ms[i];
+			}
+
+			renderStatistics.fAverageDrawCalls = static_cast<float>(dSumDrawCalls / m_RenderStatistics.cbDrawCalls.size());
+			renderStatistics.fAverageStateChanges = static_cast<float>(dSumStateChanges / m_RenderStatistics.cbStateChanges.size());
+			renderStatistics.fAverageSceneCPUTime_ms = static_cast<float>(dSumSceneCPUTime_ms / m_RenderStatistics.cbSceneCPUTimes_ms.size());
 		}
 
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetSupportedPanoTypeList(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetRenderStatistics(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::GetViewCamera(G_tViewCamera& viewCamera)
+bool GStitcherOGLWrapper_PanoRender::EnableQualityController(const G_tQualityControllerConfig* pConfig, G_tQualityCallBack qualityCallBackFunc, void* pContext)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		if (nullptr != pConfig)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetViewCamera(). Not Ready. ==>";
-			return false;
+			if (pConfig->fTargetFrameTime_ms <= 0.0f)
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::EnableQualityController(). Error: Target frame time should be positive. ==>";
+				return false;
+			}
+
+			if ((pConfig->fMinResolutionScale <= 0.0f) || (pConfig->fMinResolutionScale > 1.0f) ||
+				(pConfig->fMinOutputScale <= 0.0f) || (pConfig->fMinOutputScale > 1.0f))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::EnableQualityController(). Error: Minimum scales should be in (0.0, 1.0]. ==>";
+				return false;
+			}
 		}
 
-		GInteractionControllerDOF dof;
 		{
-			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
-			dof = m_RenderParameterManager.ReadInteractionControllerDOF();
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_bQualityControllerEnabled = (nullptr != pConfig);
+			m_QualityControllerConfig = (nullptr != pConfig) ? *pConfig : G_tQualityControllerConfig();
+			m_pQualityCallBack = qualityCallBackFunc;
+			m_pQualityCallBackContext = pContext;
+			m_bQualityControllerChanged = true;
 		}
+		WakeUpRenderingLoop(true);
 
-		viewCamera.fHorizontal = dof.fHorizontal;
-		viewCamera.fVertical = dof.fVertical;
-		viewCamera.fZoom = dof.fZoom;
-
-		//GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::GetViewCamera(). Pan: " << viewCamera.fPan
-		//	<< ", Tilt: " << viewCamera.fTilt << ", Zoom: " << viewCamera.fZoom;
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::EnableQualityController(). EXCEPTION. ==>";
+		return false;
+	}
+}
 
+bool GStitcherOGLWrapper_PanoRender::GetQualityState(G_tQualityState& qualityState)
+{
+	try
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		qualityState = m_QualityState;
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetViewCamera(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetQualityState(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::GetOriginalPanoSize(unsigned int& uiWidth, unsigned int& uiHeight)
+bool GStitcherOGLWrapper_PanoRender::SetTessellationTolerance(G_enPanoType ePanoType, float fTolerance_px)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		if (!(0.0f <= fTolerance_px))
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetOriginalPanoSize(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetTessellationTolerance(). Error: Tolerance should not be negative. ==>";
 			return false;
 		}
 
-		cv::Size panoSize;
+		//the scenes are rebuilt before the next frame, see GetTasks() and UpdateViews().
 		{
-			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
-			panoSize = cv::Size(m_iPanoOriginalWidth, m_iPanoOriginalHeight);
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_mpTessellationTolerances[ToPanoType(ePanoType)] = fTolerance_px;
+			m_bWarmUpChanged = true;
 		}
+		WakeUpRenderingLoop(true);
 
-		int iWidth4n = (0 != (panoSize.width % 4)) ? (panoSize.width / 4) * 4 + 4 : (panoSize.width / 4) * 4;
-
-		uiWidth = static_cast<unsigned int>(iWidth4n);
-		uiHeight = static_cast<unsigned int>(panoSize.height);
-
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetTessellationTolerance(). Pano type: " << ePanoType << ", Tolerance: " << fTolerance_px << " px. ==>";
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetOriginalPanoSize(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetTessellationTolerance(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::SetViewCamera(G_tViewCamera viewCamera)
+float GStitcherOGLWrapper_PanoRender::CalcTessellationTolerance(enPanoType ePanoType, const cv::Size& szOutput)
+{
+	float fTolerance_px = 0.0f;
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		auto it = m_mpTessellationTolerances.find(ePanoType);
+		if (it == m_mpTessellationTolerances.end())
+		{
+			return 0.0f;
+		}
+		fTolerance_px = it->second;
+	}
+
+	//an output pixel covers the input pixels of all cameras spread over the output.
+	cv::Size szInputFrameSize = m_RenderParameterManager.GetInputFrameSize();
+	double dOutputPixels = (double)szOutput.width * szOutput.height;
+	double dInputPixels = (double)szInputFrameSize.width * szInputFrameSize.height * m_vCameras.size();
+	if ((dOutputPixels <= 0.0) || (dInputPixels <= 0.0))
+	{
+		return fTolerance_px;
+	}
+	return static_cast<float>(fTolerance_px * sqrt(dInputPixels / dOutputPixels));
+}
+
+bool GStitcherOGLWrapper_PanoRender::SetRenderPath(G_enPanoType ePanoType, G_enRenderPath eRenderPath)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		if ((G_eRenderPathMesh != eRenderPath) && (G_eRenderPathRemapLUT != eRenderPath))
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetViewCamera(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetRenderPath(). Error: Invalid render path " << eRenderPath << ". ==>";
 			return false;
 		}
 
-		//G_tViewCamera viewCameraOld;
-		//GetViewCamera(viewCameraOld);
-		//GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::SetViewCamera(). Pan: " << viewCameraOld.fHorizontal
-		//	<< ", Tilt: " << viewCameraOld.fVertical << ", Zoom: " << viewCameraOld.fZoom
-		//	<< " ---> Pan: " << viewCamera.fHorizontal
-		//	<< ", Tilt: " << viewCamera.fVertical << ", Zoom: " << viewCamera.fZoom;
-
-		GInteractionControllerDOF dof;
-		dof.fHorizontal = viewCamera.fHorizontal;
-		dof.fVertical = viewCamera.fVertical;
-		dof.fZoom = viewCamera.fZoom;
+		//the remap tables cover the plane surfaces, the ones of the unwrapped pano types seen through an orthogonal camera.
+		enPanoType eSetPanoType = ToPanoType(ePanoType);
+		if ((G_eRenderPathRemapLUT == eRenderPath) && (eViewCameraTypeOrthogonal != GPanoTypeStaticParameters::GetDefaultViewCameraType(eSetPanoType)))
+		{
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetRenderPath(). Error: Pano type " << ePanoType << " can not be drawn from remap tables. ==>";
+			return false;
+		}
 
+		//the scenes are rebuilt before the next frame, see GetTasks() and UpdateViews().
 		{
-			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
-			m_RenderParameterManager.SetInteractionControllerDOF(dof);
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_mpRenderPaths[eSetPanoType] = eRenderPath;
+			m_bWarmUpChanged = true;
 		}
+		WakeUpRenderingLoop(true);
 
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetRenderPath(). Pano type: " << ePanoType << ", Render path: " << eRenderPath << ". ==>";
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetViewCamera(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetRenderPath(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::SetDrawingRegion(unsigned int uiX0, unsigned int uiY0, unsigned int uiWidth, unsigned int uiHeight)
+cv::Size GStitcherOGLWrapper_PanoRender::CalcRemapTableSize(enPanoType ePanoType, const cv::Size& szOutput)
 {
-	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		auto it = m_mpRenderPaths.find(ePanoType);
+		if ((it == m_mpRenderPaths.end()) || (G_eRenderPathRemapLUT != it->second))
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetDrawingRegion(). Not Ready. ==>";
-			return false;
+			return cv::Size(0, 0);
 		}
+	}
 
-		GLOGGER(info) << "==> GStitcherOGLWrapper_PanoRender::SetDrawingRegion(). X0: " << uiX0
-			<< "; Y0: " << uiY0 << "; Width: " << uiWidth << "; Height: " << uiHeight;
+	//one entry per output pixel, the output size is not known before the first frame.
+	if ((szOutput.width <= 0) || (szOutput.height <= 0))
+	{
+		return cv::Size(0, 0);
+	}
+	return szOutput;
+}
 
+bool GStitcherOGLWrapper_PanoRender::SetSceneCacheDirectory(const char* sDirectory)
+{
+	try
+	{
+		std::string sSceneCacheDirectory = (nullptr == sDirectory) ? "" : sDirectory;
 		{
-			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
-			m_RenderParameterManager.SetDrawRegion(static_cast<int>(uiX0), static_cast<int>(uiY0)
-				, static_cast<int>(uiWidth), static_cast<int>(uiHeight));
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_sSceneCacheDirectory = sSceneCacheDirectory;
+			m_bWarmUpChanged = true;
 		}
 
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetSceneCacheDirectory(). Directory: " << sSceneCacheDirectory << ". ==>";
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetDrawingRegion(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetSceneCacheDirectory(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::InputFrame(int iCameraIdx, unsigned int uiWidth, unsigned int uiHeight, void* pData[3], unsigned int uiStep_Byte[3])
+bool GStitcherOGLWrapper_PanoRender::ClearSceneCache()
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateInited)
+		std::string sSceneCacheDirectory = GetSceneCacheDirectory();
+		if (sSceneCacheDirectory.empty())
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InputFrame(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::ClearSceneCache(). Error: No scene cache directory. ==>";
 			return false;
 		}
 
-		if ((iCameraIdx >= m_vPtrFrameQueues.size()) ||
-			(iCameraIdx < 0))
-		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InputFrame(). Wrong CameraIdx or Camera not supported in this profile: " << iCameraIdx << "  ==>";
-			return false;
-		}
+		return GSceneCache::Clear(sSceneCacheDirectory);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::ClearSceneCache(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+std::string GStitcherOGLWrapper_PanoRender::GetSceneCacheDirectory()
+{
+	std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+	return m_sSceneCacheDirectory;
+}
 
+bool GStitcherOGLWrapper_PanoRender::SetProgramBinaryCacheDirectory(const char* sDirectory)
+{
+	try
+	{
+		std::string sProgramBinaryCacheDirectory = (nullptr == sDirectory) ? "" : sDirectory;
 		{
-			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
-			m_RenderParameterManager.SetInputFrameSize(static_cast<int>(uiWidth), static_cast<int>(uiHeight));
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_sProgramBinaryCacheDirectory = sProgramBinaryCacheDirectory;
 		}
 
-		GFrameType frameType;
-		frameType.eFrameFormat = m_Config.m_eInputFrameFormat;
-		frameType.iWidth = static_cast<int>(uiWidth);
-		frameType.iHeight = static_cast<int>(uiHeight);
-		frameType.step_Byte[0] = static_cast<int>(uiStep_Byte[0]);
-		frameType.step_Byte[1] = static_cast<int>(uiStep_Byte[1]);
-		frameType.step_Byte[2] = static_cast<int>(uiStep_Byte[2]);
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetProgramBinaryCacheDirectory(). Directory: " << sProgramBinaryCacheDirectory << ". ==>";
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetProgramBinaryCacheDirectory(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+std::string GStitcherOGLWrapper_PanoRender::GetProgramBinaryCacheDirectory()
+{
+	std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+	return m_sProgramBinaryCacheDirectory;
+}
 
-		if (!m_vPtrFrameQueues[iCameraIdx]->CreateFrame(frameType))
+bool GStitcherOGLWrapper_PanoRender::WarmUpPanoTypes(const G_enPanoType* pPanoTypes, unsigned int uiPanoTypeNum)
+{
+	try
+	{
+		if ((nullptr == pPanoTypes) && (0 != uiPanoTypeNum))
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::InputFrame(). CreateFrame failed.";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::WarmUpPanoTypes(). Error: Invalid pano types. ==>";
 			return false;
 		}
 
-		unsigned char* pBuffer = (unsigned char*)(m_vPtrFrameQueues[iCameraIdx]->InMapFrame());
-
-		if (eFrameFormatRGB == m_Config.m_eInputFrameFormat ||
-			eFrameFormatBGR == m_Config.m_eInputFrameFormat)
-		{
-			unsigned int uiWidth_Byte = uiWidth * 3;
-			for (int iLine = 0; iLine < uiHeight; ++iLine)
-			{
-				unsigned char* pSrc = (unsigned char*)(pData[0]) + iLine * uiStep_Byte[0];
-				unsigned char* pDst = pBuffer + iLine * uiWidth_Byte;
-				std::copy(pSrc, pSrc + uiWidth_Byte, pDst);
-			}
-		}
-		else if (eFrameFormatYUV420P == m_Config.m_eInputFrameFormat ||
-			eFrameFormatYV12 == m_Config.m_eInputFrameFormat)
+		std::vector<enPanoType> vPanoTypes;
+		for (unsigned int i = 0; i < uiPanoTypeNum; ++i)
 		{
-			//cv::namedWindow("t", CV_WINDOW_KEEPRATIO);
-			////cv::Mat mTemp(cv::Size(frameType.iWidth, frameType.iHeight), CV_8UC1, pSrcBuffer);
-			//cv::Mat mTemp(cv::Size(uiWidth / 2, uiHeight / 2), CV_8UC1, pData[1]);
-			////cv::Mat mTemp(cv::Size(uiWidth / 2, uiHeight / 2), CV_8UC1, pBuffer + (frameType.iWidth*frameType.iHeight * 5) / 4);
-			//cv::imshow("t", mTemp);
-			//cv::waitKey(0);
-
-			unsigned char* pDataY = (unsigned char*)(pData[0]);
-			unsigned char* pDataU = (unsigned char*)(pData[1]);
-			unsigned char* pDataV = (unsigned char*)(pData[2]);
-
-			for (int iLineY = 0; iLineY < uiHeight; ++iLineY)
-			{
-				unsigned char* pSrc = pDataY + iLineY * uiStep_Byte[0];
-				unsigned char* pDst = pBuffer + iLineY * uiWidth;
-				std::copy(pSrc, pSrc + uiWidth, pDst);
-			}
-
-			unsigned int uiHalfWidth = uiWidth / 2;
-
-			unsigned char* pUStart = pBuffer + uiWidth * uiHeight;
-			for (int iLineU = 0; iLineU < uiHeight / 2; ++iLineU)
+			enPanoType ePanoType = ToPanoType(pPanoTypes[i]);
+			if (!m_RenderParameterManager.IsPanoTypeSupported(ePanoType))
 			{
-				unsigned char* pSrc = pDataU + iLineU * uiStep_Byte[1];
-				std::copy(pSrc, pSrc + uiHalfWidth, pUStart + iLineU * uiHalfWidth);
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::WarmUpPanoTypes(). Error: Pano type " << pPanoTypes[i] << " NOT SUPPORTED. ==>";
+				return false;
 			}
 
-			unsigned char* pVStart = pBuffer + (uiWidth * uiHeight * 5) / 4;
-			for (int iLineV = 0; iLineV < uiHeight / 2; ++iLineV)
+			if (vPanoTypes.end() == std::find(vPanoTypes.begin(), vPanoTypes.end(), ePanoType))
 			{
-				unsigned char* pSrc = pDataV + iLineV * uiStep_Byte[2];
-				std::copy(pSrc, pSrc + uiHalfWidth, pVStart + iLineV * uiHalfWidth);
+				vPanoTypes.push_back(ePanoType);
 			}
-
-			//std::copy(pDataU, pDataU + (uiWidth * uiHeight) / 4, pBuffer + uiWidth * uiHeight);
-			//std::copy(pDataV, pDataV + (uiWidth * uiHeight) / 4, pBuffer + (uiWidth * uiHeight * 5) / 4);
-
-
-			//cv::Mat mTemp(cv::Size(frameType.iWidth, frameType.iHeight), CV_8UC1, pSrcBuffer);
-			//cv::Mat mTemp(cv::Size(uiWidth / 2, uiHeight / 2), CV_8UC1, pBuffer + frameType.iWidth*frameType.iHeight);
-			//cv::Mat mTemp(cv::Size(uiWidth / 2, uiHeight / 2), CV_8UC1, pBuffer + (frameType.iWidth*frameType.iHeight * 5) / 4);
-			//cv::imshow("t", mTemp);
-			//cv::waitKey(0);
 		}
-		else if (eFrameFormatNV12 == m_Config.m_eInputFrameFormat)
-		{
-			unsigned char* pDataY = (unsigned char*)(pData[0]);
-			unsigned char* pDataUV = (unsigned char*)(pData[1]);
-
-			for (int iLineY = 0; iLineY < uiHeight; ++iLineY)
-			{
-				unsigned char* pSrc = pDataY + iLineY * uiStep_Byte[0];
-				unsigned char* pDst = pBuffer + iLineY * uiWidth;
-				std::copy(pSrc, pSrc + uiWidth, pDst);
-			}
 
-			unsigned char* pUVStart = pBuffer + uiWidth * uiHeight;
-			for (int iLineUV = 0; iLineUV < uiHeight / 2; ++iLineUV)
-			{
-				unsigned char* pSrc = pDataUV + iLineUV * uiStep_Byte[1];
-				std::copy(pSrc, pSrc + uiWidth, pUVStart + iLineUV * uiWidth);
-			}
+		{
+			std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+			m_vWarmUpPanoTypes = vPanoTypes;
+			m_bWarmUpChanged = true;
 		}
+		WakeUpRenderingLoop();
 
-		m_vPtrFrameQueues[iCameraIdx]->CompleteFrame();
-
-		m_bDataArrived = true;
-
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::WarmUpPanoTypes(). Pano type num: " << vPanoTypes.size() << ". ==>";
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::InputFrame(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::WarmUpPanoTypes(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::GetCurrentPanoType(int* pCurrentPanoType) const
+bool GStitcherOGLWrapper_PanoRender::GetWarmUpState(G_tWarmUpState& warmUpState)
 {
-	if (m_ePanoRenderState < ePanoRenderStateCreated)
+	try
 	{
-		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetCurrentPanoType(). Not Ready.";
-		return false;
+		//thread safe by itself, m_mtStitcherOGLMutex would wait for the frame.
+		GSceneWarmer::tState state = m_stitcherOGL.GetWarmUpState();
+		warmUpState.uiRequested = static_cast<unsigned int>(state.iRequested);
+		warmUpState.uiBuilt = static_cast<unsigned int>(state.iBuilt);
+		warmUpState.uiReady = static_cast<unsigned int>(state.iReady);
+		warmUpState.uiFailed = static_cast<unsigned int>(state.iFailed);
+		return true;
 	}
-
-	switch (m_RenderParameterManager.GetPanoType())
+	catch (...)
 	{
-	case ePanoTypeImmersionSemiSphere:
-		(*pCurrentPanoType) = G_ePanoTypeImmersionSemiSphere;
-		break;
-	case ePanoTypeUnwrappedCylinder180:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder180;
-		break;
-	case ePanoTypeUnwrappedCylinder360:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder360;
-		break;
-	case ePanoTypeImmersionCylinder360:
-		(*pCurrentPanoType) = G_ePanoTypeImmersionCylinder360;
-		break;
-	case ePanoTypeImmersionCylinder360Inside:
-		(*pCurrentPanoType) = G_ePanoTypeImmersionCylinder360Inside;
-		break;
-	case ePanoTypeUnwrappedCylinderSplited:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinderSplited;
-		break;
-	case ePanoTypeUnwrappedCylinderSplitedFrontBack:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinderSplitedFrontBack;
-		break;
-	case ePanoTypeUnwrappedSphere180:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedSphere180;
-		break;
-	case ePanoTypeUnwrappedSphere360:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedSphere360;
-		break;
-	case ePanoTypeUnwrappedSphere360Flip:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedSphere360Flip;
-		break;
-	case ePanoTypeUnwrappedCylinder180Flip:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder180Flip;
-		break;
-	case ePanoTypeUnwrappedCylinder360Flip:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedCylinder360Flip;
-		break;
-	case ePanoTypeImmersionFullSphere:
-		(*pCurrentPanoType) = G_ePanoTypeImmersionFullSphere;
-		break;
-	case ePanoTypeUnwrappedFullSphere360:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedFullSphere360;
-		break;
-	case ePanoTypeUnwrappedFullSphere360Flip:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedFullSphere360Flip;
-		break;
-	case ePanoTypeUnwrappedFullSphere360Binocular:
-		(*pCurrentPanoType) = G_ePanoTypeUnwrappedFullSphere360Binocular;
-		break;
-	case ePanoTypeImmersionFullSphereInside:
-		(*pCurrentPanoType) = G_ePanoTypeImmersionFullSphereInside;
-		break;
-	case ePanoTypeOriginal:
-		(*pCurrentPanoType) = G_ePanoTypeOriginal;
-		break;
-	default:
-		//todo.
-		break;
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetWarmUpState(). EXCEPTION. ==>";
+		return false;
 	}
-
-	return true;
 }
 
-bool GStitcherOGLWrapper_PanoRender::SwitchPanoType(G_enPanoType eNewPanoType)
+bool GStitcherOGLWrapper_PanoRender::SetSceneMemoryBudget(unsigned long long ullBudget_Byte)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
-		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SwitchPanoType(). Not Ready. ==>";
-			return false;
-		}
+		//thread safe by itself, applied by the rendering thread with the next frame.
+		m_stitcherOGL.SetSceneMemoryBudget(static_cast<size_t>(ullBudget_Byte));
 
-		enPanoType eCurrentPanoType = ePanoTypeImmersionSemiSphere;
-		switch (eNewPanoType)
-		{
-		case G_ePanoTypeImmersionSemiSphere:
-			eCurrentPanoType = ePanoTypeImmersionSemiSphere;
-			break;
-		case G_ePanoTypeUnwrappedCylinder180:
-			eCurrentPanoType = ePanoTypeUnwrappedCylinder180;
-			break;
-		case G_ePanoTypeUnwrappedCylinder360:
-			eCurrentPanoType = ePanoTypeUnwrappedCylinder360;
-			break;
-		case G_ePanoTypeImmersionCylinder360:
-			eCurrentPanoType = ePanoTypeImmersionCylinder360;
-			break;
-		case G_ePanoTypeImmersionCylinder360Inside:
-			eCurrentPanoType = ePanoTypeImmersionCylinder360Inside;
-			break;
-		case G_ePanoTypeUnwrappedCylinderSplited:
-			eCurrentPanoType = ePanoTypeUnwrappedCylinderSplited;
-			break;
-		case G_ePanoTypeUnwrappedCylinderSplitedFrontBack:
-			eCurrentPanoType = ePanoTypeUnwrappedCylinderSplitedFrontBack;
-			break;
-		case G_ePanoTypeUnwrappedSphere180:
-			eCurrentPanoType = ePanoTypeUnwrappedSphere180;
-			break;
-		case  G_ePanoTypeUnwrappedSphere360:
-			eCurrentPanoType = ePanoTypeUnwrappedSphere360;
-			break;
-		case  G_ePanoTypeUnwrappedSphere360Flip:
-			eCurrentPanoType = ePanoTypeUnwrappedSphere360Flip;
-			break;
-		case  G_ePanoTypeUnwrappedCylinder180Flip:
-			eCurrentPanoType = ePanoTypeUnwrappedCylinder180Flip;
-			break;
-		case  G_ePanoTypeUnwrappedCylinder360Flip:
-			eCurrentPanoType = ePanoTypeUnwrappedCylinder360Flip;
-			break;
-		case G_ePanoTypeImmersionFullSphere:
-			eCurrentPanoType = ePanoTypeImmersionFullSphere;
-			break;
-		case G_ePanoTypeUnwrappedFullSphere360:
-			eCurrentPanoType = ePanoTypeUnwrappedFullSphere360;
-			break;
-		case G_ePanoTypeUnwrappedFullSphere360Flip:
-			eCurrentPanoType = ePanoTypeUnwrappedFullSphere360Flip;
-			break;
-		case G_ePanoTypeUnwrappedFullSphere360Binocular:
-			eCurrentPanoType = ePanoTypeUnwrappedFullSphere360Binocular;
-			break;
-		case G_ePanoTypeImmersionFullSphereInside:
-			eCurrentPanoType = ePanoTypeImmersionFullSphereInside;
-			break;
-		case G_ePanoTypeOriginal:
-			eCurrentPanoType = ePanoTypeOriginal;
-			break;
-		default:
-			//todo.
-			break;
-		}
+		GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetSceneMemoryBudget(). Budget: " << ullBudget_Byte / 1024 << " KB. ==>";
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetSceneMemoryBudget(). EXCEPTION. ==>";
+		return false;
+	}
+}
 
-		{
-			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
-			m_RenderParameterManager.SetPanoType(eCurrentPanoType);
-		}
+bool GStitcherOGLWrapper_PanoRender::GetSceneMemoryState(G_tSceneMemoryState& sceneMemoryState)
+{
+	try
+	{
+		//thread safe by itself, m_mtStitcherOGLMutex would wait for the frame.
+		GStitcherOGL::tSceneMemoryState state = m_stitcherOGL.GetSceneMemoryState();
+		sceneMemoryState.ullInUse_Byte = state.ullInUse_Byte;
+		sceneMemoryState.uiInUseScenes = static_cast<unsigned int>(state.iInUseScenes);
+		sceneMemoryState.ullCached_Byte = state.ullCached_Byte;
+		sceneMemoryState.uiCachedScenes = static_cast<unsigned int>(state.iCachedScenes);
+		sceneMemoryState.ullBudget_Byte = state.ullBudget_Byte;
+		sceneMemoryState.ullEvictedScenes = state.ullEvictedScenes;
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetSceneMemoryState(). EXCEPTION. ==>";
+		return false;
+	}
+}
 
+bool GStitcherOGLWrapper_PanoRender::GetProgramCacheStatistics(G_tProgramCacheStatistics& programCacheStatistics)
+{
+	try
+	{
+		//thread safe by itself, m_mtStitcherOGLMutex would wait for the frame.
+		GGLSLProgramCache::tStatistics statistics = m_stitcherOGL.GetProgramCacheStatistics();
+		programCacheStatistics.uiPrograms = static_cast<unsigned int>(statistics.iPrograms);
+		programCacheStatistics.ullHits = statistics.ullHits;
+		programCacheStatistics.ullMisses = statistics.ullMisses;
+		programCacheStatistics.fCompileTime_ms = static_cast<float>(statistics.dCompileTime_ms);
+		programCacheStatistics.ullBinaryLoads = statistics.ullBinaryLoads;
+		programCacheStatistics.uiPending = static_cast<unsigned int>(statistics.iPending);
+		programCacheStatistics.ullBackgroundLinks = statistics.ullBackgroundLinks;
+		programCacheStatistics.fAverageLinkLatency_ms = (0 < statistics.ullBackgroundLinks) ?
+			static_cast<float>(statistics.dLinkLatency_ms / statistics.ullBackgroundLinks) : 0.0f;
+		programCacheStatistics.fMaxLinkLatency_ms = static_cast<float>(statistics.dMaxLinkLatency_ms);
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SwitchPanoType(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetProgramCacheStatistics(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::GrabPano(unsigned int* puiWidth, unsigned int* puiHeight, unsigned char* pRGBData)
+void GStitcherOGLWrapper_PanoRender::WarmUpScenes()
+{
+	std::vector<enPanoType> vPanoTypes;
+	{
+		std::lock_guard<std::mutex> lk(m_mtWakeUpMutex);
+		vPanoTypes = m_vWarmUpPanoTypes;
+		m_bWarmUpChanged = false;
+	}
+
+	//the scenes are built for the draw region of the default scene, as CreateScene does.
+	cv::Size szOriginalPanoSize = m_RenderParameterManager.ReadOriginalPanoSize();
+	cv::Size szInputFrameSize = m_RenderParameterManager.GetInputFrameSize();
+	std::vector<GStitcherOGL::tWarmUpRequest> vRequests;
+	for (auto ePanoType : vPanoTypes)
+	{
+		GStitcherOGL::tWarmUpRequest request;
+		request.ePanoType = ePanoType;
+		request.sK0Name = m_RenderParameterManager.GetK0Name();
+		request.v4fCropRatios = m_RenderParameterManager.GetCropRatios(ePanoType);
+		request.fTessellationTolerance_px = CalcTessellationTolerance(ePanoType, szOriginalPanoSize);
+		request.iInputFrameWidth = szInputFrameSize.width;
+		request.iInputFrameHeight = szInputFrameSize.height;
+		cv::Size szRemapTable = CalcRemapTableSize(ePanoType, szOriginalPanoSize);
+		request.iRemapTableWidth = szRemapTable.width;
+		request.iRemapTableHeight = szRemapTable.height;
+		vRequests.push_back(request);
+	}
+	std::string sSceneCacheDirectory = GetSceneCacheDirectory();
+	std::string sProgramBinaryCacheDirectory = GetProgramBinaryCacheDirectory();
+
+	std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
+	m_stitcherOGL.SetTessellationLevel(m_QualityLevel.iTessellationLevel);
+	m_stitcherOGL.SetSceneCacheDirectory(sSceneCacheDirectory);
+	m_stitcherOGL.SetProgramBinaryCacheDirectory(sProgramBinaryCacheDirectory);
+	m_stitcherOGL.WarmUpScenes(vRequests);
+}
+
+bool GStitcherOGLWrapper_PanoRender::AddView(const std::string& sViewName, G_enPanoType ePanoType, unsigned int uiWidth, unsigned int uiHeight)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		if (m_ePanoRenderState < ePanoRenderStateCreated)
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GrabPano(). Not Ready. ==>";
+			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::AddView(). Not Ready. ==>";
 			return false;
 		}
 
-		GGrabCallBackContext grabContext;
-		grabContext.uiWidth = *puiWidth;
-		grabContext.uiHeight = *puiHeight;
-		grabContext.pContext = pRGBData;
-
+		if (sViewName.empty() || (0 == uiWidth) || (0 == uiHeight))
 		{
-			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
-
-			GWriteOutCallBack callBack;
-			callBack.pCallBackFunc = GrabCallBack;
-			callBack.iCallBackTimes = 1;
-			callBack.fScale = 1.0f;
-			callBack.pContext = &grabContext;
-			m_mpWriteOutCallBack["GrabPano"] = callBack;
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::AddView(). Error: Invalid view name or size. ==>";
+			return false;
 		}
 
-		std::unique_lock<std::mutex> lk(grabContext.mtTaskMutex);
-		grabContext.cvTaskDone.wait(lk, [&grabContext]()
-		{
-			return grabContext.bTaskDone;
-		});
-
-		if (nullptr == grabContext.pContext)
+		enPanoType eViewPanoType = ToPanoType(ePanoType);
+		if (!m_RenderParameterManager.IsPanoTypeSupported(eViewPanoType))
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GrabPano(). No enough storage space. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::AddView(). Error: Pano type NOT SUPPORTED. ==>";
 			return false;
 		}
 
-		*puiWidth = grabContext.uiWidth;
-		*puiHeight = grabContext.uiHeight;
+		std::shared_ptr<tView> ptrView = std::make_shared<tView>();
+		ptrView->sSceneName = "view/" + sViewName;
+		ptrView->iOutputWidth = static_cast<int>(uiWidth);
+		ptrView->iOutputHeight = static_cast<int>(uiHeight);
+		ptrView->RenderParameterManager.Init(m_vPanoTypeList, static_cast<int>(m_vCameras.size()));
+		ptrView->RenderParameterManager.SetPanoType(eViewPanoType);
+		ptrView->RenderParameterManager.SetDrawRegion(0, 0, static_cast<int>(uiWidth), static_cast<int>(uiHeight));
+
+		{
+			std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+			if (m_mpViews.end() != m_mpViews.find(sViewName))
+			{
+				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::AddView(). Error: View " << sViewName << " already exists. ==>";
+				return false;
+			}
+
+			m_mpViews[sViewName] = ptrView;
+		}
 
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GrabPano(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::AddView(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::SetOutputCallBack(G_tOutputCallBack outputCallBackFunc, float fScale, void* pContext)
+bool GStitcherOGLWrapper_PanoRender::RemoveView(const std::string& sViewName)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		std::lock_guard<std::mutex> lk(m_mtViewsMutex);
+
+		auto itView = m_mpViews.find(sViewName);
+		if (m_mpViews.end() == itView)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBack(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RemoveView(). Error: View " << sViewName << " NOT FOUND. ==>";
 			return false;
 		}
 
-		{
-			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
-
-			if (nullptr != outputCallBackFunc)
-			{
-				GWriteOutCallBack callBack;
-				callBack.pCallBackFunc = outputCallBackFunc;
-				callBack.iCallBackTimes = -1;
-				callBack.fScale = fScale;
-				callBack.pContext = pContext;
-				m_mpWriteOutCallBack["OutputCallBack"] = callBack;
-			}
-			else
-			{
-				m_mpWriteOutCallBack.erase("OutputCallBack");
-			}
-
-			return true;
-
-		}
+		//its OpenGL resources are released by the rendering thread.
+		m_vRemovedViews.push_back(itView->second);
+		m_mpViews.erase(itView);
 
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBack(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::RemoveView(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::SetPreRenderCallBack(G_tRenderCallBack renderCallBackFunc, void* pContext)
+bool GStitcherOGLWrapper_PanoRender::GetViewCameraOfView(const std::string& sViewName, G_tViewCamera& viewCamera)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		std::shared_ptr<tView> ptrView = FindView(sViewName);
+		if (nullptr == ptrView)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetPreRenderCallBack(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetViewCameraOfView(). Error: View " << sViewName << " NOT FOUND. ==>";
 			return false;
 		}
 
+		GInteractionControllerDOF dof;
 		{
-			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
-			m_stitcherOGL.SetPreRenderCallBack((tRenderCallBack)(renderCallBackFunc), pContext);
+			std::lock_guard<std::mutex> lockGuard(ptrView->RenderParameterManager.m_mtManagerMutex);
+			dof = ptrView->RenderParameterManager.ReadInteractionControllerDOF();
 		}
 
+		viewCamera.fHorizontal = dof.fHorizontal;
+		viewCamera.fVertical = dof.fVertical;
+		viewCamera.fZoom = dof.fZoom;
+
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetPreRenderCallBack(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetViewCameraOfView(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::SetRenderCallBack(G_tRenderCallBack renderCallBackFunc, void* pContext)
+bool GStitcherOGLWrapper_PanoRender::SetViewCameraOfView(const std::string& sViewName, G_tViewCamera viewCamera)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		std::shared_ptr<tView> ptrView = FindView(sViewName);
+		if (nullptr == ptrView)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::SetRenderCallBack(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetViewCameraOfView(). Error: View " << sViewName << " NOT FOUND. ==>";
 			return false;
 		}
 
+		GInteractionControllerDOF dof;
+		dof.fHorizontal = viewCamera.fHorizontal;
+		dof.fVertical = viewCamera.fVertical;
+		dof.fZoom = viewCamera.fZoom;
+
 		{
-			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
-			m_stitcherOGL.SetRenderCallBack((tRenderCallBack)(renderCallBackFunc), pContext);
+			std::lock_guard<std::mutex> lockGuard(ptrView->RenderParameterManager.m_mtManagerMutex);
+			ptrView->RenderParameterManager.SetInteractionControllerDOF(dof);
 		}
+		WakeUpRenderingLoop();
 
 		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetRenderCallBack(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetViewCameraOfView(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::UnProject(G_tNormalizedPixelCoordinate* pPoints, unsigned int uiPointsSize, G_tPhysicalDirection* pPhysicalDirection)
+bool GStitcherOGLWrapper_PanoRender::SwitchPanoTypeOfView(const std::string& sViewName, G_enPanoType eNewPanoType)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		std::shared_ptr<tView> ptrView = FindView(sViewName);
+		if (nullptr == ptrView)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::UnProject(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SwitchPanoTypeOfView(). Error: View " << sViewName << " NOT FOUND. ==>";
 			return false;
 		}
 
-		m_UnprojectContext.vfInputPoints.clear();
-		m_UnprojectContext.vfOutputPoints.clear();
-
-		for (int i = 0; i < uiPointsSize; ++i)
-		{
-			cv::Point2f point2f;
-			point2f.x = pPoints[i].fX;
-			point2f.y = pPoints[i].fY;
-
-			if (point2f.x < 0.0 || point2f.x > 1.0 || point2f.y < 0.0 || point2f.y > 1.0)
-			{
-				GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::UnProject(). Error: Invalid normalized pixel coordinate value. ==>";
-				return false;
-			}
-
-			m_UnprojectContext.vfInputPoints.push_back(point2f);
-		}
-
-		m_UnprojectContext.vfOutputPoints.resize(uiPointsSize);
-		m_UnprojectContext.bNeedUnProject = true;
-
-		std::unique_lock<std::mutex> lk(m_UnprojectContext.mtTaskMutex);
-		m_UnprojectContext.cvTaskDone.wait(lk, [this]()
-		{
-			return (!this->m_UnprojectContext.bNeedUnProject);
-		});
-
-		//for pix with a infinit depth, return FLT_MAX.
-		for (int i = 0; i < uiPointsSize; ++i)
-		{
-			if (FLT_MAX == m_UnprojectContext.vfOutputPoints[i].x &&
-				FLT_MAX == m_UnprojectContext.vfOutputPoints[i].y &&
-				FLT_MAX == m_UnprojectContext.vfOutputPoints[i].z)
-			{
-				pPhysicalDirection[i].fTheta = FLT_MAX;
-				pPhysicalDirection[i].fPhi = FLT_MAX;
-				return true;
-			}
-		}
-
-		//convert 3D coordinate to direction.
-		//theta: start from +z.
-		//phi: start from +x, x -> y.
-		for (int i = 0; i < uiPointsSize; ++i)
 		{
-			cv::Point3f point3f;
-			point3f.x = m_UnprojectContext.vfOutputPoints[i].x;
-			point3f.y = m_UnprojectContext.vfOutputPoints[i].y;
-			point3f.z = m_UnprojectContext.vfOutputPoints[i].z;
-
-			pPhysicalDirection[i].fTheta = atan2f(sqrtf(point3f.x*point3f.x + point3f.y*point3f.y), point3f.z);
-			pPhysicalDirection[i].fPhi = atan2f(point3f.y, point3f.x);
+			std::lock_guard<std::mutex> lockGuard(ptrView->RenderParameterManager.m_mtManagerMutex);
+			ptrView->RenderParameterManager.SetPanoType(ToPanoType(eNewPanoType));
 		}
+		WakeUpRenderingLoop();
 
-		return m_UnprojectContext.bRet;
+		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::UnProject(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SwitchPanoTypeOfView(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::CalcViewCamera(G_tPhysicalDirection pPhysicalDirection, G_tViewCamera* pViewCamera)
+bool GStitcherOGLWrapper_PanoRender::SetOutputCallBackOfView(const std::string& sViewName, G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateSceneCreated)
+		std::shared_ptr<tView> ptrView = FindView(sViewName);
+		if (nullptr == ptrView)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::CalcViewCamera(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBackOfView(). Error: View " << sViewName << " NOT FOUND. ==>";
 			return false;
 		}
 
-		GInteractionControllerDOF dof;
-		dof.fZoom = pViewCamera->fZoom;
-
-		bool bRet = false;
 		{
-			std::lock_guard<std::mutex> lockGuard(m_RenderParameterManager.m_mtManagerMutex);
-			bRet = m_RenderParameterManager.CalcInteractionControllerDOF(pPhysicalDirection.fTheta, pPhysicalDirection.fPhi, dof);
-		}
+			std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
 
-		pViewCamera->fHorizontal = dof.fHorizontal;
-		pViewCamera->fVertical = dof.fVertical;
-		pViewCamera->fZoom = dof.fZoom;
+			if (nullptr != outputCallBackFunc)
+			{
+				GWriteOutCallBack callBack;
+				callBack.pCallBackFunc = nullptr;
+				callBack.pCallBackFuncEx = outputCallBackFunc;
+				callBack.iCallBackTimes = -1;
+				callBack.fScale = fScale;
+				callBack.pContext = pContext;
+				ptrView->mpWriteOutCallBack["OutputCallBackEx"] = callBack;
+			}
+			else
+			{
+				ptrView->mpWriteOutCallBack.erase("OutputCallBackEx");
+			}
+		}
 
-		return bRet;
+		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::CalcViewCamera(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::SetOutputCallBackOfView(). EXCEPTION. ==>";
 		return false;
 	}
 }
 
-bool GStitcherOGLWrapper_PanoRender::GetCameraParameters(int iCameraIdx, char* sCameraMode, float* fK, float* fDistortion, float* fR, G_enCameraModelType* peCameraModelType)
+bool GStitcherOGLWrapper_PanoRender::GetViewStatistics(const std::string& sViewName, G_tViewStatistics& viewStatistics)
 {
 	try
 	{
-		if (m_ePanoRenderState < ePanoRenderStateCreated)
+		std::shared_ptr<tView> ptrView = FindView(sViewName);
+		if (nullptr == ptrView)
 		{
-			GLOGGER(info) << "GStitcherOGLWrapper_PanoRender::GetCameraParameters(). Not Ready. ==>";
+			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetViewStatistics(). Error: View " << sViewName << " NOT FOUND. ==>";
 			return false;
 		}
 
-		bool bRet = false;
-		if ((iCameraIdx >= 0) && (iCameraIdx < m_vCameras.size()))
-		{
-			cv::Mat mK(cv::Size(3, 3), CV_32FC1, fK);
-			cv::Mat mR(cv::Size(3, 3), CV_32FC1, fR);
-
-			if (eCameraTypeNormal == m_vCameras[iCameraIdx].eCameraType)
-			{
-				cv::Mat mDist(cv::Size(5, 1), CV_32FC1, fDistortion);
-				m_vCameras[iCameraIdx].distorsionCoefficients.convertTo(mDist, CV_32FC1);
-				*peCameraModelType = G_eCameraModelTypeNormal2r2t1r;
-			}
-			else if (eCameraTypeFisheye == m_vCameras[iCameraIdx].eCameraType)
-			{
-				cv::Mat mDist(cv::Size(4, 1), CV_32FC1, fDistortion);
-				m_vCameras[iCameraIdx].distorsionCoefficients.convertTo(mDist, CV_32FC1);
-				*peCameraModelType = G_eCameraModelTypeFisheye4theta;
-			}
-			else if (eCameraTypeFisheyeAnglePoly5 == m_vCameras[iCameraIdx].eCameraType)
-			{
-				cv::Mat mDist(cv::Size(5, 1), CV_32FC1, fDistortion);
-				m_vCameras[iCameraIdx].distorsionCoefficients.convertTo(mDist, CV_32FC1);
-				*peCameraModelType = G_eCameraModelTypeFisheyeAnglePoly5;
-			}
-
-			m_vCameras[iCameraIdx].m_mpMultiK0Map[std::string(sCameraMode)].convertTo(mK, CV_32FC1);
-
-			cv::Mat mTemp;
-			m_vCameras[iCameraIdx].R.convertTo(mTemp, CV_32FC1);
+		std::lock_guard<std::mutex> lockGuard(m_mtStitcherOGLMutex);
 
-			cv::SVD svd;
-			svd(mTemp, cv::SVD::FULL_UV);
-			mTemp = svd.u * svd.vt;
-			if (cv::determinant(mTemp) < 0)
-			{
-				mTemp *= -1;
-			}
-			mTemp.convertTo(mR, CV_32FC1);
+		viewStatistics.ullRenderedFrames = ptrView->ullRenderedFrames;
+		viewStatistics.ullDeliveredFrames = ptrView->ullDeliveredFrames;
 
-			bRet = true;
+		double dSum = 0.0;
+		for (int i = 0; i < ptrView->cbRenderTimes_ms.size(); ++i)
+		{
+			dSum += ptrView->cbRenderTimes_ms[i];
 		}
-		else
+		viewStatistics.fAverageRenderTime_ms = ptrView->cbRenderTimes_ms.empty() ? 0.0f : static_cast<float>(dSum / ptrView->cbRenderTimes_ms.size());
+
+		dSum = 0.0;
+		for (int i = 0; i < ptrView->cbOutputLatencies_ms.size(); ++i)
 		{
-			GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetCameraParameters(). ERROR: Invalid iCameraIdx: " << iCameraIdx << ". ==>";
-			return false;
+			dSum += ptrView->cbOutputLatencies_ms[i];
 		}
-		return bRet;
+		viewStatistics.fAverageOutputLatency_ms = ptrView->cbOutputLatencies_ms.empty() ? 0.0f : static_cast<float>(dSum / ptrView->cbOutputLatencies_ms.size());
+
+		return true;
 	}
 	catch (...)
 	{
-		m_ePanoRenderState = ePanoRenderStateError;
-		DestroyPanoRender();
-		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetCameraParameters(). EXCEPTION. ==>";
+		GLOGGER(error) << "GStitcherOGLWrapper_PanoRender::GetViewStatistics(). EXCEPTION. ==>";
 		return false;
 	}
 }
@@ -1914,8 +4140,21 @@ void GStitcherOGLWrapper_PanoRender::DestroyPanoRender()
 			std::lock_guard<std::mutex> lk(m_mtHWNDMutex);
 			m_bRendering = false;
 		}
-		m_cvInitFlag.notify_one();
-		m_tdRendering.join();
+
+		for (int iQue = 0; iQue < m_vPtrFrameQueues.size(); ++iQue)
+		{
+			m_vPtrFrameQueues[iQue]->Interrupt();
+		}
+
+		WakeUpRenderingLoop(true);
+		if (nullptr != m_ptrRenderExecutor)
+		{
+			m_ptrRenderExecutor->WaitForFinish(this);
+		}
+		else
+		{
+			m_tdRendering.join();
+		}
 		return;
 	}
 	catch (...)
@@ -31,6 +31,8 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 
 #include "opencv2/core/core.hpp"
@@ -39,6 +41,8 @@
 #include "GRender.h"
 #include "GRenderParaManager.h"
 #include "GDataTransfer.h"
+#include "GRenderExecutor.h"
+#include "GQualityController.h"
 
 #if defined WIN32
 #include "Windows.h"
@@ -47,19 +51,19 @@
 #elif __linux__
 #endif // WIN32
 
-class GStitcherOGLWrapper_PanoRender
+class GStitcherOGLWrapper_PanoRender : public GRenderTaskIF
 {
 public:
 	GStitcherOGLWrapper_PanoRender() :
 		m_Config(GStitcherConfig())
-		, m_ePanoRenderState(ePanoRenderStateUnCreated)
-		, m_bDataArrived(false)
-		, m_bRendering(true)
-		, m_iFPS(0)
+		, m_bHasTextureGroup(false)
 		, m_iPanoOriginalWidth(0)
 		, m_iPanoOriginalHeight(0)
+		, m_bDataArrived(false)
+		, m_ePanoRenderState(ePanoRenderStateUnCreated)
 		, m_HWND(nullptr)
 		, m_bInitCalled(false)
+		, m_eHeadlessPlatform(eHeadlessPlatformNone)
 #ifdef WIN32
 		, m_HDC(nullptr)
 		, m_GLContext(nullptr)
@@ -69,12 +73,34 @@ public:
 		, m_Surface(EGL_NO_SURFACE)
 		, m_GLContext(EGL_NO_CONTEXT)
 #endif // WIN32
+		, m_bRendering(true)
+		, m_bNewEvent(false)
+		, m_bUrgentEvent(false)
+		, m_eFramePacingMode(eFramePacingModeFixedFPS)
+		, m_fTargetFPS(30.0f)
+		, m_bFramePacingChanged(false)
+		, m_bRestartFrameGrid(true)
+		, m_bMeasureIdleSlack(false)
+		, m_bLateLatchViewCamera(false)
+		, m_bQualityControllerEnabled(false)
+		, m_pQualityCallBack(nullptr)
+		, m_pQualityCallBackContext(nullptr)
+		, m_bQualityControllerChanged(false)
+		, m_iSceneTessellationLevel(0)
+		, m_fSceneTessellationTolerance_px(0.0f)
+		, m_szSceneRemapTable(0, 0)
+		, m_bWarmUpChanged(false)
+		, m_ullOutputSequenceNumber(0)
 	{}
 
-	bool Create(G_tPanoRenderConfig panoRenderConfig, const char* pModel, unsigned int uiSize_Byte);
+	//ptrRenderExecutor: run on the shared render threads instead of a thread of its own, if not null.
+	bool Create(G_tPanoRenderConfig panoRenderConfig, const char* pModel, unsigned int uiSize_Byte
+		, std::shared_ptr<GRenderExecutor> ptrRenderExecutor = nullptr);
 
 	bool InitPanoRender(void* hWnd);
 
+	bool InitPanoRenderHeadless(G_enHeadlessPlatform eHeadlessPlatform);
+
 	bool GetSupportedPanoTypeList(std::vector<G_enPanoType>& vSupportedPanoTypeList);
 
 	bool GetViewCamera(G_tViewCamera& viewCamera);
@@ -83,10 +109,14 @@ public:
 
 	bool SetViewCamera(G_tViewCamera viewCamera);
 
+	bool SetViewCameraLateLatch(bool bEnable);
+
 	bool SetDrawingRegion(unsigned int uiX0, unsigned int uiY0, unsigned int uiWidth, unsigned int uiHeight);
 
 	bool InputFrame(int iCameraIdx
-		, unsigned int uiWidth, unsigned int uiHeight, void* pData[3], unsigned int uiStep_Byte[3]);
+		, unsigned int uiWidth, unsigned int uiHeight, void* pData[3], unsigned int uiStep_Byte[3], const long long* pllTimeStamp = nullptr);
+
+	bool RenderFrameGroup(const G_tInputFrame* pInputFrames, unsigned int uiInputFrameNum, G_tFrameGroupOutput* pOutputs, unsigned int uiOutputNum);
 
 	bool GetCurrentPanoType(int* pCurrentPanoType) const;
 
@@ -96,6 +126,8 @@ public:
 
 	bool SetOutputCallBack(G_tOutputCallBack outputCallBackFunc, float fScale, void* pContext);
 
+	bool SetOutputCallBackEx(G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext);
+
 	bool SetPreRenderCallBack(G_tRenderCallBack renderCallBackFunc, void* pContext);
 
 	bool SetRenderCallBack(G_tRenderCallBack renderCallBackFunc, void* pContext);
@@ -106,20 +138,109 @@ public:
 
 	bool GetCameraParameters(int iCameraIdx, char* sCameraMode, float* fK, float* fDistortion, float* fR, G_enCameraModelType* peCameraModelType);
 
+	bool SetFramePacing(G_enFramePacingMode eFramePacingMode, float fTargetFPS);
+
+	bool GetRenderStatistics(G_tRenderStatistics& renderStatistics);
+
+	//pConfig: null disables the controller.
+	bool EnableQualityController(const G_tQualityControllerConfig* pConfig, G_tQualityCallBack qualityCallBackFunc, void* pContext);
+
+	bool GetQualityState(G_tQualityState& qualityState);
+
+	//fTolerance_px: in output pixels, 0 subdivides the surfaces of the pano type uniformly.
+	bool SetTessellationTolerance(G_enPanoType ePanoType, float fTolerance_px);
+
+	//eRenderPath: remap tables are only supported by the pano types of an orthogonal view camera.
+	bool SetRenderPath(G_enPanoType ePanoType, G_enRenderPath eRenderPath);
+
+	//sDirectory: null or empty disables the scene cache.
+	bool SetSceneCacheDirectory(const char* sDirectory);
+
+	bool ClearSceneCache();
+
+	//sDirectory: null or empty disables the program binary cache.
+	bool SetProgramBinaryCacheDirectory(const char* sDirectory);
+
+	//the scenes of the pano types are built in the background, an empty list releases them.
+	bool WarmUpPanoTypes(const G_enPanoType* pPanoTypes, unsigned int uiPanoTypeNum);
+
+	bool GetWarmUpState(G_tWarmUpState& warmUpState);
+
+	bool SetSceneMemoryBudget(unsigned long long ullBudget_Byte);
+
+	bool GetSceneMemoryState(G_tSceneMemoryState& sceneMemoryState);
+
+	bool GetProgramCacheStatistics(G_tProgramCacheStatistics& programCacheStatistics);
+
+	bool AddView(const std::string& sViewName, G_enPanoType ePanoType, unsigned int uiWidth, unsigned int uiHeight);
+
+	bool RemoveView(const std::string& sViewName);
+
+	bool GetViewCameraOfView(const std::string& sViewName, G_tViewCamera& viewCamera);
+
+	bool SetViewCameraOfView(const std::string& sViewName, G_tViewCamera viewCamera);
+
+	bool SwitchPanoTypeOfView(const std::string& sViewName, G_enPanoType eNewPanoType);
+
+	bool SetOutputCallBackOfView(const std::string& sViewName, G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext);
+
+	bool GetViewStatistics(const std::string& sViewName, G_tViewStatistics& viewStatistics);
+
 	void DestroyPanoRender();
 
+	//GRenderTaskIF, called by the rendering thread.
+	virtual bool RunStep();
+
+	virtual bool IsRunnable(const std::chrono::steady_clock::time_point& tpNow
+		, std::chrono::steady_clock::time_point& tpReadySince, std::chrono::steady_clock::time_point& tpWakeUp);
+
+	virtual bool MakeCurrent();
+
 private:
 	//methods just for Rendering thread.
 
+	//the rendering thread of its own, if no render executor is used.
 	static void RenderingLoop(GStitcherOGLWrapper_PanoRender* pPanoRender);
 
+	//one iteration of the rendering loop, return false to stop rendering.
+	bool RunTasks();
+
 	unsigned long GetTasks();
 
+	//the next step runs when the wait set by the current step is over.
+	//bUrgentOnly: ignore events that are not urgent, except that a complete frame group always wakes up an input driven rendering loop.
+	void WaitForEvents(bool bUrgentOnly = false);
+
+	void WaitForEventsUntil(const std::chrono::steady_clock::time_point& tpDeadline);
+
+	void WaitForNextStep();
+
+	//called with m_mtWakeUpMutex locked.
+	bool IsWaitOver(const std::chrono::steady_clock::time_point& tpNow
+		, std::chrono::steady_clock::time_point& tpReadySince, std::chrono::steady_clock::time_point& tpWakeUp) const;
+
+	//called with m_mtWakeUpMutex locked.
+	bool IsFrameGroupReady() const;
+
+	//the executor skipped the step. the task waits for an urgent event to retry, and is then destroyed.
+	void OnMakeCurrentFailed();
+
+	//start a frame: apply the swap interval of a new pacing mode.
+	std::chrono::steady_clock::time_point BeginFrame();
+
+	//schedule the next frame according to the pacing mode, and update the statistics of the frame.
+	void ScheduleNextFrame(const std::chrono::steady_clock::time_point& tpFrameStart);
+
+	bool SetSwapInterval(int iInterval);
+
 #ifdef WIN32
 	bool InitOpenGL();
 #elif __APPLE__
 #elif (defined __ANDROID__) || (defined __linux__)
 	bool GetDisplay(void* pNativeWindow = nullptr);
+	//get the display of m_eHeadlessPlatform, which should not be eHeadlessPlatformAuto.
+	EGLDisplay GetHeadlessDisplay();
+	static bool HasEGLExtension(const char* pExtensions, const std::string& sExtension);
 	bool GetConfig(EGLConfig& eglConfig);
 	bool GetSurface(EGLConfig eglConfig, void* pNativeWindow = nullptr);
 	bool InitOpenGL();
@@ -127,7 +248,17 @@ private:
 
 	bool InitStitcher();
 
-	bool UploadTextures();
+	//vUploadMask: cameras whose frames are consumed without being uploaded are set to false, empty to upload all.
+	bool UploadTextures(const std::vector<bool>& vUploadMask);
+
+	//the cameras seen by the panorama or any view with an output callback, called with m_mtStitcherOGLMutex locked.
+	void GetVisibleCameras(const glm::mat4& matP, const glm::mat4& matV, std::vector<bool>& vVisible);
+
+	//feed the time of a frame to the quality controller and apply the new quality level, if any.
+	void UpdateQuality(double dFrameTime_ms);
+
+	//scale the output size by the rendering resolution of the current quality level.
+	int ScaleByQuality(int iSize) const;
 
 	bool Render();
 
@@ -137,12 +268,28 @@ private:
 
 	bool RenderWithOutput4EarlyVersion(const glm::mat4& matP, const glm::mat4& matV);
 
-	void OutputCallBack(unsigned char* pData, int iWidth, int iHeight);
+	void UpdateFrameInfo(long long llRenderStartTime_us);
+
+	//render the frame group of a RenderFrameGroup() call and read it back into its outputs.
+	bool RenderRequestedFrameGroup();
+
+	void OutputCallBack(unsigned char* pData, int iWidth, int iHeight, const GOutputFrameInfo& frameInfo);
 
-	void OutputCallBackwithScale(GFrameDownloader* pDownloader);
+	//called with m_mtStitcherOGLMutex locked: apply the parameters of the views, create their scenes and release removed views.
+	bool UpdateViews();
+
+	//called with m_mtStitcherOGLMutex locked, after the textures of the frame are uploaded.
+	bool RenderViews(bool bLateLatch);
+
+	//deliver the frames still being downloaded, used by the off screen mode when it runs out of input.
+	void FlushOutput();
 
 	void Release();
 
+	//wake up the rendering loop. urgent events interrupt the wait for the next frame deadline,
+	//other events only wake up an idle rendering loop.
+	void WakeUpRenderingLoop(bool bUrgent = false);
+
 private:
 	enum  enPanoRenderState
 	{
@@ -159,11 +306,77 @@ private:
 		ePanoRenderTaskCreateScene,
 		ePanoRenderTaskSetViewPort,
 		ePanoRenderTaskSetOriginalPanoSize,
+		ePanoRenderTaskWarmUp,
 		ePanoRenderTaskUnProject,
+		ePanoRenderTaskRenderFrameGroup,
 		ePanoRenderTaskRender,
 		ePanoRenderTaskDestroy,
 	};
 
+	enum enHeadlessPlatform
+	{
+		eHeadlessPlatformNone = 0,
+		eHeadlessPlatformAuto,
+		eHeadlessPlatformSurfaceless,
+		eHeadlessPlatformDevice,
+		eHeadlessPlatformPBuffer,
+	};
+
+	enum enFramePacingMode
+	{
+		eFramePacingModeFixedFPS = 0,
+		eFramePacingModeInputDriven,
+		eFramePacingModeUnthrottled,
+		eFramePacingModeVSync,
+	};
+
+	struct tRenderStatistics
+	{
+		tRenderStatistics() :
+			cbFrameStartTimes(60)
+			, cbFrameTimes_ms(60)
+			, cbSlacks_ms(60)
+			, cbDrawCalls(60)
+			, cbStateChanges(60)
+			, cbSceneCPUTimes_ms(60)
+			, ullRenderedFrames(0)
+			, ullLateFrames(0)
+		{}
+
+		boost::circular_buffer<std::chrono::steady_clock::time_point> cbFrameStartTimes;
+		boost::circular_buffer<double> cbFrameTimes_ms;
+		boost::circular_buffer<double> cbSlacks_ms;
+		//GL calls of the scenes of a frame.
+		boost::circular_buffer<int> cbDrawCalls;
+		boost::circular_buffer<int> cbStateChanges;
+		boost::circular_buffer<double> cbSceneCPUTimes_ms;
+		unsigned long long ullRenderedFrames;
+		unsigned long long ullLateFrames;
+
+		std::mutex mtStatisticsMutex;
+	};
+
+	enum enStepWait
+	{
+		eStepWaitNone = 0,
+		eStepWaitForEvents,
+		eStepWaitUntil,
+	};
+
+	//when the next step of the rendering loop may run, guarded by m_mtWakeUpMutex.
+	struct tNextStep
+	{
+		tNextStep() :
+			eWait(eStepWaitNone)
+			, bUrgentOnly(false)
+		{}
+
+		enStepWait eWait;
+		bool bUrgentOnly;
+		std::chrono::steady_clock::time_point tpDeadline;
+		std::chrono::steady_clock::time_point tpScheduled;
+	};
+
 	struct tUnprojectContext
 	{
 		tUnprojectContext() :
@@ -179,23 +392,151 @@ private:
 		std::condition_variable cvTaskDone;
 	};
 
+	//a frame passed to RenderFrameGroup(), grabbed once.
+	struct tFrameGroupSource : public GFrameSourceIF
+	{
+		tFrameGroupSource(const GFrameType& type) :
+			frameType(type)
+			, vBuffer(type.Size_Byte())
+			, bGrabbed(false)
+		{}
+
+		virtual bool GrabFrame(GFrameType& type)
+		{
+			if (bGrabbed)
+			{
+				return false;
+			}
+
+			type = frameType;
+			bGrabbed = true;
+			return true;
+		}
+
+		virtual void* OutMapFrame() { return vBuffer.data(); };
+
+		virtual void ReleaseFrame() {};
+
+		GFrameType frameType;
+		std::vector<unsigned char> vBuffer;
+		bool bGrabbed;
+	};
+
+	struct tFrameGroupContext
+	{
+		tFrameGroupContext() :
+			bPending(false)
+			, bReleased(false)
+			, bRet(false)
+			, pOutputs(nullptr)
+			, uiOutputNum(0)
+		{}
+
+		bool bPending;
+		//no more tasks are taken after Release().
+		bool bReleased;
+		bool bRet;
+		std::vector<std::shared_ptr<GFrameSourceIF>> vPtrSources;
+		G_tFrameGroupOutput* pOutputs;
+		unsigned int uiOutputNum;
+
+		std::mutex mtTaskMutex;
+		std::condition_variable cvTaskDone;
+
+		//one call at a time.
+		std::mutex mtCallMutex;
+	};
+
 	struct GWriteOutCallBack
 	{
 		//iCallBackTimes:
 		//iCallBackTimes >= 0: call back n times.
 		//iCallBackTimes < 0: call back until callback function reseted.
+		//pCallBackFuncEx is used instead of pCallBackFunc if it is not null.
 
 		G_tOutputCallBack pCallBackFunc;
+		G_tOutputCallBackEx pCallBackFuncEx;
 		int iCallBackTimes;
 		float fScale;
 		void* pContext;
 	};
 
+	static void InvokeOutputCallBack(const GWriteOutCallBack& task
+		, int iWidth, int iHeight, const unsigned char* pData, const GOutputFrameInfo& frameInfo);
+
+	struct tView
+	{
+		tView() :
+			iOutputWidth(0)
+			, iOutputHeight(0)
+			, bInited(false)
+			, bSceneCreated(false)
+			, iTessellationLevel(0)
+			, fTessellationTolerance_px(0.0f)
+			, szRemapTable(0, 0)
+			, cbRenderTimes_ms(60)
+			, cbOutputLatencies_ms(60)
+			, ullRenderedFrames(0)
+			, ullDeliveredFrames(0)
+		{}
+
+		std::string sSceneName;
+		GRenderParameterManager RenderParameterManager;
+
+		//guarded by m_mtStitcherOGLMutex.
+		GTaskQueue<GFrameDownloader> downloaders;
+		std::map <std::string, GWriteOutCallBack> mpWriteOutCallBack;
+		int iOutputWidth;
+		int iOutputHeight;
+		bool bInited;
+		bool bSceneCreated;
+		int iTessellationLevel;
+		float fTessellationTolerance_px;
+		cv::Size szRemapTable;
+
+		boost::circular_buffer<double> cbRenderTimes_ms;
+		boost::circular_buffer<double> cbOutputLatencies_ms;
+		unsigned long long ullRenderedFrames;
+		unsigned long long ullDeliveredFrames;
+	};
+
+	//return whether any callback received the frame.
+	bool OutputCallBackwithScale(GFrameDownloader* pDownloader, std::map <std::string, GWriteOutCallBack>& mpWriteOutCallBack);
+
+	std::shared_ptr<tView> FindView(const std::string& sViewName);
+
+	void OutputView(tView& view, GFrameDownloader* pDownloader);
+
+	static enPanoType ToPanoType(G_enPanoType ePanoType);
+
+	//tessellation tolerance of the pano type in pixels of the input frames, for an output of szOutput.
+	float CalcTessellationTolerance(enPanoType ePanoType, const cv::Size& szOutput);
+
+	//size of the remap tables of the pano type for an output of szOutput, 0 x 0 if it is drawn from the tessellated surface.
+	cv::Size CalcRemapTableSize(enPanoType ePanoType, const cv::Size& szOutput);
+
+	std::string GetSceneCacheDirectory();
+
+	std::string GetProgramBinaryCacheDirectory();
+
+	//hand the pano types to warm up over to the stitcher, with the current parameters of the scenes.
+	void WarmUpScenes();
+
+	static long long GetTimeStamp_us();
+
+	//fill in the type of an input frame and count it.
+	GFrameType CreateFrameType(int iCameraIdx, unsigned int uiWidth, unsigned int uiHeight, const unsigned int uiStep_Byte[3], const long long* pllTimeStamp);
+
+	//copy the planes of an input frame into a buffer without padding.
+	void CopyFrame(const GFrameType& frameType, void* const pData[3], unsigned char* pBuffer) const;
+
 private:
 	GRenderParameterManager m_RenderParameterManager;
 	GStitcherConfig m_Config;
 	
 	GTextureGroup m_textureGroup;
+	//whether frames have been uploaded into m_textureGroup since InitStitcher().
+	bool m_bHasTextureGroup;
 
 	GTextureGroupUploader m_uploader;
 
@@ -210,14 +551,22 @@ private:
 	std::mutex m_mtStitcherOGLMutex;
 
 	std::vector<CameraModel> m_vCameras;
+	std::vector<GPanoTypeParas> m_vPanoTypeList;
+
+	//views by name, and removed views whose OpenGL resources are not released yet.
+	std::map<std::string, std::shared_ptr<tView>> m_mpViews;
+	std::vector<std::shared_ptr<tView>> m_vRemovedViews;
+	std::mutex m_mtViewsMutex;
 
 	bool m_bDataArrived;
 	enPanoRenderState m_ePanoRenderState;
 
 	std::thread m_tdRendering;
+	std::shared_ptr<GRenderExecutor> m_ptrRenderExecutor;
 
 	void* m_HWND;
 	bool m_bInitCalled;
+	enHeadlessPlatform m_eHeadlessPlatform;
 #ifdef WIN32
 	HDC m_HDC;
 	HGLRC m_GLContext;
@@ -229,13 +578,77 @@ private:
 #endif // WIN32
 
 	std::mutex m_mtHWNDMutex;
-	std::condition_variable m_cvInitFlag;
 
 	bool m_bRendering;
 
-	int m_iFPS;
+	std::mutex m_mtWakeUpMutex;
+	std::condition_variable m_cvWakeUp;
+	bool m_bNewEvent;
+	bool m_bUrgentEvent;
+	std::chrono::steady_clock::time_point m_tpEventTime;
+	tNextStep m_NextStep;
+	//the thread running the steps, the own rendering thread or a render executor worker.
+	std::thread::id m_idRenderingThread;
+
+	//frame pacing, guarded by m_mtWakeUpMutex.
+	enFramePacingMode m_eFramePacingMode;
+	float m_fTargetFPS;
+	bool m_bFramePacingChanged;
+	std::vector<bool> m_vCameraActive;
+	std::vector<int> m_vPendingFrameNum;
+
+	//deadline of the next frame in the fixed fps mode, and the end of the last frame, only used by the rendering thread.
+	std::chrono::steady_clock::time_point m_tpNextFrame;
+	std::chrono::steady_clock::time_point m_tpLastFrameEnd;
+	bool m_bRestartFrameGrid;
+	bool m_bMeasureIdleSlack;
+
+	//re-sample the view camera right before the draw call, guarded by m_mtWakeUpMutex.
+	bool m_bLateLatchViewCamera;
+
+	//adaptive quality, guarded by m_mtWakeUpMutex. the rendering thread picks up a new configuration at the end of a frame.
+	bool m_bQualityControllerEnabled;
+	G_tQualityControllerConfig m_QualityControllerConfig;
+	G_tQualityCallBack m_pQualityCallBack;
+	void* m_pQualityCallBackContext;
+	bool m_bQualityControllerChanged;
+	G_tQualityState m_QualityState;
+
+	//only used by the rendering thread. the scenes are rebuilt when the tessellation level of the quality level changes.
+	GQualityController m_QualityController;
+	GQualityController::tLevel m_QualityLevel;
+	int m_iSceneTessellationLevel;
+
+	//tessellation tolerances in output pixels by pano type, guarded by m_mtWakeUpMutex.
+	std::map<enPanoType, float> m_mpTessellationTolerances;
+	//only used by the rendering thread, the scene is rebuilt when the tolerance of its pano type changes.
+	float m_fSceneTessellationTolerance_px;
+
+	//render paths by pano type, guarded by m_mtWakeUpMutex. the default is the tessellated surface.
+	std::map<enPanoType, G_enRenderPath> m_mpRenderPaths;
+	//only used by the rendering thread, the scene is rebuilt when the remap table size of its pano type changes.
+	cv::Size m_szSceneRemapTable;
+
+	//guarded by m_mtWakeUpMutex, used by the scenes created afterwards.
+	std::string m_sSceneCacheDirectory;
+	//guarded by m_mtWakeUpMutex, used by the programs linked afterwards.
+	std::string m_sProgramBinaryCacheDirectory;
+
+	//guarded by m_mtWakeUpMutex. the requests are rebuilt by the rendering thread when changed or after a new scene.
+	std::vector<enPanoType> m_vWarmUpPanoTypes;
+	bool m_bWarmUpChanged;
+
+	tRenderStatistics m_RenderStatistics;
+
+	//G_InputFrame() and RenderFrameGroup() may count frames of a camera from several threads.
+	std::vector<std::atomic<unsigned long long>> m_vInputFrameCounters;
+	unsigned long long m_ullOutputSequenceNumber;
+	GOutputFrameInfo m_CurrentFrameInfo;
 
 	tUnprojectContext m_UnprojectContext;
+
+	tFrameGroupContext m_FrameGroupContext;
+	GFrameDownloader m_FrameGroupDownloader;
 };
 
 
@@ -24,6 +24,7 @@
  
 #include "PanoRender/GPanoRenderOGLIF.h"
 #include "GPanoRenderOGL.h"
+#include "GRenderExecutor.h"
 
 #include "Common/GiraffeLogger/GiraffeLogger.h"
 
@@ -34,6 +35,120 @@ static std::mutex global_mtPanoRendersMapMutex;
 static std::mutex mtGlobalInited;
 static bool bGlobalInited = false;
 
+static std::shared_ptr<GRenderExecutor> global_ptrRenderExecutor;
+static std::mutex global_mtRenderExecutorMutex;
+
+int G_CALL_CONVENTION G_InitRenderExecutor(unsigned int uiThreadNum)
+{
+	try
+	{
+		{
+			std::lock_guard<std::mutex> globalInitedLockGuard(mtGlobalInited);
+			if (!bGlobalInited)
+			{
+				GiraffeLogger::Init();
+				bGlobalInited = true;
+			}
+		}
+
+		GLOGGER(info) << "==> G_InitRenderExecutor().";
+
+		if ((0 == uiThreadNum) || (1024 < uiThreadNum))
+		{
+			GLOGGER(error) << "G_InitRenderExecutor(). ERROR: Invalid thread num.";
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::lock_guard<std::mutex> lockGuard(global_mtRenderExecutorMutex);
+		if (nullptr != global_ptrRenderExecutor)
+		{
+			GLOGGER(error) << "G_InitRenderExecutor(). ERROR: Already inited.";
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GRenderExecutor> ptrRenderExecutor = std::make_shared<GRenderExecutor>();
+		if (!ptrRenderExecutor->Init(static_cast<int>(uiThreadNum)))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		global_ptrRenderExecutor = ptrRenderExecutor;
+
+		GLOGGER(info) << "G_InitRenderExecutor(). ==>";
+		return G_ePanoRenderErrorCodeNone;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_InitRenderExecutor(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetRenderExecutorStatistics(G_tRenderExecutorStatistics* pRenderExecutorStatistics)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetRenderExecutorStatistics().";
+
+		if (nullptr == pRenderExecutorStatistics)
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GRenderExecutor> ptrRenderExecutor;
+		{
+			std::lock_guard<std::mutex> lockGuard(global_mtRenderExecutorMutex);
+			ptrRenderExecutor = global_ptrRenderExecutor;
+		}
+
+		if (nullptr == ptrRenderExecutor)
+		{
+			GLOGGER(error) << "G_GetRenderExecutorStatistics(). ERROR: Not inited.";
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		int iRet = (ptrRenderExecutor->GetStatistics(*pRenderExecutorStatistics) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetRenderExecutorStatistics(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetRenderExecutorStatistics(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_ReleaseRenderExecutor()
+{
+	try
+	{
+		GLOGGER(info) << "==> G_ReleaseRenderExecutor().";
+
+		std::lock_guard<std::mutex> lockGuard(global_mtRenderExecutorMutex);
+		if (nullptr == global_ptrRenderExecutor)
+		{
+			GLOGGER(error) << "G_ReleaseRenderExecutor(). ERROR: Not inited.";
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		if (!global_ptrRenderExecutor->Release())
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		global_ptrRenderExecutor.reset();
+
+		GLOGGER(info) << "G_ReleaseRenderExecutor(). ==>";
+		return G_ePanoRenderErrorCodeNone;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_ReleaseRenderExecutor(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
 int G_CALL_CONVENTION G_CreatePanoRender(G_tPanoRenderConfig panoRenderConfig
 	, const char* pModel, unsigned int uiModelSize_Byte, int* piPanoRenderIdx)
 {
@@ -53,7 +168,15 @@ int G_CALL_CONVENTION G_CreatePanoRender(G_tPanoRenderConfig panoRenderConfig
 		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender =
 			std::shared_ptr<GStitcherOGLWrapper_PanoRender>(new GStitcherOGLWrapper_PanoRender());
 
-		bool bRet = ptrPanoRender->Create(panoRenderConfig, pModel, uiModelSize_Byte);
+		//on screen rendering keeps a thread of its own, swapping buffers would stall the other PanoRenders.
+		std::shared_ptr<GRenderExecutor> ptrRenderExecutor;
+		if (G_eRenderingModeOnScreen != panoRenderConfig.eRenderingMode)
+		{
+			std::lock_guard<std::mutex> lockGuard(global_mtRenderExecutorMutex);
+			ptrRenderExecutor = global_ptrRenderExecutor;
+		}
+
+		bool bRet = ptrPanoRender->Create(panoRenderConfig, pModel, uiModelSize_Byte, ptrRenderExecutor);
 
 		if (bRet)
 		{
@@ -118,6 +241,38 @@ int G_CALL_CONVENTION G_InitPanoRender(int iPanoRenderIdx, void* hWnd)
 	}
 }
 
+int G_CALL_CONVENTION G_InitPanoRenderHeadless(int iPanoRenderIdx, G_enHeadlessPlatform eHeadlessPlatform)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_InitPanoRenderHeadless().";
+
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_InitPanoRenderHeadless(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_InitPanoRenderHeadless(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		bool bRet = ptrPanoRender->InitPanoRenderHeadless(eHeadlessPlatform);
+
+		GLOGGER(info) << "G_InitPanoRenderHeadless(). ==>";
+		return (bRet ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_InitPanoRenderHeadless(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
 int G_CALL_CONVENTION G_GetSupportedPanoTypeList(int iPanoRenderIdx, int* pSupportedPanoTypeList, int* pSize)
 {
 	try
@@ -251,6 +406,37 @@ int G_CALL_CONVENTION G_SetViewCamera(int iPanoRenderIdx, G_tViewCamera viewCame
 	}
 }
 
+int G_CALL_CONVENTION G_SetViewCameraLateLatch(int iPanoRenderIdx, int iEnable)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetViewCameraLateLatch().";
+
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetViewCameraLateLatch(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetViewCameraLateLatch(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetViewCameraLateLatch(0 != iEnable) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+		GLOGGER(info) << "G_SetViewCameraLateLatch(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetViewCameraLateLatch(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
 int G_CALL_CONVENTION G_SetDrawingRegion(int iPanoRenderIdx, unsigned int uiX0, unsigned int uiY0, unsigned int uiWidth, unsigned int uiHeight)
 {
 	try
@@ -313,6 +499,75 @@ int G_CALL_CONVENTION G_InputFrame(int iPanoRenderIdx, int iCameraIdx, unsigned
 	}
 }
 
+int G_CALL_CONVENTION G_InputFrameEx(int iPanoRenderIdx, int iCameraIdx, unsigned int uiWidth, unsigned int uiHeight, void* pData[3], unsigned int uiStep_Byte[3]
+	, long long llTimeStamp)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_InputFrameEx().";
+
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_InputFrameEx(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_InputFrameEx(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->InputFrame(iCameraIdx, uiWidth, uiHeight, pData, uiStep_Byte, &llTimeStamp) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+		GLOGGER(info) << "G_InputFrameEx(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_InputFrameEx(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_RenderFrameGroup(int iPanoRenderIdx, const G_tInputFrame* pInputFrames, unsigned int uiInputFrameNum
+	, G_tFrameGroupOutput* pOutputs, unsigned int uiOutputNum)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_RenderFrameGroup().";
+
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_RenderFrameGroup(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == pInputFrames) || ((nullptr == pOutputs) && (0 != uiOutputNum)))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_RenderFrameGroup(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->RenderFrameGroup(pInputFrames, uiInputFrameNum, pOutputs, uiOutputNum) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+		GLOGGER(info) << "G_RenderFrameGroup(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_RenderFrameGroup(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
 int G_CALL_CONVENTION G_GetCurrentPanoType(int iPanoRenderIdx, int* pCurrentPanoType)
 {
 	try
@@ -444,6 +699,42 @@ int G_CALL_CONVENTION G_SetOutputCallBack(int iPanoRenderIdx, G_tOutputCallBack
 	}
 }
 
+int G_CALL_CONVENTION G_SetOutputCallBackEx(int iPanoRenderIdx, G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetOutputCallBackEx().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetOutputCallBackEx(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if (fScale <= 0.0)
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetOutputCallBackEx(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetOutputCallBackEx(outputCallBackFunc, fScale, pContext) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetOutputCallBackEx(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetOutputCallBackEx(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
 int G_CALL_CONVENTION G_SetPreRenderCallBack(int iPanoRenderIdx, G_tRenderCallBack renderCallBackFunc, void* pContext)
 {
 	try
@@ -599,6 +890,717 @@ int G_CALL_CONVENTION G_GetCameraParameters(int iPanoRenderIdx, int iCameraIdx,
 	}
 }
 
+int G_CALL_CONVENTION G_SetFramePacing(int iPanoRenderIdx, G_enFramePacingMode eFramePacingMode, float fTargetFPS)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetFramePacing().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetFramePacing(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetFramePacing(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetFramePacing(eFramePacingMode, fTargetFPS) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetFramePacing(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetFramePacing(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetRenderStatistics(int iPanoRenderIdx, G_tRenderStatistics* pRenderStatistics)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetRenderStatistics().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_GetRenderStatistics(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if (nullptr == pRenderStatistics)
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_GetRenderStatistics(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->GetRenderStatistics(*pRenderStatistics) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetRenderStatistics(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetRenderStatistics(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_EnableQualityController(int iPanoRenderIdx, const G_tQualityControllerConfig* pConfig, G_tQualityCallBack qualityCallBackFunc, void* pContext)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_EnableQualityController().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_EnableQualityController(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_EnableQualityController(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->EnableQualityController(pConfig, qualityCallBackFunc, pContext) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_EnableQualityController(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_EnableQualityController(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetQualityState(int iPanoRenderIdx, G_tQualityState* pQualityState)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetQualityState().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_GetQualityState(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if (nullptr == pQualityState)
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_GetQualityState(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->GetQualityState(*pQualityState) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetQualityState(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetQualityState(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SetTessellationTolerance(int iPanoRenderIdx, G_enPanoType ePanoType, float fTolerance_px)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetTessellationTolerance().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetTessellationTolerance(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetTessellationTolerance(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetTessellationTolerance(ePanoType, fTolerance_px) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetTessellationTolerance(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetTessellationTolerance(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SetRenderPath(int iPanoRenderIdx, G_enPanoType ePanoType, G_enRenderPath eRenderPath)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetRenderPath().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetRenderPath(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetRenderPath(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetRenderPath(ePanoType, eRenderPath) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetRenderPath(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetRenderPath(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SetSceneCacheDirectory(int iPanoRenderIdx, const char* sDirectory)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetSceneCacheDirectory().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetSceneCacheDirectory(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetSceneCacheDirectory(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetSceneCacheDirectory(sDirectory) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetSceneCacheDirectory(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetSceneCacheDirectory(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_ClearSceneCache(int iPanoRenderIdx)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_ClearSceneCache().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_ClearSceneCache(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_ClearSceneCache(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->ClearSceneCache() ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_ClearSceneCache(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_ClearSceneCache(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SetProgramBinaryCacheDirectory(int iPanoRenderIdx, const char* sDirectory)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetProgramBinaryCacheDirectory().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetProgramBinaryCacheDirectory(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetProgramBinaryCacheDirectory(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetProgramBinaryCacheDirectory(sDirectory) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetProgramBinaryCacheDirectory(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetProgramBinaryCacheDirectory(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_WarmUpPanoTypes(int iPanoRenderIdx, const G_enPanoType* pPanoTypes, unsigned int uiPanoTypeNum)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_WarmUpPanoTypes().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_WarmUpPanoTypes(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_WarmUpPanoTypes(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->WarmUpPanoTypes(pPanoTypes, uiPanoTypeNum) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_WarmUpPanoTypes(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_WarmUpPanoTypes(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetWarmUpState(int iPanoRenderIdx, G_tWarmUpState* pWarmUpState)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetWarmUpState().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_GetWarmUpState(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if (nullptr == pWarmUpState)
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_GetWarmUpState(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->GetWarmUpState(*pWarmUpState) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetWarmUpState(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetWarmUpState(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SetSceneMemoryBudget(int iPanoRenderIdx, unsigned long long ullBudget_Byte)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetSceneMemoryBudget().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetSceneMemoryBudget(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetSceneMemoryBudget(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetSceneMemoryBudget(ullBudget_Byte) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetSceneMemoryBudget(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetSceneMemoryBudget(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetSceneMemoryState(int iPanoRenderIdx, G_tSceneMemoryState* pSceneMemoryState)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetSceneMemoryState().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_GetSceneMemoryState(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if (nullptr == pSceneMemoryState)
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_GetSceneMemoryState(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->GetSceneMemoryState(*pSceneMemoryState) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetSceneMemoryState(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetSceneMemoryState(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetProgramCacheStatistics(int iPanoRenderIdx, G_tProgramCacheStatistics* pProgramCacheStatistics)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetProgramCacheStatistics().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_GetProgramCacheStatistics(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if (nullptr == pProgramCacheStatistics)
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_GetProgramCacheStatistics(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->GetProgramCacheStatistics(*pProgramCacheStatistics) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetProgramCacheStatistics(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetProgramCacheStatistics(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_AddView(int iPanoRenderIdx, const char* sViewName, int ePanoType, unsigned int uiWidth, unsigned int uiHeight)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_AddView().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_AddView(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == sViewName))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_AddView(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->AddView(sViewName, static_cast<G_enPanoType>(ePanoType), uiWidth, uiHeight) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_AddView(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_AddView(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_RemoveView(int iPanoRenderIdx, const char* sViewName)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_RemoveView().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_RemoveView(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == sViewName))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_RemoveView(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->RemoveView(sViewName) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_RemoveView(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_RemoveView(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetViewCameraOfView(int iPanoRenderIdx, const char* sViewName, G_tViewCamera* pViewCamera)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetViewCameraOfView().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_GetViewCameraOfView(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == sViewName) || (nullptr == pViewCamera))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_GetViewCameraOfView(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->GetViewCameraOfView(sViewName, *pViewCamera) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetViewCameraOfView(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetViewCameraOfView(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SetViewCameraOfView(int iPanoRenderIdx, const char* sViewName, G_tViewCamera viewCamera)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetViewCameraOfView().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetViewCameraOfView(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == sViewName))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetViewCameraOfView(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetViewCameraOfView(sViewName, viewCamera) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetViewCameraOfView(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetViewCameraOfView(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SwitchPanoTypeOfView(int iPanoRenderIdx, const char* sViewName, int eNewPanoType)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SwitchPanoTypeOfView().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SwitchPanoTypeOfView(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == sViewName))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SwitchPanoTypeOfView(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SwitchPanoTypeOfView(sViewName, static_cast<G_enPanoType>(eNewPanoType)) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SwitchPanoTypeOfView(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SwitchPanoTypeOfView(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_SetOutputCallBackOfView(int iPanoRenderIdx, const char* sViewName, G_tOutputCallBackEx outputCallBackFunc, float fScale, void* pContext)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_SetOutputCallBackOfView().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_SetOutputCallBackOfView(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == sViewName))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_SetOutputCallBackOfView(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->SetOutputCallBackOfView(sViewName, outputCallBackFunc, fScale, pContext) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_SetOutputCallBackOfView(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_SetOutputCallBackOfView(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
+int G_CALL_CONVENTION G_GetViewStatistics(int iPanoRenderIdx, const char* sViewName, G_tViewStatistics* pViewStatistics)
+{
+	try
+	{
+		GLOGGER(info) << "==> G_GetViewStatistics().";
+		if (iPanoRenderIdx <= 0)
+		{
+			GLOGGER(error) << "G_GetViewStatistics(). ERROR: Invalid PanoRender index.";
+			return G_ePanoRenderErrorCodeInvalidPanoRenderIdx;
+		}
+
+		if ((nullptr == sViewName) || (nullptr == pViewStatistics))
+		{
+			return G_ePanoRenderErrorCodeUnknown;
+		}
+
+		std::shared_ptr<GStitcherOGLWrapper_PanoRender> ptrPanoRender;
+		int iFound = GetPanoRender(iPanoRenderIdx, ptrPanoRender);
+		if (G_ePanoRenderErrorCodeNone != iFound)
+		{
+			GLOGGER(error) << "G_GetViewStatistics(). ERROR: Invalid PanoRender index.";
+			return iFound;
+		}
+
+		int iRet = (ptrPanoRender->GetViewStatistics(sViewName, *pViewStatistics) ? G_ePanoRenderErrorCodeNone : G_ePanoRenderErrorCodeUnknown);
+
+		GLOGGER(info) << "G_GetViewStatistics(). ==>";
+		return iRet;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "G_GetViewStatistics(). EXCEPTION. ==>";
+		return G_ePanoRenderErrorCodeUnknown;
+	}
+}
+
 int G_CALL_CONVENTION G_DestroyPanoRender(int iPanoRenderIdx)
 {
 	try
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#include "GQualityController.h"
+
+#include <algorithm>
+
+#include "Common/GiraffeLogger/GiraffeLogger.h"
+
+GQualityController::GQualityController() :
+	m_bEnabled(false)
+	, m_iLevel(0)
+	, m_dAverageFrameTime_ms(0.0)
+	, m_bHasFrameTime(false)
+	, m_iOverBudgetFrames(0)
+	, m_iHeadroomFrames(0)
+	, m_iHoldFrames(0)
+	, m_iRestoreFrames(eRestoreFrames)
+	, m_ullFrames(0)
+	, m_ullLastRestoreFrame(0)
+{
+	m_Config = G_tQualityControllerConfig();
+	m_vLevels.push_back(tLevel());
+}
+
+bool GQualityController::Init(const G_tQualityControllerConfig* pConfig, int iFullTessellationLevel)
+{
+	tLevel level;
+	level.iTessellationLevel = iFullTessellationLevel;
+
+	m_vLevels.clear();
+	m_vLevels.push_back(level);
+
+	m_bEnabled = (nullptr != pConfig);
+	m_Config = m_bEnabled ? *pConfig : G_tQualityControllerConfig();
+
+	if (m_bEnabled)
+	{
+		if ((m_Config.fTargetFrameTime_ms <= 0.0f) ||
+			(m_Config.fMinResolutionScale <= 0.0f) || (m_Config.fMinResolutionScale > 1.0f) ||
+			(m_Config.fMinOutputScale <= 0.0f) || (m_Config.fMinOutputScale > 1.0f))
+		{
+			GLOGGER(error) << "GQualityController::Init(). Invalid config. ==>";
+			m_bEnabled = false;
+			m_Config = G_tQualityControllerConfig();
+			return false;
+		}
+
+		//skipping invisible cameras costs nothing visible, so it goes first.
+		if (m_Config.uiAxes & G_eQualityAxisInvisibleCameras)
+		{
+			level.bSkipInvisibleCameras = true;
+			m_vLevels.push_back(level);
+		}
+
+		//then the resolution and the output scales in turn, by 20% a step.
+		bool bResolution = (0 != (m_Config.uiAxes & G_eQualityAxisResolution));
+		bool bOutputScale = (0 != (m_Config.uiAxes & G_eQualityAxisOutputScale));
+		bool bStepped = true;
+		while (bStepped)
+		{
+			bStepped = false;
+			if (bResolution && (level.fResolutionScale > m_Config.fMinResolutionScale))
+			{
+				level.fResolutionScale = std::max(level.fResolutionScale * 0.8f, m_Config.fMinResolutionScale);
+				m_vLevels.push_back(level);
+				bStepped = true;
+			}
+
+			if (bOutputScale && (level.fOutputScale > m_Config.fMinOutputScale))
+			{
+				level.fOutputScale = std::max(level.fOutputScale * 0.8f, m_Config.fMinOutputScale);
+				m_vLevels.push_back(level);
+				bStepped = true;
+			}
+		}
+
+		//the tessellation level rebuilds the scenes, so it is the last resort.
+		if (m_Config.uiAxes & G_eQualityAxisTessellation)
+		{
+			int iMinTessellationLevel = std::max(m_Config.iMinTessellationLevel, 0);
+			while (level.iTessellationLevel > iMinTessellationLevel)
+			{
+				--level.iTessellationLevel;
+				m_vLevels.push_back(level);
+			}
+		}
+	}
+
+	m_iLevel = 0;
+	m_dAverageFrameTime_ms = 0.0;
+	m_bHasFrameTime = false;
+	m_iOverBudgetFrames = 0;
+	m_iHeadroomFrames = 0;
+	m_iHoldFrames = 0;
+	m_iRestoreFrames = eRestoreFrames;
+	m_ullFrames = 0;
+	m_ullLastRestoreFrame = 0;
+
+	GLOGGER(info) << "GQualityController::Init(). Enabled: " << m_bEnabled << ", Level Num: " << m_vLevels.size() << ". ==>";
+	return true;
+}
+
+bool GQualityController::AddFrameTime(double dFrameTime_ms)
+{
+	if (!m_bEnabled)
+	{
+		return false;
+	}
+
+	++m_ullFrames;
+
+	//a single slow frame should not degrade the quality.
+	m_dAverageFrameTime_ms = m_bHasFrameTime ? (0.8 * m_dAverageFrameTime_ms + 0.2 * dFrameTime_ms) : dFrameTime_ms;
+	m_bHasFrameTime = true;
+
+	//let the frame time settle at a new level before judging it.
+	if (m_iHoldFrames > 0)
+	{
+		--m_iHoldFrames;
+		return false;
+	}
+
+	if (m_dAverageFrameTime_ms > m_Config.fTargetFrameTime_ms)
+	{
+		++m_iOverBudgetFrames;
+		m_iHeadroomFrames = 0;
+	}
+	else if (m_dAverageFrameTime_ms < 0.6 * m_Config.fTargetFrameTime_ms)
+	{
+		++m_iHeadroomFrames;
+		m_iOverBudgetFrames = 0;
+	}
+	else
+	{
+		m_iOverBudgetFrames = 0;
+		m_iHeadroomFrames = 0;
+	}
+
+	if ((m_iOverBudgetFrames >= eDegradeFrames) && (m_iLevel + 1 < static_cast<int>(m_vLevels.size())))
+	{
+		//a restored level that did not hold makes the next restore wait longer, to avoid oscillating between two levels.
+		if ((0 != m_ullLastRestoreFrame) && (m_ullFrames - m_ullLastRestoreFrame < static_cast<unsigned long long>(m_iRestoreFrames)))
+		{
+			m_iRestoreFrames = std::min(m_iRestoreFrames * 2, static_cast<int>(eMaxRestoreFrames));
+		}
+		else
+		{
+			m_iRestoreFrames = eRestoreFrames;
+		}
+
+		ChangeLevel(m_iLevel + 1);
+		return true;
+	}
+
+	if ((m_iHeadroomFrames >= m_iRestoreFrames) && (m_iLevel > 0))
+	{
+		m_ullLastRestoreFrame = m_ullFrames;
+		ChangeLevel(m_iLevel - 1);
+		return true;
+	}
+
+	return false;
+}
+
+void GQualityController::ChangeLevel(int iLevel)
+{
+	bool bRebuild = (m_vLevels[iLevel].iTessellationLevel != m_vLevels[m_iLevel].iTessellationLevel);
+
+	GLOGGER(info) << "GQualityController::ChangeLevel(). Level " << m_iLevel << " -> " << iLevel
+		<< ", Average Frame Time: " << m_dAverageFrameTime_ms << " ms. ==>";
+
+	m_iLevel = iLevel;
+	m_iOverBudgetFrames = 0;
+	m_iHeadroomFrames = 0;
+	m_iHoldFrames = bRebuild ? eRebuildHoldFrames : eHoldFrames;
+}
+
+const GQualityController::tLevel& GQualityController::GetLevel() const
+{
+	return m_vLevels[m_iLevel];
+}
+
+void GQualityController::GetState(G_tQualityState& state) const
+{
+	const tLevel& level = m_vLevels[m_iLevel];
+
+	state.iLevel = m_iLevel;
+	state.iLevelNum = static_cast<int>(m_vLevels.size());
+	state.fResolutionScale = level.fResolutionScale;
+	state.fOutputScale = level.fOutputScale;
+	state.iTessellationLevel = level.iTessellationLevel;
+	state.bSkipInvisibleCameras = level.bSkipInvisibleCameras ? 1 : 0;
+	state.fAverageFrameTime_ms = static_cast<float>(m_dAverageFrameTime_ms);
+	state.fTargetFrameTime_ms = m_Config.fTargetFrameTime_ms;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#ifndef G_QUALITY_CONTROLLER_H_
+#define G_QUALITY_CONTROLLER_H_
+
+#include "PanoRender/GPanoRenderOGLIF.h"
+
+#include <vector>
+
+//holds a frame time budget by stepping through a ladder of quality levels, from the full quality at level 0
+//to the lowest quality allowed by the configuration. it degrades quickly when the budget is exceeded, and restores
+//slowly when there is enough headroom, waiting longer every time a restored level turns out to be too expensive.
+//only used by the rendering thread.
+class GQualityController
+{
+public:
+	struct tLevel
+	{
+		tLevel() :
+			fResolutionScale(1.0f)
+			, fOutputScale(1.0f)
+			, iTessellationLevel(0)
+			, bSkipInvisibleCameras(false)
+		{}
+
+		float fResolutionScale;
+		float fOutputScale;
+		int iTessellationLevel;
+		bool bSkipInvisibleCameras;
+	};
+
+	GQualityController();
+
+	//build the ladder of quality levels and restart at the full quality, where the scenes are built with iFullTessellationLevel.
+	//pConfig: null disables the controller, which then stays at the full quality.
+	bool Init(const G_tQualityControllerConfig* pConfig, int iFullTessellationLevel);
+
+	bool IsEnabled() const { return m_bEnabled; };
+
+	//feed the time of a rendered frame, return true if the quality level changed.
+	bool AddFrameTime(double dFrameTime_ms);
+
+	const tLevel& GetLevel() const;
+
+	void GetState(G_tQualityState& state) const;
+
+private:
+	enum
+	{
+		eDegradeFrames = 5,
+		eRestoreFrames = 60,
+		eMaxRestoreFrames = 960,
+		eHoldFrames = 10,
+		//a new tessellation level rebuilds the scenes, which should not be taken for the cost of the level.
+		eRebuildHoldFrames = 30,
+	};
+
+	void ChangeLevel(int iLevel);
+
+private:
+	bool m_bEnabled;
+	G_tQualityControllerConfig m_Config;
+	std::vector<tLevel> m_vLevels;
+	int m_iLevel;
+
+	double m_dAverageFrameTime_ms;
+	bool m_bHasFrameTime;
+	int m_iOverBudgetFrames;
+	int m_iHeadroomFrames;
+	int m_iHoldFrames;
+
+	//frames of headroom needed before restoring, doubled when a level is degraded again shortly after being restored.
+	int m_iRestoreFrames;
+	unsigned long long m_ullFrames;
+	unsigned long long m_ullLastRestoreFrame;
+};
+
+
+#endif //G_QUALITY_CONTROLLER_H_
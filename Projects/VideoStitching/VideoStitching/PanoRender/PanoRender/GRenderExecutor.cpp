@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#include "GRenderExecutor.h"
+
+#include <algorithm>
+
+#include "Common/GiraffeLogger/GiraffeLogger.h"
+
+GRenderExecutor::~GRenderExecutor()
+{
+	Release();
+}
+
+bool GRenderExecutor::Init(int iThreadNum)
+{
+	try
+	{
+		GLOGGER(info) << "==> GRenderExecutor::Init(). Thread Num: " << iThreadNum;
+
+		std::lock_guard<std::mutex> lk(m_mtExecutorMutex);
+
+		if (!m_vPtrWorkers.empty())
+		{
+			GLOGGER(error) << "GRenderExecutor::Init(). Error: Already Inited. ==>";
+			return false;
+		}
+
+		if (iThreadNum <= 0)
+		{
+			GLOGGER(error) << "GRenderExecutor::Init(). Error: Invalid Thread Num. ==>";
+			return false;
+		}
+
+		m_tpStartTime = std::chrono::steady_clock::now();
+
+		for (int iThread = 0; iThread < iThreadNum; ++iThread)
+		{
+			std::shared_ptr<tWorker> ptrWorker = std::make_shared<tWorker>();
+			ptrWorker->tdWorker = std::thread(GRenderExecutor::WorkerLoop, this, ptrWorker.get());
+			m_vPtrWorkers.push_back(ptrWorker);
+		}
+
+		GLOGGER(info) << "GRenderExecutor::Init(). ==>";
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GRenderExecutor::Init(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GRenderExecutor::Attach(GRenderTaskIF* pTask)
+{
+	try
+	{
+		std::lock_guard<std::mutex> lk(m_mtExecutorMutex);
+
+		if (m_vPtrWorkers.empty())
+		{
+			GLOGGER(error) << "GRenderExecutor::Attach(). Error: Not Inited. ==>";
+			return false;
+		}
+
+		if (m_mpTaskWorkers.end() != m_mpTaskWorkers.find(pTask))
+		{
+			GLOGGER(error) << "GRenderExecutor::Attach(). Error: Already Attached. ==>";
+			return false;
+		}
+
+		//the thread with the fewest tasks.
+		tWorker* pWorker = nullptr;
+		size_t szMinTaskNum = 0;
+		for (int iWorker = 0; iWorker < m_vPtrWorkers.size(); ++iWorker)
+		{
+			std::lock_guard<std::mutex> lkWorker(m_vPtrWorkers[iWorker]->mtWorkerMutex);
+			if ((nullptr == pWorker) || (m_vPtrWorkers[iWorker]->vTasks.size() < szMinTaskNum))
+			{
+				pWorker = m_vPtrWorkers[iWorker].get();
+				szMinTaskNum = pWorker->vTasks.size();
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lkWorker(pWorker->mtWorkerMutex);
+			tTaskSlot taskSlot;
+			taskSlot.pTask = pTask;
+			taskSlot.ullLastStep = pWorker->ullSteps;
+			pWorker->vTasks.push_back(taskSlot);
+			pWorker->bNotified = true;
+		}
+		pWorker->cvWorker.notify_one();
+
+		m_mpTaskWorkers[pTask] = pWorker;
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GRenderExecutor::Attach(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+void GRenderExecutor::Notify(GRenderTaskIF* pTask)
+{
+	std::lock_guard<std::mutex> lk(m_mtExecutorMutex);
+
+	std::map<GRenderTaskIF*, tWorker*>::iterator itTask = m_mpTaskWorkers.find(pTask);
+	if (m_mpTaskWorkers.end() == itTask)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lkWorker(itTask->second->mtWorkerMutex);
+		itTask->second->bNotified = true;
+	}
+	itTask->second->cvWorker.notify_one();
+}
+
+void GRenderExecutor::WaitForFinish(GRenderTaskIF* pTask)
+{
+	std::unique_lock<std::mutex> lk(m_mtExecutorMutex);
+	m_cvTaskFinished.wait(lk, [this, pTask]()
+	{
+		return (this->m_mpTaskWorkers.end() == this->m_mpTaskWorkers.find(pTask));
+	});
+}
+
+bool GRenderExecutor::GetStatistics(G_tRenderExecutorStatistics& statistics)
+{
+	try
+	{
+		std::lock_guard<std::mutex> lk(m_mtExecutorMutex);
+
+		double dSchedulingDelay_ms = 0.0;
+		double dBusyTime_ms = 0.0;
+
+		statistics.uiThreadNum = static_cast<unsigned int>(m_vPtrWorkers.size());
+		statistics.uiPanoRenderNum = static_cast<unsigned int>(m_mpTaskWorkers.size());
+		statistics.ullSteps = 0;
+		statistics.ullContextSwitches = 0;
+		statistics.fMaxSchedulingDelay_ms = 0.0f;
+
+		for (int iWorker = 0; iWorker < m_vPtrWorkers.size(); ++iWorker)
+		{
+			tWorker* pWorker = m_vPtrWorkers[iWorker].get();
+			std::lock_guard<std::mutex> lkWorker(pWorker->mtWorkerMutex);
+
+			statistics.ullSteps += pWorker->ullSteps;
+			statistics.ullContextSwitches += pWorker->ullContextSwitches;
+			statistics.fMaxSchedulingDelay_ms = (std::max)(statistics.fMaxSchedulingDelay_ms, static_cast<float>(pWorker->dMaxSchedulingDelay_ms));
+			dSchedulingDelay_ms += pWorker->dSchedulingDelay_ms;
+			dBusyTime_ms += pWorker->dBusyTime_ms;
+		}
+
+		statistics.fAverageSchedulingDelay_ms = (0 < statistics.ullSteps) ? static_cast<float>(dSchedulingDelay_ms / statistics.ullSteps) : 0.0f;
+
+		double dElapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_tpStartTime).count();
+		statistics.fUtilization = ((0 < statistics.uiThreadNum) && (0.0 < dElapsed_ms)) ?
+			static_cast<float>(dBusyTime_ms / (dElapsed_ms * statistics.uiThreadNum)) : 0.0f;
+
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GRenderExecutor::GetStatistics(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+bool GRenderExecutor::Release()
+{
+	try
+	{
+		std::vector<std::shared_ptr<tWorker>> vPtrWorkers;
+		{
+			std::lock_guard<std::mutex> lk(m_mtExecutorMutex);
+			if (!m_mpTaskWorkers.empty())
+			{
+				GLOGGER(error) << "GRenderExecutor::Release(). Error: " << m_mpTaskWorkers.size() << " PanoRenders still attached. ==>";
+				return false;
+			}
+
+			vPtrWorkers.swap(m_vPtrWorkers);
+		}
+
+		for (int iWorker = 0; iWorker < vPtrWorkers.size(); ++iWorker)
+		{
+			{
+				std::lock_guard<std::mutex> lkWorker(vPtrWorkers[iWorker]->mtWorkerMutex);
+				vPtrWorkers[iWorker]->bRunning = false;
+			}
+			vPtrWorkers[iWorker]->cvWorker.notify_one();
+			vPtrWorkers[iWorker]->tdWorker.join();
+		}
+
+		return true;
+	}
+	catch (...)
+	{
+		GLOGGER(error) << "GRenderExecutor::Release(). EXCEPTION. ==>";
+		return false;
+	}
+}
+
+GRenderTaskIF* GRenderExecutor::PickTask(tWorker* pWorker)
+{
+	std::vector<tTaskSlot> vTasks;
+	{
+		std::unique_lock<std::mutex> lk(pWorker->mtWorkerMutex);
+		//events that arrive while the tasks are checked are not lost.
+		pWorker->bNotified = false;
+		vTasks = pWorker->vTasks;
+	}
+
+	std::chrono::steady_clock::time_point tpNow = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point tpWakeUp = (std::chrono::steady_clock::time_point::max)();
+
+	//the task that has been runnable for the longest time runs first, so a task never waits for more
+	//than one step of each other task. the least recently run task wins ties.
+	int iPicked = -1;
+	std::chrono::steady_clock::time_point tpPickedReadySince;
+	for (int iTask = 0; iTask < vTasks.size(); ++iTask)
+	{
+		std::chrono::steady_clock::time_point tpReadySince = tpNow;
+		std::chrono::steady_clock::time_point tpTaskWakeUp = (std::chrono::steady_clock::time_point::max)();
+		if (!vTasks[iTask].pTask->IsRunnable(tpNow, tpReadySince, tpTaskWakeUp))
+		{
+			tpWakeUp = (std::min)(tpWakeUp, tpTaskWakeUp);
+			continue;
+		}
+
+		tpReadySince = (std::min)(tpReadySince, tpNow);
+		if ((-1 == iPicked) || (tpReadySince < tpPickedReadySince) ||
+			((tpReadySince == tpPickedReadySince) && (vTasks[iTask].ullLastStep < vTasks[iPicked].ullLastStep)))
+		{
+			iPicked = iTask;
+			tpPickedReadySince = tpReadySince;
+		}
+	}
+
+	std::unique_lock<std::mutex> lk(pWorker->mtWorkerMutex);
+	if (-1 != iPicked)
+	{
+		double dSchedulingDelay_ms = std::chrono::duration<double, std::milli>(tpNow - tpPickedReadySince).count();
+		pWorker->dSchedulingDelay_ms += dSchedulingDelay_ms;
+		pWorker->dMaxSchedulingDelay_ms = (std::max)(pWorker->dMaxSchedulingDelay_ms, dSchedulingDelay_ms);
+		return vTasks[iPicked].pTask;
+	}
+
+	if ((std::chrono::steady_clock::time_point::max)() == tpWakeUp)
+	{
+		pWorker->cvWorker.wait(lk, [pWorker]()
+		{
+			return (pWorker->bNotified || (!pWorker->bRunning));
+		});
+	}
+	else
+	{
+		pWorker->cvWorker.wait_until(lk, tpWakeUp, [pWorker]()
+		{
+			return (pWorker->bNotified || (!pWorker->bRunning));
+		});
+	}
+
+	return nullptr;
+}
+
+void GRenderExecutor::WorkerLoop(GRenderExecutor* pExecutor, tWorker* pWorker)
+{
+	GLOGGER(info) << "==> GRenderExecutor::WorkerLoop().";
+
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lk(pWorker->mtWorkerMutex);
+			//Release() is called only after all tasks finished.
+			if ((!pWorker->bRunning) && pWorker->vTasks.empty())
+			{
+				break;
+			}
+		}
+
+		GRenderTaskIF* pTask = pExecutor->PickTask(pWorker);
+		if (nullptr == pTask)
+		{
+			continue;
+		}
+
+		if (pTask != pWorker->pCurrentTask)
+		{
+			//a failed switch leaves the previous context current, the step must not run against it.
+			if (!pTask->MakeCurrent())
+			{
+				GLOGGER(error) << "GRenderExecutor::WorkerLoop(). MakeCurrent FAILED, step skipped.";
+				continue;
+			}
+
+			std::lock_guard<std::mutex> lk(pWorker->mtWorkerMutex);
+			pWorker->pCurrentTask = pTask;
+			++pWorker->ullContextSwitches;
+		}
+
+		std::chrono::steady_clock::time_point tpStepStart = std::chrono::steady_clock::now();
+		bool bContinue = pTask->RunStep();
+		double dStepTime_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStepStart).count();
+
+		if (bContinue)
+		{
+			std::lock_guard<std::mutex> lk(pWorker->mtWorkerMutex);
+			++pWorker->ullSteps;
+			pWorker->dBusyTime_ms += dStepTime_ms;
+			for (int iTask = 0; iTask < pWorker->vTasks.size(); ++iTask)
+			{
+				if (pTask == pWorker->vTasks[iTask].pTask)
+				{
+					pWorker->vTasks[iTask].ullLastStep = pWorker->ullSteps;
+				}
+			}
+			continue;
+		}
+
+		//the task released its context, the next one has to be made current anyway.
+		{
+			std::lock_guard<std::mutex> lk(pExecutor->m_mtExecutorMutex);
+			pExecutor->m_mpTaskWorkers.erase(pTask);
+
+			std::lock_guard<std::mutex> lkWorker(pWorker->mtWorkerMutex);
+			++pWorker->ullSteps;
+			pWorker->dBusyTime_ms += dStepTime_ms;
+			pWorker->pCurrentTask = nullptr;
+			pWorker->vTasks.erase(std::remove_if(pWorker->vTasks.begin(), pWorker->vTasks.end(), [pTask](const tTaskSlot& taskSlot)
+			{
+				return (pTask == taskSlot.pTask);
+			}), pWorker->vTasks.end());
+		}
+		pExecutor->m_cvTaskFinished.notify_all();
+	}
+
+	GLOGGER(info) << "GRenderExecutor::WorkerLoop() ==>";
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#ifndef G_RENDER_EXECUTOR_H_
+#define G_RENDER_EXECUTOR_H_
+
+#include "PanoRender/GPanoRenderOGLIF.h"
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+class GRenderTaskIF
+{
+public:
+	virtual ~GRenderTaskIF(){};
+
+	//run one iteration of the rendering loop. return false when the task is finished and should be removed.
+	virtual bool RunStep() = 0;
+
+	//whether the next step can run at tpNow. if so, tpReadySince tells since when it could run,
+	//otherwise tpWakeUp tells when it will become runnable without any event.
+	virtual bool IsRunnable(const std::chrono::steady_clock::time_point& tpNow
+		, std::chrono::steady_clock::time_point& tpReadySince, std::chrono::steady_clock::time_point& tpWakeUp) = 0;
+
+	//make the OpenGL context of the task current on the calling thread. on failure the step is skipped,
+	//the task should not be runnable again before it can retry.
+	virtual bool MakeCurrent() = 0;
+};
+
+//a pool of render threads shared by many tasks. a task stays on one thread, so its OpenGL context never migrates,
+//and a thread switches between the contexts of its tasks. runnable tasks of a thread run one step at a time
+//in the order they became runnable, so a task paced by deadlines runs at its deadline unless the thread is overloaded.
+class GRenderExecutor
+{
+public:
+	GRenderExecutor(){}
+
+	~GRenderExecutor();
+
+	bool Init(int iThreadNum);
+
+	//the task runs on the thread with the fewest tasks, until RunStep() returns false.
+	bool Attach(GRenderTaskIF* pTask);
+
+	//tell the thread of the task that the task may have become runnable.
+	void Notify(GRenderTaskIF* pTask);
+
+	//block until the task finished.
+	void WaitForFinish(GRenderTaskIF* pTask);
+
+	bool GetStatistics(G_tRenderExecutorStatistics& statistics);
+
+	bool Release();
+
+private:
+	struct tTaskSlot
+	{
+		tTaskSlot() :
+			pTask(nullptr)
+			, ullLastStep(0)
+		{}
+
+		GRenderTaskIF* pTask;
+		unsigned long long ullLastStep;
+	};
+
+	struct tWorker
+	{
+		tWorker() :
+			bRunning(true)
+			, bNotified(false)
+			, pCurrentTask(nullptr)
+			, ullSteps(0)
+			, ullContextSwitches(0)
+			, dBusyTime_ms(0.0)
+			, dSchedulingDelay_ms(0.0)
+			, dMaxSchedulingDelay_ms(0.0)
+		{}
+
+		std::thread tdWorker;
+		std::mutex mtWorkerMutex;
+		std::condition_variable cvWorker;
+		std::vector<tTaskSlot> vTasks;
+		bool bRunning;
+		bool bNotified;
+		GRenderTaskIF* pCurrentTask;
+
+		unsigned long long ullSteps;
+		unsigned long long ullContextSwitches;
+		double dBusyTime_ms;
+		double dSchedulingDelay_ms;
+		double dMaxSchedulingDelay_ms;
+	};
+
+	static void WorkerLoop(GRenderExecutor* pExecutor, tWorker* pWorker);
+
+	GRenderTaskIF* PickTask(tWorker* pWorker);
+
+private:
+	std::vector<std::shared_ptr<tWorker>> m_vPtrWorkers;
+	std::map<GRenderTaskIF*, tWorker*> m_mpTaskWorkers;
+	std::mutex m_mtExecutorMutex;
+	std::condition_variable m_cvTaskFinished;
+
+	std::chrono::steady_clock::time_point m_tpStartTime;
+};
+
+
+#endif //G_RENDER_EXECUTOR_H_
@@ -308,6 +308,21 @@ void OnKeyPressed(unsigned char ucKey, int iX, int iY)
 		G_GrabPano(iPanoRenderIdx, &uiPanoWidth, &uiPanoHeight, mPano.data);
 		cv::imwrite("panograb.jpg", mPano);
 	}
+
+	//cpu cost of rendering the scenes, averaged over the recent frames.
+	if ('s' == ucKey)
+	{
+		G_tRenderStatistics renderStatistics;
+		if (G_ePanoRenderErrorCodeNone != G_GetRenderStatistics(iPanoRenderIdx, &renderStatistics))
+		{
+			return;
+		}
+		std::cout << "fps: " << renderStatistics.fAchievedFPS
+			<< ", frame time: " << renderStatistics.fAverageFrameTime_ms << " ms"
+			<< ", scene cpu time: " << renderStatistics.fAverageSceneCPUTime_ms << " ms"
+			<< ", draw calls: " << renderStatistics.fAverageDrawCalls
+			<< ", state changes: " << renderStatistics.fAverageStateChanges << std::endl;
+	}
 }
 
 void OnClose()
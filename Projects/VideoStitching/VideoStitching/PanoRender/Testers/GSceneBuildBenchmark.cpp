@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2015-2023 Pengju Lu, Yanli Wang
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+ 
+ 
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "opencv2/core/core.hpp"
+
+#include "GRenderScene.h"
+#include "GSurfaceGenerator.h"
+#include "GProjectorObjects.h"
+#include "GPanoTypeStaticParameters.h"
+
+
+//times the cpu part of a scene build (surface generation and patch generation) without a gl context.
+//the unwrapped pano types are timed with remap tables as well, see G_SetRenderPath().
+//usage: SceneBuildBenchmark [tessellation level] [repeat times] [remap table width] [remap table height]
+
+struct tBenchmarkCamera
+{
+	cv::Mat mR;
+	cv::Mat mK;
+	cv::Mat mDist;
+};
+
+//fisheye cameras evenly spaced around the vertical axis, normalized intrinsics.
+static std::vector<tBenchmarkCamera> CreateCameras(int iNumOfCameras)
+{
+	std::vector<tBenchmarkCamera> vCameras(iNumOfCameras);
+	for (int iCameraIdx = 0; iCameraIdx < iNumOfCameras; ++iCameraIdx)
+	{
+		double dYaw = 2.0 * CV_PI * iCameraIdx / iNumOfCameras;
+		vCameras[iCameraIdx].mR = (cv::Mat_<double>(3, 3) <<
+			cos(dYaw), 0.0, sin(dYaw),
+			0.0, 1.0, 0.0,
+			-sin(dYaw), 0.0, cos(dYaw));
+		vCameras[iCameraIdx].mK = (cv::Mat_<double>(3, 3) <<
+			0.3, 0.0, 0.5,
+			0.0, 0.3, 0.5,
+			0.0, 0.0, 1.0);
+		vCameras[iCameraIdx].mDist = cv::Mat::zeros(1, 8, CV_64FC1);
+	}
+	return vCameras;
+}
+
+template<class tProjectorObject>
+static void SetUpProjectors(const std::vector<tBenchmarkCamera>& vCameras, std::vector<tProjectorObject>& vProjectorObjs)
+{
+	vProjectorObjs.resize(vCameras.size());
+	for (size_t iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+	{
+		vProjectorObjs[iProjectorObjIdx].SetCameraIdx(static_cast<int>(iProjectorObjIdx));
+		vProjectorObjs[iProjectorObjIdx].SetR10(vCameras[iProjectorObjIdx].mR.inv());
+		vProjectorObjs[iProjectorObjIdx].SetDist1(vCameras[iProjectorObjIdx].mDist);
+		vProjectorObjs[iProjectorObjIdx].SetK1(vCameras[iProjectorObjIdx].mK);
+		vProjectorObjs[iProjectorObjIdx].SetCameraType(eCameraTypeFisheye);
+		vProjectorObjs[iProjectorObjIdx].SetDistortionValidRange(1.6f);
+	}
+}
+
+static bool IsSamePatches(const std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches1
+	, const std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan>& mpPatches2)
+{
+	if (mpPatches1.size() != mpPatches2.size())
+	{
+		return false;
+	}
+
+	for (auto it1 = mpPatches1.begin(), it2 = mpPatches2.begin(); it1 != mpPatches1.end(); ++it1, ++it2)
+	{
+		const GScenePatch& patch1 = it1->second;
+		const GScenePatch& patch2 = it2->second;
+		if (it1->first != it2->first
+			|| patch1.vVertices.size() != patch2.vVertices.size()
+			|| patch1.vVerticeIndices != patch2.vVerticeIndices
+			|| patch1.vMultiTextureCoordinates.size() != patch2.vMultiTextureCoordinates.size())
+		{
+			return false;
+		}
+
+		for (size_t iVertexIdx = 0; iVertexIdx < patch1.vVertices.size(); ++iVertexIdx)
+		{
+			if (patch1.vVertices[iVertexIdx].x != patch2.vVertices[iVertexIdx].x
+				|| patch1.vVertices[iVertexIdx].y != patch2.vVertices[iVertexIdx].y
+				|| patch1.vVertices[iVertexIdx].z != patch2.vVertices[iVertexIdx].z)
+			{
+				return false;
+			}
+		}
+
+		for (size_t iTextureIdx = 0; iTextureIdx < patch1.vMultiTextureCoordinates.size(); ++iTextureIdx)
+		{
+			const std::vector<tTextureCoordinate>& vCoordinates1 = patch1.vMultiTextureCoordinates[iTextureIdx].second;
+			const std::vector<tTextureCoordinate>& vCoordinates2 = patch2.vMultiTextureCoordinates[iTextureIdx].second;
+			if (patch1.vMultiTextureCoordinates[iTextureIdx].first != patch2.vMultiTextureCoordinates[iTextureIdx].first
+				|| vCoordinates1.size() != vCoordinates2.size())
+			{
+				return false;
+			}
+
+			for (size_t iCoordinateIdx = 0; iCoordinateIdx < vCoordinates1.size(); ++iCoordinateIdx)
+			{
+				if (vCoordinates1[iCoordinateIdx].u != vCoordinates2[iCoordinateIdx].u
+					|| vCoordinates1[iCoordinateIdx].v != vCoordinates2[iCoordinateIdx].v
+					|| vCoordinates1[iCoordinateIdx].weight != vCoordinates2[iCoordinateIdx].weight)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+static double ElapsedMs(const std::chrono::steady_clock::time_point& tpStart)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count();
+}
+
+//returns false if the multi threaded patches differ from the single threaded ones.
+template<class tProjectorObject>
+static bool RunCase(const std::string& sPanoType, int iNumOfCameras, int iRepeatTimes
+	, std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator, const std::vector<tProjectorObject>& vProjectorObjs)
+{
+	std::vector<tVertex> vVertices;
+	std::vector<GLuint> vVerticeIndices;
+
+	std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+	for (int iRepeatIdx = 0; iRepeatIdx < iRepeatTimes; ++iRepeatIdx)
+	{
+		vVertices.clear();
+		vVerticeIndices.clear();
+		ptrSurfaceGenerator->GenerateSurface(vVertices, vVerticeIndices);
+	}
+	double dSurfaceTime_ms = ElapsedMs(tpStart) / iRepeatTimes;
+
+	std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan> mpSingleThreadPatches;
+	tpStart = std::chrono::steady_clock::now();
+	for (int iRepeatIdx = 0; iRepeatIdx < iRepeatTimes; ++iRepeatIdx)
+	{
+		GPatchesGenerator::GeneratePatches(vVertices, vVerticeIndices, vProjectorObjs, mpSingleThreadPatches, 1);
+	}
+	double dSingleThreadTime_ms = ElapsedMs(tpStart) / iRepeatTimes;
+
+	std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan> mpPatches;
+	tpStart = std::chrono::steady_clock::now();
+	for (int iRepeatIdx = 0; iRepeatIdx < iRepeatTimes; ++iRepeatIdx)
+	{
+		GPatchesGenerator::GeneratePatches(vVertices, vVerticeIndices, vProjectorObjs, mpPatches);
+	}
+	double dMultiThreadTime_ms = ElapsedMs(tpStart) / iRepeatTimes;
+
+	bool bSame = IsSamePatches(mpSingleThreadPatches, mpPatches);
+
+	//what Prepare() uploads to the vertex buffers.
+	size_t uiPatchVertexNum = 0;
+	size_t uiBufferSize_Byte = 0;
+	for (auto it = mpPatches.begin(); it != mpPatches.end(); ++it)
+	{
+		uiPatchVertexNum += it->second.vVertices.size();
+		uiBufferSize_Byte += it->second.vVertices.size() * (sizeof(tVertex) + it->second.vMultiTextureCoordinates.size() * sizeof(tTextureCoordinate))
+			+ it->second.vVerticeIndices.size() * sizeof(GLuint);
+	}
+
+	std::cout << std::left << std::setw(24) << sPanoType
+		<< std::right << std::setw(8) << iNumOfCameras
+		<< std::setw(10) << vVerticeIndices.size() / 3
+		<< std::setw(9) << mpPatches.size()
+		<< std::setw(10) << uiPatchVertexNum
+		<< std::setw(10) << uiBufferSize_Byte / 1024
+		<< std::fixed << std::setprecision(2)
+		<< std::setw(12) << dSurfaceTime_ms
+		<< std::setw(12) << dSingleThreadTime_ms
+		<< std::setw(12) << dMultiThreadTime_ms
+		<< std::setw(9) << ((dMultiThreadTime_ms > 0.0) ? dSingleThreadTime_ms / dMultiThreadTime_ms : 0.0)
+		<< "  " << (bSame ? "same" : "DIFFERENT") << std::endl;
+
+	return bSame;
+}
+
+//a remap table replaces both the surface and the patches of the mesh.
+template<class tProjectorObject>
+static void RunRemapCase(const std::string& sPanoType, int iNumOfCameras, int iRepeatTimes, const cv::Size& szTable
+	, std::shared_ptr<GSurfaceGenerator4RenderIF> ptrSurfaceGenerator, const std::vector<tProjectorObject>& vProjectorObjs)
+{
+	float fPlaneWidth = 0.0f;
+	float fPlaneHeight = 0.0f;
+	ptrSurfaceGenerator->GetPlaneSize(fPlaneWidth, fPlaneHeight);
+
+	std::vector<tVertex> vVertices;
+	std::vector<GLuint> vVerticeIndices;
+	std::map < std::bitset<MAX_PATCHES_NUM>, GScenePatch, BitsetLessThan> mpPatches;
+	std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+	for (int iRepeatIdx = 0; iRepeatIdx < iRepeatTimes; ++iRepeatIdx)
+	{
+		vVertices.clear();
+		vVerticeIndices.clear();
+		ptrSurfaceGenerator->GenerateSurface(vVertices, vVerticeIndices);
+		GPatchesGenerator::GeneratePatches(vVertices, vVerticeIndices, vProjectorObjs, mpPatches);
+	}
+	double dMeshTime_ms = ElapsedMs(tpStart) / iRepeatTimes;
+
+	GRemapTable remapTable;
+	tpStart = std::chrono::steady_clock::now();
+	for (int iRepeatIdx = 0; iRepeatIdx < iRepeatTimes; ++iRepeatIdx)
+	{
+		remapTable.Generate(fPlaneWidth, fPlaneHeight, szTable.width, szTable.height, vProjectorObjs, 4);
+	}
+	double dRemapTime_ms = ElapsedMs(tpStart) / iRepeatTimes;
+
+	std::cout << std::left << std::setw(24) << sPanoType
+		<< std::right << std::setw(8) << iNumOfCameras
+		<< std::setw(8) << remapTable.iLayerNum
+		<< std::setw(10) << (size_t)remapTable.iLayerNum * remapTable.iWidth * remapTable.iHeight * sizeof(GRemapTable::tTexel) / 1024
+		<< std::fixed << std::setprecision(2)
+		<< std::setw(12) << dRemapTime_ms
+		<< std::setw(12) << dMeshTime_ms << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	int iTessellationLevel = (argc > 1) ? atoi(argv[1]) : 7;
+	int iRepeatTimes = (argc > 2) ? atoi(argv[2]) : 3;
+	iRepeatTimes = (iRepeatTimes < 1) ? 1 : iRepeatTimes;
+	cv::Size szRemapTable((argc > 3) ? atoi(argv[3]) : 1920, (argc > 4) ? atoi(argv[4]) : 960);
+
+	std::cout << "tessellation level: " << iTessellationLevel
+		<< ", repeat times: " << iRepeatTimes
+		<< ", threads: " << std::thread::hardware_concurrency() << std::endl;
+	std::cout << std::left << std::setw(24) << "pano type"
+		<< std::right << std::setw(8) << "cameras"
+		<< std::setw(10) << "triangles"
+		<< std::setw(9) << "patches"
+		<< std::setw(10) << "vertices"
+		<< std::setw(10) << "buffer KB"
+		<< std::setw(12) << "surface ms"
+		<< std::setw(12) << "1 thread ms"
+		<< std::setw(12) << "N thread ms"
+		<< std::setw(9) << "speedup" << std::endl;
+
+	bool bAllSame = true;
+	const int vNumOfCameras[] = { 2, 4, 6, 8 };
+	for (size_t iCaseIdx = 0; iCaseIdx < sizeof(vNumOfCameras) / sizeof(vNumOfCameras[0]); ++iCaseIdx)
+	{
+		int iNumOfCameras = vNumOfCameras[iCaseIdx];
+		std::vector<tBenchmarkCamera> vCameras = CreateCameras(iNumOfCameras);
+
+		{
+			std::shared_ptr<GSurfaceGeneratorSphere> ptrSphereSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorSphere>(new GSurfaceGeneratorSphere);
+			ptrSphereSurfaceGenerator->SetTessellationLevel(iTessellationLevel);
+			std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+			SetUpProjectors(vCameras, vProjectorObjs);
+			bAllSame &= RunCase("ImmersionSemiSphere", iNumOfCameras, iRepeatTimes, ptrSphereSurfaceGenerator, vProjectorObjs);
+		}
+
+		{
+			std::shared_ptr<GSurfaceGeneratorSphere> ptrSphereSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorSphere>(new GSurfaceGeneratorSphere);
+			ptrSphereSurfaceGenerator->SetIsFullSphere(true);
+			ptrSphereSurfaceGenerator->SetTessellationLevel(iTessellationLevel);
+			std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+			SetUpProjectors(vCameras, vProjectorObjs);
+			bAllSame &= RunCase("ImmersionFullSphere", iNumOfCameras, iRepeatTimes, ptrSphereSurfaceGenerator, vProjectorObjs);
+		}
+
+		{
+			std::shared_ptr<GSurfaceGeneratorCylinder> ptrCylinderSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorCylinder>(new GSurfaceGeneratorCylinder);
+			ptrCylinderSurfaceGenerator->SetSurfaceSize(GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeImmersionCylinder360));
+			ptrCylinderSurfaceGenerator->SetTessellationLevel(iTessellationLevel);
+			std::vector<GProjectorObjectGlobal3d2NormalizedPix> vProjectorObjs;
+			SetUpProjectors(vCameras, vProjectorObjs);
+			bAllSame &= RunCase("ImmersionCylinder360", iNumOfCameras, iRepeatTimes, ptrCylinderSurfaceGenerator, vProjectorObjs);
+		}
+
+		{
+			std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
+			ptrPlaneSurfaceGenerator->SetSurfaceSize(
+				GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinder360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinder360));
+			ptrPlaneSurfaceGenerator->SetTessellationLevel(iTessellationLevel);
+			std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+			SetUpProjectors(vCameras, vProjectorObjs);
+			for (size_t iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+			{
+				vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+				vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
+			}
+			bAllSame &= RunCase("UnwrappedCylinder360", iNumOfCameras, iRepeatTimes, ptrPlaneSurfaceGenerator, vProjectorObjs);
+		}
+
+		{
+			std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
+			ptrPlaneSurfaceGenerator->SetSurfaceSize(
+				GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedFullSphere360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedFullSphere360));
+			ptrPlaneSurfaceGenerator->SetTessellationLevel(iTessellationLevel);
+			std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+			SetUpProjectors(vCameras, vProjectorObjs);
+			for (size_t iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+			{
+				vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+				vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(true);
+			}
+			bAllSame &= RunCase("UnwrappedFullSphere360", iNumOfCameras, iRepeatTimes, ptrPlaneSurfaceGenerator, vProjectorObjs);
+		}
+	}
+
+	std::cout << std::endl << "remap table: " << szRemapTable.width << "x" << szRemapTable.height << std::endl;
+	std::cout << std::left << std::setw(24) << "pano type"
+		<< std::right << std::setw(8) << "cameras"
+		<< std::setw(8) << "layers"
+		<< std::setw(10) << "table KB"
+		<< std::setw(12) << "remap ms"
+		<< std::setw(12) << "mesh ms" << std::endl;
+
+	for (size_t iCaseIdx = 0; iCaseIdx < sizeof(vNumOfCameras) / sizeof(vNumOfCameras[0]); ++iCaseIdx)
+	{
+		int iNumOfCameras = vNumOfCameras[iCaseIdx];
+		std::vector<tBenchmarkCamera> vCameras = CreateCameras(iNumOfCameras);
+
+		{
+			std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
+			ptrPlaneSurfaceGenerator->SetSurfaceSize(
+				GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedCylinder360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedCylinder360));
+			ptrPlaneSurfaceGenerator->SetTessellationLevel(iTessellationLevel);
+			std::vector<GProjectorObjectCylinderExpandedPlane3d2NormalizedPix> vProjectorObjs;
+			SetUpProjectors(vCameras, vProjectorObjs);
+			for (size_t iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+			{
+				vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+				vProjectorObjs[iProjectorObjIdx].SetTheta(0.0);
+			}
+			RunRemapCase("UnwrappedCylinder360", iNumOfCameras, iRepeatTimes, szRemapTable, ptrPlaneSurfaceGenerator, vProjectorObjs);
+		}
+
+		{
+			std::shared_ptr<GSurfaceGeneratorPlane> ptrPlaneSurfaceGenerator = std::shared_ptr<GSurfaceGeneratorPlane>(new GSurfaceGeneratorPlane);
+			ptrPlaneSurfaceGenerator->SetSurfaceSize(
+				GPanoTypeStaticParameters::GetDefaultCanvasWidth(ePanoTypeUnwrappedFullSphere360), GPanoTypeStaticParameters::GetDefaultCanvasHeight(ePanoTypeUnwrappedFullSphere360));
+			ptrPlaneSurfaceGenerator->SetTessellationLevel(iTessellationLevel);
+			std::vector<GProjectorObjectSphereExpandedPlane3d2NormalizedPix360> vProjectorObjs;
+			SetUpProjectors(vCameras, vProjectorObjs);
+			for (size_t iProjectorObjIdx = 0; iProjectorObjIdx < vProjectorObjs.size(); ++iProjectorObjIdx)
+			{
+				vProjectorObjs[iProjectorObjIdx].SetFlip(false);
+				vProjectorObjs[iProjectorObjIdx].SetIsFullSphere(true);
+			}
+			RunRemapCase("UnwrappedFullSphere360", iNumOfCameras, iRepeatTimes, szRemapTable, ptrPlaneSurfaceGenerator, vProjectorObjs);
+		}
+	}
+
+	return bAllSame ? 0 : 1;
+}